@@ -0,0 +1,137 @@
+/**
+ * BufferPool Microbenchmark
+ *
+ * v2.12: Compares the size-classed BufferPool against the v2.7 single-size
+ * pool under contention from several capture instances. Both take a mutex
+ * per acquire/release; the difference is that packets larger than the
+ * default buffer size are pooled in their size class instead of allocated.
+ *
+ * Each thread simulates one capture: it acquires a buffer per packet,
+ * writes it, and keeps a small window of buffers alive (JS still holding
+ * them) before dropping the oldest, which runs the release path.
+ *
+ * Build (Node headers + node-addon-api; no N-API calls are made):
+ *   g++ -O2 -std=c++17 -DNAPI_VERSION=8 -DNAPI_DISABLE_CPP_EXCEPTIONS \
+ *       -I<node>/include/node -Inode_modules/node-addon-api -Isrc/napi \
+ *       benchmark/buffer_pool_bench.cpp src/napi/external_buffer.cpp \
+ *       -lpthread -Wl,--unresolved-symbols=ignore-all -o buffer_pool_bench
+ *   (MSVC: cl /O2 /std:c++17 /EHsc with the same defines and include paths,
+ *    linking node.lib)
+ *
+ * Usage: buffer_pool_bench [threads=8] [packets_per_thread=200000]
+ */
+
+#include "external_buffer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using AudioCapture::BufferPool;
+using AudioCapture::ExternalBuffer;
+
+namespace {
+
+// v2.7 pool: one mutex, one buffer size, shared_ptr per acquire
+class LegacyBufferPool {
+public:
+    LegacyBufferPool(size_t buffer_size, size_t pool_size)
+        : buffer_size_(buffer_size), pool_size_(pool_size) {
+        for (size_t i = 0; i < pool_size; ++i) {
+            available_.push_back(new ExternalBuffer(buffer_size));
+        }
+    }
+
+    ~LegacyBufferPool() {
+        for (ExternalBuffer* buffer : available_) delete buffer;
+    }
+
+    std::shared_ptr<ExternalBuffer> Acquire(size_t size) {
+        if (size > buffer_size_) {
+            return std::make_shared<ExternalBuffer>(size);  // Copy-path fallback
+        }
+        ExternalBuffer* buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!available_.empty()) {
+                buffer = available_.back();
+                available_.pop_back();
+            }
+        }
+        if (!buffer) buffer = new ExternalBuffer(buffer_size_);
+        return std::shared_ptr<ExternalBuffer>(buffer, [this](ExternalBuffer* ptr) { Release(ptr); });
+    }
+
+private:
+    void Release(ExternalBuffer* buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (available_.size() < pool_size_) {
+            available_.push_back(buffer);
+        } else {
+            delete buffer;
+        }
+    }
+
+    size_t buffer_size_;
+    size_t pool_size_;
+    std::vector<ExternalBuffer*> available_;
+    std::mutex mutex_;
+};
+
+template <typename Pool>
+double Run(Pool& pool, int threads, int packets, size_t packet_size) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, packets, packet_size]() {
+            std::deque<std::shared_ptr<ExternalBuffer>> in_flight;  // Held by "JS"
+            for (int i = 0; i < packets; ++i) {
+                auto buffer = pool.Acquire(packet_size);
+                std::memset(buffer->data(), i & 0xFF, packet_size);
+                in_flight.push_back(std::move(buffer));
+                if (in_flight.size() > 8) {
+                    in_flight.pop_front();  // Finalizer -> release path
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(threads) * packets);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int threads = argc > 1 ? std::atoi(argv[1]) : 8;
+    int packets = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    // 10 ms packets: 48 kHz stereo float (3840 B) and 48 kHz 7.1 float (15360 B)
+    const size_t sizes[] = {3840, 15360};
+
+    std::printf("threads=%d packets/thread=%d\n", threads, packets);
+    std::printf("%-12s %-10s %12s\n", "pool", "packet", "ns/acquire");
+
+    for (size_t size : sizes) {
+        LegacyBufferPool legacy(4096, 100);
+        BufferPool pooled(4096, 100);
+
+        double legacy_ns = Run(legacy, threads, packets, size);
+        double pooled_ns = Run(pooled, threads, packets, size);
+
+        std::printf("%-12s %-10zu %12.1f\n", "v2.7", size, legacy_ns);
+        std::printf("%-12s %-10zu %12.1f\n", "size-class", size, pooled_ns);
+
+        auto stats = pooled.GetStats();
+        std::printf("  size-class hit rate: %.1f%% (%llu dynamic allocations)\n",
+                    stats.hit_rate, static_cast<unsigned long long>(stats.dynamic_allocations));
+    }
+    return 0;
+}
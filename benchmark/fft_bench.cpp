@@ -0,0 +1,97 @@
+/**
+ * Spectrum FFT Microbenchmark
+ *
+ * v2.12: Compares the real-input (packed N/2) FFT used by SpectrumAnalyzer
+ * against the kiss_fft complex transform of the same real signal (zero
+ * imaginary part), which is what the analyzer did before and is still the
+ * fftMode: 'complex' path. The in-house planar ComplexFFT is timed as well.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -Isrc/napi -Ideps/kiss_fft benchmark/fft_bench.cpp \
+ *       src/napi/real_fft.cpp deps/kiss_fft/kiss_fft.c deps/kiss_fft/kiss_fft_wrapper.c \
+ *       -o fft_bench
+ *   (MSVC: cl /O2 /std:c++17 /EHsc with the same sources and include paths)
+ *   Without deps/kiss_fft, add -DBENCH_NO_KISS_FFT and drop the kiss sources;
+ *   the speedup is then against ComplexFFT and labelled so.
+ *
+ * Usage: fft_bench [iterations=20000]
+ */
+
+#include "real_fft.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifndef BENCH_NO_KISS_FFT
+#include "kiss_fft_wrapper.h"
+#endif
+
+using audio_capture::AlignedVector;
+using audio_capture::ComplexFFT;
+using audio_capture::RealFFT;
+
+namespace {
+
+volatile float g_sink = 0.0f;  // Keeps results alive
+
+template <typename Fn>
+double TimeNs(int iterations, Fn&& fn) {
+    for (int i = 0; i < iterations / 10 + 1; i++) fn();  // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+#ifndef BENCH_NO_KISS_FFT
+    std::printf("%-6s %14s %14s %14s %14s\n", "size", "kiss (ns)", "complex (ns)", "real (ns)", "vs kiss");
+#else
+    std::printf("%-6s %14s %14s %14s\n", "size", "complex (ns)", "real (ns)", "vs complex");
+#endif
+
+    for (size_t n : {512u, 1024u, 2048u, 4096u}) {
+        AlignedVector<float> signal(n);
+        for (size_t i = 0; i < n; i++) {
+            signal[i] = static_cast<float>(std::sin(0.05 * i) + 0.25 * std::cos(0.31 * i));
+        }
+
+        // In-house planar complex transform with a zero imaginary part
+        ComplexFFT complex(n);
+        AlignedVector<float> cre(n), cim(n);
+        double complex_ns = TimeNs(iterations, [&] {
+            for (size_t i = 0; i < n; i++) { cre[i] = signal[i]; cim[i] = 0.0f; }
+            complex.Forward(cre.data(), cim.data());
+            g_sink = g_sink + cre[1];
+        });
+
+        RealFFT real(n);
+        AlignedVector<float> re(real.BinCount()), im(real.BinCount());
+        double real_ns = TimeNs(iterations, [&] {
+            real.Forward(signal.data(), re.data(), im.data());
+            g_sink = g_sink + re[1];
+        });
+
+#ifndef BENCH_NO_KISS_FFT
+        // Previous approach (and the fftMode: 'complex' path): kiss_fft complex transform
+        void* cfg = kiss_fft_wrapper_alloc(static_cast<int>(n));
+        std::vector<float> kin_i(n, 0.0f), kout_r(n), kout_i(n);
+        double kiss_ns = TimeNs(iterations, [&] {
+            kiss_fft_wrapper_transform(cfg, signal.data(), kin_i.data(),
+                                       kout_r.data(), kout_i.data(), static_cast<int>(n));
+            g_sink = g_sink + kout_r[1];
+        });
+        kiss_fft_wrapper_free(cfg);
+        std::printf("%-6zu %14.0f %14.0f %14.0f %13.2fx\n", n, kiss_ns, complex_ns, real_ns, kiss_ns / real_ns);
+#else
+        std::printf("%-6zu %14.0f %14.0f %13.2fx\n", n, complex_ns, real_ns, complex_ns / real_ns);
+#endif
+    }
+    return 0;
+}
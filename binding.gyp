@@ -18,10 +18,21 @@
         "src/napi/device_manager.cpp",
         "src/napi/external_buffer.cpp",
         "src/napi/audio_effects.cpp",
+        "src/napi/denoise_engine.cpp",
+        "src/napi/vad_gate.cpp",
         "src/napi/agc_processor.cpp",
         "src/napi/biquad_filter.cpp",
+        "src/napi/biquad_cascade.cpp",
         "src/napi/eq_processor.cpp",
+        "src/napi/true_peak_limiter.cpp",
         "src/napi/spectrum_analyzer.cpp",
+        "src/napi/real_fft.cpp",
+        "src/napi/mel_features.cpp",
+        "src/napi/polyphase_resampler.cpp",
+        "src/napi/format_converter.cpp",
+        "src/napi/processing_worker.cpp",
+        "src/napi/cpu_features.cpp",
+        "src/napi/audio_level_kernels.cpp",
         "deps/kiss_fft/kiss_fft.c",
         "deps/kiss_fft/kiss_fft_wrapper.c",
         "deps/rnnoise/src/celt_lpc.c",
@@ -113,6 +113,135 @@ export interface AudioCaptureOptions {
      */
     bufferPoolMax?: number;
     
+    /**
+     * v2.12: 在独立处理线程上运行效果链
+     * 捕获线程只把数据拷贝到无锁环形缓冲区，降噪/AGC/EQ 不再阻塞 WASAPI 缓冲区释放
+     * @default true
+     * @since 2.12.0
+     */
+    processingThread?: boolean;
+    
+    /**
+     * v2.12: 捕获线程 → 处理线程环形缓冲区槽位数（向上取整为 2 的幂）
+     * @default 64
+     * @since 2.12.0
+     */
+    processingQueueSize?: number;
+    
+    /**
+     * v2.12: 等待 JS 事件循环处理的数据包上限（0 = 无上限）
+     * JS 线程阻塞（GC 暂停等）时，超出部分按 deliveryPolicy 处理，原生内存有上界
+     * @default 32
+     * @since 2.12.0
+     */
+    deliveryQueueSize?: number;
+    
+    /**
+     * v2.12: 投递队列满时的策略
+     * - 'drop-oldest': 丢弃最旧的数据包（延迟最低）
+     * - 'drop-newest': 丢弃新到的数据包
+     * - 'coalesce': 合并到最新排队的数据包中（超过 coalesceMaxBytes 时退化为 drop-oldest）
+     * @default 'drop-oldest'
+     * @since 2.12.0
+     */
+    deliveryPolicy?: 'drop-oldest' | 'drop-newest' | 'coalesce';
+    
+    /**
+     * v2.12: coalesce 策略下单个合并数据包的最大字节数
+     * @default 1 秒音频（采样率 × 每帧字节数）
+     * @since 2.12.0
+     */
+    coalesceMaxBytes?: number;
+    
+    /**
+     * v2.12: 批量投递间隔（毫秒）
+     * 原生层把多个 WASAPI 数据包（约 10ms）合并为一个 Buffer，每批只回调一次 JS
+     * 0 表示不按时间合并
+     * @default 0
+     * @since 2.12.0
+     */
+    deliveryIntervalMs?: number;
+    
+    /**
+     * v2.12: 每次回调的最小字节数（与 deliveryIntervalMs 取较大者作为批次大小）
+     * 0 表示不按大小合并
+     * @default 0
+     * @since 2.12.0
+     */
+    minBytesPerCallback?: number;
+    
+    /**
+     * v2.12: 原生输出采样率（Hz）
+     * Float32 混音格式在处理线程上经多相滤波器重采样后再投递（替代 JS AudioResampler）
+     * 降噪/AGC/EQ、频谱、特征和统计仍在捕获采样率上运行
+     * 0 或与捕获采样率相同时不做重采样；非 Float32 格式忽略此选项
+     * @default 0
+     * @since 2.12.0
+     */
+    outputSampleRate?: number;
+    
+    /**
+     * v2.12: 原生重采样质量
+     * - 'fast': 8 个过零点，约 -60 dB 阻带
+     * - 'balanced': 16 个过零点，约 -85 dB 阻带
+     * - 'best': 32 个过零点，约 -100 dB 阻带
+     * @default 'balanced'
+     * @since 2.12.0
+     */
+    resampleQuality?: 'fast' | 'balanced' | 'best';
+    
+    /**
+     * v2.12: 原生输出样本格式（替代 utils/AudioFormatConverter.js）
+     * 'int16' 在处理线程上以饱和 SIMD 转换（满量程 1.0 = 32768），交给 JS 的数据量减半
+     * 非 Float32 混音格式忽略此选项
+     * @default 'float32'
+     * @since 2.12.0
+     */
+    outputFormat?: 'float32' | 'int16';
+    
+    /**
+     * v2.12: 原生输出声道数（1-8，0 = 与捕获格式相同）
+     * 默认混音：N → 1 取平均；1 → N 复制；5.1/7.1 → 2 含 -3 dB 中置/环绕（丢弃 LFE）
+     * @default 0
+     * @since 2.12.0
+     */
+    outputChannels?: number;
+    
+    /**
+     * v2.12: 自定义混音矩阵，每个输出声道一行，每行为各输入声道的增益
+     * 也可以是按行展开的一维数组；未指定 outputChannels 时取行数
+     * @example [[0.5, 0.5]] // 立体声 → 单声道
+     * @since 2.12.0
+     */
+    downmixMatrix?: number[][] | number[];
+    
+    /**
+     * v2.12: int16 输出时加 ±1 LSB 的 TPDF 抖动（消除低电平量化失真）
+     * @default false
+     * @since 2.12.0
+     */
+    dither?: boolean;
+    
+    /**
+     * v2.12: 原生 ASR 预设（与 lib/audio-processing-pipeline.js 同名）
+     * 一次设置 outputSampleRate / outputChannels / outputFormat / frameMs，单独指定的选项优先
+     * - 'china-asr': 16 kHz Int16 单声道，40 ms 帧（1280 字节）
+     * - 'openai-whisper' / 'azure' / 'google': 16 kHz Int16 单声道，100 ms 帧（3200 字节）
+     * - 'global-asr-48k': 48 kHz Int16 单声道，20 ms 帧
+     * - 'raw': 不转换
+     * @since 2.12.0
+     */
+    preset?: 'raw' | 'china-asr' | 'openai-whisper' | 'global-asr-48k' | 'azure' | 'google';
+    
+    /**
+     * v2.12: 固定帧长（毫秒）。每个 'data' Buffer 恰好是 frameMs 的输出格式数据
+     * （来自缓冲池，每帧一个），启用时取代 deliveryIntervalMs / minBytesPerCallback 批量投递；
+     * stopCapture() 时投递最后一个不完整的帧。0 表示按数据包投递
+     * @default 0
+     * @since 2.12.0
+     */
+    frameMs?: number;
+    
     /**
      * v2.7: 音频效果配置
      * @since 2.7.0
@@ -175,6 +304,20 @@ export interface AudioStats {
      */
     isSilence: boolean;
     
+    /**
+     * 当前连续静音时长（毫秒，跨统计间隔累计）
+     * 仅 'stats' 事件提供
+     * @since 2.12.0
+     */
+    silenceDuration?: number;
+    
+    /**
+     * 本统计间隔覆盖的采样数（所有声道）
+     * 仅 'stats' 事件提供；上一个事件未能投递时合并覆盖多个间隔
+     * @since 2.12.0
+     */
+    sampleCount?: number;
+    
     /**
      * Unix 时间戳（毫秒）
      */
@@ -210,19 +353,51 @@ export interface AudioStatsOptions {
 export interface SpectrumAnalyzerOptions {
     /**
      * FFT 大小（必须是 2 的幂）
-     * 注意：必须小于音频缓冲区的样本数
+     * v2.12: 样本在内部滑动窗口中累积，不再受单个音频包大小限制
      * @default 2048
      * @range 256 - 8192
      */
     fftSize?: number;
     
+    /**
+     * FFT 模式
+     * - 'real': 实数输入 FFT（N/2 打包变换，约为复数 FFT 一半的计算量）
+     * - 'complex': 完整复数 FFT（虚部为零）
+     * fftSize 不是 2 的幂时自动使用 'complex'
+     * @default 'real'
+     * @since 2.12.0
+     */
+    fftMode?: 'real' | 'complex';
+    
     /**
      * 频谱更新间隔（毫秒）
+     * v2.12: 按音频时长计算（每 interval 毫秒的音频输出一帧），未指定 hopSize/overlap 时生效
      * @default 100
      * @range 10 - 1000
      */
     interval?: number;
     
+    /**
+     * STFT 跳跃长度（单声道采样数），优先于 overlap 和 interval
+     * @since 2.12.0
+     */
+    hopSize?: number;
+    
+    /**
+     * 频段数据格式
+     * - 'objects': bands 数组，每个频段一个对象（兼容 v2.11）
+     * - 'soa': bandEnergy / bandDb 两个 Float32Array，每帧 O(1) 开销，适合大量频段
+     * @default 'objects'
+     * @since 2.12.0
+     */
+    bandLayout?: 'objects' | 'soa';
+    
+    /**
+     * STFT 重叠比例（0 - 0.95），hopSize = fftSize * (1 - overlap)
+     * @since 2.12.0
+     */
+    overlap?: number;
+    
     /**
      * 频谱平滑因子（0 = 无平滑，1 = 最大平滑）
      * @default 0.8
@@ -236,6 +411,40 @@ export interface SpectrumAnalyzerOptions {
      */
     frequencyBands?: FrequencyBandConfig[];
     
+    /**
+     * 自动生成对数频段（用于 32 - 128 柱的可视化），覆盖 frequencyBands
+     * - 'custom': 使用 frequencyBands
+     * - 'third-octave': ISO 1/3 倍频程（20 Hz - 20 kHz 为 31 段，忽略 bandCount）
+     * - 'log': bandCount 个对数等距频段
+     * - 'mel': bandCount 个 mel 刻度等距频段
+     * 频段名称为中心频率（如 "63 Hz"、"1.0 kHz"）
+     * @default 'custom'
+     * @since 2.12.0
+     */
+    bandScale?: 'custom' | 'third-octave' | 'log' | 'mel';
+    
+    /**
+     * 'log' / 'mel' 频段数量
+     * @default 64
+     * @range 1 - 256
+     * @since 2.12.0
+     */
+    bandCount?: number;
+    
+    /**
+     * 生成频段的最低频率（Hz）
+     * @default 20
+     * @since 2.12.0
+     */
+    bandMinFreq?: number;
+    
+    /**
+     * 生成频段的最高频率（Hz），不超过采样率的一半
+     * @default 20000
+     * @since 2.12.0
+     */
+    bandMaxFreq?: number;
+    
     /**
      * 语音检测配置
      */
@@ -329,13 +538,26 @@ export interface SpectrumData {
     /**
      * FFT 幅度谱（Float32Array）
      * 长度为 fftSize / 2
+     * v2.12: 零拷贝视图，直接引用原生帧内存（只读使用；需要保留时请复制）
      */
     magnitudes: Float32Array;
     
     /**
-     * 频段分析结果
+     * 频段分析结果（bandLayout 为 'objects' 时提供）
+     */
+    bands?: FrequencyBand[];
+    
+    /**
+     * 各频段能量（bandLayout 为 'soa' 时提供，与 getSpectrumConfig().bandNames 顺序一致）
+     * @since 2.12.0
+     */
+    bandEnergy?: Float32Array;
+    
+    /**
+     * 各频段分贝值（bandLayout 为 'soa' 时提供）
+     * @since 2.12.0
      */
-    bands: FrequencyBand[];
+    bandDb?: Float32Array;
     
     /**
      * 语音概率（0-1）
@@ -365,6 +587,240 @@ export interface SpectrumData {
      * 时间戳（毫秒）
      */
     timestamp: number;
+    
+    /**
+     * 帧结束处的流位置（单声道采样数，从启用频谱分析开始计数）
+     * @since 2.12.0
+     */
+    position: number;
+}
+
+/**
+ * v2.12.0: 对数 Mel 特征提取选项（ASR 前端）
+ * 特征在捕获采样率下计算，Mel 滤波器只覆盖 minFreq - maxFreq，无需先重采样
+ * @since 2.12.0
+ */
+export interface FeatureExtractorOptions {
+    /**
+     * Mel 滤波器数量
+     * @default 80
+     * @range 1 - 256
+     */
+    melBins?: number;
+    
+    /**
+     * 分析窗长（毫秒），FFT 大小为不小于窗长的 2 的幂
+     * @default 25
+     */
+    windowMs?: number;
+    
+    /**
+     * 帧移（毫秒）
+     * @default 10
+     */
+    hopMs?: number;
+    
+    /**
+     * 最低频率（Hz）
+     * @default 20
+     */
+    minFreq?: number;
+    
+    /**
+     * 最高频率（Hz），不超过采样率的一半
+     * @default 8000
+     */
+    maxFreq?: number;
+    
+    /**
+     * 预加重系数（0 = 关闭）
+     * @default 0.97
+     */
+    preemphasis?: number;
+    
+    /**
+     * 倒谱均值/方差归一化（滑动窗口）
+     * - 'none': 不归一化
+     * - 'mean': 减去均值
+     * - 'meanvar': 减去均值并除以标准差
+     * @default 'none'
+     */
+    cmvn?: 'none' | 'mean' | 'meanvar';
+    
+    /**
+     * CMVN 滑动窗口（帧数）
+     * @default 300
+     */
+    cmvnWindow?: number;
+    
+    /**
+     * 每个 'features' 事件包含的帧数
+     * @default 1
+     */
+    framesPerEvent?: number;
+    
+    /**
+     * 是否继续发出 PCM 'data' 事件（false 时只发出 'features'）
+     * @default true
+     */
+    deliverAudio?: boolean;
+}
+
+/**
+ * v2.12.0: 对数 Mel 特征帧
+ * @since 2.12.0
+ */
+export interface FeatureData {
+    /**
+     * frameCount × melBins 个对数 Mel 能量，按帧排列（第 f 帧第 m 个: features[f * melBins + m]）
+     */
+    features: Float32Array;
+    
+    /**
+     * 帧数
+     */
+    frameCount: number;
+    
+    /**
+     * 每帧 Mel 滤波器数量
+     */
+    melBins: number;
+    
+    /**
+     * 最后一帧窗口结束处的流位置（单声道采样数，从启用特征提取开始计数）
+     */
+    position: number;
+    
+    /**
+     * 时间戳（毫秒）
+     */
+    timestamp: number;
+}
+
+/**
+ * v2.12.0: 特征提取配置信息（只读）
+ * @since 2.12.0
+ */
+export interface FeatureConfig extends FeatureExtractorOptions {
+    enabled: boolean;
+    deliverAudio: boolean;
+    sampleRate?: number;
+    /** 窗长（采样数） */
+    windowLength?: number;
+    /** 帧移（采样数） */
+    hopLength?: number;
+    fftSize?: number;
+}
+
+/**
+ * v2.12.0: 原生语音活动门限选项
+ * @since 2.12.0
+ */
+export interface VadOptions {
+    /** 语音概率阈值 (0-1)，默认 0.5 */
+    threshold?: number;
+    /** 连续语音多久后开门（毫秒），默认 30 */
+    attackMs?: number;
+    /** 连续非语音多久后关门（毫秒），默认 300 */
+    hangoverMs?: number;
+    /** 开门时补发语音起点之前的音频（毫秒），默认 200 */
+    preRollMs?: number;
+    /**
+     * 语音概率来源，默认 'auto'
+     * - 'auto' / 'rnnoise': 降噪开启时使用 RNNoise 概率，否则能量检测
+     * - 'energy': 始终使用能量检测（自适应噪声底）
+     */
+    source?: 'auto' | 'rnnoise' | 'energy';
+    /** 能量检测的最低电平（dBFS），默认 -50 */
+    energyThresholdDb?: number;
+    /** 能量检测高于噪声底的余量（dB），默认 10 */
+    energyMarginDb?: number;
+}
+
+/**
+ * v2.12.0: 'speechStart' / 'speechEnd' 事件数据
+ * 位置以捕获采样率的帧计数（自 startCapture 起），与投递的音频逐帧对齐
+ * @since 2.12.0
+ */
+export interface SpeechEvent {
+    /** speechStart: 第一个投递的帧（含预录）；speechEnd: 最后一个投递帧之后 */
+    position: number;
+    positionMs: number;
+    /** 仅 speechStart：触发开门的语音起点 */
+    onset?: number;
+    onsetMs?: number;
+    /** 判定帧的语音概率 */
+    probability: number;
+    /** 捕获采样率 */
+    sampleRate: number;
+    timestamp: number;
+}
+
+/**
+ * v2.12.0: 语音活动门限统计
+ * @since 2.12.0
+ */
+export interface VadStats {
+    enabled: boolean;
+    /** 当前是否处于语音段内 */
+    speaking: boolean;
+    source: 'auto' | 'rnnoise' | 'energy';
+    /** 最近一次判定的语音概率 */
+    probability: number;
+    /** 能量检测的噪声底（dBFS） */
+    noiseFloorDb: number;
+    threshold: number;
+    attackMs: number;
+    hangoverMs: number;
+    preRollMs: number;
+    /** 语音段数 */
+    segments: number;
+    /** 输入帧数 */
+    framesIn: number;
+    /** 投递帧数（含预录和拖尾） */
+    framesDelivered: number;
+    /** 被抑制的比例 (0-1) */
+    suppressedRatio: number;
+    /** 单个数据包内事件过多而丢弃的事件数 */
+    droppedEvents: number;
+}
+
+/**
+ * v2.12.0: 真峰值限幅器选项
+ * @since 2.12.0
+ */
+export interface LimiterOptions {
+    /** 真峰值上限（dBTP，-20 到 0），默认 -1 */
+    ceilingDb?: number;
+    /** 前瞻时间（毫秒，0.1-20），默认 1.5；增益在峰值到达前平滑降低 */
+    lookaheadMs?: number;
+    /** 释放时间（毫秒，1-2000），默认 50 */
+    releaseMs?: number;
+}
+
+/**
+ * v2.12.0: 真峰值限幅器统计
+ * @since 2.12.0
+ */
+export interface LimiterStats {
+    enabled: boolean;
+    ceilingDb: number;
+    lookaheadMs: number;
+    releaseMs: number;
+    /** 限幅器增加的延迟（前瞻 + 插值器） */
+    latencyFrames: number;
+    latencyMs: number;
+    /** 当前增益衰减（dB，0 = 未限幅） */
+    gainReductionDb: number;
+    /** 自 startCapture 起最大的增益衰减（dB） */
+    maxGainReductionDb: number;
+    /** 自 startCapture 起输入的最大真峰值（dBTP，4 倍过采样） */
+    truePeakDb: number;
+    /** 发生增益衰减的帧数 */
+    limitedFrames: number;
+    framesProcessed: number;
+    /** limitedFrames / framesProcessed */
+    limitedRatio: number;
 }
 
 /**
@@ -382,6 +838,36 @@ export interface SpectrumConfig {
      */
     fftSize: number;
     
+    /**
+     * 实际使用的 FFT 模式
+     * @since 2.12.0
+     */
+    fftMode?: 'real' | 'complex';
+    
+    /**
+     * 实际使用的 STFT 跳跃长度（单声道采样数）
+     * @since 2.12.0
+     */
+    hopSize?: number;
+    
+    /**
+     * 频段数据格式
+     * @since 2.12.0
+     */
+    bandLayout?: 'objects' | 'soa';
+    
+    /**
+     * 频段生成方式
+     * @since 2.12.0
+     */
+    bandScale?: 'custom' | 'third-octave' | 'log' | 'mel';
+    
+    /**
+     * 频段名称（与 bandEnergy / bandDb 下标对应）
+     * @since 2.12.0
+     */
+    bandNames?: string[];
+    
     /**
      * 采样率（Hz）
      */
@@ -551,6 +1037,192 @@ export interface BufferPoolStats {
      * v2.7: adaptive 策略目标 2-5%
      */
     hitRate: number;
+    
+    /**
+     * v2.12: 默认缓冲区大小（字节），startCapture() 后按协商后的数据包/批次大小设置
+     * 每个捕获实例拥有独立的缓冲池，统计信息互不影响
+     */
+    bufferSize: number;
+}
+
+/**
+ * v2.12: pause() 选项
+ * @since 2.12.0
+ */
+export interface PauseOptions {
+    /**
+     * 同时停止 WASAPI 音频流（IAudioClient::Stop），resume() 时重新启动
+     * @default false
+     */
+    stopStream?: boolean;
+}
+
+/**
+ * v2.12: 捕获管线统计信息
+ * @since 2.12.0
+ */
+export interface PipelineStats {
+    /**
+     * 处理线程是否在运行
+     */
+    processingThread: boolean;
+    
+    /**
+     * 环形缓冲区槽位数
+     */
+    queueCapacity: number;
+    
+    /**
+     * 当前排队的槽位数
+     */
+    queueDepth: number;
+    
+    /**
+     * 观测到的最大排队深度
+     */
+    queueHighWater: number;
+    
+    /**
+     * 捕获线程成功入队的数据包数
+     */
+    packetsSubmitted: number;
+    
+    /**
+     * 处理线程已处理完的数据包数（与 packetsSubmitted 同单位；
+     * 超大数据包占用多个槽位，但只计一次）
+     */
+    packetsProcessed: number;
+    
+    /**
+     * 环形缓冲区满而丢弃的数据包数
+     */
+    overruns: number;
+    
+    /**
+     * JS 投递队列溢出策略
+     */
+    deliveryPolicy: 'drop-oldest' | 'drop-newest' | 'coalesce';
+    
+    /**
+     * JS 投递队列上限（0 = 无上限）
+     */
+    deliveryQueueSize: number;
+    
+    /**
+     * 当前等待 JS 处理的数据包数
+     */
+    deliveryQueueDepth: number;
+    
+    /**
+     * 观测到的最大等待数据包数
+     */
+    deliveryQueueHighWater: number;
+    
+    /**
+     * 已交给 JS 的数据包数
+     */
+    packetsDelivered: number;
+    
+    /**
+     * 因 JS 阻塞被策略丢弃的数据包数
+     */
+    packetsDropped: number;
+    
+    /**
+     * 被合并到已排队数据包中的数据包数
+     */
+    packetsCoalesced: number;
+    
+    /**
+     * 因 TSFN 队列满而丢弃的非音频事件数（频谱等）
+     */
+    eventsDropped: number;
+    
+    /**
+     * 原生层是否处于暂停状态
+     */
+    paused: boolean;
+    
+    /**
+     * WASAPI 音频流是否被 pause({ stopStream: true }) 停止
+     */
+    streamPaused: boolean;
+    
+    /**
+     * 暂停期间丢弃的数据包数
+     */
+    packetsSkipped: number;
+}
+
+/**
+ * v2.12: 投递给 JS 的音频格式
+ * @since 2.12.0
+ */
+export interface OutputFormat {
+    /**
+     * 输出采样率（Hz）
+     */
+    sampleRate: number;
+    
+    /**
+     * 声道数
+     */
+    channels: number;
+    
+    /**
+     * 每个样本的位数
+     */
+    bitsPerSample: number;
+    
+    /**
+     * 是否为 IEEE float 样本
+     */
+    isFloat: boolean;
+    
+    /**
+     * 样本格式，如 'float32'、'int16'
+     */
+    format: string;
+    
+    /**
+     * 捕获（混音格式）采样率（Hz）
+     */
+    captureSampleRate: number;
+    
+    /**
+     * 捕获（混音格式）声道数
+     */
+    captureChannels: number;
+    
+    /**
+     * 原生重采样器是否生效
+     */
+    resampling: boolean;
+    
+    /**
+     * 重采样质量
+     */
+    resampleQuality: 'fast' | 'balanced' | 'best';
+    
+    /**
+     * int16 输出是否启用 TPDF 抖动
+     */
+    dither: boolean;
+    
+    /**
+     * ASR 预设名称（未使用预设时为 null）
+     */
+    preset: string | null;
+    
+    /**
+     * 固定帧长（毫秒，0 = 按数据包投递）
+     */
+    frameMs: number;
+    
+    /**
+     * 每帧字节数（0 = 按数据包投递）
+     */
+    frameBytes: number;
 }
 
 /**
@@ -579,6 +1251,94 @@ export interface DenoiseStats {
      * 降噪是否启用
      */
     enabled: boolean;
+    
+    /**
+     * v2.12: 声道模式
+     */
+    mode: DenoiseMode;
+    
+    /**
+     * v2.12: 捕获声道数
+     */
+    channels: number;
+    
+    /**
+     * v2.12: RNNoise 实例数（per-channel = channels，downmix = 1）
+     */
+    states: number;
+    
+    /**
+     * v2.12: 捕获采样率（非 48000 Hz 时内部重采样到 48 kHz）
+     */
+    sampleRate: number;
+    
+    /**
+     * v2.12: 是否在内部重采样到 48 kHz
+     */
+    resampling: boolean;
+    
+    /**
+     * v2.12: 降噪引入的固定延迟（捕获采样率下的帧数）
+     */
+    latencyFrames: number;
+    
+    /**
+     * v2.12: 降噪引入的固定延迟（毫秒）
+     */
+    latencyMs: number;
+    
+    /**
+     * v2.12: 是否使用进程共享的降噪线程池
+     */
+    sharedPool: boolean;
+    
+    /**
+     * v2.12: 共享线程池计数（进程内所有使用它的捕获合计；仅 sharedPool 时存在）
+     */
+    engine?: DenoiseEngineStats;
+}
+
+/**
+ * v2.12: 共享降噪线程池统计
+ */
+export interface DenoiseEngineStats {
+    /** 工作线程数（硬件线程数的一半，1-8） */
+    workers: number;
+    /** 提交的批次数（每凑满一个 480 样本帧一批，每个 RNNoise 实例一个任务） */
+    batches: number;
+    /** 已执行的任务数（RNNoise 帧数） */
+    jobs: number;
+    /** 由工作线程执行的任务数（其余由提交线程执行） */
+    jobsOnWorkers: number;
+    /** 提交线程在等待期间替其他捕获执行的任务数 */
+    jobsHelped: number;
+    /** 抛出异常的任务数 */
+    failures: number;
+}
+
+/**
+ * v2.12: 降噪声道模式
+ * - 'per-channel': 每个声道一个 RNNoise 实例（保留立体声像）
+ * - 'downmix': 混为单声道降噪后写回所有声道（CPU 为 1/N）
+ */
+export type DenoiseMode = 'per-channel' | 'downmix';
+
+/**
+ * v2.12: setDenoiseEnabled() 选项
+ */
+export interface DenoiseOptions {
+    /**
+     * 声道模式
+     * @default 'per-channel'
+     */
+    mode?: DenoiseMode;
+    
+    /**
+     * 在进程共享的线程池上处理 RNNoise 帧（单声道与 downmix 同样适用）。
+     * 多路捕获的帧进入同一队列，共用同一组线程，而不是各自串行处理所有声道。
+     * @default false
+     */
+    sharedPool?: boolean;
 }
 
 /**
@@ -627,8 +1387,33 @@ export interface AGCOptions {
      * @default 100
      */
     releaseTime?: number;
+    
+    /**
+     * v2.12: 增益计算模式
+     * - 'block'：每个数据包计算一次 RMS 和增益（v2.8 行为）
+     * - 'lookahead'：每 1 ms 测量一次电平（与 WASAPI 数据包大小无关），
+     *   输出延迟 lookaheadMs，增益逐采样平滑过渡，数据包边界处无增益跳变
+     * @default 'block'
+     * @since 2.12.0
+     */
+    mode?: AGCMode;
+    
+    /**
+     * v2.12: 'lookahead' 模式的前瞻延迟（ms，0-50）
+     * - 增益变化提前于引起它的信号开始
+     * - 该延迟会加到捕获路径上（见 AGCStats.latencyMs）
+     * @default 5
+     * @since 2.12.0
+     */
+    lookaheadMs?: number;
 }
 
+/**
+ * v2.12: AGC 模式
+ * @since 2.12.0
+ */
+export type AGCMode = 'block' | 'lookahead';
+
 /**
  * v2.8: AGC 统计信息
  * @since 2.8.0
@@ -663,6 +1448,21 @@ export interface AGCStats {
      * 已处理的音频帧数
      */
     framesProcessed: number;
+    
+    /**
+     * v2.12: 当前模式
+     */
+    mode: AGCMode;
+    
+    /**
+     * v2.12: 前瞻延迟（帧，'block' 模式为 0）
+     */
+    latencyFrames: number;
+    
+    /**
+     * v2.12: 前瞻延迟（毫秒）
+     */
+    latencyMs: number;
 }
 
 /**
@@ -742,9 +1542,11 @@ export declare class AudioCapture extends EventEmitter {
     
     /**
      * 暂停音频捕获（不触发 data 事件）
+     * v2.12: 原生层同时跳过整个处理管线，暂停的捕获几乎不占用 CPU
+     * @param options.stopStream 同时停止 WASAPI 音频流（默认 false）
      * @throws {Error} 如果未在运行
      */
-    pause(): void;
+    pause(options?: PauseOptions): void;
     
     /**
      * 恢复音频捕获
@@ -896,13 +1698,29 @@ export declare class AudioCapture extends EventEmitter {
      */
     getPoolStats(): BufferPoolStats | null;
     
+    /**
+     * v2.12: 获取捕获管线统计信息（处理线程队列深度、溢出计数）
+     * @returns 统计信息对象
+     * @since 2.12.0
+     */
+    getPipelineStats(): PipelineStats;
+    
+    /**
+     * v2.12: 获取 'data' 事件缓冲区的音频格式（原生输出阶段之后）
+     * @returns 输出格式
+     * @throws {Error} 如果 AudioProcessor 未初始化
+     * @since 2.12.0
+     */
+    getOutputFormat(): OutputFormat;
+    
     /**
      * v2.7: 启用或禁用音频降噪（RNNoise）
      * @param enabled - true 启用，false 禁用
+     * @param options - v2.12: 声道模式
      * @throws {Error} 如果降噪处理器初始化失败
      * @since 2.7.0
      */
-    setDenoiseEnabled(enabled: boolean): void;
+    setDenoiseEnabled(enabled: boolean, options?: DenoiseOptions): void;
     
     /**
      * v2.7: 获取当前降噪状态
@@ -1012,6 +1830,7 @@ export declare class AudioCapture extends EventEmitter {
     /**
      * v2.10.0: 启用实时音频统计
      * 启用后会定期（根据 interval）触发 'stats' 事件
+     * v2.12: 统计在原生处理线程上增量计算，间隔按音频采样数计算
      * @param options - 统计选项
      * @since 2.10.0
      * @example
@@ -1178,6 +1997,88 @@ export declare class AudioCapture extends EventEmitter {
      */
     getSpectrumConfig(): SpectrumConfig | null;
     
+    // ==================== v2.12: Log-mel Feature Methods ====================
+    
+    /**
+     * v2.12.0: 启用原生对数 Mel 特征提取
+     * 在原生处理线程上计算特征并通过 'features' 事件发出，
+     * deliverAudio: false 时不再发出 PCM，跨越 N-API 的数据量大幅减少
+     * @param options - 特征提取选项
+     * @returns 是否成功启用
+     * @since 2.12.0
+     * @example
+     * ```typescript
+     * capture.enableFeatures({ melBins: 80, cmvn: 'meanvar', framesPerEvent: 10, deliverAudio: false });
+     * capture.on('features', ({ features, frameCount, melBins }) => {
+     *   asr.push(features, frameCount, melBins);
+     * });
+     * ```
+     */
+    enableFeatures(options?: FeatureExtractorOptions): boolean;
+    
+    /**
+     * v2.12.0: 禁用特征提取（恢复 PCM 'data' 事件）
+     * @since 2.12.0
+     */
+    disableFeatures(): boolean;
+    
+    /**
+     * v2.12.0: 获取特征提取配置
+     * @since 2.12.0
+     */
+    getFeatureConfig(): FeatureConfig | null;
+    
+    /**
+     * v2.12.0: 启用原生语音活动门限
+     * 非语音音频不再投递到 'data'，语音段边界通过 'speechStart' / 'speechEnd' 发出，
+     * 与 'data' 按顺序到达且不会因投递队列满而丢弃
+     * @example
+     * ```typescript
+     * capture.setDenoiseEnabled(true);  // RNNoise 语音概率
+     * capture.enableVad({ hangoverMs: 500, preRollMs: 300 });
+     * capture.on('speechEnd', ({ positionMs }) => asr.finish(positionMs));
+     * ```
+     * @since 2.12.0
+     */
+    enableVad(options?: VadOptions): boolean;
+    
+    /**
+     * v2.12.0: 禁用语音活动门限（进行中的语音段在其剩余音频之后以 'speechEnd' 结束）
+     * @since 2.12.0
+     */
+    disableVad(): boolean;
+    
+    /**
+     * v2.12.0: 获取语音活动门限统计，未启用时返回 null
+     * @since 2.12.0
+     */
+    getVadStats(): VadStats | null;
+    
+    /**
+     * v2.12.0: 启用真峰值限幅器（效果链最后一级，位于 AGC 和 EQ 之后）
+     * 4 倍过采样检测样点间峰值，前瞻平滑降低增益，输出不超过 ceilingDb
+     * @example
+     * ```typescript
+     * capture.setEQBandGain('high', 12);
+     * capture.enableLimiter({ ceilingDb: -1 });
+     * console.log(capture.getLimiterStats()?.maxGainReductionDb);
+     * ```
+     * @since 2.12.0
+     */
+    enableLimiter(options?: LimiterOptions): boolean;
+    
+    /**
+     * v2.12.0: 禁用真峰值限幅器（保留配置）
+     * @since 2.12.0
+     */
+    disableLimiter(): boolean;
+    
+    /**
+     * v2.12.0: 获取限幅器统计（增益衰减表），从未启用时返回 null
+     * @since 2.12.0
+     */
+    getLimiterStats(): LimiterStats | null;
+    
     /**
      * 音频数据事件
      * @event
@@ -1217,6 +2118,21 @@ export declare class AudioCapture extends EventEmitter {
      */
     on(event: 'spectrum', listener: (data: SpectrumData) => void): this;
     
+    /**
+     * v2.12.0: 对数 Mel 特征事件
+     * 当启用 enableFeatures() 后，每 framesPerEvent 帧触发一次
+     * @event
+     * @since 2.12.0
+     */
+    on(event: 'features', listener: (data: FeatureData) => void): this;
+    
+    /**
+     * v2.12.0: 语音段开始 / 结束（enableVad() 后）
+     * @event
+     * @since 2.12.0
+     */
+    on(event: 'speechStart' | 'speechEnd', listener: (data: SpeechEvent) => void): this;
+    
     /**
      * 错误事件
      * @event
@@ -1252,12 +2168,15 @@ export declare class AudioCapture extends EventEmitter {
     once(event: 'data', listener: (data: AudioDataEvent) => void): this;
     once(event: 'stats', listener: (stats: AudioStats) => void): this;
     once(event: 'spectrum', listener: (data: SpectrumData) => void): this;
+    once(event: 'features', listener: (data: FeatureData) => void): this;
+    once(event: 'speechStart' | 'speechEnd', listener: (data: SpeechEvent) => void): this;
     once(event: 'error', listener: (error: Error) => void): this;
     once(event: 'started' | 'stopped' | 'paused' | 'resumed', listener: () => void): this;
     once(event: string | symbol, listener: (...args: any[]) => void): this;
     emit(event: 'data', data: AudioDataEvent): boolean;
     emit(event: 'stats', stats: AudioStats): boolean;
     emit(event: 'spectrum', data: SpectrumData): boolean;
+    emit(event: 'features', data: FeatureData): boolean;
     emit(event: 'error', error: Error): boolean;
     emit(event: 'started' | 'stopped' | 'paused' | 'resumed'): boolean;
     emit(event: string | symbol, ...args: any[]): boolean;
@@ -1458,8 +2377,9 @@ export declare class MicrophoneCapture extends EventEmitter {
      * 启用或禁用降噪
      * 
      * @param enabled - true 启用，false 禁用
+     * @param options - v2.12: 声道模式
      */
-    setDenoiseEnabled(enabled: boolean): void;
+    setDenoiseEnabled(enabled: boolean, options?: DenoiseOptions): void;
     
     /**
      * 获取降噪状态
@@ -44,8 +44,6 @@ class AudioCapture extends EventEmitter {
         // v2.10.0: 音频统计相关状态
         this._statsEnabled = false;
         this._statsInterval = 500; // 默认 500ms 统计一次
-        this._statsBuffer = [];
-        this._lastStatsTime = 0;
         this._silenceThreshold = 0.001; // Phase 2: 默认静音阈值
         
         // 创建 Native AudioProcessor 实例
@@ -74,6 +72,63 @@ class AudioCapture extends EventEmitter {
                 processorOptions.bufferPoolMax = options.bufferPoolMax;
             }
             
+            // v2.12: Processing thread (effect chain runs off the capture thread)
+            if (options.processingThread !== undefined) {
+                processorOptions.processingThread = Boolean(options.processingThread);
+            }
+            if (options.processingQueueSize !== undefined) {
+                processorOptions.processingQueueSize = options.processingQueueSize;
+            }
+            
+            // v2.12: Bounded JS delivery queue (backpressure)
+            if (options.deliveryQueueSize !== undefined) {
+                processorOptions.deliveryQueueSize = options.deliveryQueueSize;
+            }
+            if (options.deliveryPolicy !== undefined) {
+                processorOptions.deliveryPolicy = options.deliveryPolicy;
+            }
+            if (options.coalesceMaxBytes !== undefined) {
+                processorOptions.coalesceMaxBytes = options.coalesceMaxBytes;
+            }
+            
+            // v2.12: Batched delivery (one callback per batch of packets)
+            if (options.deliveryIntervalMs !== undefined) {
+                processorOptions.deliveryIntervalMs = options.deliveryIntervalMs;
+            }
+            if (options.minBytesPerCallback !== undefined) {
+                processorOptions.minBytesPerCallback = options.minBytesPerCallback;
+            }
+            
+            // v2.12: Native output sample rate (resampled on the processing thread)
+            if (options.outputSampleRate !== undefined) {
+                processorOptions.outputSampleRate = options.outputSampleRate;
+            }
+            if (options.resampleQuality !== undefined) {
+                processorOptions.resampleQuality = options.resampleQuality;
+            }
+            
+            // v2.12: Native output format / channel conversion (before delivery to JS)
+            if (options.outputFormat !== undefined) {
+                processorOptions.outputFormat = options.outputFormat;
+            }
+            if (options.outputChannels !== undefined) {
+                processorOptions.outputChannels = options.outputChannels;
+            }
+            if (options.downmixMatrix !== undefined) {
+                processorOptions.downmixMatrix = options.downmixMatrix;
+            }
+            if (options.dither !== undefined) {
+                processorOptions.dither = Boolean(options.dither);
+            }
+            
+            // v2.12: Native ASR preset and fixed-size output frames
+            if (options.preset !== undefined) {
+                processorOptions.preset = options.preset;
+            }
+            if (options.frameMs !== undefined) {
+                processorOptions.frameMs = options.frameMs;
+            }
+            
             this._processor = new addon.AudioProcessor(processorOptions);
         } catch (error) {
             this.emit('error', new Error(`Failed to create AudioProcessor: ${error.message}`));
@@ -155,6 +210,8 @@ class AudioCapture extends EventEmitter {
      * @param {number} [options.interval=100] - 频谱数据间隔（毫秒）
      * @param {number} [options.smoothing=0.8] - 平滑因子 (0-1)
      * @param {Array} [options.frequencyBands] - 自定义频段
+     * @param {string} [options.bandScale='custom'] - 生成频段: 'custom' | 'third-octave' | 'log' | 'mel' (v2.12)
+     * @param {number} [options.bandCount=64] - 'log' / 'mel' 频段数量 (v2.12)
      * @param {Object} [options.voiceDetection] - 语音检测配置
      * @returns {boolean} 是否成功启用
      */
@@ -213,13 +270,143 @@ class AudioCapture extends EventEmitter {
         return this._processor.getSpectrumConfig();
     }
     
+    /**
+     * 启用对数 Mel 特征提取 (v2.12.0)
+     * @param {Object} [options] - 特征提取选项
+     * @param {number} [options.melBins=80] - Mel 滤波器数量
+     * @param {number} [options.windowMs=25] - 窗长（毫秒）
+     * @param {number} [options.hopMs=10] - 帧移（毫秒）
+     * @param {string} [options.cmvn='none'] - 'none' | 'mean' | 'meanvar'
+     * @param {number} [options.framesPerEvent=1] - 每个 'features' 事件的帧数
+     * @param {boolean} [options.deliverAudio=true] - 是否继续发出 PCM 'data' 事件
+     * @returns {boolean} 是否成功启用
+     */
+    enableFeatures(options = {}) {
+        if (!this._processor) {
+            throw new Error('AudioProcessor not initialized');
+        }
+        return this._processor.enableFeatures(options);
+    }
+    
+    /**
+     * 禁用对数 Mel 特征提取 (v2.12.0)
+     * @returns {boolean} 是否成功禁用
+     */
+    disableFeatures() {
+        if (!this._processor) {
+            return false;
+        }
+        return this._processor.disableFeatures();
+    }
+    
+    /**
+     * 获取特征提取配置 (v2.12.0)
+     * @returns {Object|null} 当前配置
+     */
+    getFeatureConfig() {
+        if (!this._processor) {
+            return null;
+        }
+        return this._processor.getFeatureConfig();
+    }
+    
+    /**
+     * 启用原生语音活动门限 (v2.12.0)
+     * 非语音音频不再投递到 'data'；语音段边界通过 'speechStart' / 'speechEnd' 事件发出。
+     * 边界与 'data' 走同一投递队列、按顺序到达（'speechEnd' 之前已收到该段全部音频），
+     * 且不会因队列满而被丢弃。
+     * 开启降噪时使用 RNNoise 的语音概率，否则使用能量检测（自适应噪声底）。
+     * @param {Object} [options] - VAD 选项
+     * @param {number} [options.threshold=0.5] - 语音概率阈值 (0-1)
+     * @param {number} [options.attackMs=30] - 连续语音多久后开门
+     * @param {number} [options.hangoverMs=300] - 连续非语音多久后关门
+     * @param {number} [options.preRollMs=200] - 开门时补发语音起点之前的音频
+     * @param {string} [options.source='auto'] - 'auto' | 'rnnoise' | 'energy'
+     * @param {number} [options.energyThresholdDb=-50] - 能量检测的最低电平 (dBFS)
+     * @param {number} [options.energyMarginDb=10] - 能量检测高于噪声底的余量 (dB)
+     * @returns {boolean} 是否成功启用
+     */
+    enableVad(options = {}) {
+        if (!this._processor) {
+            throw new Error('AudioProcessor not initialized');
+        }
+        return this._processor.enableVad(options);
+    }
+    
+    /**
+     * 禁用语音活动门限 (v2.12.0)，进行中的语音段在其剩余音频之后以 'speechEnd' 结束
+     * （捕获中由处理线程在下一个数据包前完成；暂停期间推迟到恢复或停止）
+     * @returns {boolean} 是否成功禁用
+     */
+    disableVad() {
+        if (!this._processor) {
+            return false;
+        }
+        return this._processor.disableVad();
+    }
+    
+    /**
+     * 获取语音活动门限统计 (v2.12.0)
+     * @returns {Object|null} 统计信息，未启用时为 null
+     */
+    getVadStats() {
+        if (!this._processor) {
+            return null;
+        }
+        return this._processor.getVadStats();
+    }
+    
+    /**
+     * 启用真峰值限幅器 (v2.12.0)
+     * 位于 AGC 和 EQ 之后的最后一级效果：4 倍过采样检测真峰值，前瞻降低增益，输出不超过上限。
+     * @param {Object} [options] - 限幅器选项
+     * @param {number} [options.ceilingDb=-1] - 真峰值上限 (dBTP, -20 到 0)
+     * @param {number} [options.lookaheadMs=1.5] - 前瞻时间 (0.1-20 ms)
+     * @param {number} [options.releaseMs=50] - 释放时间 (1-2000 ms)
+     * @returns {boolean} 是否成功启用
+     */
+    enableLimiter(options = {}) {
+        if (!this._processor) {
+            throw new Error('AudioProcessor not initialized');
+        }
+        return this._processor.enableLimiter(options);
+    }
+    
+    /**
+     * 禁用真峰值限幅器 (v2.12.0)
+     * @returns {boolean} 是否成功禁用
+     */
+    disableLimiter() {
+        if (!this._processor) {
+            return false;
+        }
+        return this._processor.disableLimiter();
+    }
+    
+    /**
+     * 获取限幅器统计 (v2.12.0)
+     * @returns {Object|null} 增益衰减、真峰值等，从未启用时为 null
+     */
+    getLimiterStats() {
+        if (!this._processor) {
+            return null;
+        }
+        return this._processor.getLimiterStats();
+    }
+    
     /**
      * 暂停音频捕获（暂不触发 data 事件）
+     * v2.12: 原生层同时跳过降噪/AGC/EQ/FFT、缓冲池和 TSFN 投递
+     * @param {Object} [options]
+     * @param {boolean} [options.stopStream=false] - 同时停止 WASAPI 音频流（IAudioClient::Stop）
      */
-    pause() {
+    pause(options = {}) {
         if (!this._isRunning) {
             throw new Error('AudioCapture is not running');
         }
+        if (this._processor && typeof this._processor.pause === 'function') {
+            this._processor.pause({ stopStream: Boolean(options.stopStream) });
+        }
         this._isPaused = true;
         this.emit('paused');
     }
@@ -231,6 +418,9 @@ class AudioCapture extends EventEmitter {
         if (!this._isRunning) {
             throw new Error('AudioCapture is not running');
         }
+        if (this._processor && typeof this._processor.resume === 'function') {
+            this._processor.resume();
+        }
         this._isPaused = false;
         this.emit('resumed');
     }
@@ -284,22 +474,68 @@ class AudioCapture extends EventEmitter {
             return;
         }
         
-        // 普通音频数据处理
-        const buffer = eventTypeOrBuffer;
+        // v2.12: 对数 Mel 特征事件（原生处理线程计算）
+        if (typeof eventTypeOrBuffer === 'string' && eventTypeOrBuffer === 'features') {
+            /**
+             * 对数 Mel 特征事件 (v2.12.0)
+             * @event AudioCapture#features
+             * @type {Object}
+             * @property {Float32Array} features - frameCount × melBins 个特征值（按帧排列）
+             * @property {number} frameCount - 帧数
+             * @property {number} melBins - 每帧 Mel 滤波器数量
+             * @property {number} position - 最后一帧结束处的流位置（单声道采样数）
+             * @property {number} timestamp - 时间戳（毫秒）
+             */
+            this.emit('features', data);
+            return;
+        }
         
-        if (this._isPaused) {
+        // v2.12: 原生 VAD 门限的语音段边界
+        if (eventTypeOrBuffer === 'speechStart' || eventTypeOrBuffer === 'speechEnd') {
+            /**
+             * 语音段开始 / 结束事件 (v2.12.0)
+             * @event AudioCapture#speechStart
+             * @event AudioCapture#speechEnd
+             * @type {Object}
+             * @property {number} position - 捕获流位置（帧）：开始 = 第一个投递的帧（含预录），结束 = 最后一帧之后
+             * @property {number} positionMs - position 对应的毫秒数
+             * @property {number} [onset] - 仅 speechStart：触发开门的语音起点（帧）
+             * @property {number} [onsetMs] - 仅 speechStart：onset 对应的毫秒数
+             * @property {number} probability - 判定帧的语音概率
+             * @property {number} sampleRate - 捕获采样率
+             * @property {number} timestamp - 时间戳（毫秒）
+             */
+            this.emit(eventTypeOrBuffer, data);
             return;
         }
         
-        // v2.10.0: 收集统计数据
-        if (this._statsEnabled) {
-            this._statsBuffer.push(buffer);
-            
-            const now = Date.now();
-            if (now - this._lastStatsTime >= this._statsInterval) {
-                this._calculateAndEmitStats();
-                this._lastStatsTime = now;
+        // v2.12: 统计事件由原生处理线程按间隔发出
+        if (typeof eventTypeOrBuffer === 'string' && eventTypeOrBuffer === 'stats') {
+            /**
+             * 音频统计事件
+             * @event AudioCapture#stats
+             * @type {Object}
+             * @property {number} peak - 峰值 (0.0 - 1.0)
+             * @property {number} rms - 均方根 (0.0 - 1.0)
+             * @property {number} db - 分贝值 (-∞ to 0 dB)
+             * @property {number} volumePercent - 音量百分比 (0 - 100)
+             * @property {boolean} isSilence - 是否静音 (RMS < silenceThreshold)
+             * @property {number} silenceDuration - 当前连续静音时长（毫秒，v2.12）
+             * @property {number} sampleCount - 本统计间隔的采样数（所有声道，v2.12；
+             *           上一个事件因 JS 阻塞未能投递时，本事件合并覆盖两个间隔）
+             * @property {number} timestamp - Unix 时间戳（毫秒）
+             */
+            if (this._statsEnabled) {
+                this.emit('stats', data);
             }
+            return;
+        }
+        
+        // 普通音频数据处理
+        const buffer = eventTypeOrBuffer;
+        
+        if (this._isPaused) {
+            return;
         }
         
         /**
@@ -317,57 +553,27 @@ class AudioCapture extends EventEmitter {
         });
     }
     
-    /**
-     * v2.10.0: 计算并发射音频统计数据
-     * @private
-     */
-    _calculateAndEmitStats() {
-        if (this._statsBuffer.length === 0) {
-            return;
-        }
-        
-        try {
-            // 合并所有缓冲的数据
-            const totalBuffer = Buffer.concat(this._statsBuffer);
-            this._statsBuffer = [];
-            
-            // 调用 C++ 层计算统计
-            const stats = this._processor.calculateAudioStats(totalBuffer);
-            
-            /**
-             * 音频统计事件
-             * @event AudioCapture#stats
-             * @type {Object}
-             * @property {number} peak - 峰值 (0.0 - 1.0)
-             * @property {number} rms - 均方根 (0.0 - 1.0)
-             * @property {number} db - 分贝值 (-∞ to 0 dB)
-             * @property {number} volumePercent - 音量百分比 (0 - 100)
-             * @property {boolean} isSilence - 是否静音 (RMS < 0.001)
-             * @property {number} timestamp - Unix 时间戳（毫秒）
-             */
-            this.emit('stats', stats);
-        } catch (error) {
-            this.emit('error', new Error(`Failed to calculate audio stats: ${error.message}`));
-        }
-    }
-    
     /**
      * v2.10.0: 启用音频统计
      * Phase 2: Added silenceThreshold configuration
+     * v2.12: 统计在原生处理线程上增量计算（不再在 JS 中缓存并合并 Buffer），
+     *        间隔按音频采样数计算，'stats' 事件由原生层发出
      * @param {Object} options - 统计选项
      * @param {number} [options.interval=500] - 统计间隔（毫秒）
      * @param {number} [options.silenceThreshold=0.001] - 静音检测阈值（RMS，默认 0.001）
      */
     enableStats(options = {}) {
-        this._statsEnabled = true;
         this._statsInterval = options.interval || 500;
-        this._statsBuffer = [];
-        this._lastStatsTime = Date.now();
         
         // Phase 2: 设置静音阈值
         if (options.silenceThreshold !== undefined) {
             this.setSilenceThreshold(options.silenceThreshold);
         }
+        
+        if (this._processor) {
+            this._processor.enableStats({ interval: this._statsInterval });
+        }
+        this._statsEnabled = true;
     }
     
     /**
@@ -399,7 +605,9 @@ class AudioCapture extends EventEmitter {
      */
     disableStats() {
         this._statsEnabled = false;
-        this._statsBuffer = [];
+        if (this._processor) {
+            this._processor.disableStats();
+        }
     }
     
     /**
@@ -501,6 +709,7 @@ class AudioCapture extends EventEmitter {
      * - dynamicAllocations: 动态分配的总次数
      * - currentPoolSize: 当前缓冲池中缓冲区数量
      * - maxPoolSize: 缓冲池最大容量
+     * - bufferSize: 缓冲池默认缓冲区大小（v2.12: 按协商后的数据包大小设置）
      * - hitRate: 缓冲池命中率百分比（0-100）
      */
     getPoolStats() {
@@ -515,18 +724,73 @@ class AudioCapture extends EventEmitter {
         }
     }
 
+    /**
+     * v2.12: 获取捕获管线统计信息
+     * @returns {Object} 管线统计信息
+     * 
+     * 返回对象包含以下属性：
+     * - processingThread: 处理线程是否在运行
+     * - queueCapacity: 捕获线程 → 处理线程环形缓冲区槽位数
+     * - queueDepth: 当前排队的槽位数
+     * - queueHighWater: 观测到的最大排队深度
+     * - packetsSubmitted: 捕获线程成功入队的数据包数
+     * - packetsProcessed: 处理线程已处理完的数据包数（与 packetsSubmitted 同单位）
+     * - overruns: 环形缓冲区满而丢弃的数据包数
+     * - deliveryPolicy: JS 投递队列溢出策略
+     * - deliveryQueueSize: JS 投递队列上限（0 = 无上限）
+     * - deliveryQueueDepth: 当前等待 JS 处理的数据包数
+     * - deliveryQueueHighWater: 观测到的最大等待数据包数
+     * - packetsDelivered: 已交给 JS 的数据包数
+     * - packetsDropped: 因 JS 阻塞被策略丢弃的数据包数
+     * - packetsCoalesced: 被合并到已排队数据包中的数据包数
+     * - eventsDropped: 因 TSFN 队列满而丢弃的频谱等事件数
+     * - paused: 原生层是否处于暂停状态
+     * - streamPaused: WASAPI 音频流是否被 pause({ stopStream: true }) 停止
+     * - packetsSkipped: 暂停期间丢弃的数据包数
+     */
+    getPipelineStats() {
+        if (!this._processor) {
+            throw new Error('AudioProcessor not initialized');
+        }
+        
+        try {
+            return this._processor.getPipelineStats();
+        } catch (error) {
+            throw new Error(`Failed to get pipeline statistics: ${error.message}`);
+        }
+    }
+    
+    /**
+     * v2.12: 获取 'data' 事件缓冲区的音频格式（原生输出阶段之后）
+     * @returns {Object} { sampleRate, channels, bitsPerSample, isFloat, format, captureSampleRate, captureChannels, resampling, resampleQuality, dither, preset, frameMs, frameBytes }
+     * @throws {Error} 如果 AudioProcessor 未初始化
+     */
+    getOutputFormat() {
+        if (!this._processor) {
+            throw new Error('AudioProcessor not initialized');
+        }
+        return this._processor.getOutputFormat();
+    }
+
     /**
      * v2.7: 启用/禁用 RNNoise 降噪
      * @param {boolean} enabled - true 启用, false 禁用
+     * @param {Object} [options] - v2.12: 降噪选项
+     * @param {string} [options.mode='per-channel'] - 'per-channel'（每声道独立降噪）或 'downmix'（混为单声道降噪后复制到各声道）
+     * @param {boolean} [options.sharedPool=false] - RNNoise 帧在进程共享的降噪线程池上处理（多路捕获共用一个队列）
      * @throws {Error} 如果 AudioProcessor 未初始化或操作失败
      */
-    setDenoiseEnabled(enabled) {
+    setDenoiseEnabled(enabled, options) {
         if (!this._processor) {
             throw new Error('AudioProcessor not initialized');
         }
         
         try {
-            this._processor.setDenoiseEnabled(Boolean(enabled));
+            if (options !== undefined) {
+                this._processor.setDenoiseEnabled(Boolean(enabled), options);
+            } else {
+                this._processor.setDenoiseEnabled(Boolean(enabled));
+            }
         } catch (error) {
             throw new Error(`Failed to set denoise: ${error.message}`);
         }
@@ -539,6 +803,9 @@ class AudioCapture extends EventEmitter {
      * 返回对象包含以下属性：
      * - framesProcessed: 已处理的音频帧数
      * - vadProbability: 语音活动检测概率 (0.0-1.0)
+     * - mode / channels / sampleRate: v2.12 降噪声道模式与捕获格式
+     * - latencyFrames / latencyMs: v2.12 降噪引入的固定延迟
+     * - sharedPool / engine: v2.12 共享线程池及其进程级计数
      */
     getDenoiseStats() {
         if (!this._processor) {
@@ -12,6 +12,12 @@
  * - OpenAI Whisper
  * - Global ASR services (Azure, Google, AWS)
  * 
+ * v2.12: For live capture, pass the same preset name to AudioCapture
+ * ({ preset: 'china-asr' }). The native pipeline converts, resamples and
+ * delivers fixed-size frames without allocating a Buffer per stage; this
+ * module remains for WAV encoding and for buffers that did not come from
+ * the capture pipeline.
+ * 
  * @module lib/audio-processing-pipeline
  */
 
@@ -1,8 +1,190 @@
 #include "agc_processor.h"
+#include "audio_level_kernels.h"
 #include <cstring>
 
+#if defined(AUDIO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace wasapi_capture {
 
+bool ParseAGCMode(const std::string& name, SimpleAGC::Mode& mode) {
+    if (name == "block") {
+        mode = SimpleAGC::Mode::Block;
+    } else if (name == "lookahead") {
+        mode = SimpleAGC::Mode::LookAhead;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* AGCModeName(SimpleAGC::Mode mode) {
+    return mode == SimpleAGC::Mode::LookAhead ? "lookahead" : "block";
+}
+
+namespace agc_kernels {
+
+// ========== Scalar (reference) ==========
+
+void ApplyGainRampScalar(float* samples, size_t frames, size_t channels, float start, float step, size_t first) {
+    for (size_t f = 0; f < frames; f++) {
+        const float gain = start + step * static_cast<float>(first + f);
+        float* frame = samples + f * channels;
+        for (size_t c = 0; c < channels; c++) {
+            frame[c] *= gain;
+        }
+    }
+}
+
+#if defined(AUDIO_SIMD_X86)
+
+// ========== SSE2 ==========
+
+void ApplyGainRampSse2(float* samples, size_t frames, size_t channels, float start, float step, size_t first) {
+    const __m128 vstart = _mm_set1_ps(start);
+    const __m128 vstep = _mm_set1_ps(step);
+    size_t f = 0;
+    if (channels == 1) {
+        const __m128 offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        for (; f + 4 <= frames; f += 4) {
+            __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(first + f)), offsets);
+            __m128 gain = _mm_add_ps(vstart, _mm_mul_ps(vstep, index));
+            _mm_storeu_ps(samples + f, _mm_mul_ps(_mm_loadu_ps(samples + f), gain));
+        }
+    } else if (channels == 2) {
+        const __m128 offsets = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);  // L0 R0 L1 R1
+        for (; f + 2 <= frames; f += 2) {
+            __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(first + f)), offsets);
+            __m128 gain = _mm_add_ps(vstart, _mm_mul_ps(vstep, index));
+            _mm_storeu_ps(samples + 2 * f, _mm_mul_ps(_mm_loadu_ps(samples + 2 * f), gain));
+        }
+    } else {
+        // One gain per frame, broadcast across the channels
+        for (; f < frames; f++) {
+            const float g = start + step * static_cast<float>(first + f);
+            const __m128 gain = _mm_set1_ps(g);
+            float* frame = samples + f * channels;
+            size_t c = 0;
+            for (; c + 4 <= channels; c += 4) {
+                _mm_storeu_ps(frame + c, _mm_mul_ps(_mm_loadu_ps(frame + c), gain));
+            }
+            for (; c < channels; c++) {
+                frame[c] *= g;
+            }
+        }
+    }
+    ApplyGainRampScalar(samples + f * channels, frames - f, channels, start, step, first + f);
+}
+
+// ========== AVX2 ==========
+
+AUDIO_TARGET_AVX2
+void ApplyGainRampAvx2(float* samples, size_t frames, size_t channels, float start, float step, size_t first) {
+    if (channels > 2) {
+        ApplyGainRampSse2(samples, frames, channels, start, step, first);
+        return;
+    }
+    const __m256 vstart = _mm256_set1_ps(start);
+    const __m256 vstep = _mm256_set1_ps(step);
+    const __m256 offsets = channels == 1
+        ? _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f)
+        : _mm256_setr_ps(0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f);
+    const size_t framesPerVector = 8 / channels;
+    size_t f = 0;
+    for (; f + framesPerVector <= frames; f += framesPerVector) {
+        float* p = samples + f * channels;
+        __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(first + f)), offsets);
+        __m256 gain = _mm256_add_ps(vstart, _mm256_mul_ps(vstep, index));
+        _mm256_storeu_ps(p, _mm256_mul_ps(_mm256_loadu_ps(p), gain));
+    }
+    ApplyGainRampSse2(samples + f * channels, frames - f, channels, start, step, first + f);
+}
+
+#endif  // AUDIO_SIMD_X86
+
+#if defined(AUDIO_SIMD_NEON)
+
+// ========== NEON ==========
+
+void ApplyGainRampNeon(float* samples, size_t frames, size_t channels, float start, float step, size_t first) {
+    const float32x4_t vstart = vdupq_n_f32(start);
+    size_t f = 0;
+    if (channels <= 2) {
+        static const float kMono[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+        static const float kStereo[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+        const float32x4_t offsets = vld1q_f32(channels == 1 ? kMono : kStereo);
+        const size_t framesPerVector = 4 / channels;
+        for (; f + framesPerVector <= frames; f += framesPerVector) {
+            float* p = samples + f * channels;
+            float32x4_t index = vaddq_f32(vdupq_n_f32(static_cast<float>(first + f)), offsets);
+            float32x4_t gain = vaddq_f32(vstart, vmulq_n_f32(index, step));
+            vst1q_f32(p, vmulq_f32(vld1q_f32(p), gain));
+        }
+    } else {
+        for (; f < frames; f++) {
+            const float g = start + step * static_cast<float>(first + f);
+            float* frame = samples + f * channels;
+            size_t c = 0;
+            for (; c + 4 <= channels; c += 4) {
+                vst1q_f32(frame + c, vmulq_n_f32(vld1q_f32(frame + c), g));
+            }
+            for (; c < channels; c++) {
+                frame[c] *= g;
+            }
+        }
+    }
+    ApplyGainRampScalar(samples + f * channels, frames - f, channels, start, step, first + f);
+}
+
+#endif  // AUDIO_SIMD_NEON
+
+}  // namespace agc_kernels
+
+// ========== Dispatch ==========
+
+namespace {
+
+struct AGCKernelTable {
+    SimdLevel level;
+    void (*gainRamp)(float*, size_t, size_t, float, float, size_t);
+};
+
+AGCKernelTable SelectKernels() {
+    using namespace agc_kernels;
+    switch (GetBestSimdLevel()) {
+#if defined(AUDIO_SIMD_X86)
+        case SimdLevel::AVX2:
+            return {SimdLevel::AVX2, &ApplyGainRampAvx2};
+        case SimdLevel::SSE2:
+            return {SimdLevel::SSE2, &ApplyGainRampSse2};
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        case SimdLevel::NEON:
+            return {SimdLevel::NEON, &ApplyGainRampNeon};
+#endif
+        default:
+            return {SimdLevel::Scalar, &ApplyGainRampScalar};
+    }
+}
+
+const AGCKernelTable& Kernels() {
+    static const AGCKernelTable table = SelectKernels();
+    return table;
+}
+
+}  // namespace
+
+SimdLevel GetAGCKernel() {
+    return Kernels().level;
+}
+
+// ========== SimpleAGC ==========
+
 SimpleAGC::SimpleAGC()
     : enabled_(false),
       sample_rate_(48000),
@@ -22,21 +204,51 @@ SimpleAGC::~SimpleAGC() {
 void SimpleAGC::Initialize(int sample_rate) {
     sample_rate_ = sample_rate;
     
-    // Compute smoothing coefficients based on attack/release times
-    // Coefficient formula: 1 - exp(-1 / (time_ms * sample_rate / 1000))
-    float attack_samples = options_.attack_time_ms * sample_rate_ / 1000.0f;
-    float release_samples = options_.release_time_ms * sample_rate_ / 1000.0f;
-    
-    attack_coeff_ = 1.0f - std::exp(-1.0f / attack_samples);
-    release_coeff_ = 1.0f - std::exp(-1.0f / release_samples);
-    
+    // Smoothing coefficients are computed from sample_rate_ by ApplyPending()
     Reset();
 }
 
 void SimpleAGC::SetOptions(const Options& options) {
-    options_ = options;
-    
-    // Recompute smoothing coefficients
+    // v2.12: Staged; the processing thread copies them (and recomputes the
+    // coefficients / resizes the look-ahead state) on its next packet
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_options_ = options;
+    }
+    reconfigure_.store(true, std::memory_order_release);
+}
+
+SimpleAGC::Options SimpleAGC::GetOptions() const {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    return pending_options_;
+}
+
+void SimpleAGC::SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        // Reset gain when disabling (v2.12: applied by the processing thread,
+        // which also restarts with an empty delay line)
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_gain_reset_ = true;
+        }
+        reconfigure_.store(true, std::memory_order_release);
+    }
+}
+
+void SimpleAGC::ApplyPending() {
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        options_ = pending_options_;
+        if (pending_gain_reset_) {
+            pending_gain_reset_ = false;
+            current_gain_db_ = 0.0f;
+            current_gain_linear_ = 1.0f;
+        }
+    }
+
+    // Compute smoothing coefficients based on attack/release times
+    // Coefficient formula: 1 - exp(-1 / (time_ms * sample_rate / 1000))
     if (sample_rate_ > 0) {
         float attack_samples = options_.attack_time_ms * sample_rate_ / 1000.0f;
         float release_samples = options_.release_time_ms * sample_rate_ / 1000.0f;
@@ -46,17 +258,21 @@ void SimpleAGC::SetOptions(const Options& options) {
     }
 }
 
-void SimpleAGC::SetEnabled(bool enabled) {
-    enabled_ = enabled;
-    if (!enabled_) {
-        // Reset gain when disabling
-        current_gain_db_ = 0.0f;
-        current_gain_linear_ = 1.0f;
+void SimpleAGC::Process(float* samples, int frame_count, int channels) {
+    if (!enabled_.load(std::memory_order_relaxed) || frame_count <= 0 || channels <= 0) {
+        return;
     }
-}
 
-void SimpleAGC::Process(float* samples, int frame_count, int channels) {
-    if (!enabled_ || frame_count <= 0 || channels <= 0) {
+    // v2.12: Pick up options / gain reset staged by SetOptions / SetEnabled
+    const bool reconfigured = reconfigure_.exchange(false, std::memory_order_acquire);
+    if (reconfigured) {
+        ApplyPending();
+    }
+
+    // v2.12: Hop-based envelope, delayed output, per-sample gain ramp
+    if (options_.mode == Mode::LookAhead) {
+        ProcessLookAhead(samples, static_cast<size_t>(frame_count), static_cast<size_t>(channels), reconfigured);
+        PublishStats();
         return;
     }
 
@@ -89,16 +305,29 @@ void SimpleAGC::Process(float* samples, int frame_count, int channels) {
 
     // Step 8: Update statistics
     frames_processed_ += frame_count;
+    PublishStats();
+}
+
+void SimpleAGC::PublishStats() {
+    published_gain_db_.store(current_gain_db_, std::memory_order_relaxed);
+    published_average_db_.store(average_rms_db_, std::memory_order_relaxed);
+    published_rms_.store(recent_rms_, std::memory_order_relaxed);
+    published_clipping_.store(clipping_detected_, std::memory_order_relaxed);
+    published_frames_.store(frames_processed_, std::memory_order_relaxed);
 }
 
 SimpleAGC::Stats SimpleAGC::GetStats() const {
     Stats stats;
-    stats.enabled = enabled_;
-    stats.current_gain_db = current_gain_db_;
-    stats.average_level_db = average_rms_db_;
-    stats.rms_linear = recent_rms_;
-    stats.clipping = clipping_detected_;
-    stats.frames_processed = frames_processed_;
+    stats.enabled = enabled_.load(std::memory_order_relaxed);
+    stats.current_gain_db = published_gain_db_.load(std::memory_order_relaxed);
+    stats.average_level_db = published_average_db_.load(std::memory_order_relaxed);
+    stats.rms_linear = published_rms_.load(std::memory_order_relaxed);
+    stats.clipping = published_clipping_.load(std::memory_order_relaxed);
+    stats.frames_processed = published_frames_.load(std::memory_order_relaxed);
+    // v2.12: Mode and latency as configured (the processing thread applies them on its next packet)
+    Options options = GetOptions();
+    stats.mode = options.mode;
+    stats.latency_frames = static_cast<uint32_t>(options.mode == Mode::LookAhead ? LookaheadFrames(options) : 0);
     return stats;
 }
 
@@ -109,6 +338,9 @@ void SimpleAGC::Reset() {
     clipping_detected_ = false;
     frames_processed_ = 0;
     recent_rms_ = 0.0f;
+    envelope_ = 0.0f;
+    PublishStats();
+    reconfigure_.store(true, std::memory_order_release);
 }
 
 float SimpleAGC::ComputeRMS(const float* samples, int count) {
@@ -173,6 +405,97 @@ float SimpleAGC::ApplyGainSmoothing(float target_gain_db) {
     return current_gain_linear_;
 }
 
+// ========== v2.12: Look-ahead mode ==========
+
+size_t SimpleAGC::LookaheadFrames(const Options& options) const {
+    float ms = std::max(0.0f, std::min(options.lookahead_ms, kMaxLookaheadMs));
+    return static_cast<size_t>(std::lround(ms * sample_rate_ / 1000.0f));
+}
+
+void SimpleAGC::PrepareLookAhead(size_t channels) {
+    channels_ = channels;
+    hop_frames_ = std::max<size_t>(1, static_cast<size_t>(std::lround(kHopMs * sample_rate_ / 1000.0f)));
+    hop_fill_ = 0;
+    hop_energy_ = 0.0;
+
+    // Runs once per configuration, never per packet
+    delay_frames_ = LookaheadFrames(options_);
+    delay_.assign(delay_frames_ * channels, 0.0f);
+    delay_pos_ = 0;
+
+    // Time constants expressed in hops
+    auto per_hop = [this](float ms) {
+        float hops = ms * sample_rate_ / 1000.0f / static_cast<float>(hop_frames_);
+        return hops > 0.0f ? 1.0f - std::exp(-1.0f / hops) : 1.0f;
+    };
+    detector_coeff_ = per_hop(kDetectorMs);
+    average_coeff_ = per_hop(kAverageMs);
+    hop_attack_coeff_ = per_hop(options_.attack_time_ms);
+    hop_release_coeff_ = per_hop(options_.release_time_ms);
+
+    ramp_start_ = current_gain_linear_;
+    ramp_step_ = 0.0f;
+}
+
+void SimpleAGC::ProcessLookAhead(float* samples, size_t frames, size_t channels, bool reconfigured) {
+    if (reconfigured || channels != channels_) {
+        PrepareLookAhead(channels);
+    }
+
+    size_t offset = 0;
+    while (offset < frames) {
+        // Chunks never cross a hop boundary or the end of the delay line
+        size_t n = std::min(frames - offset, hop_frames_ - hop_fill_);
+        if (delay_frames_ > 0) {
+            n = std::min(n, delay_frames_ - delay_pos_);
+        }
+        float* block = samples + offset * channels;
+        const size_t count = n * channels;
+
+        // The detector sees the input lookahead_ms before it leaves the delay line
+        hop_energy_ += MeasureLevels(block, count).sumSquares;
+
+        if (delay_frames_ > 0) {
+            std::swap_ranges(block, block + count, delay_.data() + delay_pos_ * channels);
+            delay_pos_ = (delay_pos_ + n) % delay_frames_;
+        }
+
+        // Frame k of the hop gets ramp_start_ + ramp_step_ * (k + 1)
+        Kernels().gainRamp(block, n, channels, ramp_start_, ramp_step_, hop_fill_ + 1);
+
+        hop_fill_ += n;
+        offset += n;
+        if (hop_fill_ == hop_frames_) {
+            EndHop();
+        }
+    }
+
+    clipping_detected_ = MeasureLevels(samples, frames * channels).peak >= kClipThreshold;
+    frames_processed_ += frames;
+}
+
+void SimpleAGC::EndHop() {
+    float power = static_cast<float>(hop_energy_ / static_cast<double>(hop_frames_ * channels_));
+    if (!std::isfinite(power)) {
+        power = 0.0f;  // A NaN/Inf sample must not stick in the envelope
+    }
+    hop_fill_ = 0;
+    hop_energy_ = 0.0;
+
+    envelope_ += (power - envelope_) * detector_coeff_;
+    recent_rms_ = std::sqrt(envelope_);
+    const float level_db = LinearToDb(recent_rms_);
+    average_rms_db_ += (level_db - average_rms_db_) * average_coeff_;
+
+    float diff = ComputeTargetGain(level_db) - current_gain_db_;
+    current_gain_db_ += diff * (diff > 0.0f ? hop_attack_coeff_ : hop_release_coeff_);
+
+    // Next hop ramps linearly from the gain reached to the new one
+    ramp_start_ = current_gain_linear_;
+    current_gain_linear_ = DbToLinear(current_gain_db_);
+    ramp_step_ = (current_gain_linear_ - ramp_start_) / static_cast<float>(hop_frames_);
+}
+
 bool SimpleAGC::DetectClipping(const float* samples, int count) {
     for (int i = 0; i < count; ++i) {
         if (std::abs(samples[i]) >= kClipThreshold) {
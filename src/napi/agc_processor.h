@@ -3,6 +3,14 @@
 
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cpu_features.h"
 
 namespace wasapi_capture {
 
@@ -18,24 +26,44 @@ namespace wasapi_capture {
  * 3. Apply gain smoothing with attack/release times
  * 4. Clamp gain within min/max limits
  * 5. Apply gain to samples
+ *
+ * v2.12: Two modes.
+ * - Block (default, v2.8 behaviour): one RMS and one gain per packet.
+ * - LookAhead: the level is measured every 1 ms hop regardless of the
+ *   WASAPI packet size, and the output is delayed by lookahead_ms so gain
+ *   changes start before the signal that caused them. The gain moves
+ *   linearly, sample by sample, from one hop's value to the next (SIMD
+ *   multiply-by-ramp), so there are no steps at packet boundaries. One
+ *   log10 and one pow per hop, none per sample.
  */
 class SimpleAGC {
 public:
+    enum class Mode {
+        Block,
+        LookAhead
+    };
+
     struct Options {
         float target_level_db;  // Target output level in dBFS (e.g., -20.0)
         float max_gain_db;      // Maximum allowed gain in dB (e.g., 20.0)
         float min_gain_db;      // Minimum allowed gain in dB (e.g., -10.0)
         float attack_time_ms;   // Attack time in milliseconds (e.g., 10.0)
         float release_time_ms;  // Release time in milliseconds (e.g., 100.0)
+        Mode mode;              // v2.12: Gain computation mode
+        float lookahead_ms;     // v2.12: Output delay in LookAhead mode (0 - kMaxLookaheadMs)
 
         Options()
             : target_level_db(-20.0f),
               max_gain_db(20.0f),
               min_gain_db(-10.0f),
               attack_time_ms(10.0f),
-              release_time_ms(100.0f) {}
+              release_time_ms(100.0f),
+              mode(Mode::Block),
+              lookahead_ms(5.0f) {}
     };
 
+    static constexpr float kMaxLookaheadMs = 50.0f;
+
     struct Stats {
         bool enabled;
         float current_gain_db;   // Current gain being applied
@@ -43,6 +71,8 @@ public:
         float rms_linear;        // Current RMS value (linear scale)
         bool clipping;           // Whether clipping is detected
         uint64_t frames_processed;
+        Mode mode;               // v2.12
+        uint32_t latency_frames; // v2.12: Look-ahead delay (0 in Block mode)
     };
 
     SimpleAGC();
@@ -57,24 +87,28 @@ public:
     /**
      * @brief Set AGC options
      * @param options AGC configuration parameters
+     * @note v2.12: Safe while another thread runs Process(); the options are
+     *       staged and take effect at the start of the next Process() call
      */
     void SetOptions(const Options& options);
 
     /**
-     * @brief Get current AGC options
+     * @brief Get current AGC options (the most recently set, staged or applied)
      */
-    const Options& GetOptions() const { return options_; }
+    Options GetOptions() const;
 
     /**
      * @brief Enable or disable AGC processing
      * @param enabled True to enable, false to disable
+     * @note v2.12: Thread-safe; the gain reset on disable is applied by the
+     *       next Process() call
      */
     void SetEnabled(bool enabled);
 
     /**
      * @brief Check if AGC is enabled
      */
-    bool IsEnabled() const { return enabled_; }
+    bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
 
     /**
      * @brief Process audio samples with AGC
@@ -86,11 +120,14 @@ public:
 
     /**
      * @brief Get current AGC statistics
+     * @note v2.12: Thread-safe; gain and level fields are the values published
+     *       at the end of the last Process() call
      */
     Stats GetStats() const;
 
     /**
      * @brief Reset AGC state
+     * @note Not concurrent with Process() (same for Initialize())
      */
     void Reset();
 
@@ -135,9 +172,29 @@ private:
      */
     bool DetectClipping(const float* samples, int count);
 
+    // v2.12: Copy staged options / gain reset into the processing state
+    void ApplyPending();
+
+    // v2.12: Copy the statistics fields for GetStats() on other threads
+    void PublishStats();
+
+    // v2.12: Look-ahead mode
+    void ProcessLookAhead(float* samples, size_t frames, size_t channels, bool reconfigured);
+    void PrepareLookAhead(size_t channels);
+    void EndHop();
+    size_t LookaheadFrames(const Options& options) const;
+
 private:
-    bool enabled_;
-    Options options_;
+    std::atomic<bool> enabled_{false};
+
+    // v2.12: Written by SetOptions / SetEnabled (any thread) under pending_mutex_,
+    // copied by the processing thread when reconfigure_ is set
+    mutable std::mutex pending_mutex_;
+    Options pending_options_;
+    bool pending_gain_reset_ = false;
+    std::atomic<bool> reconfigure_{true};
+
+    Options options_;            // Applied copy (processing thread)
     int sample_rate_;
 
     // State variables
@@ -154,11 +211,61 @@ private:
     uint64_t frames_processed_;
     float recent_rms_;
 
+    // v2.12: Published copies (written by the processing thread, read by GetStats())
+    std::atomic<float> published_gain_db_{0.0f};
+    std::atomic<float> published_average_db_{-60.0f};
+    std::atomic<float> published_rms_{0.0f};
+    std::atomic<bool> published_clipping_{false};
+    std::atomic<uint64_t> published_frames_{0};
+
+    // v2.12: Look-ahead state (touched by the processing thread only;
+    // option changes are picked up through reconfigure_)
+    size_t channels_ = 0;
+    size_t hop_frames_ = 48;
+    size_t hop_fill_ = 0;
+    double hop_energy_ = 0.0;        // Sum of squares of the current hop (undelayed input)
+    float envelope_ = 0.0f;          // Smoothed mean square
+    float detector_coeff_ = 0.0f;    // Per hop
+    float average_coeff_ = 0.0f;     // Per hop
+    float hop_attack_coeff_ = 0.0f;  // Per hop
+    float hop_release_coeff_ = 0.0f; // Per hop
+    float ramp_start_ = 1.0f;        // Linear gain at the start of the current hop
+    float ramp_step_ = 0.0f;         // Per frame
+    std::vector<float> delay_;       // Interleaved delay line, delay_frames_ frames
+    size_t delay_frames_ = 0;
+    size_t delay_pos_ = 0;
+
     // Constants
     static constexpr float kEpsilon = 1e-10f;  // Small value to avoid log(0)
     static constexpr float kClipThreshold = 0.99f;  // Clipping threshold
+    static constexpr float kHopMs = 1.0f;           // v2.12: Look-ahead level hop
+    static constexpr float kDetectorMs = 10.0f;     // v2.12: Look-ahead level integration time
+    static constexpr float kAverageMs = 100.0f;     // v2.12: average_level_db time constant
 };
 
+bool ParseAGCMode(const std::string& name, SimpleAGC::Mode& mode);
+const char* AGCModeName(SimpleAGC::Mode mode);
+
+namespace agc_kernels {
+
+// Individual variants (for tests and benchmarks; callers must check the CPU)
+// Multiplies frame f of interleaved samples by start + step * (first + f)
+void ApplyGainRampScalar(float* samples, size_t frames, size_t channels, float start, float step, size_t first);
+
+#if defined(AUDIO_SIMD_X86)
+void ApplyGainRampSse2(float* samples, size_t frames, size_t channels, float start, float step, size_t first);
+void ApplyGainRampAvx2(float* samples, size_t frames, size_t channels, float start, float step, size_t first);
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+void ApplyGainRampNeon(float* samples, size_t frames, size_t channels, float start, float step, size_t first);
+#endif
+
+}  // namespace agc_kernels
+
+// v2.12: Variant used by the look-ahead gain ramp
+SimdLevel GetAGCKernel();
+
 } // namespace wasapi_capture
 
 #endif // AGC_PROCESSOR_H
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025 node-windows-audio-capture contributors
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace audio_capture {
+
+/**
+ * v2.12: Cache-line aligned allocator for DSP working buffers
+ *
+ * Keeps planar FFT / filter buffers on 64-byte boundaries so SIMD loads
+ * never split a cache line at the start of a buffer.
+ */
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        size_t bytes = n * sizeof(T);
+#if defined(_MSC_VER)
+        void* p = _aligned_malloc(bytes, Alignment);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, Alignment, bytes) != 0) {
+            p = nullptr;
+        }
+#endif
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        free(p);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace audio_capture
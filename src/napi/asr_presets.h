@@ -0,0 +1,44 @@
+/**
+ * ASR Output Presets
+ *
+ * v2.12: Native equivalents of the presets in lib/audio-processing-pipeline.js.
+ * A preset only selects output stage settings (rate, channels, sample format,
+ * frame length); explicit AudioProcessor options override each field.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "format_converter.h"
+
+namespace wasapi_capture {
+
+struct AsrPreset {
+    const char* name;
+    uint32_t sample_rate;   // 0 = capture rate
+    uint16_t channels;      // 0 = capture channels
+    SampleFormat format;
+    uint32_t frame_ms;      // 0 = packet-sized delivery
+};
+
+inline const AsrPreset* FindAsrPreset(const std::string& name) {
+    static const AsrPreset kPresets[] = {
+        {"raw",            0,     0, SampleFormat::Float32, 0},
+        {"china-asr",      16000, 1, SampleFormat::Int16,   40},   // 1280-byte frames (Xunfei / Baidu / Aliyun)
+        {"openai-whisper", 16000, 1, SampleFormat::Int16,   100},
+        {"global-asr-48k", 48000, 1, SampleFormat::Int16,   20},
+        {"azure",          16000, 1, SampleFormat::Int16,   100},
+        {"google",         16000, 1, SampleFormat::Int16,   100},
+    };
+    for (const AsrPreset& preset : kPresets) {
+        if (name == preset.name) {
+            return &preset;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace wasapi_capture
@@ -4,11 +4,31 @@
 #include "audio_effects.h"
 #include <rnnoise.h>
 #include <cstring>
+#include <cmath>
+#include <cstdio>
 #include <algorithm>
 #include <stdexcept>
 
 namespace AudioCapture {
 
+namespace {
+
+// RNNoise input/output range (16-bit sample values)
+constexpr float kRnnoiseScale = 32768.0f;
+
+int16_t ToInt16(float sample) {
+    float scaled = sample * kRnnoiseScale;
+    if (scaled >= 32767.0f) {
+        return 32767;
+    }
+    if (scaled <= -32768.0f) {
+        return -32768;
+    }
+    return static_cast<int16_t>(std::lrint(scaled));
+}
+
+}  // namespace
+
 DenoiseProcessor::DenoiseProcessor(int frame_size)
     : state_(nullptr)
     , frame_size_(frame_size)
@@ -30,6 +50,7 @@ DenoiseProcessor::DenoiseProcessor(int frame_size)
     // Allocate buffers
     temp_buffer_.resize(frame_size);
     frame_buffer_.resize(frame_size);
+    output_buffer_.resize(frame_size);
 }
 
 DenoiseProcessor::~DenoiseProcessor() {
@@ -48,6 +69,7 @@ void DenoiseProcessor::Reset() {
     last_vad_prob_ = 0.0f;
     frame_buffer_pos_ = 0;
     std::fill(frame_buffer_.begin(), frame_buffer_.end(), 0.0f);
+    std::fill(output_buffer_.begin(), output_buffer_.end(), 0.0f);
 }
 
 float DenoiseProcessor::ProcessFrame(float* frame, int size) {
@@ -61,47 +83,57 @@ float DenoiseProcessor::ProcessFrame(float* frame, int size) {
         throw std::runtime_error("Denoise processor not initialized");
     }
     
+    // v2.12: RNNoise works on 16-bit sample values; at full scale 1.0 its
+    // feature energies sit ~90 dB low and everything is treated as noise
+    for (int i = 0; i < size; i++) {
+        frame[i] *= kRnnoiseScale;
+    }
+
     // Process frame with RNNoise
     // Note: rnnoise_process_frame() modifies the input buffer in-place
     // Returns Voice Activity Detection (VAD) probability
     last_vad_prob_ = rnnoise_process_frame(state_, frame, frame);
     processed_frames_++;
+
+    for (int i = 0; i < size; i++) {
+        frame[i] *= 1.0f / kRnnoiseScale;
+    }
     
     return last_vad_prob_;
 }
 
 void DenoiseProcessor::ProcessBuffer(float* buffer, int size) {
+    // v2.12: Each input sample goes into the frame being filled and is replaced
+    // by the denoised sample at the same position of the previous frame, so
+    // packets of any size stream through with exactly frame_size_ latency
     int offset = 0;
-    
-    // Process complete frames
-    while (offset + frame_size_ <= size) {
-        ProcessFrame(buffer + offset, frame_size_);
-        offset += frame_size_;
-    }
-    
-    // Handle remaining samples (if any)
-    int remaining = size - offset;
-    if (remaining > 0) {
-        // Buffer incomplete frame for next call
-        std::memcpy(frame_buffer_.data() + frame_buffer_pos_, 
-                    buffer + offset, 
-                    remaining * sizeof(float));
-        frame_buffer_pos_ += remaining;
-        
-        // If we have a complete frame, process it
-        if (frame_buffer_pos_ >= frame_size_) {
+    while (offset < size) {
+        offset += Feed(buffer + offset, size - offset);
+        if (FrameReady()) {
             ProcessFrame(frame_buffer_.data(), frame_size_);
-            
-            // Copy back to original buffer
-            std::memcpy(buffer + offset, 
-                        frame_buffer_.data(), 
-                        remaining * sizeof(float));
-            
-            frame_buffer_pos_ = 0;
+            CompleteFrame();
         }
     }
 }
 
+int DenoiseProcessor::Feed(float* buffer, int size) {
+    int n = (std::min)(size, frame_size_ - frame_buffer_pos_);
+    float* in = frame_buffer_.data() + frame_buffer_pos_;
+    const float* out = output_buffer_.data() + frame_buffer_pos_;
+    for (int i = 0; i < n; i++) {
+        float sample = buffer[i];
+        buffer[i] = out[i];
+        in[i] = sample;
+    }
+    frame_buffer_pos_ += n;
+    return n;
+}
+
+void DenoiseProcessor::CompleteFrame() {
+    frame_buffer_.swap(output_buffer_);  // No copy, no allocation
+    frame_buffer_pos_ = 0;
+}
+
 float DenoiseProcessor::ProcessFrame(int16_t* frame, int size) {
     if (size != frame_size_) {
         char msg[128];
@@ -111,7 +143,7 @@ float DenoiseProcessor::ProcessFrame(int16_t* frame, int size) {
     
     // Convert Int16 to Float32 (normalize to [-1, 1])
     for (int i = 0; i < size; i++) {
-        temp_buffer_[i] = static_cast<float>(frame[i]) / 32768.0f;
+        temp_buffer_[i] = static_cast<float>(frame[i]) / kRnnoiseScale;
     }
     
     // Process with RNNoise
@@ -119,58 +151,261 @@ float DenoiseProcessor::ProcessFrame(int16_t* frame, int size) {
     
     // Convert back to Int16
     for (int i = 0; i < size; i++) {
-        float sample = temp_buffer_[i] * 32768.0f;
-        
-        // Clamp to Int16 range
-        if (sample > 32767.0f) {
-            frame[i] = 32767;
-        } else if (sample < -32768.0f) {
-            frame[i] = -32768;
-        } else {
-            frame[i] = static_cast<int16_t>(sample);
-        }
+        frame[i] = ToInt16(temp_buffer_[i]);
     }
     
     return vad;
 }
 
 void DenoiseProcessor::ProcessBuffer(int16_t* buffer, int size) {
+    // v2.12: Same streaming path as Float32, converted one frame-sized chunk
+    // at a time through temp_buffer_
     int offset = 0;
-    
-    // Process complete frames
-    while (offset + frame_size_ <= size) {
-        ProcessFrame(buffer + offset, frame_size_);
-        offset += frame_size_;
+    while (offset < size) {
+        int n = (std::min)(size - offset, frame_size_);
+        for (int i = 0; i < n; i++) {
+            temp_buffer_[i] = static_cast<float>(buffer[offset + i]) / kRnnoiseScale;
+        }
+        ProcessBuffer(temp_buffer_.data(), n);
+        for (int i = 0; i < n; i++) {
+            buffer[offset + i] = ToInt16(temp_buffer_[i]);
+        }
+        offset += n;
     }
-    
-    // Handle remaining samples
-    int remaining = size - offset;
-    if (remaining > 0) {
-        // Convert remaining samples to Float32
-        for (int i = 0; i < remaining; i++) {
-            frame_buffer_[frame_buffer_pos_ + i] = static_cast<float>(buffer[offset + i]) / 32768.0f;
+}
+
+// ============================================================================
+// DenoiseStage
+// ============================================================================
+
+bool ParseDenoiseChannelMode(const std::string& name, DenoiseChannelMode& mode) {
+    if (name == "per-channel") {
+        mode = DenoiseChannelMode::PerChannel;
+    } else if (name == "downmix") {
+        mode = DenoiseChannelMode::Downmix;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* DenoiseChannelModeName(DenoiseChannelMode mode) {
+    return mode == DenoiseChannelMode::Downmix ? "downmix" : "per-channel";
+}
+
+DenoiseStage::DenoiseStage(uint32_t sampleRate, uint16_t channels, DenoiseChannelMode mode)
+    : sample_rate_(sampleRate)
+    , channels_(channels)
+    , mode_(mode)
+{
+    if (sampleRate == 0 || channels == 0 || channels > kMaxChannels) {
+        throw std::invalid_argument("Denoise supports 1-8 channels at a non-zero sample rate");
+    }
+    if (channels == 1) {
+        mode_ = DenoiseChannelMode::PerChannel;  // Same thing, without the mix copy
+    }
+
+    size_t states = mode_ == DenoiseChannelMode::Downmix ? 1 : channels;
+    processors_.reserve(states);
+    for (size_t i = 0; i < states; i++) {
+        processors_.push_back(std::make_unique<DenoiseProcessor>(kRnnoiseFrame));
+    }
+
+    if (mode_ == DenoiseChannelMode::Downmix) {
+        mix_.resize(kChunkFrames);
+    }
+
+    size_t rateFrames = kChunkFrames;
+    if (sampleRate != kRnnoiseRate) {
+        // Throws std::invalid_argument for ratios beyond kMaxPhases
+        uint16_t resampleChannels = static_cast<uint16_t>(states);
+        up_ = std::make_unique<wasapi_capture::PolyphaseResampler>(sampleRate, kRnnoiseRate, resampleChannels);
+        down_ = std::make_unique<wasapi_capture::PolyphaseResampler>(kRnnoiseRate, sampleRate, resampleChannels);
+
+        rateFrames = up_->MaxOutputFrames(kChunkFrames);
+        rate_.resize(rateFrames * states);
+        size_t backFrames = down_->MaxOutputFrames(rateFrames);
+        back_.resize(backFrames * states);
+
+        // The resamplers hold back their look-ahead, so down_ returns fewer
+        // frames than went in; prime the FIFO with that deficit (plus slack
+        // for packet-to-packet jitter) so every call can pop a full packet
+        double ratio = static_cast<double>(sampleRate) / kRnnoiseRate;
+        double deficit = static_cast<double>(up_->GetLatencyFrames()) +
+                         down_->GetLatencyFrames() * ratio;
+        fifo_prime_ = static_cast<size_t>(std::ceil(deficit)) + 4;
+        latency_frames_ = fifo_prime_ + static_cast<size_t>(std::lround(kRnnoiseFrame * ratio));
+
+        fifo_capacity_ = fifo_prime_ + backFrames + kChunkFrames;
+        fifo_.resize(fifo_capacity_ * states);
+    } else {
+        latency_frames_ = kRnnoiseFrame;
+    }
+
+    if (states > 1) {
+        planar_.resize(rateFrames * states);
+    }
+    Reset();
+}
+
+void DenoiseStage::Reset() {
+    for (auto& processor : processors_) {
+        processor->Reset();
+    }
+    if (up_) {
+        up_->Reset();
+        down_->Reset();
+        std::fill(fifo_.begin(), fifo_.end(), 0.0f);
+        fifo_read_ = 0;
+        fifo_count_ = fifo_prime_;  // Primed with silence
+    }
+    underruns_ = 0;
+}
+
+float DenoiseStage::GetLastVoiceProbability() const {
+    float vad = 0.0f;
+    for (const auto& processor : processors_) {
+        vad = (std::max)(vad, processor->GetLastVoiceProbability());
+    }
+    return vad;
+}
+
+int DenoiseStage::GetProcessedFrames() const {
+    return processors_.empty() ? 0 : processors_[0]->GetProcessedFrames();
+}
+
+void DenoiseStage::Process(float* interleaved, size_t frames) {
+    const size_t channels = channels_;
+    const bool downmix = mode_ == DenoiseChannelMode::Downmix;
+    const float mixScale = 1.0f / channels;
+
+    for (size_t offset = 0; offset < frames; offset += kChunkFrames) {
+        size_t n = (std::min)(kChunkFrames, frames - offset);
+        float* chunk = interleaved + offset * channels;
+
+        // Downmix mode denoises a mono copy and fans the result back out
+        float* source = chunk;
+        if (downmix) {
+            for (size_t f = 0; f < n; f++) {
+                const float* frame = chunk + f * channels;
+                float sum = 0.0f;
+                for (size_t c = 0; c < channels; c++) {
+                    sum += frame[c];
+                }
+                mix_[f] = sum * mixScale;
+            }
+            source = mix_.data();
         }
-        frame_buffer_pos_ += remaining;
-        
-        // If we have a complete frame, process it
-        if (frame_buffer_pos_ >= frame_size_) {
-            ProcessFrame(frame_buffer_.data(), frame_size_);
-            
-            // Convert back to Int16
-            for (int i = 0; i < remaining; i++) {
-                float sample = frame_buffer_[i] * 32768.0f;
-                if (sample > 32767.0f) {
-                    buffer[offset + i] = 32767;
-                } else if (sample < -32768.0f) {
-                    buffer[offset + i] = -32768;
-                } else {
-                    buffer[offset + i] = static_cast<int16_t>(sample);
+
+        if (!up_) {
+            Denoise(source, n);  // Already 48 kHz, in place
+        } else {
+            size_t up = up_->Process(source, n, rate_.data());
+            Denoise(rate_.data(), up);
+            size_t back = down_->Process(rate_.data(), up, back_.data());
+            FifoPush(back_.data(), back);
+            FifoPop(source, n);
+        }
+
+        if (downmix) {
+            for (size_t f = 0; f < n; f++) {
+                float* frame = chunk + f * channels;
+                for (size_t c = 0; c < channels; c++) {
+                    frame[c] = mix_[f];
                 }
             }
-            
-            frame_buffer_pos_ = 0;
         }
     }
 }
 
+void DenoiseStage::Denoise(float* interleaved, size_t frames) {
+    const size_t states = processors_.size();
+    const int count = static_cast<int>(frames);
+    if (states == 1) {
+        // Mono / downmix: already planar
+        if (engine_) {
+            DenoiseOnEngine(interleaved, count);
+        } else {
+            processors_[0]->ProcessBuffer(interleaved, count);
+        }
+        return;
+    }
+
+    // Deinterleave, run each channel through its own state, reinterleave
+    for (size_t c = 0; c < states; c++) {
+        float* plane = planar_.data() + c * frames;
+        for (size_t f = 0; f < frames; f++) {
+            plane[f] = interleaved[f * states + c];
+        }
+    }
+    if (engine_) {
+        DenoiseOnEngine(planar_.data(), count);
+    } else {
+        for (size_t c = 0; c < states; c++) {
+            processors_[c]->ProcessBuffer(planar_.data() + c * frames, count);
+        }
+    }
+    for (size_t c = 0; c < states; c++) {
+        const float* plane = planar_.data() + c * frames;
+        for (size_t f = 0; f < frames; f++) {
+            interleaved[f * states + c] = plane[f];
+        }
+    }
+}
+
+// v2.12: Feed every state up to its next frame boundary, send the completed
+// frames to the engine as one batch (one job per state), repeat. The states
+// are created and fed together, so they reach each boundary together.
+void DenoiseStage::DenoiseOnEngine(float* planes, int count) {
+    const size_t states = processors_.size();
+    DenoiseJob jobs[kMaxChannels];
+    int offset = 0;
+    while (offset < count) {
+        int used = 0;
+        size_t ready = 0;
+        for (size_t c = 0; c < states; c++) {
+            DenoiseProcessor* processor = processors_[c].get();
+            used = processor->Feed(planes + c * count + offset, count - offset);
+            if (processor->FrameReady()) {
+                jobs[ready++] = DenoiseJob{processor, processor->PendingFrame()};
+            }
+        }
+        offset += used;
+        if (ready > 0) {
+            engine_->Run(jobs, ready);
+            for (size_t j = 0; j < ready; j++) {
+                jobs[j].processor->CompleteFrame();
+            }
+        }
+    }
+}
+
+void DenoiseStage::FifoPush(const float* interleaved, size_t frames) {
+    const size_t states = processors_.size();
+    for (size_t f = 0; f < frames; f++) {
+        if (fifo_count_ == fifo_capacity_) {
+            // Cannot happen with a steady ratio; keep the newest audio
+            fifo_read_ = (fifo_read_ + 1) % fifo_capacity_;
+            fifo_count_--;
+        }
+        size_t slot = (fifo_read_ + fifo_count_) % fifo_capacity_;
+        std::memcpy(fifo_.data() + slot * states, interleaved + f * states, states * sizeof(float));
+        fifo_count_++;
+    }
+}
+
+void DenoiseStage::FifoPop(float* interleaved, size_t frames) {
+    const size_t states = processors_.size();
+    size_t available = (std::min)(frames, fifo_count_);
+    for (size_t f = 0; f < available; f++) {
+        std::memcpy(interleaved + f * states, fifo_.data() + fifo_read_ * states, states * sizeof(float));
+        fifo_read_ = (fifo_read_ + 1) % fifo_capacity_;
+    }
+    fifo_count_ -= available;
+    if (available < frames) {
+        std::fill(interleaved + available * states, interleaved + frames * states, 0.0f);
+        underruns_ += frames - available;
+    }
+}
+
 } // namespace AudioCapture
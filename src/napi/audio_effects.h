@@ -4,9 +4,14 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
+#include "polyphase_resampler.h"  // v2.12: 48 kHz conversion for non-48 kHz mix formats
+#include "denoise_engine.h"       // v2.12: Shared RNNoise worker pool
+
 // Forward declare RNNoise type
 typedef struct DenoiseState DenoiseState;
 
@@ -14,7 +19,7 @@ namespace AudioCapture {
 
 /**
  * @brief Audio Denoise Processor using RNNoise
- * 
+ *
  * RNNoise expects 48kHz mono audio in 10ms frames (480 samples).
  * This class handles frame buffering and processing.
  */
@@ -25,32 +30,47 @@ public:
      * @param frame_size Number of samples per frame (must be 480 for RNNoise)
      */
     explicit DenoiseProcessor(int frame_size = 480);
-    
+
     /**
      * @brief Destroy the Denoise Processor
      */
     ~DenoiseProcessor();
-    
+
     // Disable copy
     DenoiseProcessor(const DenoiseProcessor&) = delete;
     DenoiseProcessor& operator=(const DenoiseProcessor&) = delete;
-    
+
     /**
      * @brief Process a single frame of Float32 audio
-     * @param frame Pointer to audio data (must be exactly frame_size samples)
+     * @param frame Pointer to audio data (must be exactly frame_size samples, full scale 1.0)
      * @param size Number of samples (must equal frame_size)
      * @return Voice Activity Detection probability (0.0 - 1.0)
+     * @note v2.12: Samples are scaled to the 16-bit range RNNoise was trained on
      */
     float ProcessFrame(float* frame, int size);
-    
+
     /**
-     * @brief Process a buffer of Float32 audio (multiple frames)
+     * @brief Process a buffer of Float32 audio (any length, in place)
      * @param buffer Pointer to audio data
      * @param size Number of samples
-     * @note If size is not a multiple of frame_size, remaining samples are buffered
+     * @note v2.12: Streaming with a fixed latency of one frame: the samples
+     *       written back are the denoised input from frame_size samples
+     *       earlier. The carry buffers are allocated once, in the constructor.
      */
     void ProcessBuffer(float* buffer, int size);
-    
+
+    /**
+     * v2.12: ProcessBuffer split at frame boundaries (for DenoiseEngine).
+     * Feed() streams samples in until a frame is complete and returns how
+     * many it consumed; once FrameReady(), run ProcessFrame() on
+     * PendingFrame() (any thread) and call CompleteFrame() before feeding
+     * more. The output is identical to ProcessBuffer.
+     */
+    int Feed(float* buffer, int size);
+    bool FrameReady() const { return frame_buffer_pos_ == frame_size_; }
+    float* PendingFrame() { return frame_buffer_.data(); }
+    void CompleteFrame();
+
     /**
      * @brief Process a single frame of Int16 audio
      * @param frame Pointer to audio data
@@ -58,32 +78,32 @@ public:
      * @return Voice Activity Detection probability (0.0 - 1.0)
      */
     float ProcessFrame(int16_t* frame, int size);
-    
+
     /**
-     * @brief Process a buffer of Int16 audio (multiple frames)
+     * @brief Process a buffer of Int16 audio (any length, in place, one frame latency)
      * @param buffer Pointer to audio data
      * @param size Number of samples
      */
     void ProcessBuffer(int16_t* buffer, int size);
-    
+
     /**
      * @brief Get the last Voice Activity Detection probability
      * @return float Probability that last frame contained voice (0.0 - 1.0)
      */
     float GetLastVoiceProbability() const { return last_vad_prob_; }
-    
+
     /**
      * @brief Get the total number of frames processed
      * @return int Frame count
      */
     int GetProcessedFrames() const { return processed_frames_; }
-    
+
     /**
      * @brief Get the configured frame size
      * @return int Frame size in samples
      */
     int GetFrameSize() const { return frame_size_; }
-    
+
     /**
      * @brief Reset the processor state
      */
@@ -94,10 +114,106 @@ private:
     int frame_size_;                // Samples per frame (480)
     int processed_frames_;          // Total frames processed
     float last_vad_prob_;           // Last VAD probability
-    
+
     std::vector<float> temp_buffer_; // Temporary buffer for Int16 conversion
-    std::vector<float> frame_buffer_; // Buffer for incomplete frames
+    std::vector<float> frame_buffer_; // Frame being filled (ProcessBuffer input)
+    std::vector<float> output_buffer_; // v2.12: Previous denoised frame (ProcessBuffer output)
     int frame_buffer_pos_;          // Current position in frame buffer
 };
 
+/**
+ * v2.12: How interleaved channels map onto RNNoise states
+ */
+enum class DenoiseChannelMode {
+    PerChannel,  // One RNNoise state per channel (keeps the stereo image)
+    Downmix      // One state on the mono mix, result copied to every channel (1/N the CPU)
+};
+
+bool ParseDenoiseChannelMode(const std::string& name, DenoiseChannelMode& mode);
+const char* DenoiseChannelModeName(DenoiseChannelMode mode);
+
+/**
+ * v2.12: Denoise stage for the interleaved capture stream
+ *
+ * Deinterleaves into per-channel (or one downmixed) RNNoise states,
+ * converts to 48 kHz and back with the polyphase resampler when the mix
+ * format runs at another rate, and reinterleaves in place. Output lags the
+ * input by GetLatencyFrames(); every buffer is sized in the constructor, so
+ * Process() never allocates.
+ */
+class DenoiseStage {
+public:
+    /**
+     * @throws std::invalid_argument for 0 or more than kMaxChannels channels, or
+     *         a sample rate the resampler cannot convert to 48 kHz
+     * @throws std::runtime_error if an RNNoise state cannot be created
+     */
+    DenoiseStage(uint32_t sampleRate, uint16_t channels,
+                 DenoiseChannelMode mode = DenoiseChannelMode::PerChannel);
+
+    DenoiseStage(const DenoiseStage&) = delete;
+    DenoiseStage& operator=(const DenoiseStage&) = delete;
+
+    // Denoise interleaved Float32 frames in place
+    void Process(float* interleaved, size_t frames);
+
+    // Run the RNNoise frames of every state on a shared engine (nullptr: calling thread only)
+    void SetEngine(std::shared_ptr<DenoiseEngine> engine) { engine_ = std::move(engine); }
+    const std::shared_ptr<DenoiseEngine>& GetEngine() const { return engine_; }
+
+    void Reset();
+
+    bool Matches(uint32_t sampleRate, uint16_t channels) const {
+        return sampleRate == sample_rate_ && channels == channels_;
+    }
+
+    uint32_t GetSampleRate() const { return sample_rate_; }
+    uint16_t GetChannels() const { return channels_; }
+    DenoiseChannelMode GetMode() const { return mode_; }
+    size_t GetStateCount() const { return processors_.size(); }
+    bool IsResampling() const { return up_ != nullptr; }
+    size_t GetLatencyFrames() const { return latency_frames_; }  // Capture-rate frames
+    uint64_t GetUnderruns() const { return underruns_; }         // Frames output as silence
+
+    // Highest VAD probability of the last frame across states
+    float GetLastVoiceProbability() const;
+    // RNNoise frames per state
+    int GetProcessedFrames() const;
+
+    static constexpr uint32_t kRnnoiseRate = 48000;
+    static constexpr int kRnnoiseFrame = 480;
+    static constexpr uint16_t kMaxChannels = 8;
+
+private:
+    uint32_t sample_rate_;
+    uint16_t channels_;
+    DenoiseChannelMode mode_;
+    std::vector<std::unique_ptr<DenoiseProcessor>> processors_;
+    std::shared_ptr<DenoiseEngine> engine_;
+
+    // Capture rate <-> 48 kHz (both null at 48 kHz)
+    std::unique_ptr<wasapi_capture::PolyphaseResampler> up_;
+    std::unique_ptr<wasapi_capture::PolyphaseResampler> down_;
+
+    static constexpr size_t kChunkFrames = 480;  // Capture frames per step
+    std::vector<float> mix_;     // Downmixed chunk (kChunkFrames)
+    std::vector<float> rate_;    // 48 kHz interleaved chunk (states x up_->MaxOutputFrames)
+    std::vector<float> planar_;  // Per-state 48 kHz samples
+    std::vector<float> back_;    // Capture-rate interleaved output of down_
+
+    // Capture-rate FIFO behind down_, primed with fifo_prime_ frames of silence
+    std::vector<float> fifo_;
+    size_t fifo_capacity_ = 0;   // Frames
+    size_t fifo_prime_ = 0;
+    size_t fifo_read_ = 0;
+    size_t fifo_count_ = 0;
+    size_t latency_frames_ = 0;
+    uint64_t underruns_ = 0;
+
+    void Denoise(float* interleaved, size_t frames);
+    void DenoiseOnEngine(float* planes, int count);  // v2.12: State c at planes + c * count
+    void FifoPush(const float* interleaved, size_t frames);
+    void FifoPop(float* interleaved, size_t frames);
+};
+
 } // namespace AudioCapture
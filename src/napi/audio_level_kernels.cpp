@@ -0,0 +1,354 @@
+/**
+ * Audio Level Kernels Implementation
+ */
+
+#include "audio_level_kernels.h"
+
+#include <cmath>
+
+#if defined(AUDIO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace wasapi_capture {
+
+namespace {
+
+constexpr double kInt16Scale = 1.0 / 32768.0;
+
+// Float lanes are flushed to the double total every kBlock samples, which
+// keeps the float rounding error of the sum of squares around 1e-5 relative
+constexpr size_t kBlock = 1024;
+
+LevelSums FromInt16(int32_t maxAbs, uint64_t sumSquares) {
+    return LevelSums{
+        static_cast<float>(maxAbs * kInt16Scale),
+        static_cast<double>(sumSquares) * (kInt16Scale * kInt16Scale)
+    };
+}
+
+}  // namespace
+
+namespace level_kernels {
+
+// ========== Scalar (reference) ==========
+
+LevelSums MeasureScalar(const float* samples, size_t count) {
+    float peak = 0.0f;
+    double sumSquares = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        float absValue = std::fabs(samples[i]);
+        if (absValue > peak) {
+            peak = absValue;
+        }
+        sumSquares += static_cast<double>(samples[i]) * static_cast<double>(samples[i]);
+    }
+    return LevelSums{peak, sumSquares};
+}
+
+LevelSums MeasureScalar(const int16_t* samples, size_t count) {
+    int32_t maxAbs = 0;
+    uint64_t sumSquares = 0;
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = samples[i];
+        int32_t absValue = value < 0 ? -value : value;  // 32-bit: |-32768| fits
+        if (absValue > maxAbs) {
+            maxAbs = absValue;
+        }
+        sumSquares += static_cast<uint64_t>(value * value);
+    }
+    return FromInt16(maxAbs, sumSquares);
+}
+
+#if defined(AUDIO_SIMD_X86)
+
+// ========== SSE2 ==========
+
+namespace {
+
+inline double HorizontalSumSse2(__m128 v) {
+    __m128d lo = _mm_cvtps_pd(v);
+    __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+    __m128d sum = _mm_add_pd(lo, hi);
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+    return _mm_cvtsd_f64(sum);
+}
+
+inline float HorizontalMaxSse2(__m128 v) {
+    v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+inline uint64_t HorizontalSumEpi64Sse2(__m128i v) {
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+    return lanes[0] + lanes[1];
+}
+
+inline int32_t PeakFromMinMaxSse2(__m128i vmax, __m128i vmin) {
+    alignas(16) int16_t maxLanes[8];
+    alignas(16) int16_t minLanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(maxLanes), vmax);
+    _mm_store_si128(reinterpret_cast<__m128i*>(minLanes), vmin);
+    int32_t peak = 0;
+    for (int i = 0; i < 8; i++) {
+        int32_t hi = maxLanes[i];
+        int32_t lo = -static_cast<int32_t>(minLanes[i]);
+        if (hi > peak) peak = hi;
+        if (lo > peak) peak = lo;
+    }
+    return peak;
+}
+
+}  // namespace
+
+LevelSums MeasureSse2(const float* samples, size_t count) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 vpeak = _mm_setzero_ps();
+    double sumSquares = 0.0;
+
+    size_t i = 0;
+    const size_t vectorEnd = count & ~size_t(7);
+    while (i < vectorEnd) {
+        size_t blockEnd = (vectorEnd - i > kBlock) ? i + kBlock : vectorEnd;
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for (; i < blockEnd; i += 8) {
+            __m128 a = _mm_loadu_ps(samples + i);
+            __m128 b = _mm_loadu_ps(samples + i + 4);
+            // max(x, peak) returns peak when x is NaN, like the scalar compare
+            vpeak = _mm_max_ps(_mm_and_ps(a, absMask), vpeak);
+            vpeak = _mm_max_ps(_mm_and_ps(b, absMask), vpeak);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(a, a));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(b, b));
+        }
+        sumSquares += HorizontalSumSse2(_mm_add_ps(acc0, acc1));
+    }
+
+    LevelSums tail = MeasureScalar(samples + i, count - i);
+    float peak = HorizontalMaxSse2(vpeak);
+    return LevelSums{tail.peak > peak ? tail.peak : peak, sumSquares + tail.sumSquares};
+}
+
+LevelSums MeasureSse2(const int16_t* samples, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i vmax = zero;
+    __m128i vmin = zero;
+    __m128i acc = zero;  // 2 x uint64
+
+    size_t i = 0;
+    const size_t vectorEnd = count & ~size_t(7);
+    for (; i < vectorEnd; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        vmax = _mm_max_epi16(vmax, x);
+        vmin = _mm_min_epi16(vmin, x);
+        // Pairwise x*x sums; 2 * 32768^2 only fits as unsigned 32-bit
+        __m128i squares = _mm_madd_epi16(x, x);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(squares, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(squares, zero));
+    }
+
+    int32_t maxAbs = PeakFromMinMaxSse2(vmax, vmin);
+    uint64_t sumSquares = HorizontalSumEpi64Sse2(acc);
+    for (; i < count; i++) {
+        int32_t value = samples[i];
+        int32_t absValue = value < 0 ? -value : value;
+        if (absValue > maxAbs) maxAbs = absValue;
+        sumSquares += static_cast<uint64_t>(value * value);
+    }
+    return FromInt16(maxAbs, sumSquares);
+}
+
+// ========== AVX2 ==========
+
+AUDIO_TARGET_AVX2
+LevelSums MeasureAvx2(const float* samples, size_t count) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 vpeak = _mm256_setzero_ps();
+    double sumSquares = 0.0;
+
+    size_t i = 0;
+    const size_t vectorEnd = count & ~size_t(15);
+    while (i < vectorEnd) {
+        size_t blockEnd = (vectorEnd - i > kBlock) ? i + kBlock : vectorEnd;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for (; i < blockEnd; i += 16) {
+            __m256 a = _mm256_loadu_ps(samples + i);
+            __m256 b = _mm256_loadu_ps(samples + i + 8);
+            vpeak = _mm256_max_ps(_mm256_and_ps(a, absMask), vpeak);
+            vpeak = _mm256_max_ps(_mm256_and_ps(b, absMask), vpeak);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(a, a));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(b, b));
+        }
+        __m256 acc = _mm256_add_ps(acc0, acc1);
+        __m256d wide = _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(acc)),
+                                     _mm256_cvtps_pd(_mm256_extractf128_ps(acc, 1)));
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(wide), _mm256_extractf128_pd(wide, 1));
+        sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+        sumSquares += _mm_cvtsd_f64(sum);
+    }
+
+    __m128 peak4 = _mm_max_ps(_mm256_castps256_ps128(vpeak), _mm256_extractf128_ps(vpeak, 1));
+    peak4 = _mm_max_ps(peak4, _mm_movehl_ps(peak4, peak4));
+    peak4 = _mm_max_ss(peak4, _mm_shuffle_ps(peak4, peak4, 1));
+    float peak = _mm_cvtss_f32(peak4);
+
+    LevelSums tail = MeasureScalar(samples + i, count - i);
+    return LevelSums{tail.peak > peak ? tail.peak : peak, sumSquares + tail.sumSquares};
+}
+
+AUDIO_TARGET_AVX2
+LevelSums MeasureAvx2(const int16_t* samples, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmax = zero;
+    __m256i vmin = zero;
+    __m256i acc = zero;  // 4 x uint64
+
+    size_t i = 0;
+    const size_t vectorEnd = count & ~size_t(15);
+    for (; i < vectorEnd; i += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i));
+        vmax = _mm256_max_epi16(vmax, x);
+        vmin = _mm256_min_epi16(vmin, x);
+        __m256i squares = _mm256_madd_epi16(x, x);
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(squares, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(squares, zero));
+    }
+
+    __m128i max8 = _mm_max_epi16(_mm256_castsi256_si128(vmax), _mm256_extracti128_si256(vmax, 1));
+    __m128i min8 = _mm_min_epi16(_mm256_castsi256_si128(vmin), _mm256_extracti128_si256(vmin, 1));
+    __m128i acc2 = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+
+    int32_t maxAbs = PeakFromMinMaxSse2(max8, min8);
+    uint64_t sumSquares = HorizontalSumEpi64Sse2(acc2);
+    for (; i < count; i++) {
+        int32_t value = samples[i];
+        int32_t absValue = value < 0 ? -value : value;
+        if (absValue > maxAbs) maxAbs = absValue;
+        sumSquares += static_cast<uint64_t>(value * value);
+    }
+    return FromInt16(maxAbs, sumSquares);
+}
+
+#endif  // AUDIO_SIMD_X86
+
+#if defined(AUDIO_SIMD_NEON)
+
+// ========== NEON ==========
+
+LevelSums MeasureNeon(const float* samples, size_t count) {
+    float32x4_t vpeak = vdupq_n_f32(0.0f);
+    double sumSquares = 0.0;
+
+    size_t i = 0;
+    const size_t vectorEnd = count & ~size_t(7);
+    while (i < vectorEnd) {
+        size_t blockEnd = (vectorEnd - i > kBlock) ? i + kBlock : vectorEnd;
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        for (; i < blockEnd; i += 8) {
+            float32x4_t a = vld1q_f32(samples + i);
+            float32x4_t b = vld1q_f32(samples + i + 4);
+            // maxnm ignores NaN operands, like the scalar compare
+            vpeak = vmaxnmq_f32(vpeak, vabsq_f32(a));
+            vpeak = vmaxnmq_f32(vpeak, vabsq_f32(b));
+            acc0 = vfmaq_f32(acc0, a, a);
+            acc1 = vfmaq_f32(acc1, b, b);
+        }
+        float32x4_t acc = vaddq_f32(acc0, acc1);
+        float64x2_t wide = vaddq_f64(vcvt_f64_f32(vget_low_f32(acc)), vcvt_high_f64_f32(acc));
+        sumSquares += vaddvq_f64(wide);
+    }
+
+    float peak = vmaxnmvq_f32(vpeak);
+    LevelSums tail = MeasureScalar(samples + i, count - i);
+    return LevelSums{tail.peak > peak ? tail.peak : peak, sumSquares + tail.sumSquares};
+}
+
+LevelSums MeasureNeon(const int16_t* samples, size_t count) {
+    int16x8_t vmax = vdupq_n_s16(0);
+    int16x8_t vmin = vdupq_n_s16(0);
+    int64x2_t acc = vdupq_n_s64(0);
+
+    size_t i = 0;
+    const size_t vectorEnd = count & ~size_t(7);
+    for (; i < vectorEnd; i += 8) {
+        int16x8_t x = vld1q_s16(samples + i);
+        vmax = vmaxq_s16(vmax, x);
+        vmin = vminq_s16(vmin, x);
+        // Each product is at most 2^30, so the widened pairwise add is exact
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(x), vget_low_s16(x)));
+        acc = vpadalq_s32(acc, vmull_high_s16(x, x));
+    }
+
+    int32_t maxAbs = vmaxvq_s16(vmax);
+    int32_t minAbs = -static_cast<int32_t>(vminvq_s16(vmin));
+    if (minAbs > maxAbs) maxAbs = minAbs;
+    uint64_t sumSquares = static_cast<uint64_t>(vaddvq_s64(acc));
+    for (; i < count; i++) {
+        int32_t value = samples[i];
+        int32_t absValue = value < 0 ? -value : value;
+        if (absValue > maxAbs) maxAbs = absValue;
+        sumSquares += static_cast<uint64_t>(value * value);
+    }
+    return FromInt16(maxAbs, sumSquares);
+}
+
+#endif  // AUDIO_SIMD_NEON
+
+}  // namespace level_kernels
+
+// ========== Dispatch ==========
+
+namespace {
+
+struct LevelKernelTable {
+    SimdLevel level;
+    LevelSums (*measureFloat)(const float*, size_t);
+    LevelSums (*measureInt16)(const int16_t*, size_t);
+};
+
+LevelKernelTable SelectKernels() {
+    using namespace level_kernels;
+    switch (GetBestSimdLevel()) {
+#if defined(AUDIO_SIMD_X86)
+        case SimdLevel::AVX2:
+            return {SimdLevel::AVX2, &MeasureAvx2, &MeasureAvx2};
+        case SimdLevel::SSE2:
+            return {SimdLevel::SSE2, &MeasureSse2, &MeasureSse2};
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        case SimdLevel::NEON:
+            return {SimdLevel::NEON, &MeasureNeon, &MeasureNeon};
+#endif
+        default:
+            return {SimdLevel::Scalar, &MeasureScalar, &MeasureScalar};
+    }
+}
+
+const LevelKernelTable& Kernels() {
+    static const LevelKernelTable table = SelectKernels();
+    return table;
+}
+
+}  // namespace
+
+LevelSums MeasureLevels(const float* samples, size_t count) {
+    return Kernels().measureFloat(samples, count);
+}
+
+LevelSums MeasureLevels(const int16_t* samples, size_t count) {
+    return Kernels().measureInt16(samples, count);
+}
+
+SimdLevel GetLevelKernel() {
+    return Kernels().level;
+}
+
+}  // namespace wasapi_capture
@@ -0,0 +1,57 @@
+/**
+ * Audio Level Kernels
+ *
+ * v2.12: Fused peak + sum-of-squares over a block of samples, shared by
+ * AudioStatsCalculator and the streaming statistics.
+ *
+ * One pass computes both values. SSE2 / AVX2 / NEON variants are compiled
+ * in and the fastest one the CPU supports is chosen on first use. The
+ * scalar variant is the reference: SIMD results match it to within float
+ * rounding (sum of squares is accumulated per block in float lanes and
+ * flushed to double; Int16 sums are exact).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "cpu_features.h"
+
+namespace wasapi_capture {
+
+/**
+ * Result of one level measurement (Float32 scale, full scale = 1.0)
+ */
+struct LevelSums {
+    float peak;          // Maximum absolute sample value (NaN samples ignored)
+    double sumSquares;   // Sum of squared samples
+};
+
+// Dispatched to the best variant for this CPU
+LevelSums MeasureLevels(const float* samples, size_t count);
+LevelSums MeasureLevels(const int16_t* samples, size_t count);
+
+// Variant selected by MeasureLevels()
+SimdLevel GetLevelKernel();
+
+namespace level_kernels {
+
+// Individual variants (for tests and benchmarks; callers must check the CPU)
+LevelSums MeasureScalar(const float* samples, size_t count);
+LevelSums MeasureScalar(const int16_t* samples, size_t count);
+
+#if defined(AUDIO_SIMD_X86)
+LevelSums MeasureSse2(const float* samples, size_t count);
+LevelSums MeasureSse2(const int16_t* samples, size_t count);
+LevelSums MeasureAvx2(const float* samples, size_t count);
+LevelSums MeasureAvx2(const int16_t* samples, size_t count);
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+LevelSums MeasureNeon(const float* samples, size_t count);
+LevelSums MeasureNeon(const int16_t* samples, size_t count);
+#endif
+
+}  // namespace level_kernels
+
+}  // namespace wasapi_capture
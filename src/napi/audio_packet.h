@@ -0,0 +1,91 @@
+/**
+ * Audio Packet - single-copy capture path
+ *
+ * v2.12: A captured WASAPI packet is copied exactly once into an
+ * AudioPacket, the effect chain runs in place on that memory, and the
+ * same memory is handed to JavaScript:
+ * - Zero-copy mode: backed by a pooled ExternalBuffer (no further copies)
+ * - Copy mode: backed by a heap vector, copied once into a JS Buffer
+ */
+
+#ifndef AUDIO_PACKET_H
+#define AUDIO_PACKET_H
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "external_buffer.h"
+
+namespace AudioCapture {
+
+class AudioPacket {
+public:
+    AudioPacket() : size_(0) {}
+
+    // Move-only: a packet has exactly one owner until it reaches JS
+    AudioPacket(AudioPacket&&) = default;
+    AudioPacket& operator=(AudioPacket&&) = default;
+    AudioPacket(const AudioPacket&) = delete;
+    AudioPacket& operator=(const AudioPacket&) = delete;
+
+    // Backed by an external (pooled) buffer
+    static AudioPacket FromExternal(std::shared_ptr<ExternalBuffer> buffer, size_t size) {
+        AudioPacket packet;
+        if (buffer && size <= buffer->size()) {
+            packet.external_ = std::move(buffer);
+            packet.size_ = size;
+        }
+        return packet;
+    }
+
+    // Backed by heap memory (copy mode)
+    static AudioPacket FromHeap(size_t size) {
+        AudioPacket packet;
+        packet.heap_.resize(size);
+        packet.size_ = size;
+        return packet;
+    }
+
+    uint8_t* data() {
+        if (external_) return static_cast<uint8_t*>(external_->data());
+        return heap_.empty() ? nullptr : heap_.data();
+    }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Bytes the backing memory can hold
+    size_t capacity() const { return external_ ? external_->size() : heap_.size(); }
+
+    // Append in place; false (packet unchanged) if it does not fit capacity()
+    bool Append(const uint8_t* bytes, size_t count) {
+        if (count > capacity() - size_) return false;
+        if (count == 0) return true;
+        memcpy(data() + size_, bytes, count);
+        size_ += count;
+        return true;
+    }
+
+    // Shrink the visible size (batched delivery fills a packet partially)
+    void Truncate(size_t size) {
+        if (size < size_) size_ = size;
+    }
+
+    // Hand the packet memory to JavaScript
+    Napi::Value ToJS(Napi::Env env) {
+        if (external_) {
+            return ExternalBuffer::ToBufferFromShared(env, external_, size_);
+        }
+        return Napi::Buffer<uint8_t>::Copy(env, heap_.data(), size_);
+    }
+
+private:
+    std::shared_ptr<ExternalBuffer> external_;
+    std::vector<uint8_t> heap_;
+    size_t size_;
+};
+
+} // namespace AudioCapture
+
+#endif // AUDIO_PACKET_H
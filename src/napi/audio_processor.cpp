@@ -3,6 +3,7 @@
 #include "audio_stats_calculator.h"  // v2.10: Audio statistics
 #include <napi.h>
 #include <vector>
+#include <algorithm>
 #include <windows.h>
 #include <mmdeviceapi.h>
 #include <functiondiscoverykeys_devpkey.h>
@@ -12,8 +13,16 @@
 #include "../wasapi/audio_client.h"
 #include "../wasapi/audio_params.h"
 
+using AudioCapture::AudioPacket;
+using AudioCapture::BufferPool;
 using AudioCapture::ExternalBuffer;
-using AudioCapture::ExternalBufferFactory;
+using AudioCapture::PoolStrategy;
+
+// v2.12: TSFN 队列上限
+// 音频数据走 DeliveryQueue，专用 TSFN 中最多只有一个 drain 调用；
+// spectrum / stats / features / VAD 事件使用另一个 TSFN，事件突发不会挤占音频投递
+static constexpr size_t kAudioTsfnQueueSize = 2;
+static constexpr size_t kTsfnQueueSize = 16;
 
 Napi::Object AudioProcessor::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "AudioProcessor", {
@@ -51,12 +60,35 @@ Napi::Object AudioProcessor::Init(Napi::Env env, Napi::Object exports) {
         // v2.10 Phase 2: Silence threshold configuration
         InstanceMethod("setSilenceThreshold", &AudioProcessor::SetSilenceThreshold),
         InstanceMethod("getSilenceThreshold", &AudioProcessor::GetSilenceThreshold),
+        // v2.12: Streaming statistics
+        InstanceMethod("enableStats", &AudioProcessor::EnableStats),
+        InstanceMethod("disableStats", &AudioProcessor::DisableStats),
         // v2.11: Spectrum analysis
         InstanceMethod("enableSpectrum", &AudioProcessor::EnableSpectrum),
         InstanceMethod("disableSpectrum", &AudioProcessor::DisableSpectrum),
         InstanceMethod("isSpectrumEnabled", &AudioProcessor::IsSpectrumEnabled),
         InstanceMethod("setSpectrumConfig", &AudioProcessor::SetSpectrumConfig),
-        InstanceMethod("getSpectrumConfig", &AudioProcessor::GetSpectrumConfig)
+        InstanceMethod("getSpectrumConfig", &AudioProcessor::GetSpectrumConfig),
+        // v2.12: Log-mel features
+        InstanceMethod("enableFeatures", &AudioProcessor::EnableFeatures),
+        InstanceMethod("disableFeatures", &AudioProcessor::DisableFeatures),
+        InstanceMethod("getFeatureConfig", &AudioProcessor::GetFeatureConfig),
+        // v2.12: Voice activity gate
+        InstanceMethod("enableVad", &AudioProcessor::EnableVad),
+        InstanceMethod("disableVad", &AudioProcessor::DisableVad),
+        InstanceMethod("getVadStats", &AudioProcessor::GetVadStats),
+        // v2.12: True-peak limiter
+        InstanceMethod("enableLimiter", &AudioProcessor::EnableLimiter),
+        InstanceMethod("disableLimiter", &AudioProcessor::DisableLimiter),
+        InstanceMethod("getLimiterStats", &AudioProcessor::GetLimiterStats),
+        // v2.12: Capture pipeline statistics
+        InstanceMethod("getPipelineStats", &AudioProcessor::GetPipelineStats),
+        // v2.12: Native output stage
+        InstanceMethod("getOutputFormat", &AudioProcessor::GetOutputFormat),
+        // v2.12: Native pause/resume
+        InstanceMethod("pause", &AudioProcessor::Pause),
+        InstanceMethod("resume", &AudioProcessor::Resume),
+        InstanceMethod("isPaused", &AudioProcessor::IsPaused)
     });
     exports.Set("AudioProcessor", func);
     exports.Set("getDeviceInfo", Napi::Function::New(env, AudioProcessor::GetDeviceInfo));
@@ -105,40 +137,172 @@ AudioProcessor::AudioProcessor(const Napi::CallbackInfo& info) : Napi::ObjectWra
         useAdaptivePool_ = (strategy == "adaptive");
     }
     
-    // v2.6/v2.7: Initialize External Buffer Factory based on strategy
+    // v2.6/v2.7: Buffer pool configuration based on strategy
+    // v2.12: 每个 AudioProcessor 拥有独立的缓冲池（不再重置其他实例的全局池）
     if (useExternalBuffer_) {
         if (useAdaptivePool_) {
             // v2.7: Adaptive strategy - dynamically adjust pool size (50-200)
-            size_t initial_pool_size = 50;  // Start conservative
-            size_t min_pool_size = 50;
-            size_t max_pool_size = 200;
+            pool_size_ = 50;  // Start conservative
+            pool_min_size_ = 50;
+            pool_max_size_ = 200;
             
             // Allow user to override defaults
             if (options.Has("bufferPoolSize")) {
-                initial_pool_size = options.Get("bufferPoolSize").As<Napi::Number>().Uint32Value();
+                pool_size_ = options.Get("bufferPoolSize").As<Napi::Number>().Uint32Value();
             }
             if (options.Has("bufferPoolMin")) {
-                min_pool_size = options.Get("bufferPoolMin").As<Napi::Number>().Uint32Value();
+                pool_min_size_ = options.Get("bufferPoolMin").As<Napi::Number>().Uint32Value();
             }
             if (options.Has("bufferPoolMax")) {
-                max_pool_size = options.Get("bufferPoolMax").As<Napi::Number>().Uint32Value();
+                pool_max_size_ = options.Get("bufferPoolMax").As<Napi::Number>().Uint32Value();
             }
             
-            ExternalBufferFactory::Instance().InitializeAdaptive(
-                4096, initial_pool_size, min_pool_size, max_pool_size
-            );
-            
             // Initialize evaluation timer
             last_pool_eval_time_ = std::chrono::steady_clock::now();
             
         } else {
             // v2.6: Fixed strategy - use explicit pool size or default to 100
-            size_t pool_size = 100;
+            pool_size_ = 100;
             if (options.Has("bufferPoolSize")) {
-                pool_size = options.Get("bufferPoolSize").As<Napi::Number>().Uint32Value();
+                pool_size_ = options.Get("bufferPoolSize").As<Napi::Number>().Uint32Value();
             }
-            
-            ExternalBufferFactory::Instance().Initialize(4096, pool_size);
+        }
+        
+        // Default packet size until the stream format is known (resized in startCapture())
+        CreateBufferPool(4096);
+    }
+    
+    // v2.12: 处理线程（默认开启）：捕获线程只负责拷贝到 SPSC 环形缓冲区
+    if (options.Has("processingThread") && options.Get("processingThread").IsBoolean()) {
+        useProcessingThread_ = options.Get("processingThread").As<Napi::Boolean>().Value();
+    }
+    if (options.Has("processingQueueSize") && options.Get("processingQueueSize").IsNumber()) {
+        uint32_t slots = options.Get("processingQueueSize").As<Napi::Number>().Uint32Value();
+        processingQueueSize_ = slots > 0 ? slots : 64;
+    }
+    
+    // v2.12: JS 投递队列上限与溢出策略（drop-oldest / drop-newest / coalesce）
+    size_t deliveryQueueSize = 32;
+    AudioCapture::DeliveryPolicy deliveryPolicy = AudioCapture::DeliveryPolicy::DropOldest;
+    if (options.Has("deliveryQueueSize") && options.Get("deliveryQueueSize").IsNumber()) {
+        deliveryQueueSize = options.Get("deliveryQueueSize").As<Napi::Number>().Uint32Value();
+    }
+    if (options.Has("deliveryPolicy") && options.Get("deliveryPolicy").IsString()) {
+        std::string policy = options.Get("deliveryPolicy").As<Napi::String>().Utf8Value();
+        if (!AudioCapture::ParseDeliveryPolicy(policy, deliveryPolicy)) {
+            Napi::TypeError::New(env, "Invalid deliveryPolicy. Expected 'drop-oldest', 'drop-newest', or 'coalesce'")
+                .ThrowAsJavaScriptException();
+            return;
+        }
+    }
+    if (options.Has("coalesceMaxBytes") && options.Get("coalesceMaxBytes").IsNumber()) {
+        coalesceMaxBytes_ = options.Get("coalesceMaxBytes").As<Napi::Number>().Uint32Value();
+    }
+    delivery_queue_ = std::make_shared<PacketQueue>(
+        deliveryQueueSize, deliveryPolicy,
+        [this](DeliveryItem& into, DeliveryItem&& from) {
+            return this->MergePackets(into.packet, std::move(from.packet));
+        },
+        [](const DeliveryItem& item) { return item.boundary != nullptr; }
+    );
+    
+    // v2.12: 批量投递：按时间间隔和/或最小字节数合并多个 WASAPI 数据包后再回调 JS
+    if (options.Has("deliveryIntervalMs") && options.Get("deliveryIntervalMs").IsNumber()) {
+        deliveryIntervalMs_ = options.Get("deliveryIntervalMs").As<Napi::Number>().Uint32Value();
+    }
+    if (options.Has("minBytesPerCallback") && options.Get("minBytesPerCallback").IsNumber()) {
+        minBytesPerCallback_ = options.Get("minBytesPerCallback").As<Napi::Number>().Uint32Value();
+    }
+    
+    // v2.12: ASR 预设（与 lib/audio-processing-pipeline.js 同名）：设置输出采样率/声道/格式/帧长，
+    // 下面的单独选项可以覆盖预设中的任意一项
+    if (options.Has("preset") && options.Get("preset").IsString()) {
+        std::string name = options.Get("preset").As<Napi::String>().Utf8Value();
+        const wasapi_capture::AsrPreset* preset = wasapi_capture::FindAsrPreset(name);
+        if (!preset) {
+            Napi::TypeError::New(env,
+                "Invalid preset. Expected 'raw', 'china-asr', 'openai-whisper', 'global-asr-48k', 'azure', or 'google'"
+            ).ThrowAsJavaScriptException();
+            return;
+        }
+        preset_name_ = preset->name;
+        output_sample_rate_ = preset->sample_rate;
+        converter_config_.output_channels = preset->channels;
+        converter_config_.output_format = preset->format;
+        frame_ms_ = preset->frame_ms;
+    }
+    
+    // v2.12: 原生输出采样率（Float32 混音格式在处理线程上重采样后再投递，0 = 捕获采样率）
+    if (options.Has("outputSampleRate") && options.Get("outputSampleRate").IsNumber()) {
+        output_sample_rate_ = options.Get("outputSampleRate").As<Napi::Number>().Uint32Value();
+        if (output_sample_rate_ != 0 && (output_sample_rate_ < 8000 || output_sample_rate_ > 384000)) {
+            Napi::RangeError::New(env, "outputSampleRate must be 0 or between 8000 and 384000")
+                .ThrowAsJavaScriptException();
+            return;
+        }
+    }
+    if (options.Has("resampleQuality") && options.Get("resampleQuality").IsString()) {
+        std::string quality = options.Get("resampleQuality").As<Napi::String>().Utf8Value();
+        if (!wasapi_capture::ParseResampleQuality(quality, resample_quality_)) {
+            Napi::TypeError::New(env, "Invalid resampleQuality. Expected 'fast', 'balanced', or 'best'")
+                .ThrowAsJavaScriptException();
+            return;
+        }
+    }
+    
+    // v2.12: 原生输出格式（int16 / float32）、声道数、混音矩阵与 TPDF 抖动
+    if (options.Has("outputFormat") && options.Get("outputFormat").IsString()) {
+        std::string format = options.Get("outputFormat").As<Napi::String>().Utf8Value();
+        if (!wasapi_capture::ParseSampleFormat(format, converter_config_.output_format)) {
+            Napi::TypeError::New(env, "Invalid outputFormat. Expected 'float32' or 'int16'")
+                .ThrowAsJavaScriptException();
+            return;
+        }
+    }
+    if (options.Has("outputChannels") && options.Get("outputChannels").IsNumber()) {
+        uint32_t channels = options.Get("outputChannels").As<Napi::Number>().Uint32Value();
+        if (channels > wasapi_capture::FormatConverter::kMaxChannels) {
+            Napi::RangeError::New(env, "outputChannels must be between 0 and 8")
+                .ThrowAsJavaScriptException();
+            return;
+        }
+        converter_config_.output_channels = static_cast<uint16_t>(channels);
+    }
+    if (options.Has("downmixMatrix") && options.Get("downmixMatrix").IsArray()) {
+        // number[][] (one row per output channel) or a flat row-major number[]
+        Napi::Array rows = options.Get("downmixMatrix").As<Napi::Array>();
+        std::vector<float>& matrix = converter_config_.downmix_matrix;
+        uint32_t rowCount = 0;
+        for (uint32_t r = 0; r < rows.Length(); r++) {
+            Napi::Value row = rows.Get(r);
+            if (row.IsNumber()) {
+                matrix.push_back(row.As<Napi::Number>().FloatValue());
+            } else if (row.IsArray()) {
+                Napi::Array values = row.As<Napi::Array>();
+                for (uint32_t c = 0; c < values.Length(); c++) {
+                    matrix.push_back(values.Get(c).ToNumber().FloatValue());
+                }
+                rowCount++;
+            } else {
+                Napi::TypeError::New(env, "downmixMatrix must be an array of numbers or of number arrays")
+                    .ThrowAsJavaScriptException();
+                return;
+            }
+        }
+        if (converter_config_.output_channels == 0 && rowCount > 0) {
+            converter_config_.output_channels = static_cast<uint16_t>(rowCount);
+        }
+    }
+    if (options.Has("dither") && options.Get("dither").IsBoolean()) {
+        converter_config_.dither = options.Get("dither").As<Napi::Boolean>().Value();
+    }
+    
+    // v2.12: 固定帧长投递（每帧恰好 frameMs 毫秒的输出格式数据，0 = 按数据包投递）
+    if (options.Has("frameMs") && options.Get("frameMs").IsNumber()) {
+        frame_ms_ = options.Get("frameMs").As<Napi::Number>().Uint32Value();
+        if (frame_ms_ > 10000) {
+            Napi::RangeError::New(env, "frameMs must be between 0 and 10000").ThrowAsJavaScriptException();
+            return;
         }
     }
     
@@ -146,30 +310,34 @@ AudioProcessor::AudioProcessor(const Napi::CallbackInfo& info) : Napi::ObjectWra
     if (options.Has("callback") && options.Get("callback").IsFunction()) {
         Napi::Function callback = options.Get("callback").As<Napi::Function>();
         // 创建 ThreadSafeFunction（异步回调）
-        tsfn_ = Napi::ThreadSafeFunction::New(
-            env,
-            callback,
-            "AudioDataCallback",
-            0,      // 无限队列
-            1       // 单线程
-        );
+        CreateCallbacks(env, callback);
     }
     
     client_ = std::make_unique<AudioClient>();
     thread_ = std::make_unique<CaptureThread>(client_.get());
     
     // 设置 AudioClient 的音频数据回调
-    client_->SetAudioDataCallback([this](const std::vector<uint8_t>& data) {
-        this->OnAudioData(data);
+    // v2.12: 处理线程运行时只入队（无锁、无分配），否则在捕获线程上同步处理
+    // v2.12: 暂停时直接丢弃（不做任何 DSP、缓冲池或 TSFN 工作）
+    client_->SetAudioDataCallback([this](const uint8_t* data, size_t size, const StreamFormat& format) {
+        if (paused_.load(std::memory_order_relaxed)) {
+            packets_skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (worker_ && worker_->IsRunning()) {
+            worker_->Submit(data, size, format.blockAlign);
+        } else {
+            this->OnAudioData(data, size, format);
+        }
     });
     
     // v2.8: Initialize AGC processor
     agc_processor_ = std::make_unique<wasapi_capture::SimpleAGC>();
-    agc_processor_->Initialize(48000);  // Default sample rate, will be updated in Start()
+    agc_processor_->Initialize(stream_format_.sampleRate);  // Default sample rate, will be updated in Start()
     
     // v2.8: Initialize 3-Band EQ processor
     eq_processor_ = std::make_unique<wasapi_capture::ThreeBandEQ>();
-    eq_processor_->Initialize(48000);  // Default sample rate, will be updated in Start()
+    eq_processor_->Initialize(stream_format_.sampleRate);  // Default sample rate, will be updated in Start()
     
     // v2.10 Phase 2: Initialize audio statistics calculator with default threshold
     stats_calculator_ = std::make_unique<wasapi_capture::AudioStatsCalculator>();
@@ -180,6 +348,7 @@ AudioProcessor::~AudioProcessor() {
     if (thread_ && thread_->IsRunning()) {
         thread_->Stop();
     }
+    StopProcessingWorker();
     if (client_ && client_->IsInitialized()) {
         client_->Stop();
     }
@@ -187,6 +356,9 @@ AudioProcessor::~AudioProcessor() {
     if (tsfn_) {
         tsfn_.Release();
     }
+    if (events_tsfn_) {
+        events_tsfn_.Release();
+    }
     // 清理 COM
     if (comInitialized_) {
         CoUninitialize();
@@ -202,13 +374,7 @@ Napi::Value AudioProcessor::Start(const Napi::CallbackInfo& info) {
         
         // Create ThreadSafeFunction if not already created
         if (!tsfn_) {
-            tsfn_ = Napi::ThreadSafeFunction::New(
-                env,
-                callback,
-                "AudioDataCallback",
-                0,      // Unlimited queue
-                1       // Single thread
-            );
+            CreateCallbacks(env, callback);
         }
     }
     
@@ -255,6 +421,96 @@ Napi::Value AudioProcessor::Start(const Napi::CallbackInfo& info) {
         }
     }
     
+    // v2.12: 使用协商后的混音格式重新配置 DSP 阶段（不再硬编码 48000 Hz / 立体声）
+    stream_format_ = client_->GetStreamFormat();
+    agc_processor_->Initialize(static_cast<int>(stream_format_.sampleRate));  // Not capturing yet
+    {
+        std::lock_guard<std::mutex> lock(eq_mutex_);
+        eq_processor_->Initialize(static_cast<int>(stream_format_.sampleRate));
+    }
+    {
+        std::lock_guard<std::mutex> lock(spectrum_mutex_);
+        if (spectrum_analyzer_ &&
+            spectrum_analyzer_->GetConfig().sample_rate != static_cast<int>(stream_format_.sampleRate)) {
+            audio_capture::SpectrumConfig config = spectrum_analyzer_->GetConfig();
+            config.sample_rate = static_cast<int>(stream_format_.sampleRate);
+            config.hop_size = ResolveSpectrumHop(config.fft_size);
+            spectrum_analyzer_ = std::make_unique<audio_capture::SpectrumAnalyzer>(config);
+        }
+    }
+    
+    // v2.12: 降噪按协商后的采样率 / 声道数重建（非 48 kHz 时内部重采样）
+    {
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        if (denoise_stage_ && !denoise_stage_->Matches(stream_format_.sampleRate, stream_format_.channels)) {
+            try {
+                auto engine = denoise_stage_->GetEngine();
+                denoise_stage_ = std::make_unique<AudioCapture::DenoiseStage>(
+                    stream_format_.sampleRate, stream_format_.channels, denoise_mode_);
+                denoise_stage_->SetEngine(std::move(engine));
+            } catch (const std::exception& e) {
+                denoise_stage_.reset();
+                denoise_enabled_ = false;
+                Napi::RangeError::New(env,
+                    std::string("Denoise does not support the ") + std::to_string(stream_format_.sampleRate) +
+                    " Hz / " + std::to_string(stream_format_.channels) + " channel capture format: " + e.what()
+                ).ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+    }
+    
+    // v2.12: 限幅器按协商后的格式重建（保留配置）
+    {
+        std::lock_guard<std::mutex> lock(limiter_mutex_);
+        if (limiter_ && !limiter_->Matches(stream_format_.sampleRate, stream_format_.channels)) {
+            wasapi_capture::LimiterConfig config = limiter_->GetConfig();
+            config.sample_rate = stream_format_.sampleRate;
+            config.channels = stream_format_.channels;
+            try {
+                limiter_ = std::make_unique<wasapi_capture::TruePeakLimiter>(config);
+            } catch (const std::exception& e) {
+                limiter_.reset();
+                limiter_enabled_ = false;
+                Napi::RangeError::New(env,
+                    std::string("Limiter does not support the ") + std::to_string(stream_format_.channels) +
+                    " channel capture format: " + e.what()
+                ).ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+    }
+    
+    // v2.12: VAD 门限按协商后的格式重建（保留配置）
+    {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        if (vad_gate_ &&
+            (vad_gate_->GetConfig().sample_rate != stream_format_.sampleRate ||
+             vad_gate_->GetConfig().channels != stream_format_.channels)) {
+            AudioCapture::VadGateConfig config = vad_gate_->GetConfig();
+            config.sample_rate = stream_format_.sampleRate;
+            config.channels = stream_format_.channels;
+            vad_gate_ = std::make_unique<AudioCapture::VadGate>(config);
+        }
+    }
+    
+    // v2.12: 输出阶段按协商后的采样率创建重采样器
+    try {
+        ConfigureOutputStage();
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env,
+            std::string("Unsupported output format for the ") + std::to_string(stream_format_.sampleRate) +
+            " Hz / " + std::to_string(stream_format_.channels) + " channel capture format: " + e.what()
+        ).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    
+    // v2.12: 帧长按输出格式换算为字节
+    StreamFormat output = OutputFormat();
+    frame_assembler_.Configure(frame_ms_ > 0
+        ? static_cast<size_t>(output.sampleRate) * frame_ms_ / 1000 * output.blockAlign
+        : 0);
+    
     // 设置事件句柄（在 Start() 之前必须设置）
     HANDLE sampleReadyEvent = thread_->GetEventHandle();
     if (sampleReadyEvent && !client_->SetEventHandle(sampleReadyEvent)) {
@@ -278,6 +534,10 @@ Napi::Value AudioProcessor::Start(const Napi::CallbackInfo& info) {
 Napi::Value AudioProcessor::Stop(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
+    // v2.12: stop() 清除暂停状态
+    paused_ = false;
+    stream_paused_ = false;
+    
     // 停止音频流
     if (client_ && client_->IsInitialized()) {
         if (!client_->Stop()) {
@@ -303,6 +563,45 @@ Napi::Value AudioProcessor::StartCapture(const Napi::CallbackInfo& info) {
         return env.Undefined();
     }
     
+    ConfigureBatching();
+    if (resampler_) {
+        resampler_->Reset();  // New capture starts from silence
+    }
+    frame_assembler_.Reset();
+    {
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        if (denoise_stage_) {
+            denoise_stage_->Reset();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        if (vad_gate_) {
+            vad_gate_->Reset();  // Positions count from the start of this capture
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(limiter_mutex_);
+        if (limiter_) {
+            limiter_->Reset();  // Empty look-ahead, fresh meter
+        }
+    }
+    
+    // v2.12: 按输出格式的数据包大小（或批次大小）调整本实例的缓冲池
+    if (useExternalBuffer_) {
+        // ~10 ms; with resampling, the resampler's per-call upper bound for 10 ms of input
+        size_t packetFrames = resampler_
+            ? resampler_->MaxOutputFrames(stream_format_.sampleRate / 100)
+            : stream_format_.sampleRate / 100;
+        size_t packetBytes = frame_assembler_.IsEnabled()
+            ? frame_assembler_.FrameBytes()
+            : (batch_capacity_ > 0 ? batch_capacity_ : packetFrames * OutputFormat().blockAlign);
+        if (!buffer_pool_ || buffer_pool_->BufferSize() != packetBytes) {
+            CreateBufferPool(packetBytes);
+        }
+    }
+    
+    StartProcessingWorker();
     thread_->Start();
     return Napi::Boolean::New(env, true);
 }
@@ -315,9 +614,200 @@ Napi::Value AudioProcessor::StopCapture(const Napi::CallbackInfo& info) {
         thread_->Stop();
     }
     
+    // v2.12: 捕获线程停止后再停止处理线程（剩余数据会先处理完）
+    StopProcessingWorker();
+    
+    // v2.12: 投递未满的批次和最后一个不完整的帧（此时没有其他线程访问 batch_ / 帧）
+    FlushBatch();
+    frame_assembler_.Flush([this](AudioPacket&& frame) {
+        if (tsfn_) {
+            DeliverPacket(std::move(frame));
+        }
+    });
+    // v2.12: 语音段在停止时结束（尾部数据已在上面投递）；处理线程已停止，门限只由 JS 线程访问
+    FinishVadClose();
+    if (vad_gate_) {
+        CloseVadGate(*vad_gate_);
+    }
+    {
+        std::lock_guard<std::mutex> lock(features_mutex_);
+        FlushFeatures();
+    }
+    
+    // v2.12: A drain that could not be queued is normally retried by the next
+    // packet; after the last one nothing would retry it
+    if (tsfn_ && delivery_queue_->RequestDrain()) {
+        ScheduleDrain();
+    }
+    
     return Napi::Boolean::New(env, true);
 }
 
+// v2.12: (Re)create this instance's buffer pool for the given packet size
+// Buffers still held by JavaScript keep their old size class alive
+void AudioProcessor::CreateBufferPool(size_t bufferSize) {
+    if (useAdaptivePool_) {
+        buffer_pool_ = std::make_unique<BufferPool>(bufferSize, pool_size_, pool_max_size_);
+        buffer_pool_->SetStrategy(PoolStrategy::Adaptive);
+        buffer_pool_->SetMinMaxPoolSize(pool_min_size_, pool_max_size_);
+    } else {
+        buffer_pool_ = std::make_unique<BufferPool>(bufferSize, pool_size_);
+        buffer_pool_->SetStrategy(PoolStrategy::Fixed);
+    }
+}
+
+// v2.12: Derive the batch flush threshold from the delivered (output) format
+void AudioProcessor::ConfigureBatching() {
+    batch_ = AudioPacket();
+    batch_fill_ = 0;
+    batch_target_bytes_ = 0;
+    batch_capacity_ = 0;
+    if (frame_assembler_.IsEnabled()) {
+        return;  // Fixed-size frames replace batching
+    }
+    
+    StreamFormat output = OutputFormat();
+    size_t bytesPerSecond = static_cast<size_t>(output.sampleRate) * output.blockAlign;
+    size_t intervalBytes = bytesPerSecond * deliveryIntervalMs_ / 1000;
+    batch_target_bytes_ = intervalBytes > minBytesPerCallback_ ? intervalBytes : minBytesPerCallback_;
+    if (batch_target_bytes_ == 0) {
+        return;  // Batching disabled
+    }
+    
+    // Headroom for one more ~10 ms packet so a batch rarely has to be cut short
+    batch_capacity_ = batch_target_bytes_ + bytesPerSecond / 50;
+}
+
+// v2.12: Deliver the partially filled batch (if any)
+void AudioProcessor::FlushBatch() {
+    if (batch_.empty()) {
+        return;
+    }
+    if (batch_fill_ > 0 && tsfn_) {
+        batch_.Truncate(batch_fill_);
+        DeliverPacket(std::move(batch_));
+    }
+    batch_ = AudioPacket();
+    batch_fill_ = 0;
+}
+
+// v2.12: (Re)create the output stage for the negotiated capture format
+// Order: channel mix -> resample -> sample format, so the resampler only filters the
+// delivered channels. Only Float32 mix formats have an output stage; anything else
+// is delivered as captured.
+// @throws std::invalid_argument for an unsupported rate pair, channel count or matrix
+void AudioProcessor::ConfigureOutputStage() {
+    resampler_.reset();
+    downmixer_.reset();
+    converter_.reset();
+    if (!stream_format_.IsFloat32()) {
+        return;
+    }
+    
+    wasapi_capture::FormatConverterConfig config = converter_config_;
+    config.input_channels = stream_format_.channels;
+    const uint16_t outputChannels = config.output_channels > 0 ? config.output_channels : config.input_channels;
+    const bool mixing = outputChannels != config.input_channels || !config.downmix_matrix.empty();
+    const bool resampling = output_sample_rate_ != 0 && output_sample_rate_ != stream_format_.sampleRate;
+    
+    if (resampling && mixing) {
+        wasapi_capture::FormatConverterConfig mixConfig = config;
+        mixConfig.output_format = wasapi_capture::SampleFormat::Float32;
+        mixConfig.dither = false;
+        downmixer_ = std::make_unique<wasapi_capture::FormatConverter>(mixConfig);
+        config.input_channels = outputChannels;
+        config.downmix_matrix.clear();
+    }
+    if (resampling) {
+        resampler_ = std::make_unique<wasapi_capture::PolyphaseResampler>(
+            stream_format_.sampleRate, output_sample_rate_, config.input_channels, resample_quality_);
+    }
+    if (config.output_format != wasapi_capture::SampleFormat::Float32 ||
+        config.input_channels != outputChannels || !config.downmix_matrix.empty()) {
+        converter_ = std::make_unique<wasapi_capture::FormatConverter>(config);
+    }
+}
+
+// v2.12: Format of the buffers handed to JavaScript
+StreamFormat AudioProcessor::OutputFormat() const {
+    StreamFormat format = stream_format_;
+    if (resampler_) {
+        format.sampleRate = resampler_->GetOutputRate();
+    }
+    const wasapi_capture::FormatConverter* last = converter_ ? converter_.get() : downmixer_.get();
+    if (last) {
+        if (last->GetOutputChannels() != format.channels) {
+            format.channelMask = 0;  // Speaker positions no longer apply
+        }
+        format.channels = last->GetOutputChannels();
+        format.bitsPerSample = last->GetOutputBitsPerSample();
+        format.validBitsPerSample = format.bitsPerSample;
+        format.isFloat = last->GetOutputFormat() == wasapi_capture::SampleFormat::Float32;
+        format.blockAlign = static_cast<uint16_t>(last->GetOutputBlockAlign());
+    }
+    return format;
+}
+
+// v2.12: Mix / resample / convert processed capture samples into the output packet
+// @return Bytes written to dest (room for MaxOutputFrames in the output format)
+size_t AudioProcessor::RunOutputStage(const float* samples, size_t frameCount, uint8_t* dest) {
+    const float* stage = samples;
+    size_t frames = frameCount;
+    
+    if (downmixer_) {
+        size_t needed = frames * downmixer_->GetOutputChannels();
+        if (mix_scratch_.size() < needed) {
+            mix_scratch_.resize(needed);
+        }
+        downmixer_->Convert(stage, frames, reinterpret_cast<uint8_t*>(mix_scratch_.data()));
+        stage = mix_scratch_.data();
+    }
+    
+    if (resampler_) {
+        const size_t channels = resampler_->GetChannels();
+        if (!converter_) {
+            return resampler_->Process(stage, frames, reinterpret_cast<float*>(dest)) * channels * sizeof(float);
+        }
+        size_t needed = resampler_->MaxOutputFrames(frames) * channels;
+        if (resample_scratch_.size() < needed) {
+            resample_scratch_.resize(needed);
+        }
+        frames = resampler_->Process(stage, frames, resample_scratch_.data());
+        stage = resample_scratch_.data();
+    }
+    
+    return converter_->Convert(stage, frames, dest);
+}
+
+// v2.12: Create the processing worker for the current stream format
+void AudioProcessor::StartProcessingWorker() {
+    StopProcessingWorker();
+    
+    if (!useProcessingThread_) {
+        return;
+    }
+    
+    // One slot holds 20 ms of audio (at least 4 KB); larger packets span several slots
+    size_t slotCapacity = static_cast<size_t>(stream_format_.sampleRate / 50) * stream_format_.blockAlign;
+    if (slotCapacity < 4096) {
+        slotCapacity = 4096;
+    }
+    
+    worker_ = std::make_unique<AudioCapture::ProcessingWorker>(
+        processingQueueSize_, slotCapacity,
+        [this](uint8_t* data, size_t size) {
+            this->OnAudioData(data, size, stream_format_);
+        }
+    );
+    worker_->Start();
+}
+
+void AudioProcessor::StopProcessingWorker() {
+    if (worker_) {
+        worker_->Stop();
+    }
+}
+
 Napi::Value AudioProcessor::GetDeviceInfo(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
@@ -393,13 +883,24 @@ Napi::Value AudioProcessor::GetDeviceInfo(const Napi::CallbackInfo& info) {
 }
 
 // 音频数据回调（从捕获线程调用）
-void AudioProcessor::OnAudioData(const std::vector<uint8_t>& data) {
+// v2.12: 单次拷贝路径 —— WASAPI 数据只拷贝一次到输出缓冲区，
+// 效果链在该缓冲区上原地处理，然后将同一块内存交给 JS
+void AudioProcessor::OnAudioData(const uint8_t* data, size_t size, const StreamFormat& format) {
     if (!tsfn_) {
         return;  // 没有设置回调函数
     }
     
+    // v2.12: disableVad() while capturing - the segment ends before this packet is processed
+    if (vad_close_pending_.load(std::memory_order_acquire)) {
+        FinishVadClose();
+    }
+    
+    if (!data || size == 0) {
+        return;
+    }
+    
     // v2.7: Periodic buffer pool evaluation (every 10 seconds)
-    if (useExternalBuffer_ && useAdaptivePool_) {
+    if (useExternalBuffer_ && useAdaptivePool_ && buffer_pool_) {
         auto now = std::chrono::steady_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
             now - last_pool_eval_time_
@@ -407,22 +908,333 @@ void AudioProcessor::OnAudioData(const std::vector<uint8_t>& data) {
         
         if (elapsed >= 10) {
             // 10 seconds passed - evaluate and adjust pool
-            ExternalBufferFactory::Instance().EvaluatePool();
+            buffer_pool_->EvaluateAndAdjust();
             last_pool_eval_time_ = now;
         }
     }
     
+    // v2.12: Feature-only delivery still processes the packet, but never batches or delivers it
+    DeliveryMode mode;
+    mode.deliverAudio = deliver_audio_.load(std::memory_order_relaxed);
+    mode.framing = frame_assembler_.IsEnabled() && mode.deliverAudio;
+    mode.batching = batch_target_bytes_ > 0 && mode.deliverAudio;
+    
+    // v2.12: VAD gate - only speech (with its pre-roll) continues to the output stage
+    if (vad_enabled_.load(std::memory_order_relaxed) && format.IsFloat32() && mode.deliverAudio) {
+        ProcessGated(data, size, format, mode);
+        return;
+    }
+    
+    // v2.12: With a native output stage the chain runs on a capture-rate scratch copy and
+    // the last stage (resampler or converter) writes straight into the output packet
+    const bool transform = (resampler_ || converter_) && format.IsFloat32() && mode.deliverAudio;
+    const size_t frameCount = format.FrameCount(size);
+    const size_t outputBytes = transform
+        ? (resampler_ ? resampler_->MaxOutputFrames(frameCount) : frameCount) * OutputFormat().blockAlign  // Upper bound
+        : size;
+    
+    // The only copy: WASAPI buffer -> output packet (or the current batch)
+    AudioPacket packet;
+    uint8_t* dest = AcquireOutput(outputBytes, mode, packet);
+    if (!dest) {
+        return;  // Allocation failed - drop this packet
+    }
+    
+    uint8_t* work = dest;
+    if (transform) {
+        if (capture_scratch_.size() < size) {
+            capture_scratch_.resize(size);  // Grows to the largest packet, then stays
+        }
+        work = capture_scratch_.data();
+    }
+    memcpy(work, data, size);
+    RunChain(work, size, frameCount, format);
+    
+    size_t deliveredBytes = size;
+    if (transform) {
+        deliveredBytes = RunOutputStage(reinterpret_cast<const float*>(work), frameCount, dest);
+    }
+    CommitOutput(dest, deliveredBytes, mode, packet);
+}
+
+// v2.12: Effect chain and analysis, in place (packet memory, or the scratch copy before the output stage)
+void AudioProcessor::RunChain(uint8_t* work, size_t size, size_t frameCount, const StreamFormat& format) {
+    // v2.12: Only Float32 mix formats go through the DSP chain
+    if (format.IsFloat32()) {
+        float* samples = reinterpret_cast<float*>(work);
+        
+        ApplyEffects(samples, frameCount, format);
+        AnalyzeSpectrum(samples, frameCount, format.channels);
+        ExtractFeatures(samples, frameCount, format.channels);
+    }
+    
+    // v2.12: Statistics see the processed samples at the capture rate
+    AccumulateStats(work, size, format);
+}
+
+// v2.12: Destination for up to outputBytes of output: frame scratch, the batch tail or a new packet
+// Returns nullptr when no buffer could be allocated
+uint8_t* AudioProcessor::AcquireOutput(size_t outputBytes, const DeliveryMode& mode, AudioPacket& packet) {
+    if (mode.framing) {
+        // v2.12: Fixed-size frames - the output lands in scratch, then in one pooled packet per frame
+        if (output_scratch_.size() < outputBytes) {
+            output_scratch_.resize(outputBytes);
+        }
+        return output_scratch_.data();
+    }
+    
+    if (mode.batching) {
+        // v2.12: Batched delivery - append to the batch, cross into JS once per batch
+        if (!batch_.empty() && batch_fill_ + outputBytes > batch_.size()) {
+            FlushBatch();
+        }
+        if (batch_.empty()) {
+            batch_ = AcquirePacket(outputBytes > batch_capacity_ ? outputBytes : batch_capacity_);
+            batch_fill_ = 0;
+            batch_start_time_ = std::chrono::steady_clock::now();
+            if (batch_.empty()) {
+                return nullptr;
+            }
+        }
+        return batch_.data() + batch_fill_;
+    }
+    
+    packet = AcquirePacket(outputBytes);
+    return packet.empty() ? nullptr : packet.data();
+}
+
+// v2.12: Hand deliveredBytes written at the AcquireOutput() destination to framing, batching or JS
+void AudioProcessor::CommitOutput(uint8_t* dest, size_t deliveredBytes, const DeliveryMode& mode, AudioPacket& packet) {
+    if (mode.framing) {
+        frame_assembler_.Push(dest, deliveredBytes,
+            [this](size_t bytes) { return AcquirePacket(bytes); },
+            [this](AudioPacket&& frame) { DeliverPacket(std::move(frame)); });
+        return;
+    }
+    
+    if (!mode.batching) {
+        if (mode.deliverAudio && deliveredBytes > 0) {
+            packet.Truncate(deliveredBytes);
+            DeliverPacket(std::move(packet));
+        }
+        return;  // Otherwise the packet goes straight back to the pool
+    }
+    
+    // Flush on size, or on wall-clock age so sparse streams still get delivered
+    batch_fill_ += deliveredBytes;
+    bool due = batch_fill_ >= batch_target_bytes_;
+    if (!due && deliveryIntervalMs_ > 0) {
+        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - batch_start_time_
+        ).count();
+        due = age >= static_cast<long long>(deliveryIntervalMs_);
+    }
+    if (due) {
+        FlushBatch();
+    }
+}
+
+// v2.12: Gated path - the chain runs on a scratch copy, the gate keeps or releases the frames,
+// and each speech segment goes through the output stage. Boundaries are queued in-band with
+// the audio, so JS receives a segment's tail (partial frame or batch) before its 'speechEnd'.
+void AudioProcessor::ProcessGated(const uint8_t* data, size_t size, const StreamFormat& format, const DeliveryMode& mode) {
+    const size_t frameCount = format.FrameCount(size);
+    if (capture_scratch_.size() < size) {
+        capture_scratch_.resize(size);
+    }
+    memcpy(capture_scratch_.data(), data, size);
+    RunChain(capture_scratch_.data(), size, frameCount, format);
+    const float* samples = reinterpret_cast<const float*>(capture_scratch_.data());
+    
+    // RNNoise probability of the last denoised frame (the gate falls back to energy without it)
+    float probability = -1.0f;
+    if (denoise_enabled_) {
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        if (denoise_stage_ && denoise_stage_->Matches(format.sampleRate, format.channels)) {
+            probability = denoise_stage_->GetLastVoiceProbability();
+        }
+    }
+    
+    size_t gated = 0;
+    AudioCapture::VadEvent events[AudioCapture::VadGate::kMaxEventsPerCall];
+    size_t eventCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        if (!vad_gate_ ||
+            vad_gate_->GetConfig().sample_rate != format.sampleRate ||
+            vad_gate_->GetConfig().channels != format.channels) {
+            // Disabled meanwhile, or built for another format: pass through
+            DeliverGated(samples, frameCount, format, mode);
+            return;
+        }
+        if (vad_gate_->GetConfig().source == AudioCapture::VadSource::Energy) {
+            probability = -1.0f;
+        }
+        
+        size_t needed = vad_gate_->MaxOutputFrames(frameCount) * format.channels;
+        if (gate_scratch_.size() < needed) {
+            gate_scratch_.resize(needed);
+        }
+        gated = vad_gate_->Process(samples, frameCount, gate_scratch_.data(), probability);
+        eventCount = (std::min)(vad_gate_->GetEventCount(), AudioCapture::VadGate::kMaxEventsPerCall);
+        std::copy(vad_gate_->GetEvents(), vad_gate_->GetEvents() + eventCount, events);
+    }
+    
+    const float* gatedSamples = gate_scratch_.data();
+    size_t cursor = 0;
+    for (size_t i = 0; i < eventCount; i++) {
+        const AudioCapture::VadEvent& event = events[i];
+        DeliverGated(gatedSamples + cursor * format.channels, event.output_offset - cursor, format, mode);
+        cursor = event.output_offset;
+        if (event.type == AudioCapture::VadEvent::Type::SpeechEnd) {
+            if (mode.framing) {
+                frame_assembler_.Flush([this](AudioPacket&& frame) { DeliverPacket(std::move(frame)); });
+            }
+            if (mode.batching) {
+                FlushBatch();
+            }
+        }
+        QueueVadBoundary(event, format.sampleRate);
+    }
+    DeliverGated(gatedSamples + cursor * format.channels, gated - cursor, format, mode);
+}
+
+// v2.12: Output stage + delivery for gated capture-rate frames (one extra copy when no stage is configured)
+void AudioProcessor::DeliverGated(const float* samples, size_t frames, const StreamFormat& format, const DeliveryMode& mode) {
+    if (frames == 0) {
+        return;
+    }
+    
+    const bool transform = resampler_ || converter_;
+    const size_t bytes = frames * format.blockAlign;
+    const size_t outputBytes = transform
+        ? (resampler_ ? resampler_->MaxOutputFrames(frames) : frames) * OutputFormat().blockAlign
+        : bytes;
+    
+    AudioPacket packet;
+    uint8_t* dest = AcquireOutput(outputBytes, mode, packet);
+    if (!dest) {
+        return;  // Allocation failed - drop these frames
+    }
+    
+    size_t deliveredBytes = bytes;
+    if (transform) {
+        deliveredBytes = RunOutputStage(samples, frames, dest);
+    } else {
+        memcpy(dest, samples, bytes);
+    }
+    CommitOutput(dest, deliveredBytes, mode, packet);
+}
+
+// v2.12: 'speechStart' / 'speechEnd' payload with capture-frame positions
+static Napi::Object VadEventToJS(Napi::Env env, const AudioCapture::VadEvent& event, uint32_t sampleRate) {
+    const double rate = static_cast<double>(sampleRate);
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("position", Napi::Number::New(env, static_cast<double>(event.position)));
+    result.Set("positionMs", Napi::Number::New(env, event.position * 1000.0 / rate));
+    if (event.type == AudioCapture::VadEvent::Type::SpeechStart) {
+        result.Set("onset", Napi::Number::New(env, static_cast<double>(event.onset)));
+        result.Set("onsetMs", Napi::Number::New(env, event.onset * 1000.0 / rate));
+    }
+    result.Set("probability", Napi::Number::New(env, event.probability));
+    result.Set("sampleRate", Napi::Number::New(env, rate));
+    result.Set("timestamp", Napi::Number::New(env, static_cast<double>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count())));
+    return result;
+}
+
+// v2.12: Queue a segment boundary behind the audio delivered so far (pinned: never dropped)
+void AudioProcessor::QueueVadBoundary(const AudioCapture::VadEvent& event, uint32_t sampleRate) {
+    if (!tsfn_) {
+        return;
+    }
+    DeliveryItem item;
+    item.boundary = std::make_unique<VadBoundary>(VadBoundary{event, sampleRate});
+    if (delivery_queue_->Push(std::move(item))) {
+        ScheduleDrain();
+    }
+}
+
+// v2.12: End the gate's open segment - its tail (partial frame / batch) is queued first,
+// then 'speechEnd'. Processing thread, or JS thread once capture has stopped.
+void AudioProcessor::CloseVadGate(AudioCapture::VadGate& gate) {
+    AudioCapture::VadEvent event;
+    if (!gate.Close(event)) {
+        return;
+    }
+    frame_assembler_.Flush([this](AudioPacket&& frame) {
+        if (tsfn_) {
+            DeliverPacket(std::move(frame));
+        }
+    });
+    FlushBatch();
+    QueueVadBoundary(event, gate.GetConfig().sample_rate);
+}
+
+// v2.12: JS thread - a gate replaced or removed while capturing is closed by the processing
+// thread before its next packet, so no audio of the segment can follow 'speechEnd'
+void AudioProcessor::RetireVadGate(std::unique_ptr<AudioCapture::VadGate> gate) {
+    if (!gate) {
+        return;
+    }
+    if (thread_ && thread_->IsRunning()) {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        if (!closing_vad_gate_) {
+            closing_vad_gate_ = std::move(gate);
+            vad_close_pending_.store(true, std::memory_order_release);
+        }
+        // Otherwise the previous close is still pending: this gate has not seen a packet since
+        return;
+    }
+    CloseVadGate(*gate);  // Not capturing: nothing else touches the output stage
+}
+
+// v2.12: Close the gate handed over by RetireVadGate() (if any)
+void AudioProcessor::FinishVadClose() {
+    std::unique_ptr<AudioCapture::VadGate> gate;
+    {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        gate = std::move(closing_vad_gate_);
+        vad_close_pending_.store(false, std::memory_order_relaxed);
+    }
+    if (gate) {
+        CloseVadGate(*gate);
+    }
+}
+
+// v2.12: Acquire the output packet for one WASAPI packet
+AudioPacket AudioProcessor::AcquirePacket(size_t size) {
+    if (useExternalBuffer_) {
+        // Zero-Copy 模式：从 Buffer Pool 获取（超出池缓冲区大小时分配独立缓冲区）
+        return AudioPacket::FromExternal(buffer_pool_->Acquire(size), size);
+    }
+    
+    // 传统模式：堆内存，在 JS 线程中拷贝一次到 Buffer
+    try {
+        return AudioPacket::FromHeap(size);
+    } catch (const std::bad_alloc&) {
+        return AudioPacket();
+    }
+}
+
+// v2.12: Denoise -> AGC -> EQ -> limiter, in place (layout taken from the negotiated format)
+void AudioProcessor::ApplyEffects(float* samples, size_t frameCount, const StreamFormat& format) {
+    if (frameCount == 0) {
+        return;
+    }
+    
+    int frames = static_cast<int>(frameCount);
+    int channels = static_cast<int>(format.channels);
+    
     // v2.7: Apply audio denoising if enabled
-    std::vector<uint8_t> processedData = data;  // Copy for modification
-    if (denoise_enabled_ && denoise_processor_) {
-        // Assuming audio data is Float32 PCM
-        // Note: May need to check format and handle conversion
-        size_t sampleCount = processedData.size() / sizeof(float);
-        if (sampleCount > 0) {
+    // v2.12: Deinterleaved per channel; a stage built for another format is skipped until Start() rebuilds it
+    if (denoise_enabled_) {
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        if (denoise_stage_ && denoise_stage_->Matches(format.sampleRate, format.channels)) {
             try {
-                float* audioData = reinterpret_cast<float*>(processedData.data());
-                denoise_processor_->ProcessBuffer(audioData, static_cast<int>(sampleCount));
-            } catch (const std::exception& e) {
+                denoise_stage_->Process(samples, frameCount);
+            } catch (const std::exception&) {
                 // Denoise failed, continue with original data
                 // Could log error here if needed
             }
@@ -430,186 +1242,441 @@ void AudioProcessor::OnAudioData(const std::vector<uint8_t>& data) {
     }
     
     // v2.8: Apply AGC (Automatic Gain Control) if enabled
+    // v2.12: No lock - options set from JS are staged and picked up by Process()
     if (agc_processor_ && agc_processor_->IsEnabled()) {
-        size_t sampleCount = processedData.size() / sizeof(float);
-        if (sampleCount > 0) {
-            try {
-                float* audioData = reinterpret_cast<float*>(processedData.data());
-                // Assuming stereo audio (2 channels) - adjust if needed
-                int frameCount = static_cast<int>(sampleCount / 2);
-                int channels = 2;
-                agc_processor_->Process(audioData, frameCount, channels);
-            } catch (const std::exception& e) {
-                // AGC failed, continue with original data
-            }
+        try {
+            agc_processor_->Process(samples, frames, channels);
+        } catch (const std::exception&) {
+            // AGC failed, continue with original data
         }
     }
     
     // v2.8: Apply 3-Band EQ if enabled
-    if (eq_processor_ && eq_processor_->IsEnabled()) {
-        size_t sampleCount = processedData.size() / sizeof(float);
-        if (sampleCount > 0) {
+    {
+        std::lock_guard<std::mutex> lock(eq_mutex_);
+        if (eq_processor_ && eq_processor_->IsEnabled()) {
             try {
-                float* audioData = reinterpret_cast<float*>(processedData.data());
-                // Assuming stereo audio (2 channels) - adjust if needed
-                int frameCount = static_cast<int>(sampleCount / 2);
-                int channels = 2;
-                eq_processor_->Process(audioData, frameCount, channels);
-            } catch (const std::exception& e) {
+                eq_processor_->Process(samples, frames, channels);
+            } catch (const std::exception&) {
                 // EQ failed, continue with original data
             }
         }
     }
     
-    // v2.11: Perform spectrum analysis if enabled
-    if (spectrum_enabled_ && spectrum_analyzer_) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - last_spectrum_time_
-        ).count();
-        
-        // Update spectrum at configured interval
-        if (elapsed_ms >= spectrum_interval_ms_) {
-            size_t sampleCount = processedData.size() / sizeof(float);
-            if (sampleCount >= static_cast<size_t>(spectrum_analyzer_->GetConfig().fft_size)) {
-                try {
-                    const float* audioData = reinterpret_cast<const float*>(processedData.data());
-                    auto result = spectrum_analyzer_->Analyze(audioData, sampleCount);
-                    
-                    // Create spectrum event data
-                    struct SpectrumData {
-                        audio_capture::SpectrumResult result;
-                    };
-                    
-                    auto* spectrumData = new SpectrumData{result};
-                    
-                    // Send spectrum event to JavaScript
-                    tsfn_.NonBlockingCall(spectrumData, [](Napi::Env env, Napi::Function jsCallback, SpectrumData* data) {
-                        try {
-                            // Create spectrum object
-                            Napi::Object spectrum = Napi::Object::New(env);
-                            
-                            // Magnitudes array
-                            Napi::Float32Array magnitudes = Napi::Float32Array::New(env, data->result.magnitudes.size());
-                            for (size_t i = 0; i < data->result.magnitudes.size(); i++) {
-                                magnitudes[i] = data->result.magnitudes[i];
-                            }
-                            spectrum.Set("magnitudes", magnitudes);
-                            
-                            // Frequency bands
-                            Napi::Array bands = Napi::Array::New(env, data->result.bands.size());
-                            for (size_t i = 0; i < data->result.bands.size(); i++) {
-                                const auto& band = data->result.bands[i];
-                                Napi::Object bandObj = Napi::Object::New(env);
-                                bandObj.Set("minFreq", Napi::Number::New(env, band.min_freq));
-                                bandObj.Set("maxFreq", Napi::Number::New(env, band.max_freq));
-                                bandObj.Set("energy", Napi::Number::New(env, band.energy));
-                                bandObj.Set("db", Napi::Number::New(env, band.db));
-                                bandObj.Set("name", Napi::String::New(env, band.name));
-                                bands.Set(static_cast<uint32_t>(i), bandObj);
-                            }
-                            spectrum.Set("bands", bands);
-                            
-                            // Voice detection
-                            spectrum.Set("voiceProbability", Napi::Number::New(env, data->result.voice_probability));
-                            spectrum.Set("spectralCentroid", Napi::Number::New(env, data->result.spectral_centroid));
-                            spectrum.Set("dominantFrequency", Napi::Number::New(env, data->result.dominant_frequency));
-                            spectrum.Set("isVoice", Napi::Boolean::New(env, data->result.is_voice));
-                            spectrum.Set("timestamp", Napi::Number::New(env, data->result.timestamp));
-                            
-                            // Call with both buffer and spectrum (event type: 'spectrum')
-                            jsCallback.Call({Napi::String::New(env, "spectrum"), spectrum});
-                            
-                        } catch (...) {
-                            // Silently ignore errors
-                        }
-                        delete data;
-                    });
-                    
-                    last_spectrum_time_ = now;
-                    
-                } catch (const std::exception& e) {
-                    // Spectrum analysis failed, continue normally
-                }
-            }
+    // v2.12: True-peak limiter last, so nothing after it can push the signal over the ceiling
+    if (limiter_enabled_) {
+        std::lock_guard<std::mutex> lock(limiter_mutex_);
+        if (limiter_ && limiter_->Matches(format.sampleRate, format.channels)) {
+            limiter_->Process(samples, frameCount);
         }
     }
+}
+
+// v2.12: Zero-copy spectrum marshalling
+// One external ArrayBuffer over the pooled frame block; magnitudes and band
+// values are Float32Array views into it, so the cost per frame is O(1) in the
+// number of bins. The frame returns to its pool when V8 collects the buffer.
+// Runtimes that forbid external buffers (e.g. Electron with the V8 sandbox)
+// get a single memcpy of the block instead.
+static Napi::Object SpectrumFrameToJS(Napi::Env env, audio_capture::SpectrumFrame* frame) {
+    napi_value raw = nullptr;
+    napi_status status = napi_create_external_arraybuffer(
+        env, frame->storage.data(), frame->ByteSize(),
+        [](napi_env, void*, void* hint) {
+            static_cast<audio_capture::SpectrumFrame*>(hint)->Release();
+        },
+        frame, &raw);
+    
+    Napi::ArrayBuffer block;
+    bool external = (status == napi_ok);
+    if (external) {
+        block = Napi::ArrayBuffer(env, raw);
+    } else {
+        block = Napi::ArrayBuffer::New(env, frame->ByteSize());
+        memcpy(block.Data(), frame->storage.data(), frame->ByteSize());
+    }
     
-    if (useExternalBuffer_) {
-        // v2.6: Zero-Copy 模式 - 使用 External Buffer
-        // 创建 External Buffer（由 Buffer Pool 管理）
-        auto extBuffer = ExternalBufferFactory::Instance().Create();
-        if (!extBuffer) {
-            // Pool exhausted, fallback to copy mode
-            auto* dataPtr = new std::vector<uint8_t>(processedData);
-            tsfn_.NonBlockingCall(dataPtr, [](Napi::Env env, Napi::Function jsCallback, std::vector<uint8_t>* data) {
-                try {
-                    Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data->data(), data->size());
-                    jsCallback.Call({ buffer });
-                } catch (...) {
-                    // Silently ignore callback errors
-                }
-                delete data;
+    const size_t bins = frame->bin_count;
+    const size_t bandCount = frame->band_count;
+    Napi::Object spectrum = Napi::Object::New(env);
+    
+    // Magnitudes array (view, no per-bin work)
+    spectrum.Set("magnitudes", Napi::Float32Array::New(env, bins, block, 0));
+    
+    if (frame->soa_bands) {
+        // Struct-of-arrays bands: ranges and names come from getSpectrumConfig()
+        spectrum.Set("bandEnergy", Napi::Float32Array::New(env, bandCount, block, bins * sizeof(float)));
+        spectrum.Set("bandDb", Napi::Float32Array::New(env, bandCount, block, (bins + bandCount) * sizeof(float)));
+    } else {
+        // Frequency bands (ranges and names from the interned layout)
+        const audio_capture::SpectrumBandLayout& layout = *frame->layout;
+        Napi::Array bands = Napi::Array::New(env, bandCount);
+        for (size_t i = 0; i < bandCount; i++) {
+            Napi::Object bandObj = Napi::Object::New(env);
+            bandObj.Set("minFreq", Napi::Number::New(env, layout.min_freq[i]));
+            bandObj.Set("maxFreq", Napi::Number::New(env, layout.max_freq[i]));
+            bandObj.Set("energy", Napi::Number::New(env, frame->band_energy[i]));
+            bandObj.Set("db", Napi::Number::New(env, frame->band_db[i]));
+            bandObj.Set("name", Napi::String::New(env, layout.names[i]));
+            bands.Set(static_cast<uint32_t>(i), bandObj);
+        }
+        spectrum.Set("bands", bands);
+    }
+    
+    // Voice detection
+    spectrum.Set("voiceProbability", Napi::Number::New(env, frame->voice_probability));
+    spectrum.Set("spectralCentroid", Napi::Number::New(env, frame->spectral_centroid));
+    spectrum.Set("dominantFrequency", Napi::Number::New(env, frame->dominant_frequency));
+    spectrum.Set("isVoice", Napi::Boolean::New(env, frame->is_voice));
+    spectrum.Set("timestamp", Napi::Number::New(env, static_cast<double>(frame->timestamp)));
+    spectrum.Set("position", Napi::Number::New(env, static_cast<double>(frame->position)));
+    
+    if (!external) {
+        frame->Release();  // Data was copied
+    }
+    return spectrum;
+}
+
+// v2.11: Perform spectrum analysis if enabled
+// v2.12: Streaming STFT - the analyzer buffers a mono downmix and produces one
+// frame per hop, so the event rate depends on the sample count, not packet size
+void AudioProcessor::AnalyzeSpectrum(const float* samples, size_t frameCount, uint16_t channels) {
+    if (!spectrum_enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    // v2.12: JS may reconfigure or drop the analyzer at any time
+    std::lock_guard<std::mutex> lock(spectrum_mutex_);
+    if (!spectrum_analyzer_) {
+        return;
+    }
+    
+    try {
+        spectrum_analyzer_->ProcessStream(samples, frameCount, channels,
+            [this](const audio_capture::SpectrumResult& result) {
+                EmitSpectrum(result);
             });
+    } catch (const std::exception&) {
+        // Spectrum analysis failed, continue normally
+    }
+}
+
+// v2.12: Send one spectrum frame to JavaScript
+// The frame comes from a fixed pool and goes back to it after marshalling,
+// so steady-state spectrum delivery performs no native allocation
+// Called from AnalyzeSpectrum with spectrum_mutex_ held
+void AudioProcessor::EmitSpectrum(const audio_capture::SpectrumResult& result) {
+    size_t bins = spectrum_analyzer_->GetBinCount();
+    size_t bandCount = spectrum_analyzer_->GetBandLayout()->Size();
+    if (!spectrum_pool_ || !spectrum_pool_->Matches(bins, bandCount)) {
+        // Configuration changed; frames still in flight keep the old pool alive
+        spectrum_pool_ = audio_capture::SpectrumFramePool::Create(kSpectrumFramePoolSize, bins, bandCount);
+    }
+    
+    // JS may still hold every pooled frame (zero-copy views live until GC)
+    audio_capture::SpectrumFrame* frame = spectrum_pool_->AcquireOrAllocate();
+    if (!frame) {
+        events_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    spectrum_analyzer_->ExportFrame(result, *frame);
+    
+    frame->soa_bands = spectrum_soa_bands_;
+    
+    // Send spectrum event to JavaScript
+    napi_status status = events_tsfn_.NonBlockingCall(frame, [](Napi::Env env, Napi::Function jsCallback, audio_capture::SpectrumFrame* frame) {
+        if (env == nullptr) {
+            frame->Release();
             return;
         }
-        
-        // 检查缓冲区大小是否足够
-        if (processedData.size() > extBuffer->size()) {
-            // Buffer too small, fallback to copy mode
-            auto* dataPtr = new std::vector<uint8_t>(processedData);
-            tsfn_.NonBlockingCall(dataPtr, [](Napi::Env env, Napi::Function jsCallback, std::vector<uint8_t>* data) {
-                try {
-                    Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data->data(), data->size());
-                    jsCallback.Call({ buffer });
-                } catch (...) {
-                    // Silently ignore callback errors
+        try {
+            Napi::Object spectrum = SpectrumFrameToJS(env, frame);  // Takes ownership of the frame
+            
+            // Call with both buffer and spectrum (event type: 'spectrum')
+            jsCallback.Call({Napi::String::New(env, "spectrum"), spectrum});
+        } catch (...) {
+            // Silently ignore errors
+        }
+    });
+    
+    if (status != napi_ok) {
+        // v2.12: TSFN queue full (JS stalled) - drop this event instead of growing
+        frame->Release();
+        events_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// v2.12: 'features' payload - features_per_event frames of melBins floats, row-major
+struct FeatureBatch {
+    AudioPacket packet;
+    size_t frames;
+    size_t bins;
+    uint64_t position;
+};
+
+// v2.12: Append log-mel frames to the pending batch; deliver every features_per_event_ frames
+void AudioProcessor::ExtractFeatures(const float* samples, size_t frameCount, uint16_t channels) {
+    if (!features_enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(features_mutex_);
+    if (!feature_extractor_) {
+        return;
+    }
+    
+    const size_t bins = static_cast<size_t>(feature_extractor_->GetNumBins());
+    const size_t batchBytes = features_per_event_ * bins * sizeof(float);
+    
+    feature_extractor_->ProcessStream(samples, frameCount, channels,
+        [&](const float* features, uint64_t position) {
+            if (feature_batch_.empty()) {
+                feature_batch_ = AcquirePacket(batchBytes);
+                feature_batch_frames_ = 0;
+                if (feature_batch_.empty()) {
+                    events_dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;  // Allocation failed - drop this frame
                 }
-                delete data;
-            });
-            return;
+            }
+            float* dest = reinterpret_cast<float*>(feature_batch_.data()) + feature_batch_frames_ * bins;
+            memcpy(dest, features, bins * sizeof(float));
+            feature_batch_frames_++;
+            feature_batch_position_ = position;
+            
+            if (feature_batch_frames_ >= features_per_event_) {
+                FlushFeatures();
+            }
+        });
+}
+
+// v2.12: Send the pending feature frames (caller holds features_mutex_)
+// The frames travel in a pooled AudioPacket and reach JS as a Float32Array over it
+void AudioProcessor::FlushFeatures() {
+    if (feature_batch_.empty()) {
+        return;
+    }
+    if (feature_batch_frames_ == 0 || !events_tsfn_ || !feature_extractor_) {
+        feature_batch_ = AudioPacket();
+        feature_batch_frames_ = 0;
+        return;
+    }
+    
+    auto* batch = new FeatureBatch();
+    batch->bins = static_cast<size_t>(feature_extractor_->GetNumBins());
+    batch->frames = feature_batch_frames_;
+    batch->position = feature_batch_position_;
+    feature_batch_.Truncate(batch->frames * batch->bins * sizeof(float));
+    batch->packet = std::move(feature_batch_);
+    feature_batch_ = AudioPacket();
+    feature_batch_frames_ = 0;
+    
+    napi_status status = events_tsfn_.NonBlockingCall(batch, [](Napi::Env env, Napi::Function jsCallback, FeatureBatch* batch) {
+        if (env != nullptr) {
+            try {
+                const size_t count = batch->frames * batch->bins;
+                Napi::Buffer<uint8_t> buffer = batch->packet.ToJS(env).As<Napi::Buffer<uint8_t>>();
+                Napi::Float32Array features;
+                if (buffer.ByteOffset() % sizeof(float) == 0) {
+                    features = Napi::Float32Array::New(env, count, buffer.ArrayBuffer(), buffer.ByteOffset());
+                } else {
+                    features = Napi::Float32Array::New(env, count);
+                    memcpy(features.Data(), buffer.Data(), count * sizeof(float));
+                }
+                
+                Napi::Object data = Napi::Object::New(env);
+                data.Set("features", features);
+                data.Set("frameCount", Napi::Number::New(env, static_cast<double>(batch->frames)));
+                data.Set("melBins", Napi::Number::New(env, static_cast<double>(batch->bins)));
+                data.Set("position", Napi::Number::New(env, static_cast<double>(batch->position)));
+                data.Set("timestamp", Napi::Number::New(env, static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count())));
+                
+                jsCallback.Call({Napi::String::New(env, "features"), data});
+            } catch (...) {
+                // Silently ignore errors
+            }
         }
-        
-        // 拷贝数据到 External Buffer (use processed data)
-        size_t actualSize = processedData.size();
-        memcpy(extBuffer->data(), processedData.data(), actualSize);
-        
-        // CRITICAL FIX: Capture shared_ptr in lambda to keep buffer alive
-        // Use the new ToBufferFromShared method that properly handles ownership
-        tsfn_.NonBlockingCall(extBuffer.get(), [extBuffer, actualSize](Napi::Env env, Napi::Function jsCallback, ExternalBuffer*) {
-            // v2.7.1: Wrap callback in try-catch to prevent N-API uncaught exception warnings
+        delete batch;
+    });
+    
+    if (status != napi_ok) {
+        // TSFN queue full (JS stalled) - drop these frames
+        delete batch;
+        events_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// v2.12: Fold the packet into the streaming statistics; emit 'stats' once per interval
+void AudioProcessor::AccumulateStats(const uint8_t* data, size_t size, const StreamFormat& format) {
+    if (!stats_enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_accumulator_.SetFormat(format.sampleRate, format.channels);
+    
+    bool complete = false;
+    if (format.IsFloat32()) {
+        complete = stats_accumulator_.Add(reinterpret_cast<const float*>(data), size / sizeof(float));
+    } else if (!format.isFloat && format.bitsPerSample == 16) {
+        complete = stats_accumulator_.Add(reinterpret_cast<const int16_t*>(data), size / sizeof(int16_t));
+    }
+    if (!complete) {
+        return;
+    }
+    
+    // The interval restarts only once its snapshot is queued (NonBlockingCall never waits)
+    auto* statsData = new wasapi_capture::StreamingStatsSnapshot(stats_accumulator_.GetSnapshot());
+    
+    napi_status status = events_tsfn_.NonBlockingCall(statsData, [](Napi::Env env, Napi::Function jsCallback, wasapi_capture::StreamingStatsSnapshot* data) {
+        if (env != nullptr) {
             try {
-                // Use new method that properly transfers shared_ptr ownership to V8
-                Napi::Value buffer = ExternalBuffer::ToBufferFromShared(env, extBuffer, actualSize);
-                jsCallback.Call({ buffer });
-                // shared_ptr extBuffer goes out of scope, but ownership transferred to V8's finalize callback
-            } catch (const Napi::Error& e) {
-                // Silently ignore callback errors to prevent log pollution
-                // The error is already handled by N-API and reported to JavaScript
-                (void)e;  // Suppress unused variable warning
-            } catch (const std::exception& e) {
-                // Catch standard exceptions
-                (void)e;
+                Napi::Object stats = Napi::Object::New(env);
+                stats.Set("peak", Napi::Number::New(env, data->stats.peak));
+                stats.Set("rms", Napi::Number::New(env, data->stats.rms));
+                stats.Set("db", Napi::Number::New(env, data->stats.db));
+                stats.Set("volumePercent", Napi::Number::New(env, data->stats.volumePercent));
+                stats.Set("isSilence", Napi::Boolean::New(env, data->stats.isSilence));
+                stats.Set("silenceDuration", Napi::Number::New(env, data->silenceDurationMs));
+                stats.Set("sampleCount", Napi::Number::New(env, static_cast<double>(data->sampleCount)));
+                stats.Set("timestamp", Napi::Number::New(env, static_cast<double>(data->stats.timestamp)));
+                
+                jsCallback.Call({Napi::String::New(env, "stats"), stats});
             } catch (...) {
-                // Catch all other exceptions
+                // Silently ignore errors
             }
-        });
-    } else {
-        // 传统模式：复制数据到堆（保持向后兼容，use processed data）
-        auto* dataPtr = new std::vector<uint8_t>(processedData);
+        }
+        delete data;
+    });
+    
+    if (status != napi_ok) {
+        // TSFN queue full (JS stalled) - the next snapshot covers this interval too
+        delete statsData;
+        events_dropped_.fetch_add(1, std::memory_order_relaxed);
+        stats_accumulator_.Defer();
+        return;
+    }
+    stats_accumulator_.Restart();
+}
+
+// v2.12: One audio and one event TSFN over the same JS callback
+void AudioProcessor::CreateCallbacks(Napi::Env env, Napi::Function callback) {
+    tsfn_ = Napi::ThreadSafeFunction::New(
+        env,
+        callback,
+        "AudioDataCallback",
+        kAudioTsfnQueueSize,  // Audio backlog lives in the DeliveryQueue
+        1                     // Single thread
+    );
+    events_tsfn_ = Napi::ThreadSafeFunction::New(
+        env,
+        callback,
+        "AudioEventCallback",
+        kTsfnQueueSize,
+        1
+    );
+}
+
+// v2.12: Hand the processed packet to JavaScript (no further native copies)
+// Packets wait in the bounded DeliveryQueue; at most one TSFN drain call is pending
+void AudioProcessor::DeliverPacket(AudioPacket&& packet) {
+    if (!delivery_queue_->Push(DeliveryItem{std::move(packet), nullptr})) {
+        return;  // A drain is already scheduled and will pick this packet up
+    }
+    ScheduleDrain();
+}
+
+// v2.12: Queue one drain call on the audio TSFN
+void AudioProcessor::ScheduleDrain() {
+    // The drain holds its own reference so it stays valid if the processor is destroyed first
+    auto* queue = new std::shared_ptr<PacketQueue>(delivery_queue_);
+    
+    napi_status status = tsfn_.NonBlockingCall(queue, [](Napi::Env env, Napi::Function jsCallback, std::shared_ptr<PacketQueue>* data) {
+        std::shared_ptr<PacketQueue> queue = std::move(*data);
+        delete data;
         
-        // 调用 ThreadSafeFunction（异步传递数据到 JS 线程）
-        tsfn_.NonBlockingCall(dataPtr, [](Napi::Env env, Napi::Function jsCallback, std::vector<uint8_t>* data) {
+        std::deque<DeliveryItem> items;
+        queue->TakeAll(items);
+        if (env == nullptr) {
+            return;  // TSFN finalizing - packets released with the deque
+        }
+        
+        size_t next = 0;
+        while (next < items.size()) {
+            DeliveryItem& item = items[next++];
+            // v2.7.1: Wrap callback in try-catch to prevent N-API uncaught exception warnings
             try {
-                // 创建 Buffer 传递给 JS
-                Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::Copy(env, data->data(), data->size());
-                jsCallback.Call({ buffer });
+                if (item.boundary) {
+                    const bool start = item.boundary->event.type == AudioCapture::VadEvent::Type::SpeechStart;
+                    jsCallback.Call({
+                        Napi::String::New(env, start ? "speechStart" : "speechEnd"),
+                        VadEventToJS(env, item.boundary->event, item.boundary->sampleRate)
+                    });
+                } else {
+                    // Zero-copy 模式下 shared_ptr 所有权转移给 V8 finalizer；传统模式拷贝一次
+                    Napi::Value buffer = item.packet.ToJS(env);
+                    jsCallback.Call({ buffer });
+                }
             } catch (...) {
                 // Silently ignore callback errors
             }
-            delete data;  // 释放堆内存
-        });
+            if (env.IsExceptionPending()) {
+                break;  // JS callback threw - surface it
+            }
+        }
+        if (next < items.size()) {
+            // The rest of the audio is dropped; boundaries go back for the next drain
+            std::deque<DeliveryItem> boundaries;
+            size_t dropped = 0;
+            for (; next < items.size(); next++) {
+                if (items[next].boundary) {
+                    boundaries.push_back(std::move(items[next]));
+                } else {
+                    dropped++;
+                }
+            }
+            queue->CountDropped(dropped);
+            if (!boundaries.empty()) {
+                queue->Requeue(std::move(boundaries));
+            }
+        }
+    });
+    
+    if (status != napi_ok) {
+        // Not queued (TSFN closing) - packets stay queued, next push or StopCapture() retries
+        delete queue;
+        delivery_queue_->CancelDrain();
+    }
+}
+
+// v2.12: Coalesce policy - append `from` to the newest queued packet
+bool AudioProcessor::MergePackets(AudioPacket& into, AudioPacket&& from) {
+    size_t limit = coalesceMaxBytes_;
+    if (limit == 0) {
+        StreamFormat output = OutputFormat();
+        limit = static_cast<size_t>(output.sampleRate) * output.blockAlign;
+    }
+    
+    size_t total = into.size() + from.size();
+    if (total > limit) {
+        return false;  // Falls back to drop-oldest
+    }
+    if (into.Append(from.data(), from.size())) {
+        return true;
     }
+    
+    // Grow geometrically (up to the limit) so coalescing n bytes copies O(n) in total
+    size_t capacity = (std::min)(limit, (std::max)(total, 2 * into.size()));
+    AudioPacket merged = AcquirePacket(capacity);
+    if (merged.empty()) {
+        return false;
+    }
+    merged.Truncate(0);
+    merged.Append(into.data(), into.size());
+    merged.Append(from.data(), from.size());
+    into = std::move(merged);
+    return true;
 }
 
 // ====== v2.1: 动态音频会话静音控制 ======
@@ -747,13 +1814,13 @@ Napi::Value AudioProcessor::GetBlockList(const Napi::CallbackInfo& info) {
 Napi::Value AudioProcessor::GetPoolStats(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
-    if (!useExternalBuffer_) {
+    if (!useExternalBuffer_ || !buffer_pool_) {
         // Not using external buffer mode - return null
         return env.Null();
     }
     
-    // Get statistics from ExternalBufferFactory
-    auto stats = ExternalBufferFactory::Instance().GetStats();
+    // v2.12: Statistics of this capture's own pool
+    auto stats = buffer_pool_->GetStats();
     
     // Create JavaScript object with statistics
     Napi::Object result = Napi::Object::New(env);
@@ -762,6 +1829,7 @@ Napi::Value AudioProcessor::GetPoolStats(const Napi::CallbackInfo& info) {
     result.Set("dynamicAllocations", Napi::Number::New(env, stats.dynamic_allocations));
     result.Set("currentPoolSize", Napi::Number::New(env, stats.current_pool_size));
     result.Set("maxPoolSize", Napi::Number::New(env, stats.max_pool_size));
+    result.Set("bufferSize", Napi::Number::New(env, static_cast<double>(buffer_pool_->BufferSize())));
     
     // Calculate hit rate
     uint64_t total_requests = stats.pool_hits + stats.pool_misses;
@@ -772,6 +1840,122 @@ Napi::Value AudioProcessor::GetPoolStats(const Napi::CallbackInfo& info) {
     return result;
 }
 
+// ====== v2.12: Capture pipeline statistics ======
+
+Napi::Value AudioProcessor::GetPipelineStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("processingThread", Napi::Boolean::New(env, worker_ && worker_->IsRunning()));
+    
+    AudioCapture::ProcessingWorker::Stats stats = {};
+    if (worker_) {
+        stats = worker_->GetStats();
+    }
+    result.Set("queueCapacity", Napi::Number::New(env, static_cast<double>(stats.queue_capacity)));
+    result.Set("queueDepth", Napi::Number::New(env, static_cast<double>(stats.queue_depth)));
+    result.Set("queueHighWater", Napi::Number::New(env, static_cast<double>(stats.queue_high_water)));
+    result.Set("packetsSubmitted", Napi::Number::New(env, static_cast<double>(stats.packets_submitted)));
+    result.Set("packetsProcessed", Napi::Number::New(env, static_cast<double>(stats.packets_processed)));
+    result.Set("overruns", Napi::Number::New(env, static_cast<double>(stats.overruns)));
+    
+    // v2.12: JS delivery queue (backpressure)
+    auto delivery = delivery_queue_->GetStats();
+    result.Set("deliveryPolicy", Napi::String::New(env, AudioCapture::DeliveryPolicyName(delivery_queue_->GetPolicy())));
+    result.Set("deliveryQueueSize", Napi::Number::New(env, static_cast<double>(delivery.max_depth)));
+    result.Set("deliveryQueueDepth", Napi::Number::New(env, static_cast<double>(delivery.queue_depth)));
+    result.Set("deliveryQueueHighWater", Napi::Number::New(env, static_cast<double>(delivery.queue_high_water)));
+    result.Set("packetsDelivered", Napi::Number::New(env, static_cast<double>(delivery.packets_delivered)));
+    result.Set("packetsDropped", Napi::Number::New(env, static_cast<double>(delivery.packets_dropped)));
+    result.Set("packetsCoalesced", Napi::Number::New(env, static_cast<double>(delivery.packets_coalesced)));
+    result.Set("eventsDropped", Napi::Number::New(env, static_cast<double>(events_dropped_.load())));
+    
+    // v2.12: Native pause
+    result.Set("paused", Napi::Boolean::New(env, paused_.load()));
+    result.Set("streamPaused", Napi::Boolean::New(env, stream_paused_));
+    result.Set("packetsSkipped", Napi::Number::New(env, static_cast<double>(packets_skipped_.load())));
+    
+    return result;
+}
+
+// v2.12: getOutputFormat() - format of the 'data' buffers
+Napi::Value AudioProcessor::GetOutputFormat(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    StreamFormat output = OutputFormat();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("sampleRate", Napi::Number::New(env, output.sampleRate));
+    result.Set("channels", Napi::Number::New(env, output.channels));
+    result.Set("bitsPerSample", Napi::Number::New(env, output.bitsPerSample));
+    result.Set("isFloat", Napi::Boolean::New(env, output.isFloat));
+    result.Set("captureSampleRate", Napi::Number::New(env, stream_format_.sampleRate));
+    result.Set("resampling", Napi::Boolean::New(env, resampler_ != nullptr));
+    result.Set("resampleQuality", Napi::String::New(env, wasapi_capture::ResampleQualityName(resample_quality_)));
+    result.Set("format", Napi::String::New(env,
+        (output.isFloat ? "float" : "int") + std::to_string(output.bitsPerSample)));
+    result.Set("captureChannels", Napi::Number::New(env, stream_format_.channels));
+    result.Set("dither", Napi::Boolean::New(env, converter_ != nullptr && converter_->IsDithering()));
+    result.Set("preset", preset_name_.empty() ? env.Null() : Napi::Value(Napi::String::New(env, preset_name_)));
+    result.Set("frameMs", Napi::Number::New(env, frame_ms_));
+    result.Set("frameBytes", Napi::Number::New(env, static_cast<double>(frame_assembler_.FrameBytes())));
+    
+    return result;
+}
+
+// ====== v2.12: Native pause/resume ======
+
+// pause([{ stopStream: boolean }])
+// 暂停后捕获回调立即返回；stopStream 为 true 时同时停止 IAudioClient，捕获线程进入等待
+Napi::Value AudioProcessor::Pause(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    bool stopStream = false;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("stopStream") && options.Get("stopStream").IsBoolean()) {
+            stopStream = options.Get("stopStream").As<Napi::Boolean>().Value();
+        }
+    }
+    
+    paused_ = true;
+    
+    // v2.12: No further packets will retry a failed drain while paused
+    if (tsfn_ && delivery_queue_->RequestDrain()) {
+        ScheduleDrain();
+    }
+    
+    if (stopStream && !stream_paused_ && client_ && client_->IsInitialized()) {
+        if (!client_->Pause()) {
+            Napi::Error::New(env, "Failed to pause audio client").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        stream_paused_ = true;
+    }
+    
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value AudioProcessor::Resume(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (stream_paused_ && client_ && client_->IsInitialized()) {
+        if (!client_->Start()) {
+            Napi::Error::New(env, "Failed to resume audio client").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        stream_paused_ = false;
+    }
+    
+    paused_ = false;
+    
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value AudioProcessor::IsPaused(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    return Napi::Boolean::New(env, paused_.load());
+}
+
 // ====== v2.7: Audio Effects (RNNoise Denoising) ======
 
 Napi::Value AudioProcessor::SetDenoiseEnabled(const Napi::CallbackInfo& info) {
@@ -784,23 +1968,64 @@ Napi::Value AudioProcessor::SetDenoiseEnabled(const Napi::CallbackInfo& info) {
     
     bool enabled = info[0].As<Napi::Boolean>().Value();
     
-    if (enabled && !denoise_processor_) {
-        // Create denoise processor on first enable
+    // v2.12: { mode: 'per-channel' | 'downmix', sharedPool: boolean }
+    AudioCapture::DenoiseChannelMode mode = denoise_mode_;
+    bool sharedPool = denoise_shared_pool_;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object options = info[1].As<Napi::Object>();
+        if (options.Has("sharedPool") && options.Get("sharedPool").IsBoolean()) {
+            sharedPool = options.Get("sharedPool").As<Napi::Boolean>().Value();
+        }
+        if (options.Has("mode") && options.Get("mode").IsString()) {
+            std::string name = options.Get("mode").As<Napi::String>().Utf8Value();
+            if (!AudioCapture::ParseDenoiseChannelMode(name, mode)) {
+                Napi::TypeError::New(env, "mode must be 'per-channel' or 'downmix'")
+                    .ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+    }
+    
+    if (!enabled) {
+        // Disable denoising (the stage keeps its state for re-enabling)
+        denoise_enabled_ = false;
+        return env.Undefined();
+    }
+    
+    bool rebuild;
+    {
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        rebuild = !denoise_stage_ || mode != denoise_mode_ ||
+                  !denoise_stage_->Matches(stream_format_.sampleRate, stream_format_.channels);
+    }
+    
+    if (rebuild) {
+        // Create the stage outside the lock (RNNoise states and resampler filters)
+        std::unique_ptr<AudioCapture::DenoiseStage> stage;
         try {
-            denoise_processor_ = std::make_unique<AudioCapture::DenoiseProcessor>(480);
-            denoise_enabled_ = true;
+            stage = std::make_unique<AudioCapture::DenoiseStage>(
+                stream_format_.sampleRate, stream_format_.channels, mode);
         } catch (const std::exception& e) {
             Napi::Error::New(env, std::string("Failed to create denoise processor: ") + e.what())
                 .ThrowAsJavaScriptException();
             return env.Undefined();
         }
-    } else if (!enabled && denoise_processor_) {
-        // Disable denoising
-        denoise_enabled_ = false;
-    } else {
-        // Just update enabled state
-        denoise_enabled_ = enabled;
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        denoise_stage_ = std::move(stage);
+        denoise_mode_ = mode;
+    }
+    
+    // v2.12: Attach / detach the shared engine (created on first use, freed with its last stage)
+    std::shared_ptr<AudioCapture::DenoiseEngine> engine;
+    if (sharedPool) {
+        engine = AudioCapture::DenoiseEngine::Shared();
+    }
+    {
+        std::lock_guard<std::mutex> lock(denoise_mutex_);
+        denoise_stage_->SetEngine(std::move(engine));
+        denoise_shared_pool_ = sharedPool;
     }
+    denoise_enabled_ = true;
     
     return env.Undefined();
 }
@@ -814,16 +2039,39 @@ Napi::Value AudioProcessor::GetDenoiseStats(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     // Return null if denoise is not enabled or processor doesn't exist
-    if (!denoise_enabled_ || !denoise_processor_) {
+    std::lock_guard<std::mutex> lock(denoise_mutex_);
+    if (!denoise_enabled_ || !denoise_stage_) {
         return env.Null();
     }
     
     Napi::Object result = Napi::Object::New(env);
     // Use consistent naming: framesProcessed (not processedFrames) and vadProbability (not voiceProbability)
-    result.Set("framesProcessed", Napi::Number::New(env, denoise_processor_->GetProcessedFrames()));
-    result.Set("vadProbability", Napi::Number::New(env, denoise_processor_->GetLastVoiceProbability()));
-    result.Set("frameSize", Napi::Number::New(env, denoise_processor_->GetFrameSize()));
-    result.Set("enabled", Napi::Boolean::New(env, denoise_enabled_));
+    result.Set("framesProcessed", Napi::Number::New(env, denoise_stage_->GetProcessedFrames()));
+    result.Set("vadProbability", Napi::Number::New(env, denoise_stage_->GetLastVoiceProbability()));
+    result.Set("frameSize", Napi::Number::New(env, AudioCapture::DenoiseStage::kRnnoiseFrame));
+    result.Set("enabled", Napi::Boolean::New(env, denoise_enabled_.load()));
+    // v2.12: Layout of the stage
+    result.Set("mode", Napi::String::New(env, AudioCapture::DenoiseChannelModeName(denoise_stage_->GetMode())));
+    result.Set("channels", Napi::Number::New(env, denoise_stage_->GetChannels()));
+    result.Set("states", Napi::Number::New(env, static_cast<double>(denoise_stage_->GetStateCount())));
+    result.Set("sampleRate", Napi::Number::New(env, denoise_stage_->GetSampleRate()));
+    result.Set("resampling", Napi::Boolean::New(env, denoise_stage_->IsResampling()));
+    result.Set("latencyFrames", Napi::Number::New(env, static_cast<double>(denoise_stage_->GetLatencyFrames())));
+    result.Set("latencyMs", Napi::Number::New(env,
+        1000.0 * denoise_stage_->GetLatencyFrames() / denoise_stage_->GetSampleRate()));
+    result.Set("sharedPool", Napi::Boolean::New(env, denoise_stage_->GetEngine() != nullptr));
+    if (denoise_stage_->GetEngine()) {
+        // Process-wide counters (all streams on the engine)
+        AudioCapture::DenoiseEngine::Stats stats = denoise_stage_->GetEngine()->GetStats();
+        Napi::Object engine = Napi::Object::New(env);
+        engine.Set("workers", Napi::Number::New(env, static_cast<double>(stats.workers)));
+        engine.Set("batches", Napi::Number::New(env, static_cast<double>(stats.batches)));
+        engine.Set("jobs", Napi::Number::New(env, static_cast<double>(stats.jobs)));
+        engine.Set("jobsOnWorkers", Napi::Number::New(env, static_cast<double>(stats.jobs_on_workers)));
+        engine.Set("jobsHelped", Napi::Number::New(env, static_cast<double>(stats.jobs_helped)));
+        engine.Set("failures", Napi::Number::New(env, static_cast<double>(stats.failures)));
+        result.Set("engine", engine);
+    }
     
     return result;
 }
@@ -889,6 +2137,21 @@ Napi::Value AudioProcessor::SetAGCOptions(const Napi::CallbackInfo& info) {
     if (options.Has("releaseTime")) {
         agc_options.release_time_ms = options.Get("releaseTime").As<Napi::Number>().FloatValue();
     }
+    // v2.12: Look-ahead mode
+    if (options.Has("mode")) {
+        std::string mode = options.Get("mode").ToString().Utf8Value();
+        if (!wasapi_capture::ParseAGCMode(mode, agc_options.mode)) {
+            Napi::TypeError::New(env, "mode must be 'block' or 'lookahead'").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+    }
+    if (options.Has("lookaheadMs")) {
+        agc_options.lookahead_ms = options.Get("lookaheadMs").As<Napi::Number>().FloatValue();
+        if (!(agc_options.lookahead_ms >= 0.0f && agc_options.lookahead_ms <= wasapi_capture::SimpleAGC::kMaxLookaheadMs)) {
+            Napi::RangeError::New(env, "lookaheadMs must be between 0 and 50").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+    }
     
     agc_processor_->SetOptions(agc_options);
     
@@ -902,7 +2165,7 @@ Napi::Value AudioProcessor::GetAGCOptions(const Napi::CallbackInfo& info) {
         return env.Null();
     }
     
-    const auto& options = agc_processor_->GetOptions();
+    wasapi_capture::SimpleAGC::Options options = agc_processor_->GetOptions();
     
     Napi::Object result = Napi::Object::New(env);
     result.Set("targetLevel", Napi::Number::New(env, options.target_level_db));
@@ -910,6 +2173,8 @@ Napi::Value AudioProcessor::GetAGCOptions(const Napi::CallbackInfo& info) {
     result.Set("minGain", Napi::Number::New(env, options.min_gain_db));
     result.Set("attackTime", Napi::Number::New(env, options.attack_time_ms));
     result.Set("releaseTime", Napi::Number::New(env, options.release_time_ms));
+    result.Set("mode", Napi::String::New(env, wasapi_capture::AGCModeName(options.mode)));
+    result.Set("lookaheadMs", Napi::Number::New(env, options.lookahead_ms));
     
     return result;
 }
@@ -921,7 +2186,7 @@ Napi::Value AudioProcessor::GetAGCStats(const Napi::CallbackInfo& info) {
         return env.Null();
     }
     
-    auto stats = agc_processor_->GetStats();
+    wasapi_capture::SimpleAGC::Stats stats = agc_processor_->GetStats();
     
     Napi::Object result = Napi::Object::New(env);
     result.Set("enabled", Napi::Boolean::New(env, stats.enabled));
@@ -930,6 +2195,10 @@ Napi::Value AudioProcessor::GetAGCStats(const Napi::CallbackInfo& info) {
     result.Set("rmsLinear", Napi::Number::New(env, stats.rms_linear));
     result.Set("clipping", Napi::Boolean::New(env, stats.clipping));
     result.Set("framesProcessed", Napi::Number::New(env, static_cast<double>(stats.frames_processed)));
+    // v2.12: Look-ahead delay added to the capture path
+    result.Set("mode", Napi::String::New(env, wasapi_capture::AGCModeName(stats.mode)));
+    result.Set("latencyFrames", Napi::Number::New(env, stats.latency_frames));
+    result.Set("latencyMs", Napi::Number::New(env, 1000.0 * stats.latency_frames / stream_format_.sampleRate));
     
     return result;
 }
@@ -950,6 +2219,7 @@ Napi::Value AudioProcessor::SetEQEnabled(const Napi::CallbackInfo& info) {
     }
     
     bool enabled = info[0].As<Napi::Boolean>().Value();
+    std::lock_guard<std::mutex> lock(eq_mutex_);
     eq_processor_->SetEnabled(enabled);
     
     return env.Undefined();
@@ -962,6 +2232,7 @@ Napi::Value AudioProcessor::GetEQEnabled(const Napi::CallbackInfo& info) {
         return Napi::Boolean::New(env, false);
     }
     
+    std::lock_guard<std::mutex> lock(eq_mutex_);
     return Napi::Boolean::New(env, eq_processor_->IsEnabled());
 }
 
@@ -995,6 +2266,7 @@ Napi::Value AudioProcessor::SetEQBandGain(const Napi::CallbackInfo& info) {
         return env.Undefined();
     }
     
+    std::lock_guard<std::mutex> lock(eq_mutex_);
     eq_processor_->SetBandGain(band, gain);
     
     return env.Undefined();
@@ -1028,7 +2300,11 @@ Napi::Value AudioProcessor::GetEQBandGain(const Napi::CallbackInfo& info) {
         return env.Undefined();
     }
     
-    float gain = eq_processor_->GetBandGain(band);
+    float gain;
+    {
+        std::lock_guard<std::mutex> lock(eq_mutex_);
+        gain = eq_processor_->GetBandGain(band);
+    }
     
     return Napi::Number::New(env, gain);
 }
@@ -1040,7 +2316,11 @@ Napi::Value AudioProcessor::GetEQStats(const Napi::CallbackInfo& info) {
         return env.Null();
     }
     
-    auto stats = eq_processor_->GetStats();
+    wasapi_capture::ThreeBandEQ::Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(eq_mutex_);
+        stats = eq_processor_->GetStats();
+    }
     
     Napi::Object result = Napi::Object::New(env);
     result.Set("enabled", Napi::Boolean::New(env, stats.enabled));
@@ -1114,9 +2394,57 @@ Napi::Value AudioProcessor::SetSilenceThreshold(const Napi::CallbackInfo& info)
         stats_calculator_->SetSilenceThreshold(threshold);
     }
     
+    // v2.12: Streaming statistics use the same threshold
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_accumulator_.SetSilenceThreshold(threshold);
+    }
+    
     return env.Undefined();
 }
 
+// v2.12: Enable streaming statistics
+// Computed incrementally on the processing thread and emitted as 'stats' events
+Napi::Value AudioProcessor::EnableStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    uint32_t interval = 500;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("interval")) {
+            Napi::Value value = options.Get("interval");
+            if (!value.IsNumber() || value.As<Napi::Number>().DoubleValue() <= 0) {
+                Napi::RangeError::New(env, "Stats interval must be a positive number").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+            interval = value.As<Napi::Number>().Uint32Value();
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_accumulator_.SetInterval(interval);
+        stats_accumulator_.SetSilenceThreshold(stats_calculator_->GetSilenceThreshold());
+        stats_accumulator_.Reset();
+    }
+    stats_enabled_ = true;
+    
+    return Napi::Boolean::New(env, true);
+}
+
+// v2.12: Disable streaming statistics
+Napi::Value AudioProcessor::DisableStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    stats_enabled_ = false;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_accumulator_.Reset();
+    }
+    
+    return Napi::Boolean::New(env, true);
+}
+
 // v2.10 Phase 2: Get current silence threshold
 Napi::Value AudioProcessor::GetSilenceThreshold(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -1133,6 +2461,20 @@ Napi::Value AudioProcessor::GetSilenceThreshold(const Napi::CallbackInfo& info)
 // v2.11: Spectrum Analysis Methods
 // ======================================================================
 
+// v2.12: STFT hop in samples
+// Priority: hopSize > overlap > interval (one frame per interval of audio)
+int AudioProcessor::ResolveSpectrumHop(int fftSize) const {
+    if (spectrum_hop_size_ > 0) {
+        return spectrum_hop_size_;
+    }
+    if (spectrum_overlap_ >= 0.0f) {
+        float overlap = (std::min)(spectrum_overlap_, 0.95f);
+        return (std::max)(1, static_cast<int>(fftSize * (1.0f - overlap)));
+    }
+    int interval = spectrum_interval_ms_ > 0 ? spectrum_interval_ms_ : 100;
+    return (std::max)(1, static_cast<int>(static_cast<int64_t>(stream_format_.sampleRate) * interval / 1000));
+}
+
 // Enable spectrum analysis
 Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -1140,6 +2482,10 @@ Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
     try {
         // Parse options
         audio_capture::SpectrumConfig config;
+        bool soaBands = spectrum_soa_bands_;  // Only written on the JS thread
+        
+        // v2.12: Sample rate from the negotiated stream format (48000 until start())
+        config.sample_rate = static_cast<int>(stream_format_.sampleRate);
         
         if (info.Length() > 0 && info[0].IsObject()) {
             Napi::Object options = info[0].As<Napi::Object>();
@@ -1149,8 +2495,15 @@ Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
                 config.fft_size = options.Get("fftSize").As<Napi::Number>().Int32Value();
             }
             
-            // Sample rate (default to 48000 if not available)
-            config.sample_rate = 48000;  // Default sample rate
+            // v2.12: FFT mode ('real' = packed real-input FFT, 'complex' = full complex FFT)
+            if (options.Has("fftMode")) {
+                std::string mode = options.Get("fftMode").ToString().Utf8Value();
+                if (mode != "real" && mode != "complex") {
+                    Napi::TypeError::New(env, "fftMode must be 'real' or 'complex'").ThrowAsJavaScriptException();
+                    return env.Undefined();
+                }
+                config.use_real_fft = (mode == "real");
+            }
             
             // Smoothing factor
             if (options.Has("smoothing")) {
@@ -1162,6 +2515,24 @@ Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
                 spectrum_interval_ms_ = options.Get("interval").As<Napi::Number>().Int32Value();
             }
             
+            // v2.12: Band delivery layout ('objects' = array of band objects, 'soa' = typed arrays)
+            if (options.Has("bandLayout")) {
+                std::string layout = options.Get("bandLayout").ToString().Utf8Value();
+                if (layout != "objects" && layout != "soa") {
+                    Napi::TypeError::New(env, "bandLayout must be 'objects' or 'soa'").ThrowAsJavaScriptException();
+                    return env.Undefined();
+                }
+                soaBands = (layout == "soa");
+            }
+            
+            // v2.12: STFT hop (samples) or overlap (fraction of fftSize)
+            if (options.Has("hopSize")) {
+                spectrum_hop_size_ = options.Get("hopSize").As<Napi::Number>().Int32Value();
+            }
+            if (options.Has("overlap")) {
+                spectrum_overlap_ = options.Get("overlap").As<Napi::Number>().FloatValue();
+            }
+            
             // Custom frequency bands
             if (options.Has("frequencyBands") && options.Get("frequencyBands").IsArray()) {
                 Napi::Array bands = options.Get("frequencyBands").As<Napi::Array>();
@@ -1180,6 +2551,42 @@ Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
                 }
             }
             
+            // v2.12: Generated log-spaced band set (replaces frequencyBands)
+            if (options.Has("bandScale")) {
+                std::string scale = options.Get("bandScale").ToString().Utf8Value();
+                audio_capture::BandScale bandScale;
+                if (scale == "custom") {
+                    bandScale = audio_capture::BandScale::Custom;
+                } else if (scale == "third-octave") {
+                    bandScale = audio_capture::BandScale::ThirdOctave;
+                } else if (scale == "log") {
+                    bandScale = audio_capture::BandScale::Log;
+                } else if (scale == "mel") {
+                    bandScale = audio_capture::BandScale::Mel;
+                } else {
+                    Napi::TypeError::New(env, "bandScale must be 'custom', 'third-octave', 'log' or 'mel'").ThrowAsJavaScriptException();
+                    return env.Undefined();
+                }
+                
+                if (bandScale != audio_capture::BandScale::Custom) {
+                    int bandCount = options.Has("bandCount") ?
+                        options.Get("bandCount").As<Napi::Number>().Int32Value() : 64;
+                    float minFreq = options.Has("bandMinFreq") ?
+                        options.Get("bandMinFreq").As<Napi::Number>().FloatValue() : 20.0f;
+                    float maxFreq = options.Has("bandMaxFreq") ?
+                        options.Get("bandMaxFreq").As<Napi::Number>().FloatValue() : 20000.0f;
+                    maxFreq = (std::min)(maxFreq, config.sample_rate / 2.0f);
+                    
+                    config.frequency_bands = audio_capture::SpectrumAnalyzer::MakeBands(
+                        bandScale, bandCount, minFreq, maxFreq, &config.band_names);
+                    if (config.frequency_bands.empty()) {
+                        Napi::RangeError::New(env, "bandMinFreq must be below bandMaxFreq").ThrowAsJavaScriptException();
+                        return env.Undefined();
+                    }
+                }
+                config.band_scale = bandScale;
+            }
+            
             // Voice detection params
             if (options.Has("voiceDetection") && options.Get("voiceDetection").IsObject()) {
                 Napi::Object vdParams = options.Get("voiceDetection").As<Napi::Object>();
@@ -1197,9 +2604,14 @@ Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
         }
         
         // Create spectrum analyzer
-        spectrum_analyzer_ = std::make_unique<audio_capture::SpectrumAnalyzer>(config);
-        spectrum_enabled_ = true;
-        last_spectrum_time_ = std::chrono::steady_clock::now();
+        config.hop_size = ResolveSpectrumHop(config.fft_size);
+        auto analyzer = std::make_unique<audio_capture::SpectrumAnalyzer>(config);
+        {
+            std::lock_guard<std::mutex> lock(spectrum_mutex_);
+            spectrum_analyzer_ = std::move(analyzer);
+            spectrum_soa_bands_ = soaBands;
+            spectrum_enabled_ = true;
+        }
         
         return Napi::Boolean::New(env, true);
         
@@ -1213,6 +2625,7 @@ Napi::Value AudioProcessor::EnableSpectrum(const Napi::CallbackInfo& info) {
 Napi::Value AudioProcessor::DisableSpectrum(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
+    std::lock_guard<std::mutex> lock(spectrum_mutex_);
     spectrum_enabled_ = false;
     spectrum_analyzer_.reset();
     
@@ -1222,13 +2635,14 @@ Napi::Value AudioProcessor::DisableSpectrum(const Napi::CallbackInfo& info) {
 // Check if spectrum analysis is enabled
 Napi::Value AudioProcessor::IsSpectrumEnabled(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    return Napi::Boolean::New(env, spectrum_enabled_);
+    return Napi::Boolean::New(env, spectrum_enabled_.load());
 }
 
 // Set spectrum configuration
 Napi::Value AudioProcessor::SetSpectrumConfig(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
+    // v2.12: The analyzer is only created / dropped on the JS thread, so this check needs no lock
     if (!spectrum_analyzer_) {
         Napi::Error::New(env, "Spectrum analyzer not initialized").ThrowAsJavaScriptException();
         return env.Undefined();
@@ -1241,45 +2655,412 @@ Napi::Value AudioProcessor::SetSpectrumConfig(const Napi::CallbackInfo& info) {
     
     Napi::Object options = info[0].As<Napi::Object>();
     
-    // Smoothing factor
-    if (options.Has("smoothing")) {
-        float smoothing = options.Get("smoothing").As<Napi::Number>().FloatValue();
-        spectrum_analyzer_->SetSmoothingFactor(smoothing);
-    }
+    // v2.12: Read everything from JS first, then apply under spectrum_mutex_
+    bool hasSmoothing = options.Has("smoothing");
+    float smoothing = hasSmoothing ? options.Get("smoothing").As<Napi::Number>().FloatValue() : 0.0f;
     
     // Update interval
     if (options.Has("interval")) {
         spectrum_interval_ms_ = options.Get("interval").As<Napi::Number>().Int32Value();
     }
     
+    // v2.12: STFT hop / overlap
+    if (options.Has("hopSize")) {
+        spectrum_hop_size_ = options.Get("hopSize").As<Napi::Number>().Int32Value();
+    }
+    if (options.Has("overlap")) {
+        spectrum_overlap_ = options.Get("overlap").As<Napi::Number>().FloatValue();
+    }
+    bool hopChanged = options.Has("interval") || options.Has("hopSize") || options.Has("overlap");
+    
     // Voice detection params
-    if (options.Has("voiceThreshold") || options.Has("minVoiceFreq") || options.Has("maxVoiceFreq")) {
-        float threshold = options.Has("voiceThreshold") ? 
-            options.Get("voiceThreshold").As<Napi::Number>().FloatValue() : 0.3f;
-        float minFreq = options.Has("minVoiceFreq") ? 
-            options.Get("minVoiceFreq").As<Napi::Number>().FloatValue() : 300.0f;
-        float maxFreq = options.Has("maxVoiceFreq") ? 
-            options.Get("maxVoiceFreq").As<Napi::Number>().FloatValue() : 3400.0f;
-        
+    bool hasVoiceParams = options.Has("voiceThreshold") || options.Has("minVoiceFreq") || options.Has("maxVoiceFreq");
+    float threshold = options.Has("voiceThreshold") ? 
+        options.Get("voiceThreshold").As<Napi::Number>().FloatValue() : 0.3f;
+    float minFreq = options.Has("minVoiceFreq") ? 
+        options.Get("minVoiceFreq").As<Napi::Number>().FloatValue() : 300.0f;
+    float maxFreq = options.Has("maxVoiceFreq") ? 
+        options.Get("maxVoiceFreq").As<Napi::Number>().FloatValue() : 3400.0f;
+    
+    std::lock_guard<std::mutex> lock(spectrum_mutex_);
+    if (hasSmoothing) {
+        spectrum_analyzer_->SetSmoothingFactor(smoothing);
+    }
+    if (hopChanged) {
+        spectrum_analyzer_->SetHopSize(ResolveSpectrumHop(spectrum_analyzer_->GetConfig().fft_size));
+    }
+    if (hasVoiceParams) {
         spectrum_analyzer_->SetVoiceDetectionParams(threshold, minFreq, maxFreq);
     }
     
     return env.Undefined();
 }
 
+// ======================================================================
+// v2.12: Log-mel Feature Extraction
+// ======================================================================
+
+// Enable log-mel features ('features' events, optionally instead of PCM 'data')
+Napi::Value AudioProcessor::EnableFeatures(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    audio_capture::MelFeatureConfig config;
+    config.sample_rate = static_cast<int>(stream_format_.sampleRate);
+    size_t framesPerEvent = 1;
+    bool deliverAudio = true;
+    
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        
+        if (options.Has("melBins")) {
+            config.num_mel_bins = options.Get("melBins").As<Napi::Number>().Int32Value();
+            if (config.num_mel_bins < 1 || config.num_mel_bins > 256) {
+                Napi::RangeError::New(env, "melBins must be between 1 and 256").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+        if (options.Has("windowMs")) {
+            config.window_ms = options.Get("windowMs").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("hopMs")) {
+            config.hop_ms = options.Get("hopMs").As<Napi::Number>().FloatValue();
+        }
+        if (config.window_ms <= 0.0f || config.hop_ms <= 0.0f) {
+            Napi::RangeError::New(env, "windowMs and hopMs must be positive").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        if (options.Has("minFreq")) {
+            config.min_freq = options.Get("minFreq").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("maxFreq")) {
+            config.max_freq = options.Get("maxFreq").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("preemphasis")) {
+            config.preemphasis = options.Get("preemphasis").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("cmvn")) {
+            std::string cmvn = options.Get("cmvn").ToString().Utf8Value();
+            if (cmvn == "none") {
+                config.cmvn = audio_capture::CmvnMode::None;
+            } else if (cmvn == "mean") {
+                config.cmvn = audio_capture::CmvnMode::Mean;
+            } else if (cmvn == "meanvar") {
+                config.cmvn = audio_capture::CmvnMode::MeanVariance;
+            } else {
+                Napi::TypeError::New(env, "cmvn must be 'none', 'mean' or 'meanvar'").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+        if (options.Has("cmvnWindow")) {
+            config.cmvn_window = options.Get("cmvnWindow").As<Napi::Number>().Int32Value();
+        }
+        if (options.Has("framesPerEvent")) {
+            int frames = options.Get("framesPerEvent").As<Napi::Number>().Int32Value();
+            framesPerEvent = static_cast<size_t>((std::max)(1, frames));
+        }
+        if (options.Has("deliverAudio")) {
+            deliverAudio = options.Get("deliverAudio").ToBoolean().Value();
+        }
+    }
+    
+    try {
+        auto extractor = std::make_unique<audio_capture::MelFeatureExtractor>(config);
+        
+        std::lock_guard<std::mutex> lock(features_mutex_);
+        feature_extractor_ = std::move(extractor);
+        features_per_event_ = framesPerEvent;
+        feature_batch_ = AudioPacket();
+        feature_batch_frames_ = 0;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("Failed to enable features: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    
+    deliver_audio_ = deliverAudio;
+    features_enabled_ = true;
+    return Napi::Boolean::New(env, true);
+}
+
+// Disable log-mel features (PCM delivery resumes)
+Napi::Value AudioProcessor::DisableFeatures(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    features_enabled_ = false;
+    deliver_audio_ = true;
+    {
+        std::lock_guard<std::mutex> lock(features_mutex_);
+        feature_extractor_.reset();
+        feature_batch_ = AudioPacket();
+        feature_batch_frames_ = 0;
+    }
+    
+    return Napi::Boolean::New(env, true);
+}
+
+// Get log-mel feature configuration
+Napi::Value AudioProcessor::GetFeatureConfig(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, features_enabled_.load()));
+    result.Set("deliverAudio", Napi::Boolean::New(env, deliver_audio_.load()));
+    
+    std::lock_guard<std::mutex> lock(features_mutex_);
+    if (feature_extractor_) {
+        const auto& cfg = feature_extractor_->GetConfig();
+        result.Set("sampleRate", Napi::Number::New(env, cfg.sample_rate));
+        result.Set("melBins", Napi::Number::New(env, cfg.num_mel_bins));
+        result.Set("windowMs", Napi::Number::New(env, cfg.window_ms));
+        result.Set("hopMs", Napi::Number::New(env, cfg.hop_ms));
+        result.Set("windowLength", Napi::Number::New(env, static_cast<double>(feature_extractor_->GetWindowLength())));
+        result.Set("hopLength", Napi::Number::New(env, static_cast<double>(feature_extractor_->GetHopLength())));
+        result.Set("fftSize", Napi::Number::New(env, static_cast<double>(feature_extractor_->GetFFTSize())));
+        result.Set("minFreq", Napi::Number::New(env, cfg.min_freq));
+        result.Set("maxFreq", Napi::Number::New(env, cfg.max_freq));
+        result.Set("preemphasis", Napi::Number::New(env, cfg.preemphasis));
+        const char* cmvn = cfg.cmvn == audio_capture::CmvnMode::Mean ? "mean"
+                         : cfg.cmvn == audio_capture::CmvnMode::MeanVariance ? "meanvar" : "none";
+        result.Set("cmvn", Napi::String::New(env, cmvn));
+        result.Set("cmvnWindow", Napi::Number::New(env, cfg.cmvn_window));
+        result.Set("framesPerEvent", Napi::Number::New(env, static_cast<double>(features_per_event_)));
+    }
+    
+    return result;
+}
+
+// ====== v2.12: Voice activity gate ======
+
+Napi::Value AudioProcessor::EnableVad(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    AudioCapture::VadGateConfig config;
+    config.sample_rate = stream_format_.sampleRate;
+    config.channels = stream_format_.channels;
+    
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        
+        if (options.Has("threshold")) {
+            config.threshold = options.Get("threshold").As<Napi::Number>().FloatValue();
+            if (!(config.threshold >= 0.0f && config.threshold <= 1.0f)) {
+                Napi::RangeError::New(env, "threshold must be between 0 and 1").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+        
+        struct MsOption { const char* name; uint32_t* value; };
+        const MsOption msOptions[] = {
+            {"attackMs", &config.attack_ms},
+            {"hangoverMs", &config.hangover_ms},
+            {"preRollMs", &config.pre_roll_ms},
+        };
+        for (const MsOption& option : msOptions) {
+            if (!options.Has(option.name)) {
+                continue;
+            }
+            double ms = options.Get(option.name).As<Napi::Number>().DoubleValue();
+            if (!(ms >= 0.0 && ms <= 10000.0)) {
+                Napi::RangeError::New(env, std::string(option.name) + " must be between 0 and 10000")
+                    .ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+            *option.value = static_cast<uint32_t>(ms);
+        }
+        
+        if (options.Has("source")) {
+            std::string source = options.Get("source").ToString().Utf8Value();
+            if (!AudioCapture::ParseVadSource(source, config.source)) {
+                Napi::TypeError::New(env, "source must be 'auto', 'rnnoise' or 'energy'").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+        if (options.Has("energyThresholdDb")) {
+            config.energy_threshold_db = options.Get("energyThresholdDb").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("energyMarginDb")) {
+            config.energy_margin_db = options.Get("energyMarginDb").As<Napi::Number>().FloatValue();
+        }
+    }
+    
+    try {
+        auto gate = std::make_unique<AudioCapture::VadGate>(config);
+        
+        {
+            std::lock_guard<std::mutex> lock(vad_mutex_);
+            gate.swap(vad_gate_);
+        }
+        RetireVadGate(std::move(gate));  // Re-enable: the previous gate's segment still ends
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("Failed to enable VAD: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    
+    vad_enabled_ = true;
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value AudioProcessor::DisableVad(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    vad_enabled_ = false;
+    std::unique_ptr<AudioCapture::VadGate> gate;
+    {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        gate = std::move(vad_gate_);
+    }
+    RetireVadGate(std::move(gate));  // 'speechEnd' follows the segment's remaining audio
+    
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value AudioProcessor::GetVadStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    std::lock_guard<std::mutex> lock(vad_mutex_);
+    if (!vad_enabled_ || !vad_gate_) {
+        return env.Null();
+    }
+    
+    const AudioCapture::VadGateConfig& cfg = vad_gate_->GetConfig();
+    const uint64_t position = vad_gate_->GetPosition();
+    const uint64_t delivered = vad_gate_->GetFramesDelivered();
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, true));
+    result.Set("speaking", Napi::Boolean::New(env, vad_gate_->IsSpeaking()));
+    result.Set("source", Napi::String::New(env, AudioCapture::VadSourceName(cfg.source)));
+    result.Set("probability", Napi::Number::New(env, vad_gate_->GetLastProbability()));
+    result.Set("noiseFloorDb", Napi::Number::New(env, vad_gate_->GetNoiseFloorDb()));
+    result.Set("threshold", Napi::Number::New(env, cfg.threshold));
+    result.Set("attackMs", Napi::Number::New(env, cfg.attack_ms));
+    result.Set("hangoverMs", Napi::Number::New(env, cfg.hangover_ms));
+    result.Set("preRollMs", Napi::Number::New(env, cfg.pre_roll_ms));
+    result.Set("segments", Napi::Number::New(env, static_cast<double>(vad_gate_->GetSegments())));
+    result.Set("framesIn", Napi::Number::New(env, static_cast<double>(position)));
+    result.Set("framesDelivered", Napi::Number::New(env, static_cast<double>(delivered)));
+    result.Set("suppressedRatio", Napi::Number::New(env,
+        position > 0 ? 1.0 - static_cast<double>((std::min)(delivered, position)) / position : 0.0));
+    result.Set("droppedEvents", Napi::Number::New(env, static_cast<double>(vad_gate_->GetDroppedEvents())));
+    
+    return result;
+}
+
+// ====== v2.12: True-peak limiter ======
+
+Napi::Value AudioProcessor::EnableLimiter(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    wasapi_capture::LimiterConfig config;
+    {
+        std::lock_guard<std::mutex> lock(limiter_mutex_);
+        if (limiter_) {
+            config = limiter_->GetConfig();  // Options not given keep their current value
+        }
+    }
+    config.sample_rate = stream_format_.sampleRate;
+    config.channels = stream_format_.channels;
+    
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("ceilingDb")) {
+            config.ceiling_db = options.Get("ceilingDb").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("lookaheadMs")) {
+            config.lookahead_ms = options.Get("lookaheadMs").As<Napi::Number>().FloatValue();
+        }
+        if (options.Has("releaseMs")) {
+            config.release_ms = options.Get("releaseMs").As<Napi::Number>().FloatValue();
+        }
+    }
+    
+    std::unique_ptr<wasapi_capture::TruePeakLimiter> limiter;
+    try {
+        limiter = std::make_unique<wasapi_capture::TruePeakLimiter>(config);
+    } catch (const std::invalid_argument& e) {
+        Napi::RangeError::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(limiter_mutex_);
+        limiter_ = std::move(limiter);
+    }
+    limiter_enabled_ = true;
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value AudioProcessor::DisableLimiter(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    limiter_enabled_ = false;
+    // The limiter (and its options) stays for the next enableLimiter()
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value AudioProcessor::GetLimiterStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    std::lock_guard<std::mutex> lock(limiter_mutex_);
+    if (!limiter_) {
+        return env.Null();
+    }
+    
+    const wasapi_capture::LimiterConfig& cfg = limiter_->GetConfig();
+    const auto stats = limiter_->GetStats();
+    const size_t latency = limiter_->GetLatencyFrames();
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, limiter_enabled_.load()));
+    result.Set("ceilingDb", Napi::Number::New(env, cfg.ceiling_db));
+    result.Set("lookaheadMs", Napi::Number::New(env, cfg.lookahead_ms));
+    result.Set("releaseMs", Napi::Number::New(env, cfg.release_ms));
+    result.Set("latencyFrames", Napi::Number::New(env, static_cast<double>(latency)));
+    result.Set("latencyMs", Napi::Number::New(env, 1000.0 * latency / cfg.sample_rate));
+    result.Set("gainReductionDb", Napi::Number::New(env, stats.gain_reduction_db));
+    result.Set("maxGainReductionDb", Napi::Number::New(env, stats.max_gain_reduction_db));
+    result.Set("truePeakDb", Napi::Number::New(env, stats.true_peak_db));
+    result.Set("limitedFrames", Napi::Number::New(env, static_cast<double>(stats.limited_frames)));
+    result.Set("framesProcessed", Napi::Number::New(env, static_cast<double>(stats.frames_processed)));
+    result.Set("limitedRatio", Napi::Number::New(env,
+        stats.frames_processed > 0 ? static_cast<double>(stats.limited_frames) / stats.frames_processed : 0.0));
+    
+    return result;
+}
+
 // Get spectrum configuration
 Napi::Value AudioProcessor::GetSpectrumConfig(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     Napi::Object config = Napi::Object::New(env);
     
-    config.Set("enabled", Napi::Boolean::New(env, spectrum_enabled_));
+    config.Set("enabled", Napi::Boolean::New(env, spectrum_enabled_.load()));
     config.Set("interval", Napi::Number::New(env, spectrum_interval_ms_));
     
+    std::lock_guard<std::mutex> lock(spectrum_mutex_);
     if (spectrum_analyzer_) {
         const auto& cfg = spectrum_analyzer_->GetConfig();
         
         config.Set("fftSize", Napi::Number::New(env, cfg.fft_size));
+        config.Set("fftMode", Napi::String::New(env, spectrum_analyzer_->IsRealFFT() ? "real" : "complex"));
+        config.Set("hopSize", Napi::Number::New(env, spectrum_analyzer_->GetHopSize()));
+        config.Set("bandLayout", Napi::String::New(env, spectrum_soa_bands_ ? "soa" : "objects"));
+        
+        const char* bandScale = "custom";
+        switch (cfg.band_scale) {
+        case audio_capture::BandScale::ThirdOctave: bandScale = "third-octave"; break;
+        case audio_capture::BandScale::Log: bandScale = "log"; break;
+        case audio_capture::BandScale::Mel: bandScale = "mel"; break;
+        default: break;
+        }
+        config.Set("bandScale", Napi::String::New(env, bandScale));
+        
+        // v2.12: Band names (for the 'soa' layout, which omits them per frame)
+        const auto& names = spectrum_analyzer_->GetBandLayout()->names;
+        Napi::Array bandNames = Napi::Array::New(env, names.size());
+        for (size_t i = 0; i < names.size(); i++) {
+            bandNames.Set(static_cast<uint32_t>(i), Napi::String::New(env, names[i]));
+        }
+        config.Set("bandNames", bandNames);
         config.Set("sampleRate", Napi::Number::New(env, cfg.sample_rate));
         config.Set("smoothing", Napi::Number::New(env, cfg.smoothing));
         
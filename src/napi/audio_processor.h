@@ -5,11 +5,23 @@
 #include "../wasapi/capture_thread.h"
 #include "../wasapi/audio_client.h"
 #include "external_buffer.h"
+#include "audio_packet.h"   // v2.12: Single-copy capture path
+#include "processing_worker.h"  // v2.12: Capture/processing thread split
+#include "delivery_queue.h"     // v2.12: Bounded JS delivery queue
 #include "audio_effects.h"  // v2.7: Audio effects (RNNoise)
 #include "agc_processor.h"  // v2.8: AGC (Automatic Gain Control)
 #include "eq_processor.h"   // v2.8: 3-Band EQ
+#include "true_peak_limiter.h"  // v2.12: True-peak limiter
 #include "audio_stats_calculator.h"  // v2.10 Phase 2: Audio statistics
 #include "spectrum_analyzer.h"        // v2.11: Spectrum analysis
+#include "streaming_stats.h"          // v2.12: Native streaming statistics
+#include "mel_features.h"             // v2.12: Log-mel ASR features
+#include "polyphase_resampler.h"       // v2.12: Native output sample rate
+#include "format_converter.h"          // v2.12: Native output sample format / channels
+#include "frame_assembler.h"           // v2.12: Fixed-size output frames
+#include "asr_presets.h"              // v2.12: ASR output presets
+#include "vad_gate.h"                 // v2.12: Voice activity gate
+#include <mutex>
 
 class AudioProcessor : public Napi::ObjectWrap<AudioProcessor> {
 public:
@@ -22,24 +34,46 @@ private:
     std::unique_ptr<CaptureThread> thread_;
     DWORD processId_ = 0;
     std::string deviceId_;  // v2.9.0: 设备 ID（支持麦克风捕获）
-    Napi::ThreadSafeFunction tsfn_;
+    Napi::ThreadSafeFunction tsfn_;         // Audio packets (DeliveryQueue drains)
+    Napi::ThreadSafeFunction events_tsfn_;  // v2.12: Spectrum / stats / features / VAD events
     bool comInitialized_ = false;
     bool useExternalBuffer_ = false;  // Zero-copy 模式开关
     
     // v2.7: Audio effects
-    std::unique_ptr<AudioCapture::DenoiseProcessor> denoise_processor_;
-    bool denoise_enabled_ = false;
+    // v2.12: Per-channel stage for the negotiated format (replaces the mono
+    // DenoiseProcessor that was fed interleaved samples); guarded by denoise_mutex_
+    std::unique_ptr<AudioCapture::DenoiseStage> denoise_stage_;
+    AudioCapture::DenoiseChannelMode denoise_mode_ = AudioCapture::DenoiseChannelMode::PerChannel;
+    std::atomic<bool> denoise_enabled_{false};
+    std::mutex denoise_mutex_;
+    bool denoise_shared_pool_ = false;  // v2.12: States run on the process-wide DenoiseEngine
     
     // v2.8: AGC (Automatic Gain Control)
+    // v2.12: Configured from JS while the processing thread runs it; SimpleAGC stages
+    // options and publishes stats itself, so no lock is taken on the processing thread
     std::unique_ptr<wasapi_capture::SimpleAGC> agc_processor_;
     
     // v2.8: 3-Band EQ
+    // v2.12: Guarded by eq_mutex_ (same reason)
     std::unique_ptr<wasapi_capture::ThreeBandEQ> eq_processor_;
+    std::mutex eq_mutex_;
+    
+    // v2.12: True-peak limiter, last effect in the chain; guarded by limiter_mutex_
+    std::unique_ptr<wasapi_capture::TruePeakLimiter> limiter_;
+    std::atomic<bool> limiter_enabled_{false};
+    std::mutex limiter_mutex_;
     
     // v2.7: Buffer pool adaptive optimization
     bool useAdaptivePool_ = false;  // Adaptive pool strategy enabled
     std::chrono::steady_clock::time_point last_pool_eval_time_;  // Last evaluation time
     
+    // v2.12: Per-instance buffer pool (replaces the ExternalBufferFactory singleton)
+    std::unique_ptr<AudioCapture::BufferPool> buffer_pool_;
+    size_t pool_size_ = 100;
+    size_t pool_min_size_ = 50;
+    size_t pool_max_size_ = 200;
+    void CreateBufferPool(size_t bufferSize);
+    
     // N-API 方法声明
     Napi::Value Start(const Napi::CallbackInfo& info);
     Napi::Value Stop(const Napi::CallbackInfo& info);
@@ -83,6 +117,21 @@ private:
     Napi::Value SetSilenceThreshold(const Napi::CallbackInfo& info);
     Napi::Value GetSilenceThreshold(const Napi::CallbackInfo& info);
     
+    // v2.12: Streaming statistics ('stats' events from the processing thread)
+    Napi::Value EnableStats(const Napi::CallbackInfo& info);
+    Napi::Value DisableStats(const Napi::CallbackInfo& info);
+    
+    // v2.12: Capture pipeline statistics
+    Napi::Value GetPipelineStats(const Napi::CallbackInfo& info);
+    
+    // v2.12: Format of the delivered audio (after the native output stage)
+    Napi::Value GetOutputFormat(const Napi::CallbackInfo& info);
+    
+    // v2.12: Native pause/resume (skips the whole pipeline while paused)
+    Napi::Value Pause(const Napi::CallbackInfo& info);
+    Napi::Value Resume(const Napi::CallbackInfo& info);
+    Napi::Value IsPaused(const Napi::CallbackInfo& info);
+    
     // v2.11: Spectrum analysis
     Napi::Value EnableSpectrum(const Napi::CallbackInfo& info);
     Napi::Value DisableSpectrum(const Napi::CallbackInfo& info);
@@ -90,18 +139,163 @@ private:
     Napi::Value SetSpectrumConfig(const Napi::CallbackInfo& info);
     Napi::Value GetSpectrumConfig(const Napi::CallbackInfo& info);
     
+    // v2.12: Log-mel feature extraction ('features' events)
+    Napi::Value EnableFeatures(const Napi::CallbackInfo& info);
+    Napi::Value DisableFeatures(const Napi::CallbackInfo& info);
+    Napi::Value GetFeatureConfig(const Napi::CallbackInfo& info);
+    
+    // v2.12: Voice activity gate ('speechStart' / 'speechEnd' events)
+    Napi::Value EnableVad(const Napi::CallbackInfo& info);
+    Napi::Value DisableVad(const Napi::CallbackInfo& info);
+    Napi::Value GetVadStats(const Napi::CallbackInfo& info);
+    
+    // v2.12: True-peak limiter
+    Napi::Value EnableLimiter(const Napi::CallbackInfo& info);
+    Napi::Value DisableLimiter(const Napi::CallbackInfo& info);
+    Napi::Value GetLimiterStats(const Napi::CallbackInfo& info);
+    
     // v2.10 Phase 2: Audio statistics calculator with configurable threshold
     std::unique_ptr<wasapi_capture::AudioStatsCalculator> stats_calculator_;
     
+    // v2.12: Streaming statistics accumulator (guarded by stats_mutex_)
+    wasapi_capture::StreamingStatsAccumulator stats_accumulator_;
+    std::atomic<bool> stats_enabled_{false};
+    std::mutex stats_mutex_;
+    
     // v2.11: Spectrum analyzer
+    // v2.12: Analyzer, frame pool and band layout are guarded by spectrum_mutex_
     std::unique_ptr<audio_capture::SpectrumAnalyzer> spectrum_analyzer_;
-    bool spectrum_enabled_ = false;
+    std::atomic<bool> spectrum_enabled_{false};
+    std::mutex spectrum_mutex_;
     int spectrum_interval_ms_ = 100;  // 频谱更新间隔（毫秒）
-    std::chrono::steady_clock::time_point last_spectrum_time_;
+    int spectrum_hop_size_ = 0;       // v2.12: STFT hop in samples (0 = derived)
+    float spectrum_overlap_ = -1.0f;  // v2.12: STFT overlap 0-0.95 (< 0 = unset)
+    
+    int ResolveSpectrumHop(int fftSize) const;
+    
+    // v2.12: Recycled spectrum frames (processing thread acquires, JS thread releases)
+    static constexpr size_t kSpectrumFramePoolSize = 16;
+    std::shared_ptr<audio_capture::SpectrumFramePool> spectrum_pool_;
+    bool spectrum_soa_bands_ = false;  // v2.12: Deliver bands as Float32Arrays
+    
+    // v2.12: Log-mel features (extractor and batch guarded by features_mutex_)
+    std::unique_ptr<audio_capture::MelFeatureExtractor> feature_extractor_;
+    std::atomic<bool> features_enabled_{false};
+    std::mutex features_mutex_;
+    size_t features_per_event_ = 1;           // Frames per 'features' event
+    AudioCapture::AudioPacket feature_batch_;  // Frames waiting for delivery
+    size_t feature_batch_frames_ = 0;
+    uint64_t feature_batch_position_ = 0;     // Stream position after the last frame
+    std::atomic<bool> deliver_audio_{true};   // false: 'features' instead of PCM
+    
+    // v2.12: Voice activity gate (gate guarded by vad_mutex_, scratch on the processing thread)
+    std::unique_ptr<AudioCapture::VadGate> vad_gate_;
+    std::atomic<bool> vad_enabled_{false};
+    std::mutex vad_mutex_;
+    std::vector<float> gate_scratch_;                  // Gated capture-rate frames (grow-only)
+    // Gate removed by disableVad() while capturing; the processing thread flushes the
+    // segment tail, then closes it (handed over under vad_mutex_)
+    std::unique_ptr<AudioCapture::VadGate> closing_vad_gate_;
+    std::atomic<bool> vad_close_pending_{false};
     
     // 静态方法：设备枚举
     static Napi::Value GetDeviceInfo(const Napi::CallbackInfo& info);
     
+    // v2.12: Negotiated stream format (cached from AudioClient after Start())
+    StreamFormat stream_format_;
+    
+    // v2.12: Native output stage - resample / convert the processed Float32 stream before delivery
+    uint32_t output_sample_rate_ = 0;  // 0 = capture rate
+    wasapi_capture::ResampleQuality resample_quality_ = wasapi_capture::ResampleQuality::Balanced;
+    std::unique_ptr<wasapi_capture::PolyphaseResampler> resampler_;  // Created in Start()
+    wasapi_capture::FormatConverterConfig converter_config_;         // input_channels set in Start()
+    std::unique_ptr<wasapi_capture::FormatConverter> downmixer_;     // Channel mix ahead of the resampler
+    std::unique_ptr<wasapi_capture::FormatConverter> converter_;     // Final format (after the resampler)
+    std::vector<uint8_t> capture_scratch_;  // Capture-rate samples (processing thread, grow-only)
+    std::vector<float> mix_scratch_;        // Downmixed samples ahead of the resampler (grow-only)
+    std::vector<float> resample_scratch_;   // Resampler output ahead of the converter (grow-only)
+    std::vector<uint8_t> output_scratch_;   // Output stage result ahead of the frame assembler (grow-only)
+    
+    // v2.12: Fixed-size frames (ASR presets / frameMs); replaces batching when enabled
+    std::string preset_name_;               // Empty = no preset
+    uint32_t frame_ms_ = 0;                 // 0 = packet-sized delivery
+    AudioCapture::FrameAssembler<AudioCapture::AudioPacket> frame_assembler_;  // Processing thread
+    
+    void ConfigureOutputStage();
+    StreamFormat OutputFormat() const;
+    size_t RunOutputStage(const float* samples, size_t frameCount, uint8_t* dest);
+    
+    // v2.12: Processing thread (capture thread only copies into an SPSC ring)
+    std::unique_ptr<AudioCapture::ProcessingWorker> worker_;
+    bool useProcessingThread_ = true;
+    size_t processingQueueSize_ = 64;  // Ring slots
+    
+    void StartProcessingWorker();
+    void StopProcessingWorker();
+    
+    // v2.12: Bounded delivery queue (backpressure against a stalled JS event loop).
+    // Speech boundaries travel in-band so that they reach JS in order with the audio;
+    // they are pinned (never dropped or merged).
+    struct VadBoundary {
+        AudioCapture::VadEvent event;
+        uint32_t sampleRate;
+    };
+    struct DeliveryItem {
+        AudioCapture::AudioPacket packet;
+        std::unique_ptr<VadBoundary> boundary;  // Set: 'speechStart'/'speechEnd', no audio
+    };
+    using PacketQueue = AudioCapture::DeliveryQueue<DeliveryItem>;
+    std::shared_ptr<PacketQueue> delivery_queue_;
+    size_t coalesceMaxBytes_ = 0;  // 0 = one second of audio in the stream format
+    std::atomic<uint64_t> events_dropped_{0};  // Non-audio TSFN events rejected (queue full)
+    
+    bool MergePackets(AudioCapture::AudioPacket& into, AudioCapture::AudioPacket&& from);
+    void CreateCallbacks(Napi::Env env, Napi::Function callback);
+    void ScheduleDrain();
+    
+    // v2.12: Batched delivery (several WASAPI packets per JS callback)
+    uint32_t deliveryIntervalMs_ = 0;   // 0 = no time-based batching
+    size_t minBytesPerCallback_ = 0;    // 0 = no size-based batching
+    size_t batch_target_bytes_ = 0;     // Flush threshold for the current stream format (0 = off)
+    size_t batch_capacity_ = 0;         // Batch packet size (target + headroom)
+    AudioCapture::AudioPacket batch_;   // Packet being filled (processing thread only)
+    size_t batch_fill_ = 0;
+    std::chrono::steady_clock::time_point batch_start_time_;
+    
+    void ConfigureBatching();
+    void FlushBatch();
+    
+    // v2.12: Native pause state
+    std::atomic<bool> paused_{false};
+    bool stream_paused_ = false;                // IAudioClient stopped by Pause()
+    std::atomic<uint64_t> packets_skipped_{0};  // Packets discarded while paused
+    
     // 音频数据回调（从捕获线程调用）
-    void OnAudioData(const std::vector<uint8_t>& data);
+    void OnAudioData(const uint8_t* data, size_t size, const StreamFormat& format);
+    
+    // v2.12: Where processed audio goes (decided once per packet)
+    struct DeliveryMode {
+        bool deliverAudio;
+        bool framing;
+        bool batching;
+    };
+    uint8_t* AcquireOutput(size_t outputBytes, const DeliveryMode& mode, AudioCapture::AudioPacket& packet);
+    void CommitOutput(uint8_t* dest, size_t deliveredBytes, const DeliveryMode& mode, AudioCapture::AudioPacket& packet);
+    void RunChain(uint8_t* work, size_t size, size_t frameCount, const StreamFormat& format);
+    void ProcessGated(const uint8_t* data, size_t size, const StreamFormat& format, const DeliveryMode& mode);
+    void DeliverGated(const float* samples, size_t frames, const StreamFormat& format, const DeliveryMode& mode);
+    void QueueVadBoundary(const AudioCapture::VadEvent& event, uint32_t sampleRate);
+    void CloseVadGate(AudioCapture::VadGate& gate);
+    void RetireVadGate(std::unique_ptr<AudioCapture::VadGate> gate);
+    void FinishVadClose();
+    
+    // v2.12: Single-copy pipeline stages (operate in place on the output packet)
+    AudioCapture::AudioPacket AcquirePacket(size_t size);
+    void ApplyEffects(float* samples, size_t frameCount, const StreamFormat& format);
+    void AnalyzeSpectrum(const float* samples, size_t frameCount, uint16_t channels);
+    void EmitSpectrum(const audio_capture::SpectrumResult& result);  // spectrum_mutex_ held
+    void ExtractFeatures(const float* samples, size_t frameCount, uint16_t channels);
+    void FlushFeatures();
+    void AccumulateStats(const uint8_t* data, size_t size, const StreamFormat& format);
+    void DeliverPacket(AudioCapture::AudioPacket&& packet);
 };
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <algorithm>
 #include <chrono>
+#include "audio_level_kernels.h"  // v2.12: Fused SIMD peak/RMS
 
 // Prevent Windows.h min/max macro conflicts
 #ifdef min
@@ -61,114 +62,79 @@ public:
     /**
      * Calculate audio statistics from Float32 PCM samples
      * 
+     * v2.12: Peak and RMS come from one fused SIMD pass (MeasureLevels)
+     * 
      * @param samples - Float32 PCM samples (-1.0 to 1.0)
      * @param numSamples - Number of samples
      * @return AudioStats structure with calculated values
      */
     AudioStats Calculate(const float* samples, size_t numSamples) {
-        AudioStats stats = {};
-        
         if (!samples || numSamples == 0) {
-            stats.timestamp = GetCurrentTimestamp();
-            stats.db = -INFINITY;
-            stats.isSilence = true;
-            return stats;
-        }
-        
-        // 1. Calculate Peak (maximum absolute amplitude)
-        float maxAbsValue = 0.0f;
-        for (size_t i = 0; i < numSamples; i++) {
-            float absValue = std::abs(samples[i]);
-            if (absValue > maxAbsValue) {
-                maxAbsValue = absValue;
-            }
-        }
-        stats.peak = std::min(maxAbsValue, 1.0f);  // Clamp to [0, 1]
-        
-        // 2. Calculate RMS (Root Mean Square)
-        double sumSquares = 0.0;
-        for (size_t i = 0; i < numSamples; i++) {
-            sumSquares += static_cast<double>(samples[i]) * static_cast<double>(samples[i]);
+            return EmptyStats();
         }
-        stats.rms = std::min(static_cast<float>(std::sqrt(sumSquares / numSamples)), 1.0f);
-        
-        // 3. Calculate dB (Decibel, reference level = 1.0)
-        const float kMinRMS = 1e-10f;  // -200 dB
-        if (stats.rms > kMinRMS) {
-            stats.db = 20.0f * std::log10(stats.rms);
-        } else {
-            stats.db = -200.0f;  // Practical minimum
-        }
-        
-        // 4. Calculate volume percentage (0 - 100%)
-        stats.volumePercent = stats.rms * 100.0f;
-        
-        // 5. Detect silence (Phase 2: use configurable threshold)
-        stats.isSilence = (stats.rms < silenceThreshold_);
-        
-        // 6. Timestamp
-        stats.timestamp = GetCurrentTimestamp();
-        
-        return stats;
+        return FromLevels(MeasureLevels(samples, numSamples), numSamples);
     }
     
     /**
      * Calculate audio statistics from Int16 PCM samples
      * 
+     * v2.12: Integer SIMD pass; sum of squares is exact before scaling
+     * 
      * @param samples - Int16 PCM samples (-32768 to 32767)
      * @param numSamples - Number of samples
      * @return AudioStats structure with calculated values
      */
     AudioStats Calculate(const int16_t* samples, size_t numSamples) {
-        AudioStats stats = {};
-        
         if (!samples || numSamples == 0) {
-            stats.timestamp = GetCurrentTimestamp();
-            stats.db = -INFINITY;
-            stats.isSilence = true;
-            return stats;
+            return EmptyStats();
         }
+        return FromLevels(MeasureLevels(samples, numSamples), numSamples);
+    }
+
+    /**
+     * v2.12: Build statistics from accumulated peak / sum of squares
+     * 
+     * @param levels - Peak and sum of squares (Float32 scale)
+     * @param numSamples - Number of samples the sums cover
+     */
+    AudioStats FromLevels(const LevelSums& levels, size_t numSamples) const {
+        AudioStats stats = {};
         
-        // Convert Int16 to Float32 range and calculate
-        const float kInt16ToFloat = 1.0f / 32768.0f;
-        
-        // 1. Calculate Peak
-        int16_t maxAbsValue = 0;
-        for (size_t i = 0; i < numSamples; i++) {
-            int16_t absValue = std::abs(samples[i]);
-            if (absValue > maxAbsValue) {
-                maxAbsValue = absValue;
-            }
-        }
-        stats.peak = std::min(maxAbsValue * kInt16ToFloat, 1.0f);
+        // 1. Peak (maximum absolute amplitude)
+        stats.peak = std::min(levels.peak, 1.0f);  // Clamp to [0, 1]
         
-        // 2. Calculate RMS
-        double sumSquares = 0.0;
-        for (size_t i = 0; i < numSamples; i++) {
-            double normalized = samples[i] * kInt16ToFloat;
-            sumSquares += normalized * normalized;
-        }
-        stats.rms = std::min(static_cast<float>(std::sqrt(sumSquares / numSamples)), 1.0f);
+        // 2. RMS (Root Mean Square)
+        stats.rms = std::min(static_cast<float>(std::sqrt(levels.sumSquares / numSamples)), 1.0f);
         
-        // 3-6. Same as Float32 version
-        const float kMinRMS = 1e-10f;
+        // 3. Calculate dB (Decibel, reference level = 1.0)
+        const float kMinRMS = 1e-10f;  // -200 dB
         if (stats.rms > kMinRMS) {
             stats.db = 20.0f * std::log10(stats.rms);
         } else {
-            stats.db = -200.0f;
+            stats.db = -200.0f;  // Practical minimum
         }
         
+        // 4. Calculate volume percentage (0 - 100%)
         stats.volumePercent = stats.rms * 100.0f;
         
-        // Phase 2: use configurable threshold
+        // 5. Detect silence (Phase 2: use configurable threshold)
         stats.isSilence = (stats.rms < silenceThreshold_);
         
+        // 6. Timestamp
         stats.timestamp = GetCurrentTimestamp();
         
         return stats;
     }
 
 private:
+    AudioStats EmptyStats() const {
+        AudioStats stats = {};
+        stats.timestamp = GetCurrentTimestamp();
+        stats.db = -INFINITY;
+        stats.isSilence = true;
+        return stats;
+    }
+
     int64_t GetCurrentTimestamp() const {
         using namespace std::chrono;
         auto now = system_clock::now();
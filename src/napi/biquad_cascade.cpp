@@ -0,0 +1,357 @@
+/**
+ * Biquad Cascade Implementation
+ */
+
+#include "biquad_cascade.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(AUDIO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace wasapi_capture {
+
+namespace biquad_kernels {
+
+// Section layout (floats from the start of the section):
+//   coeffs: b0 [0, 8)  b1 [8, 16)  b2 [16, 24)  a1 [24, 32)  a2 [32, 40)
+//   state:  z1 [0, 8)  z2 [8, 16)
+// Lane c belongs to channel c.
+
+// ========== Scalar (reference) ==========
+
+void CascadeMonoBlock(float* samples, size_t frames, size_t stride,
+                      const float* coeffs, float* state, size_t sections) {
+    // One section over the whole block, then the next: coefficients and
+    // state live in registers and the loop carries only z1 / z2
+    for (size_t s = 0; s < sections; s++) {
+        const float* c = coeffs + s * kCoeffStride;
+        float* z = state + s * kStateStride;
+        const float b0 = c[0], b1 = c[8], b2 = c[16], a1 = c[24], a2 = c[32];
+        float z1 = z[0];
+        float z2 = z[8];
+        for (size_t f = 0; f < frames; f++) {
+            const float x = samples[f * stride];
+            const float y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            samples[f * stride] = y;
+        }
+        z[0] = z1;
+        z[8] = z2;
+    }
+}
+
+void CascadeScalar(float* samples, size_t frames, size_t channels, size_t stride,
+                   const float* coeffs, float* state, size_t sections) {
+    if (channels == 1) {
+        // Same arithmetic per sample as the loop below, in section-major order
+        CascadeMonoBlock(samples, frames, stride, coeffs, state, sections);
+        return;
+    }
+    for (size_t f = 0; f < frames; f++) {
+        float* frame = samples + f * stride;
+        for (size_t ch = 0; ch < channels; ch++) {
+            float x = frame[ch];
+            for (size_t s = 0; s < sections; s++) {
+                const float* c = coeffs + s * kCoeffStride + ch;
+                float* z = state + s * kStateStride + ch;
+                const float y = c[0] * x + z[0];
+                z[0] = c[8] * x - c[24] * y + z[8];
+                z[8] = c[16] * x - c[32] * y;
+                x = y;
+            }
+            frame[ch] = x;
+        }
+    }
+}
+
+#if defined(AUDIO_SIMD_X86)
+
+// ========== SSE2 ==========
+
+namespace {
+
+// One section for four lanes; c and z point at the first lane
+inline __m128 SectionSse2(__m128 x, const float* c, float* z) {
+    const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(c), x), _mm_loadu_ps(z));
+    const __m128 z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(c + 8), x),
+                                            _mm_mul_ps(_mm_loadu_ps(c + 24), y)),
+                                 _mm_loadu_ps(z + 8));
+    const __m128 z2 = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(c + 16), x),
+                                 _mm_mul_ps(_mm_loadu_ps(c + 32), y));
+    _mm_storeu_ps(z, z1);
+    _mm_storeu_ps(z + 8, z2);
+    return y;
+}
+
+}  // namespace
+
+void CascadeSse2(float* samples, size_t frames, size_t channels, size_t stride,
+                 const float* coeffs, float* state, size_t sections) {
+    if (channels == 1) {
+        CascadeMonoBlock(samples, frames, stride, coeffs, state, sections);
+        return;
+    }
+    const bool two_groups = channels > 4;
+    alignas(16) float lanes[8] = {};  // Staging for 3, 5, 6 and 7 channels
+
+    for (size_t f = 0; f < frames; f++) {
+        float* frame = samples + f * stride;
+        __m128 x0;
+        __m128 x1 = _mm_setzero_ps();
+        if (channels == 2) {
+            x0 = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(frame)));  // Frames are only 4-byte aligned
+        } else if (channels == 4) {
+            x0 = _mm_loadu_ps(frame);
+        } else if (channels == 8) {
+            x0 = _mm_loadu_ps(frame);
+            x1 = _mm_loadu_ps(frame + 4);
+        } else {
+            std::memcpy(lanes, frame, channels * sizeof(float));
+            x0 = _mm_load_ps(lanes);
+            x1 = _mm_load_ps(lanes + 4);
+        }
+
+        const float* c = coeffs;
+        float* z = state;
+        for (size_t s = 0; s < sections; s++, c += kCoeffStride, z += kStateStride) {
+            x0 = SectionSse2(x0, c, z);
+            if (two_groups) {
+                x1 = SectionSse2(x1, c + 4, z + 4);
+            }
+        }
+
+        if (channels == 2) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(frame), _mm_castps_si128(x0));
+        } else if (channels == 4) {
+            _mm_storeu_ps(frame, x0);
+        } else if (channels == 8) {
+            _mm_storeu_ps(frame, x0);
+            _mm_storeu_ps(frame + 4, x1);
+        } else {
+            _mm_store_ps(lanes, x0);
+            _mm_store_ps(lanes + 4, x1);
+            std::memcpy(frame, lanes, channels * sizeof(float));
+        }
+    }
+}
+
+// ========== AVX2 ==========
+
+namespace {
+
+// lanes [8 - n, 16 - n) enable the first n lanes
+alignas(32) const int32_t kLaneMask[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+}  // namespace
+
+AUDIO_TARGET_AVX2
+void CascadeAvx2(float* samples, size_t frames, size_t channels, size_t stride,
+                 const float* coeffs, float* state, size_t sections) {
+    if (channels <= 4) {
+        CascadeSse2(samples, frames, channels, stride, coeffs, state, sections);  // One SSE group
+        return;
+    }
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kLaneMask + 8 - channels));
+    const bool full = channels == 8;
+
+    for (size_t f = 0; f < frames; f++) {
+        float* frame = samples + f * stride;
+        __m256 x = full ? _mm256_loadu_ps(frame) : _mm256_maskload_ps(frame, mask);
+
+        const float* c = coeffs;
+        float* z = state;
+        for (size_t s = 0; s < sections; s++, c += kCoeffStride, z += kStateStride) {
+            const __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(c), x), _mm256_loadu_ps(z));
+            const __m256 z1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(c + 8), x),
+                                                          _mm256_mul_ps(_mm256_loadu_ps(c + 24), y)),
+                                            _mm256_loadu_ps(z + 8));
+            const __m256 z2 = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(c + 16), x),
+                                            _mm256_mul_ps(_mm256_loadu_ps(c + 32), y));
+            _mm256_storeu_ps(z, z1);
+            _mm256_storeu_ps(z + 8, z2);
+            x = y;
+        }
+
+        if (full) {
+            _mm256_storeu_ps(frame, x);
+        } else {
+            _mm256_maskstore_ps(frame, mask, x);
+        }
+    }
+}
+
+#endif  // AUDIO_SIMD_X86
+
+#if defined(AUDIO_SIMD_NEON)
+
+// ========== NEON ==========
+
+namespace {
+
+inline float32x4_t SectionNeon(float32x4_t x, const float* c, float* z) {
+    const float32x4_t y = vaddq_f32(vmulq_f32(vld1q_f32(c), x), vld1q_f32(z));
+    const float32x4_t z1 = vaddq_f32(vsubq_f32(vmulq_f32(vld1q_f32(c + 8), x),
+                                               vmulq_f32(vld1q_f32(c + 24), y)),
+                                     vld1q_f32(z + 8));
+    const float32x4_t z2 = vsubq_f32(vmulq_f32(vld1q_f32(c + 16), x),
+                                     vmulq_f32(vld1q_f32(c + 32), y));
+    vst1q_f32(z, z1);
+    vst1q_f32(z + 8, z2);
+    return y;
+}
+
+}  // namespace
+
+void CascadeNeon(float* samples, size_t frames, size_t channels, size_t stride,
+                 const float* coeffs, float* state, size_t sections) {
+    if (channels == 1) {
+        CascadeMonoBlock(samples, frames, stride, coeffs, state, sections);
+        return;
+    }
+    const bool two_groups = channels > 4;
+    alignas(16) float lanes[8] = {};
+
+    for (size_t f = 0; f < frames; f++) {
+        float* frame = samples + f * stride;
+        float32x4_t x0;
+        float32x4_t x1 = vdupq_n_f32(0.0f);
+        if (channels == 2) {
+            x0 = vcombine_f32(vld1_f32(frame), vdup_n_f32(0.0f));
+        } else if (channels == 4) {
+            x0 = vld1q_f32(frame);
+        } else if (channels == 8) {
+            x0 = vld1q_f32(frame);
+            x1 = vld1q_f32(frame + 4);
+        } else {
+            std::memcpy(lanes, frame, channels * sizeof(float));
+            x0 = vld1q_f32(lanes);
+            x1 = vld1q_f32(lanes + 4);
+        }
+
+        const float* c = coeffs;
+        float* z = state;
+        for (size_t s = 0; s < sections; s++, c += kCoeffStride, z += kStateStride) {
+            x0 = SectionNeon(x0, c, z);
+            if (two_groups) {
+                x1 = SectionNeon(x1, c + 4, z + 4);
+            }
+        }
+
+        if (channels == 2) {
+            vst1_f32(frame, vget_low_f32(x0));
+        } else if (channels == 4) {
+            vst1q_f32(frame, x0);
+        } else if (channels == 8) {
+            vst1q_f32(frame, x0);
+            vst1q_f32(frame + 4, x1);
+        } else {
+            vst1q_f32(lanes, x0);
+            vst1q_f32(lanes + 4, x1);
+            std::memcpy(frame, lanes, channels * sizeof(float));
+        }
+    }
+}
+
+#endif  // AUDIO_SIMD_NEON
+
+}  // namespace biquad_kernels
+
+// ========== Dispatch ==========
+
+namespace {
+
+using CascadeFn = void (*)(float*, size_t, size_t, size_t, const float*, float*, size_t);
+
+struct BiquadKernelTable {
+    SimdLevel level;
+    CascadeFn cascade;
+};
+
+BiquadKernelTable SelectKernels() {
+    using namespace biquad_kernels;
+    switch (GetBestSimdLevel()) {
+#if defined(AUDIO_SIMD_X86)
+        case SimdLevel::AVX2:
+            return {SimdLevel::AVX2, &CascadeAvx2};
+        case SimdLevel::SSE2:
+            return {SimdLevel::SSE2, &CascadeSse2};
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        case SimdLevel::NEON:
+            return {SimdLevel::NEON, &CascadeNeon};
+#endif
+        default:
+            return {SimdLevel::Scalar, &CascadeScalar};
+    }
+}
+
+const BiquadKernelTable& Kernels() {
+    static const BiquadKernelTable table = SelectKernels();
+    return table;
+}
+
+}  // namespace
+
+SimdLevel GetBiquadKernel() {
+    return Kernels().level;
+}
+
+// ========== BiquadCascade ==========
+
+BiquadCascade::BiquadCascade(size_t sections, size_t channels)
+    : sections_(sections), channels_(channels) {
+    if (sections == 0) {
+        throw std::invalid_argument("Biquad cascade needs at least one section");
+    }
+    if (channels == 0 || channels > kMaxChannels) {
+        throw std::invalid_argument("Biquad cascade supports 1-8 channels");
+    }
+    coeffs_.assign(sections * biquad_kernels::kCoeffStride, 0.0f);
+    state_.assign(sections * biquad_kernels::kStateStride, 0.0f);
+    for (size_t s = 0; s < sections; s++) {
+        SetSection(s, BiquadCoefficients{1.0f, 0.0f, 0.0f, 0.0f, 0.0f});  // Pass-through
+    }
+}
+
+void BiquadCascade::SetSection(size_t section, const BiquadCoefficients& coefficients) {
+    if (section >= sections_) {
+        throw std::out_of_range("Biquad section index out of range");
+    }
+    float* c = coeffs_.data() + section * biquad_kernels::kCoeffStride;
+    const float values[5] = {coefficients.b0, coefficients.b1, coefficients.b2,
+                             coefficients.a1, coefficients.a2};
+    for (size_t k = 0; k < 5; k++) {
+        std::fill(c + k * kLanes, c + (k + 1) * kLanes, values[k]);
+    }
+}
+
+BiquadCoefficients BiquadCascade::GetSection(size_t section) const {
+    if (section >= sections_) {
+        throw std::out_of_range("Biquad section index out of range");
+    }
+    const float* c = coeffs_.data() + section * biquad_kernels::kCoeffStride;
+    return BiquadCoefficients{c[0], c[kLanes], c[2 * kLanes], c[3 * kLanes], c[4 * kLanes]};
+}
+
+void BiquadCascade::Process(float* samples, size_t frames, size_t stride) {
+    if (samples == nullptr || frames == 0 || stride == 0) {
+        return;
+    }
+    const size_t channels = (std::min)(stride, channels_);
+    Kernels().cascade(samples, frames, channels, stride, coeffs_.data(), state_.data(), sections_);
+}
+
+void BiquadCascade::Reset() {
+    std::fill(state_.begin(), state_.end(), 0.0f);
+}
+
+}  // namespace wasapi_capture
@@ -0,0 +1,103 @@
+/**
+ * Biquad Cascade
+ *
+ * v2.12: Vectorized engine for a series of biquad sections applied to
+ * interleaved multichannel audio (used by ThreeBandEQ).
+ *
+ * Coefficients and state are kept in structure-of-arrays form: for every
+ * section, each coefficient and each state variable is an 8-lane array
+ * (one lane per channel, coefficients replicated), so a frame of up to 8
+ * channels goes through a section as a handful of SIMD operations, with no
+ * per-sample virtual call or pointer chase. Mono uses a transposed direct
+ * form II block kernel instead: one section at a time over the whole block,
+ * coefficients and state in registers.
+ *
+ * All sections use transposed direct form II:
+ *   y  = b0*x + z1
+ *   z1 = b1*x - a1*y + z2
+ *   z2 = b2*x - a2*y
+ *
+ * SSE2 / AVX2 / NEON variants are selected at runtime like the level
+ * kernels; they match the scalar reference to within float rounding.
+ * Process() does not allocate.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "aligned_buffer.h"
+#include "biquad_filter.h"
+#include "cpu_features.h"
+
+namespace wasapi_capture {
+
+class BiquadCascade {
+public:
+    static constexpr size_t kMaxChannels = 8;
+    static constexpr size_t kLanes = 8;
+
+    /**
+     * @throws std::invalid_argument for zero sections or a channel count
+     *         outside 1-8
+     */
+    BiquadCascade(size_t sections, size_t channels);
+
+    // Same coefficients for every channel; state is kept
+    // (std::out_of_range for a bad section index)
+    void SetSection(size_t section, const BiquadCoefficients& coefficients);
+    BiquadCoefficients GetSection(size_t section) const;
+
+    /**
+     * Filter interleaved frames in place
+     *
+     * @param stride Channels per frame in the buffer; the first
+     *        min(stride, GetChannels()) channels are filtered
+     */
+    void Process(float* samples, size_t frames, size_t stride);
+
+    // Clear the filter state (coefficients are kept)
+    void Reset();
+
+    size_t GetSectionCount() const { return sections_; }
+    size_t GetChannels() const { return channels_; }
+
+private:
+    size_t sections_;
+    size_t channels_;
+    audio_capture::AlignedVector<float> coeffs_;  // Per section: b0 b1 b2 a1 a2, kLanes each
+    audio_capture::AlignedVector<float> state_;   // Per section: z1 z2, kLanes each
+};
+
+namespace biquad_kernels {
+
+constexpr size_t kCoeffStride = 5 * BiquadCascade::kLanes;  // Floats per section
+constexpr size_t kStateStride = 2 * BiquadCascade::kLanes;
+
+// Individual variants (for tests and benchmarks; callers must check the CPU)
+// channels <= 8 lanes are filtered, frames are `stride` floats apart
+void CascadeScalar(float* samples, size_t frames, size_t channels, size_t stride,
+                   const float* coeffs, float* state, size_t sections);
+// Transposed direct form II, one section at a time (channels == 1)
+void CascadeMonoBlock(float* samples, size_t frames, size_t stride,
+                      const float* coeffs, float* state, size_t sections);
+
+#if defined(AUDIO_SIMD_X86)
+void CascadeSse2(float* samples, size_t frames, size_t channels, size_t stride,
+                 const float* coeffs, float* state, size_t sections);
+void CascadeAvx2(float* samples, size_t frames, size_t channels, size_t stride,
+                 const float* coeffs, float* state, size_t sections);
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+void CascadeNeon(float* samples, size_t frames, size_t channels, size_t stride,
+                 const float* coeffs, float* state, size_t sections);
+#endif
+
+}  // namespace biquad_kernels
+
+// Variant used by BiquadCascade
+SimdLevel GetBiquadKernel();
+
+}  // namespace wasapi_capture
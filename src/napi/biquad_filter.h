@@ -6,6 +6,14 @@
 
 namespace wasapi_capture {
 
+/**
+ * @brief Normalized biquad coefficients (a0 = 1)
+ */
+struct BiquadCoefficients {
+    float b0, b1, b2;
+    float a1, a2;
+};
+
 /**
  * @brief Biquad IIR Filter
  * 
@@ -90,6 +98,11 @@ public:
      */
     float GetGain() const { return gain_db_; }
 
+    /**
+     * @brief Get the current coefficients (for BiquadCascade)
+     */
+    BiquadCoefficients GetCoefficients() const { return {b0_, b1_, b2_, a1_, a2_}; }
+
 private:
     /**
      * @brief Calculate filter coefficients based on type and parameters
@@ -0,0 +1,99 @@
+/**
+ * CPU Feature Detection Implementation
+ */
+
+#include "cpu_features.h"
+
+#if defined(AUDIO_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace wasapi_capture {
+
+namespace {
+
+#if defined(AUDIO_SIMD_X86)
+void Cpuid(int leaf, int subleaf, int regs[4]) {
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, subleaf);
+#else
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    regs[0] = static_cast<int>(a);
+    regs[1] = static_cast<int>(b);
+    regs[2] = static_cast<int>(c);
+    regs[3] = static_cast<int>(d);
+#endif
+}
+
+uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+CpuFeatures Detect() {
+    CpuFeatures features;
+
+#if defined(AUDIO_SIMD_X86)
+    int regs[4] = {0, 0, 0, 0};
+    Cpuid(0, 0, regs);
+    int max_leaf = regs[0];
+
+    Cpuid(1, 0, regs);
+    features.sse2 = (regs[3] & (1 << 26)) != 0;
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+    features.fma = (regs[2] & (1 << 12)) != 0;
+
+    // AVX state must be enabled by the OS (XMM + YMM in XCR0)
+    bool ymm_enabled = osxsave && avx && ((ReadXcr0() & 0x6) == 0x6);
+    if (ymm_enabled && max_leaf >= 7) {
+        Cpuid(7, 0, regs);
+        features.avx2 = (regs[1] & (1 << 5)) != 0;
+    }
+    features.fma = features.fma && ymm_enabled;
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+    features.neon = true;  // Mandatory on AArch64
+#endif
+
+    return features;
+}
+
+}  // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+    static const CpuFeatures features = Detect();
+    return features;
+}
+
+SimdLevel GetBestSimdLevel() {
+    const CpuFeatures& features = GetCpuFeatures();
+    if (features.avx2) return SimdLevel::AVX2;
+    if (features.sse2) return SimdLevel::SSE2;
+    if (features.neon) return SimdLevel::NEON;
+    return SimdLevel::Scalar;
+}
+
+const char* SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::NEON: return "neon";
+        default:              return "scalar";
+    }
+}
+
+}  // namespace wasapi_capture
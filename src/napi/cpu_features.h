@@ -0,0 +1,60 @@
+/**
+ * CPU Feature Detection
+ *
+ * v2.12: Runtime SIMD detection shared by the DSP kernels.
+ * Kernels are compiled for every instruction set the target architecture
+ * can have and selected once at runtime, so a single prebuilt binary runs
+ * on every CPU.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Architecture families with SIMD kernels
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define AUDIO_SIMD_X86 1
+#endif
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#define AUDIO_SIMD_NEON 1
+#endif
+
+// Per-function instruction set enablement (GCC/Clang need it, MSVC does not)
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#define AUDIO_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+#define AUDIO_TARGET_AVX2
+#define AUDIO_TARGET_AVX2_FMA
+#endif
+
+namespace wasapi_capture {
+
+/**
+ * Instruction sets available to the DSP kernels
+ */
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+struct CpuFeatures {
+    bool sse2 = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool neon = false;
+};
+
+// Detected once, on first use
+const CpuFeatures& GetCpuFeatures();
+
+// Best level supported by this CPU
+SimdLevel GetBestSimdLevel();
+
+// For logs and stats ("scalar", "sse2", "avx2", "neon")
+const char* SimdLevelName(SimdLevel level);
+
+}  // namespace wasapi_capture
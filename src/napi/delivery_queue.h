@@ -0,0 +1,258 @@
+/**
+ * Bounded Delivery Queue
+ *
+ * v2.12: Backpressure between the native pipeline and the JS event loop.
+ *
+ * Packets waiting for JavaScript are held here instead of inside the
+ * ThreadSafeFunction queue. At most one TSFN call ("drain") is in flight:
+ * Push() reports when a drain has to be scheduled, and the JS thread takes
+ * every queued packet in one go. When the queue is full the configured
+ * policy decides what happens, so a stalled event loop (GC pause, busy
+ * renderer) costs a bounded amount of native memory.
+ *
+ * Pinned items (e.g. speech segment boundaries travelling in order with the
+ * audio) are never dropped or merged; they may exceed the bound, and they
+ * are not counted in the packet statistics.
+ *
+ * Platform independent; the packet type and merge operation are supplied
+ * by the caller.
+ */
+
+#ifndef DELIVERY_QUEUE_H
+#define DELIVERY_QUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace AudioCapture {
+
+/**
+ * What to do with a new packet when the queue is full
+ */
+enum class DeliveryPolicy {
+    DropOldest,   // Discard the oldest queued packet (lowest latency)
+    DropNewest,   // Discard the incoming packet (keeps continuity of old data)
+    Coalesce      // Append to the newest queued packet; drop oldest if that fails
+};
+
+inline const char* DeliveryPolicyName(DeliveryPolicy policy) {
+    switch (policy) {
+        case DeliveryPolicy::DropNewest: return "drop-newest";
+        case DeliveryPolicy::Coalesce:   return "coalesce";
+        default:                         return "drop-oldest";
+    }
+}
+
+/**
+ * @return false if the name is unknown (policy left unchanged)
+ */
+inline bool ParseDeliveryPolicy(const std::string& name, DeliveryPolicy& policy) {
+    if (name == "drop-oldest") {
+        policy = DeliveryPolicy::DropOldest;
+    } else if (name == "drop-newest") {
+        policy = DeliveryPolicy::DropNewest;
+    } else if (name == "coalesce") {
+        policy = DeliveryPolicy::Coalesce;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+class DeliveryQueue {
+public:
+    // Append `from` to `into`; return false if not possible (e.g. size limit),
+    // leaving `from` untouched. Runs without the queue lock held.
+    using MergeFn = std::function<bool(T& into, T&& from)>;
+    // True for items that must reach JavaScript (never dropped or merged)
+    using PinnedFn = std::function<bool(const T& item)>;
+
+    struct Stats {
+        uint64_t packets_queued;      // Packets accepted by Push()
+        uint64_t packets_delivered;   // Packets handed to the JS thread
+        uint64_t packets_dropped;     // Packets discarded by the policy
+        uint64_t packets_coalesced;   // Packets merged into a queued packet
+        size_t queue_depth;           // Packets currently queued
+        size_t queue_high_water;      // Maximum queued packets observed
+        size_t max_depth;             // Configured bound (0 = unbounded)
+    };
+
+    /**
+     * @param max_depth Maximum queued packets (0 = unbounded)
+     * @param policy Overflow policy
+     * @param merge Merge operation used by DeliveryPolicy::Coalesce
+     * @param pinned Identifies pinned items (nullptr: none)
+     */
+    DeliveryQueue(size_t max_depth, DeliveryPolicy policy, MergeFn merge = nullptr, PinnedFn pinned = nullptr)
+        : max_depth_(max_depth), policy_(policy), merge_(std::move(merge)), pinned_(std::move(pinned)) {
+    }
+
+    // Disable copy
+    DeliveryQueue(const DeliveryQueue&) = delete;
+    DeliveryQueue& operator=(const DeliveryQueue&) = delete;
+
+    /**
+     * @brief Queue a packet (single producer thread at a time)
+     * @return true if the caller must schedule a drain on the JS thread
+     */
+    bool Push(T&& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (IsPinned(item)) {
+            queue_.push_back(std::move(item));  // Never refused, even above max_depth_
+            UpdateHighWaterLocked();
+            return ScheduleLocked();
+        }
+
+        if (max_depth_ > 0 && queue_.size() >= max_depth_) {
+            if (policy_ == DeliveryPolicy::DropNewest) {
+                stats_.packets_dropped++;
+                return ScheduleLocked();  // Retry if the last drain could not be queued
+            }
+            if (policy_ == DeliveryPolicy::Coalesce && merge_ && !IsPinned(queue_.back())) {
+                // The producer owns the newest packet while merging, so the copy
+                // never blocks TakeAll(). The drain only removes from the front,
+                // so pushing it back keeps the order.
+                T tail = std::move(queue_.back());
+                queue_.pop_back();
+                lock.unlock();
+                const bool merged = merge_(tail, std::move(item));
+                lock.lock();
+                queue_.push_back(std::move(tail));
+                if (merged) {
+                    stats_.packets_coalesced++;
+                    return ScheduleLocked();
+                }
+            }
+            if (queue_.size() >= max_depth_) {  // The drain may have run meanwhile
+                DropOldestLocked();
+            }
+        }
+
+        queue_.push_back(std::move(item));
+        stats_.packets_queued++;
+        UpdateHighWaterLocked();
+        return ScheduleLocked();
+    }
+
+    /**
+     * @brief Take every queued packet (JS thread); ends the pending drain
+     */
+    size_t TakeAll(std::deque<T>& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.swap(queue_);
+        queue_.clear();
+        drain_scheduled_ = false;
+        stats_.packets_delivered += CountPackets(out);
+        return out.size();
+    }
+
+    /**
+     * @brief Put taken items back at the front, in order (JS thread, when
+     *        they could not be delivered); the next Push() or RequestDrain()
+     *        schedules them again
+     */
+    void Requeue(std::deque<T>&& items) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.packets_delivered -= CountPackets(items);
+        queue_.insert(queue_.begin(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+    }
+
+    /**
+     * @brief Schedule a drain for packets left behind by a failed one (e.g. on stop)
+     * @return true if the caller must schedule a drain on the JS thread
+     */
+    bool RequestDrain() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !queue_.empty() && ScheduleLocked();
+    }
+
+    /**
+     * @brief The scheduled drain could not be queued; the next Push() or RequestDrain() retries
+     */
+    void CancelDrain() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drain_scheduled_ = false;
+    }
+
+    /**
+     * @brief Count packets that were taken but never reached JavaScript
+     */
+    void CountDropped(size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.packets_delivered -= count;
+        stats_.packets_dropped += count;
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+    }
+
+    Stats GetStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.queue_depth = queue_.size();
+        stats.max_depth = max_depth_;
+        return stats;
+    }
+
+    DeliveryPolicy GetPolicy() const { return policy_; }
+
+private:
+    bool IsPinned(const T& item) const { return pinned_ && pinned_(item); }
+
+    size_t CountPackets(const std::deque<T>& items) const {
+        if (!pinned_) {
+            return items.size();
+        }
+        return static_cast<size_t>(std::count_if(items.begin(), items.end(),
+            [this](const T& item) { return !pinned_(item); }));
+    }
+
+    // Oldest packet that is not pinned; if every queued item is pinned, nothing is dropped
+    void DropOldestLocked() {
+        auto it = queue_.begin();
+        while (it != queue_.end() && IsPinned(*it)) {
+            ++it;
+        }
+        if (it != queue_.end()) {
+            queue_.erase(it);
+            stats_.packets_dropped++;
+        }
+    }
+
+    void UpdateHighWaterLocked() {
+        if (queue_.size() > stats_.queue_high_water) {
+            stats_.queue_high_water = queue_.size();
+        }
+    }
+
+    bool ScheduleLocked() {
+        if (drain_scheduled_) {
+            return false;
+        }
+        drain_scheduled_ = true;
+        return true;
+    }
+
+    const size_t max_depth_;
+    const DeliveryPolicy policy_;
+    MergeFn merge_;
+    PinnedFn pinned_;
+
+    mutable std::mutex mutex_;
+    std::deque<T> queue_;
+    bool drain_scheduled_ = false;
+    Stats stats_ = {};
+};
+
+} // namespace AudioCapture
+
+#endif // DELIVERY_QUEUE_H
@@ -0,0 +1,166 @@
+/**
+ * Shared Denoise Engine Implementation
+ */
+
+#include "denoise_engine.h"
+#include "audio_effects.h"
+#include <algorithm>
+
+namespace AudioCapture {
+
+struct DenoiseEngine::Batch {
+    DenoiseJob* jobs;
+    size_t count;
+    std::atomic<size_t> next{0};  // Next unclaimed job
+    size_t done = 0;              // Finished jobs (under mutex_)
+    size_t users = 0;             // Helpers holding a pointer (under mutex_)
+};
+
+DenoiseEngine::DenoiseEngine(size_t workers) {
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; i++) {
+        workers_.emplace_back(&DenoiseEngine::WorkerLoop, this);
+    }
+}
+
+DenoiseEngine::~DenoiseEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+std::shared_ptr<DenoiseEngine> DenoiseEngine::Shared() {
+    static std::mutex mutex;
+    static std::weak_ptr<DenoiseEngine> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<DenoiseEngine> engine = shared.lock();
+    if (!engine) {
+        size_t threads = std::thread::hardware_concurrency();
+        engine = std::make_shared<DenoiseEngine>((std::min)((std::max)(threads / 2, size_t{1}), size_t{8}));
+        shared = engine;
+    }
+    return engine;
+}
+
+bool DenoiseEngine::RunJob(DenoiseJob& job) {
+    try {
+        job.vad = job.processor->ProcessFrame(job.frame, job.processor->GetFrameSize());
+        return true;
+    } catch (...) {
+        job.vad = 0.0f;
+        return false;  // The frame keeps whatever the processor left in it
+    }
+}
+
+size_t DenoiseEngine::Drain(Batch& batch) {
+    size_t ran = 0;
+    uint64_t failures = 0;
+    for (;;) {
+        size_t i = batch.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= batch.count) {
+            break;
+        }
+        if (!RunJob(batch.jobs[i])) {
+            failures++;
+        }
+        ran++;
+    }
+    jobs_.fetch_add(ran, std::memory_order_relaxed);
+    if (failures) {
+        failures_.fetch_add(failures, std::memory_order_relaxed);
+    }
+    return ran;
+}
+
+void DenoiseEngine::Remove(Batch* batch) {
+    auto it = std::find(queue_.begin(), queue_.end(), batch);
+    if (it != queue_.end()) {
+        queue_.erase(it);
+    }
+}
+
+void DenoiseEngine::HelpOldest(std::unique_lock<std::mutex>& lock, bool worker) {
+    Batch* batch = queue_.front();
+    batch->users++;
+    lock.unlock();
+
+    size_t ran = Drain(*batch);
+    (worker ? jobs_on_workers_ : jobs_helped_).fetch_add(ran, std::memory_order_relaxed);
+
+    lock.lock();
+    Remove(batch);  // Every job is claimed
+    batch->done += ran;
+    batch->users--;
+    done_cv_.notify_all();
+}
+
+void DenoiseEngine::Run(DenoiseJob* jobs, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    batches_.fetch_add(1, std::memory_order_relaxed);
+
+    // No pool: run inline
+    if (workers_.empty()) {
+        Batch batch;
+        batch.jobs = jobs;
+        batch.count = count;
+        Drain(batch);
+        return;
+    }
+
+    Batch batch;
+    batch.jobs = jobs;
+    batch.count = count;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(&batch);
+    }
+    work_cv_.notify_all();
+
+    // The submitting thread works on its own batch while the pool helps
+    size_t ran = Drain(batch);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    Remove(&batch);
+    batch.done += ran;
+    // Until the jobs claimed by workers finish (and workers let go of the
+    // batch), run frames other streams have queued instead of just waiting
+    while (batch.done != batch.count || batch.users != 0) {
+        if (!queue_.empty()) {
+            HelpOldest(lock, false);
+        } else {
+            done_cv_.wait(lock);
+        }
+    }
+}
+
+void DenoiseEngine::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_) {
+            return;
+        }
+        HelpOldest(lock, true);
+    }
+}
+
+DenoiseEngine::Stats DenoiseEngine::GetStats() const {
+    Stats stats;
+    stats.workers = workers_.size();
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.jobs = jobs_.load(std::memory_order_relaxed);
+    stats.jobs_on_workers = jobs_on_workers_.load(std::memory_order_relaxed);
+    stats.jobs_helped = jobs_helped_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace AudioCapture
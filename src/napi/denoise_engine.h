@@ -0,0 +1,102 @@
+/**
+ * Shared Denoise Engine
+ *
+ * v2.12: One bounded worker pool for the RNNoise frames of every capture in
+ * the process. A DenoiseStage feeds its states up to the next 480-sample
+ * frame boundary and hands the engine the completed frames - one job per
+ * RNNoise state, mono and downmix streams included - as one batch. Batches
+ * of all streams share one queue: pool threads drain whichever is oldest,
+ * and a submitting thread whose own frames are all claimed runs frames of
+ * other streams while it waits. Ten 8-channel captures therefore share a
+ * few threads instead of each walking its channels serially.
+ *
+ * Jobs of one batch belong to different states and never depend on each
+ * other; a state has at most one frame in flight. Each job returns the VAD
+ * probability of its frame. RunJob() is the single place RNNoise is
+ * invoked, so a batched network evaluation can replace it without touching
+ * the streams. Statistics are lock-free counters.
+ *
+ * Platform independent (std::thread only).
+ */
+
+#ifndef DENOISE_ENGINE_H
+#define DENOISE_ENGINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AudioCapture {
+
+class DenoiseProcessor;
+
+// Denoise one complete frame of one state in place (DenoiseProcessor::ProcessFrame)
+struct DenoiseJob {
+    DenoiseProcessor* processor;
+    float* frame;        // processor->GetFrameSize() samples
+    float vad = 0.0f;    // Set by the engine: VAD probability of the frame
+};
+
+class DenoiseEngine {
+public:
+    struct Stats {
+        size_t workers;            // Pool threads
+        uint64_t batches;          // Run() calls
+        uint64_t jobs;             // Jobs executed
+        uint64_t jobs_on_workers;  // Jobs executed by pool threads (rest: submitting threads)
+        uint64_t jobs_helped;      // Jobs a submitting thread ran for another stream
+        uint64_t failures;         // Jobs that threw
+    };
+
+    // workers == 0 runs every batch on the calling thread
+    explicit DenoiseEngine(size_t workers);
+    ~DenoiseEngine();
+
+    DenoiseEngine(const DenoiseEngine&) = delete;
+    DenoiseEngine& operator=(const DenoiseEngine&) = delete;
+
+    /**
+     * Process-wide engine, created on first use and destroyed with its last
+     * user. Worker count: half the hardware threads, 1-8.
+     */
+    static std::shared_ptr<DenoiseEngine> Shared();
+
+    // Execute all jobs; returns when every job has finished
+    // (the calling thread may run jobs of other streams meanwhile)
+    void Run(DenoiseJob* jobs, size_t count);
+
+    size_t GetWorkerCount() const { return workers_.size(); }
+    Stats GetStats() const;
+
+private:
+    struct Batch;
+
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;   // Workers: batch queued or stopping
+    std::condition_variable done_cv_;   // Submitters: a job of some batch finished
+    std::deque<Batch*> queue_;          // Batches with unclaimed jobs
+    bool stop_ = false;
+
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> jobs_{0};
+    std::atomic<uint64_t> jobs_on_workers_{0};
+    std::atomic<uint64_t> jobs_helped_{0};
+    std::atomic<uint64_t> failures_{0};
+
+    void WorkerLoop();
+    size_t Drain(Batch& batch);
+    void HelpOldest(std::unique_lock<std::mutex>& lock, bool worker);  // Locked on entry and exit
+    void Remove(Batch* batch);  // Caller holds mutex_
+    static bool RunJob(DenoiseJob& job);
+};
+
+}  // namespace AudioCapture
+
+#endif  // DENOISE_ENGINE_H
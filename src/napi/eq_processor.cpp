@@ -7,13 +7,8 @@ namespace wasapi_capture {
 ThreeBandEQ::ThreeBandEQ()
     : enabled_(false),
       sample_rate_(48000),
-      frames_processed_(0) {
-    // Initialize stereo filters
-    for (int i = 0; i < 2; ++i) {
-        low_filter_[i] = std::make_unique<BiquadFilter>();
-        mid_filter_[i] = std::make_unique<BiquadFilter>();
-        high_filter_[i] = std::make_unique<BiquadFilter>();
-    }
+      frames_processed_(0),
+      cascade_(3, BiquadCascade::kMaxChannels) {
 }
 
 ThreeBandEQ::~ThreeBandEQ() = default;
@@ -22,11 +17,10 @@ void ThreeBandEQ::Initialize(int sample_rate) {
     sample_rate_ = sample_rate;
 
     // Initialize all filters with sample rate
-    for (int i = 0; i < 2; ++i) {
-        low_filter_[i]->Initialize(sample_rate);
-        mid_filter_[i]->Initialize(sample_rate);
-        high_filter_[i]->Initialize(sample_rate);
-    }
+    low_filter_.Initialize(sample_rate);
+    mid_filter_.Initialize(sample_rate);
+    high_filter_.Initialize(sample_rate);
+    cascade_.Reset();
 
     UpdateFilters();
 }
@@ -98,31 +92,9 @@ void ThreeBandEQ::Process(float* samples, int frame_count, int channels) {
         return;
     }
 
-    // Ensure we have stereo channels (or mono duplicated)
-    int process_channels = std::min(channels, 2);
-
-    // Process each frame
-    for (int frame = 0; frame < frame_count; ++frame) {
-        for (int ch = 0; ch < process_channels; ++ch) {
-            int index = frame * channels + ch;
-            float sample = samples[index];
-
-            // Apply 3-band EQ in series
-            // Order: Low shelf -> Mid bell -> High shelf
-            sample = low_filter_[ch]->Process(sample);
-            sample = mid_filter_[ch]->Process(sample);
-            sample = high_filter_[ch]->Process(sample);
-
-            samples[index] = sample;
-        }
-
-        // If mono, copy to other channels
-        if (channels > process_channels) {
-            for (int ch = process_channels; ch < channels; ++ch) {
-                samples[frame * channels + ch] = samples[frame * channels + 0];
-            }
-        }
-    }
+    // Apply 3-band EQ in series to every channel (up to 8)
+    // Order: Low shelf -> Mid bell -> High shelf
+    cascade_.Process(samples, static_cast<size_t>(frame_count), static_cast<size_t>(channels));
 
     frames_processed_ += frame_count;
 }
@@ -140,45 +112,40 @@ ThreeBandEQ::Stats ThreeBandEQ::GetStats() const {
 void ThreeBandEQ::Reset() {
     frames_processed_ = 0;
 
-    // Reset all filters
-    for (int i = 0; i < 2; ++i) {
-        low_filter_[i]->Reset();
-        mid_filter_[i]->Reset();
-        high_filter_[i]->Reset();
-    }
+    // Reset filter state
+    cascade_.Reset();
 }
 
 void ThreeBandEQ::UpdateFilters() {
     // Update low shelf filter (LowShelf)
     // Default Q = 0.707 (Butterworth)
-    for (int i = 0; i < 2; ++i) {
-        low_filter_[i]->SetFilter(
-            BiquadFilter::Type::LowShelf,
-            options_.low_freq,
-            0.707f,  // Standard Q for shelf filters
-            options_.low_gain_db
-        );
-    }
+    low_filter_.SetFilter(
+        BiquadFilter::Type::LowShelf,
+        options_.low_freq,
+        0.707f,  // Standard Q for shelf filters
+        options_.low_gain_db
+    );
 
     // Update mid parametric filter (Peak)
-    for (int i = 0; i < 2; ++i) {
-        mid_filter_[i]->SetFilter(
-            BiquadFilter::Type::Peak,
-            options_.mid_freq,
-            options_.mid_q,
-            options_.mid_gain_db
-        );
-    }
+    mid_filter_.SetFilter(
+        BiquadFilter::Type::Peak,
+        options_.mid_freq,
+        options_.mid_q,
+        options_.mid_gain_db
+    );
 
     // Update high shelf filter (HighShelf)
-    for (int i = 0; i < 2; ++i) {
-        high_filter_[i]->SetFilter(
-            BiquadFilter::Type::HighShelf,
-            options_.high_freq,
-            0.707f,  // Standard Q for shelf filters
-            options_.high_gain_db
-        );
-    }
+    high_filter_.SetFilter(
+        BiquadFilter::Type::HighShelf,
+        options_.high_freq,
+        0.707f,  // Standard Q for shelf filters
+        options_.high_gain_db
+    );
+
+    // Same coefficients for all channels; filter state is kept
+    cascade_.SetSection(0, low_filter_.GetCoefficients());
+    cascade_.SetSection(1, mid_filter_.GetCoefficients());
+    cascade_.SetSection(2, high_filter_.GetCoefficients());
 }
 
 } // namespace wasapi_capture
@@ -1,8 +1,9 @@
 #ifndef EQ_PROCESSOR_H
 #define EQ_PROCESSOR_H
 
+#include "biquad_cascade.h"
 #include "biquad_filter.h"
-#include <memory>
+#include <cstdint>
 
 namespace wasapi_capture {
 
@@ -16,6 +17,9 @@ namespace wasapi_capture {
  * 
  * Each band has adjustable gain (-20 to +20 dB).
  * Suitable for voice enhancement, music EQ, and general audio processing.
+ *
+ * v2.12: The three bands run as one BiquadCascade, with all channels (up to 8)
+ * filtered together in SIMD lanes instead of per sample and channel.
  */
 class ThreeBandEQ {
 public:
@@ -110,7 +114,7 @@ public:
      * @brief Process audio samples with EQ
      * @param samples Interleaved audio samples (modified in-place)
      * @param frame_count Number of frames (samples per channel)
-     * @param channels Number of audio channels
+     * @param channels Number of audio channels (channels beyond 8 pass through)
      */
     void Process(float* samples, int frame_count, int channels);
 
@@ -136,10 +140,13 @@ private:
     int sample_rate_;
     uint64_t frames_processed_;
 
-    // Biquad filters for each band (stereo)
-    std::unique_ptr<BiquadFilter> low_filter_[2];   // Low shelf
-    std::unique_ptr<BiquadFilter> mid_filter_[2];   // Parametric
-    std::unique_ptr<BiquadFilter> high_filter_[2];  // High shelf
+    // Coefficient design for each band
+    BiquadFilter low_filter_;   // Low shelf
+    BiquadFilter mid_filter_;   // Parametric
+    BiquadFilter high_filter_;  // High shelf
+
+    // v2.12: Low -> mid -> high sections, state for every channel
+    BiquadCascade cascade_;
 
     // Constants
     static constexpr float kMinGain = -20.0f;  // Minimum gain (dB)
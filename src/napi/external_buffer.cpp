@@ -3,6 +3,7 @@
  */
 
 #include "external_buffer.h"
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -143,55 +144,235 @@ void ExternalBuffer::Release() {
     }
 }
 
+// ============================================================================
+// BufferPool::SizeClass Implementation (v2.12)
+// ============================================================================
+
+/**
+ * One power-of-two size class.
+ *
+ * Idle buffers sit on a mutex-protected freelist. At most capacity buffers
+ * of this class exist at a time (idle or handed out); beyond that the pool
+ * hands out unpooled buffers. The critical sections are a vector push/pop.
+ */
+class BufferPool::SizeClass {
+public:
+    SizeClass(size_t buffer_size, size_t capacity, size_t target)
+        : buffer_size_(buffer_size), capacity_(capacity), target_(target) {
+        free_.reserve(capacity);  // Push never allocates under the lock
+    }
+
+    // Runs once the pool and every outstanding buffer have released their reference
+    ~SizeClass() {
+        for (ExternalBuffer* buffer : free_) {
+            delete buffer;
+        }
+    }
+
+    size_t BufferSize() const { return buffer_size_; }
+
+    size_t Available() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_.size();
+    }
+
+    size_t Target() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return target_;
+    }
+
+    void SetTarget(size_t target) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        target_ = target;
+    }
+
+    /**
+     * @param hit Set to true if an idle buffer was reused
+     * @return nullptr if capacity buffers are in use (caller allocates unpooled)
+     */
+    ExternalBuffer* Take(bool& hit) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                hit = true;
+                ExternalBuffer* buffer = free_.back();
+                free_.pop_back();
+                return buffer;
+            }
+            if (live_ >= capacity_) {
+                hit = false;
+                return nullptr;
+            }
+            live_++;
+        }
+
+        hit = false;
+        return Create();
+    }
+
+    // Return a buffer to the freelist (called from the V8 finalizer)
+    void Recycle(ExternalBuffer* buffer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_.size() < target_) {
+                free_.push_back(buffer);
+                return;
+            }
+            live_--;
+        }
+        delete buffer;  // Above target - free the memory outside the lock
+    }
+
+    // Pre-allocate idle buffers up to count
+    void Fill(size_t count) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (free_.size() >= count || live_ >= capacity_) {
+                    return;
+                }
+                live_++;
+            }
+            ExternalBuffer* buffer = Create();
+            if (!buffer) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(buffer);
+        }
+    }
+
+private:
+    // Allocates outside the lock; gives the live_ count reserved by the caller back on failure
+    ExternalBuffer* Create() {
+        try {
+            return new ExternalBuffer(buffer_size_);
+        } catch (const std::exception&) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            live_--;
+            return nullptr;
+        }
+    }
+
+    const size_t buffer_size_;
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::vector<ExternalBuffer*> free_;  // Idle buffers (capacity_ reserved)
+    size_t live_ = 0;                    // Pooled buffers in existence (idle + handed out)
+    size_t target_;                      // Idle buffers to retain
+};
+
 // ============================================================================
 // BufferPool Implementation
 // ============================================================================
 
-BufferPool::BufferPool(size_t buffer_size, size_t pool_size)
+BufferPool::BufferPool(size_t buffer_size, size_t pool_size, size_t max_pool_size)
     : buffer_size_(buffer_size), 
       pool_size_(pool_size),
       min_pool_size_(pool_size),  // Default: same as initial
-      max_pool_size_(pool_size),  // Default: same as initial (fixed)
+      max_pool_size_(max_pool_size > pool_size ? max_pool_size : pool_size),
+      slot_capacity_(max_pool_size > pool_size ? max_pool_size : pool_size),
       strategy_(PoolStrategy::Fixed) {  // Default: fixed strategy
     
-    // Pre-allocate buffers
-    available_buffers_.reserve(pool_size);
+    // v2.12: One freelist per size class, each with a fixed buffer capacity
+    for (size_t i = 0; i < kClassCount; ++i) {
+        classes_[i] = std::make_shared<SizeClass>(
+            size_t(1) << (kMinClassShift + i), slot_capacity_, ClassTarget(i, pool_size));
+    }
     
-    for (size_t i = 0; i < pool_size; ++i) {
-        try {
-            auto buffer = std::make_shared<ExternalBuffer>(buffer_size, this);
-            available_buffers_.push_back(buffer);
-        } catch (const std::exception& e) {
-            // Failed to pre-allocate - continue with smaller pool
-            break;
-        }
+    // Pre-allocate buffers for the default request size
+    size_t index = ClassIndex(buffer_size);
+    if (index < kClassCount) {
+        classes_[index]->Fill(pool_size);
     }
 }
 
 BufferPool::~BufferPool() {
+    // Size classes are freed once the last outstanding buffer is released
     std::lock_guard<std::mutex> lock(pool_mutex_);
-    available_buffers_.clear();
+    for (auto& size_class : classes_) {
+        size_class.reset();
+    }
+}
+
+// v2.12: Idle buffers a size class retains for a given pool size.
+// The default request class keeps pool_size buffers; the others share the
+// same byte budget (pool_size * buffer_size_), so 1 MB classes don't each
+// hold as many idle buffers as the 4 KB default class.
+size_t BufferPool::ClassTarget(size_t index, size_t pool_size) const {
+    if (index == ClassIndex(buffer_size_)) {
+        return pool_size;
+    }
+    size_t class_size = size_t(1) << (kMinClassShift + index);
+    size_t target = pool_size * buffer_size_ / class_size;
+    return (std::min)(pool_size, (std::max)(kMinClassTarget, target));
+}
+
+void BufferPool::ApplyTargets(size_t pool_size) {
+    for (size_t i = 0; i < kClassCount; ++i) {
+        classes_[i]->SetTarget(ClassTarget(i, pool_size));
+    }
+}
+
+size_t BufferPool::RetainTarget(size_t size) const {
+    size_t index = ClassIndex(size);
+    return index < kClassCount ? classes_[index]->Target() : 0;
+}
+
+// v2.12: Smallest power-of-two class that fits size
+size_t BufferPool::ClassIndex(size_t size) {
+    if (size > MaxPooledSize()) {
+        return kClassCount;
+    }
+    size_t shift = kMinClassShift;
+    while ((size_t(1) << shift) < size) {
+        ++shift;
+    }
+    return shift - kMinClassShift;
 }
 
 std::shared_ptr<ExternalBuffer> BufferPool::Acquire() {
-    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return Acquire(buffer_size_);
+}
+
+std::shared_ptr<ExternalBuffer> BufferPool::Acquire(size_t min_size) {
+    if (min_size == 0) {
+        min_size = 1;
+    }
     
-    if (!available_buffers_.empty()) {
-        // Pool hit - reuse existing buffer
-        auto buffer = available_buffers_.back();
-        available_buffers_.pop_back();
+    size_t index = ClassIndex(min_size);
+    if (index < kClassCount) {
+        const std::shared_ptr<SizeClass>& size_class = classes_[index];
         
-        pool_hits_.fetch_add(1, std::memory_order_relaxed);
-        return buffer;
+        bool hit = false;
+        ExternalBuffer* buffer = size_class->Take(hit);
+        if (buffer) {
+            if (hit) {
+                pool_hits_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                pool_misses_.fetch_add(1, std::memory_order_relaxed);
+                dynamic_allocations_.fetch_add(1, std::memory_order_relaxed);
+            }
+            
+            // The deleter keeps the size class alive (the pool may be gone by then)
+            try {
+                return std::shared_ptr<ExternalBuffer>(buffer, [owner = size_class](ExternalBuffer* ptr) {
+                    owner->Recycle(ptr);
+                });
+            } catch (const std::exception&) {
+                return nullptr;  // Deleter already recycled the buffer
+            }
+        }
     }
     
-    // Pool miss - allocate new buffer dynamically
+    // Pool miss - size class at capacity (or oversized request): unpooled buffer
     pool_misses_.fetch_add(1, std::memory_order_relaxed);
     dynamic_allocations_.fetch_add(1, std::memory_order_relaxed);
     
     try {
-        return std::make_shared<ExternalBuffer>(buffer_size_, this);
-    } catch (const std::exception& e) {
+        size_t size = (index < kClassCount) ? (size_t(1) << (kMinClassShift + index)) : min_size;
+        return std::make_shared<ExternalBuffer>(size);
+    } catch (const std::exception&) {
         // Allocation failed - return nullptr (caller must handle)
         return nullptr;
     }
@@ -200,33 +381,12 @@ std::shared_ptr<ExternalBuffer> BufferPool::Acquire() {
 void BufferPool::Release(ExternalBuffer* buffer) {
     if (!buffer) return;
     
-    std::lock_guard<std::mutex> lock(pool_mutex_);
-    
-    // Return to pool if not full
-    if (available_buffers_.size() < pool_size_) {
-        // Reset buffer content for reuse (optional, for security)
-        // std::memset(buffer->data(), 0, buffer->size());
-        
-        // CRITICAL FIX: Use a custom deleter that does NOTHING
-        // The buffer should NOT be deleted when returned to pool
-        // It will only be deleted when the pool itself is destroyed
-        available_buffers_.push_back(std::shared_ptr<ExternalBuffer>(
-            buffer,
-            [](ExternalBuffer* ptr) {
-                // NO-OP deleter: buffer is managed by pool, don't delete here
-                // The buffer will be deleted in ~BufferPool()
-            }
-        ));
-    } else {
-        // Pool full - delete the buffer
-        // This only happens for dynamically allocated buffers beyond pool size
-        delete buffer;
-    }
+    // v2.12: Pooled buffers are recycled by their shared_ptr deleter;
+    // anything reaching this path is not owned by a size class
+    delete buffer;
 }
 
 BufferPool::Stats BufferPool::GetStats() const {
-    std::lock_guard<std::mutex> lock(pool_mutex_);
-    
     uint64_t hits = pool_hits_.load(std::memory_order_relaxed);
     uint64_t misses = pool_misses_.load(std::memory_order_relaxed);
     uint64_t total = hits + misses;
@@ -234,12 +394,20 @@ BufferPool::Stats BufferPool::GetStats() const {
     // Calculate hit rate percentage
     double hit_rate = (total > 0) ? (static_cast<double>(hits) / total * 100.0) : 0.0;
     
+    // v2.12: Idle buffers across all size classes
+    size_t available = 0;
+    for (const auto& size_class : classes_) {
+        if (size_class) {
+            available += size_class->Available();
+        }
+    }
+    
     return Stats{
         hits,
         misses,
         dynamic_allocations_.load(std::memory_order_relaxed),
-        available_buffers_.size(),
-        pool_size_,
+        available,
+        pool_size_.load(std::memory_order_relaxed),
         hit_rate
     };
 }
@@ -258,15 +426,26 @@ void BufferPool::SetMinMaxPoolSize(size_t min_size, size_t max_size) {
         std::swap(min_size, max_size);
     }
     
+    // v2.12: Size-class capacity is fixed at construction
+    if (max_size > slot_capacity_) {
+        max_size = slot_capacity_;
+    }
+    if (min_size > max_size) {
+        min_size = max_size;
+    }
+    
     min_pool_size_ = min_size;
     max_pool_size_ = max_size;
     
     // Clamp current pool size to new constraints
-    if (pool_size_ < min_pool_size_) {
-        pool_size_ = min_pool_size_;
-    } else if (pool_size_ > max_pool_size_) {
-        pool_size_ = max_pool_size_;
+    size_t pool_size = pool_size_.load(std::memory_order_relaxed);
+    if (pool_size < min_pool_size_) {
+        pool_size = min_pool_size_;
+    } else if (pool_size > max_pool_size_) {
+        pool_size = max_pool_size_;
     }
+    pool_size_.store(pool_size, std::memory_order_relaxed);
+    ApplyTargets(pool_size);
 }
 
 // v2.7: Evaluate pool performance and adjust size
@@ -303,30 +482,24 @@ void BufferPool::EvaluateAndAdjust() {
     // If hit rate > 5%: pool might be too large, consider shrinking
     // If 2% <= hit rate <= 5%: optimal, no change
     
-    size_t old_pool_size = pool_size_;
+    size_t pool_size = pool_size_.load(std::memory_order_relaxed);
     
-    if (period_hit_rate < 2.0 && pool_size_ < max_pool_size_) {
+    if (period_hit_rate < 2.0 && pool_size < max_pool_size_) {
         // Hit rate too low - grow pool by 20%
-        size_t growth = std::max<size_t>(10, pool_size_ / 5); // At least 10, or 20%
-        pool_size_ = std::min(pool_size_ + growth, max_pool_size_);
+        size_t growth = std::max<size_t>(10, pool_size / 5); // At least 10, or 20%
+        pool_size_.store(std::min(pool_size + growth, max_pool_size_), std::memory_order_relaxed);
         
         // Pre-allocate additional buffers
         AdjustPoolSize();
         
-    } else if (period_hit_rate > 5.0 && pool_size_ > min_pool_size_) {
+    } else if (period_hit_rate > 5.0 && pool_size > min_pool_size_) {
         // Hit rate too high - pool might be over-sized, shrink by 10%
-        size_t shrink = std::max<size_t>(5, pool_size_ / 10); // At least 5, or 10%
-        pool_size_ = std::max(pool_size_ - shrink, min_pool_size_);
+        size_t shrink = std::max<size_t>(5, pool_size / 10); // At least 5, or 10%
+        pool_size_.store(std::max(pool_size - shrink, min_pool_size_), std::memory_order_relaxed);
         
         // Note: we don't actively delete buffers, just reduce target size
         // Excess buffers will naturally not be retained on Release()
-    }
-    
-    // Log adjustment (optional, can be removed in production)
-    if (old_pool_size != pool_size_) {
-        // Pool size changed - could log here
-        // printf("[BufferPool] Adjusted: %zu -> %zu (hit rate: %.2f%%)\n", 
-        //        old_pool_size, pool_size_, period_hit_rate);
+        ApplyTargets(pool_size_.load(std::memory_order_relaxed));
     }
 }
 
@@ -334,26 +507,16 @@ void BufferPool::EvaluateAndAdjust() {
 void BufferPool::AdjustPoolSize() {
     // Called with pool_mutex_ already locked
     
-    size_t current_available = available_buffers_.size();
-    size_t target_size = pool_size_;
+    size_t target_size = pool_size_.load(std::memory_order_relaxed);
+    ApplyTargets(target_size);
     
-    if (current_available < target_size) {
-        // Need to pre-allocate more buffers
-        size_t needed = target_size - current_available;
-        available_buffers_.reserve(target_size);
-        
-        for (size_t i = 0; i < needed; ++i) {
-            try {
-                auto buffer = std::make_shared<ExternalBuffer>(buffer_size_, this);
-                available_buffers_.push_back(buffer);
-            } catch (const std::exception& e) {
-                // Allocation failed - stop growing
-                break;
-            }
-        }
+    // Need to pre-allocate more buffers (default request size only)
+    size_t index = ClassIndex(buffer_size_);
+    if (index < kClassCount) {
+        classes_[index]->Fill(target_size);
     }
     // Note: shrinking happens naturally as buffers are not retained
-    // when available_buffers_.size() >= pool_size_ in Release()
+    // when a size class is above its target in Recycle()
 }
 
 // ============================================================================
@@ -390,7 +553,7 @@ void ExternalBufferFactory::InitializeAdaptive(size_t buffer_size,
         buffer_pool_.reset();
     }
     
-    buffer_pool_ = std::make_unique<BufferPool>(buffer_size, initial_pool_size);
+    buffer_pool_ = std::make_unique<BufferPool>(buffer_size, initial_pool_size, max_pool_size);
     buffer_pool_->SetStrategy(PoolStrategy::Adaptive); // Adaptive strategy
     buffer_pool_->SetMinMaxPoolSize(min_pool_size, max_pool_size);
 }
@@ -406,6 +569,17 @@ std::shared_ptr<ExternalBuffer> ExternalBufferFactory::Create() {
     return buffer_pool_->Acquire();
 }
 
+// v2.12: Acquire a buffer large enough for min_size bytes (size-classed pool)
+std::shared_ptr<ExternalBuffer> ExternalBufferFactory::Create(size_t min_size) {
+    std::lock_guard<std::mutex> lock(factory_mutex_);
+    
+    if (!buffer_pool_) {
+        buffer_pool_ = std::make_unique<BufferPool>(4096, 10);
+    }
+    
+    return buffer_pool_->Acquire(min_size);
+}
+
 BufferPool::Stats ExternalBufferFactory::GetStats() const {
     std::lock_guard<std::mutex> lock(factory_mutex_);
     
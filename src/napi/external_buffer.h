@@ -15,6 +15,7 @@
 #include <mutex>
 #include <vector>
 #include <atomic>
+#include <array>
 
 namespace AudioCapture {
 
@@ -49,6 +50,8 @@ public:
     int RefCount() const { return ref_count_.load(); }
 
 private:
+    friend class BufferPool;
+
     void* data_;
     size_t size_;
     std::atomic<int> ref_count_;
@@ -70,16 +73,38 @@ enum class PoolStrategy {
  * Falls back to dynamic allocation when pool is exhausted.
  * 
  * v2.7: Supports adaptive pool sizing to optimize hit rate (target: 2-5%)
+ * 
+ * v2.12: Power-of-two size classes (256 B - 1 MB), each with its own small
+ * mutex-protected freelist, so packets of any size up to 1 MB are pooled.
+ * Idle buffers are retained per class by a shared byte budget. Size classes
+ * are reference counted by their outstanding buffers, so a buffer still held
+ * by JavaScript can safely be released after the pool itself is gone.
  */
 class BufferPool {
 public:
-    BufferPool(size_t buffer_size, size_t pool_size);
+    static constexpr size_t kMinClassShift = 8;    // 256 B
+    static constexpr size_t kMaxClassShift = 20;   // 1 MB
+    static constexpr size_t kClassCount = kMaxClassShift - kMinClassShift + 1;
+    static constexpr size_t kMinClassTarget = 2;   // Idle buffers kept by any size class
+
+    /**
+     * @param buffer_size Default request size (pre-allocated class)
+     * @param pool_size Buffers retained for the default request size; other
+     *        size classes retain the same number of bytes (at least
+     *        kMinClassTarget buffers, at most pool_size)
+     * @param max_pool_size Slot capacity per size class (0 = pool_size)
+     */
+    BufferPool(size_t buffer_size, size_t pool_size, size_t max_pool_size = 0);
     ~BufferPool();
 
     // Acquire a buffer (from pool or allocate new)
     std::shared_ptr<ExternalBuffer> Acquire();
 
-    // Return buffer to pool (called by finalize callback)
+    // v2.12: Acquire a buffer of at least min_size bytes from its size class
+    // Requests above the largest class get a dedicated, unpooled buffer
+    std::shared_ptr<ExternalBuffer> Acquire(size_t min_size);
+
+    // Return buffer to pool (intrusive ExternalBuffer::Release path)
     void Release(ExternalBuffer* buffer);
 
     // Statistics
@@ -94,6 +119,18 @@ public:
 
     Stats GetStats() const;
     void ResetStats();
+    
+    // v2.12: Default request size in bytes
+    size_t BufferSize() const { return buffer_size_; }
+    
+    // v2.12: Largest request served from a size class
+    static constexpr size_t MaxPooledSize() { return size_t(1) << kMaxClassShift; }
+    
+    // v2.12: Size class index for a request (kClassCount if unpooled)
+    static size_t ClassIndex(size_t size);
+
+    // v2.12: Idle buffers retained by the size class serving size (0 if unpooled)
+    size_t RetainTarget(size_t size) const;
 
     // v2.7: Adaptive pool management
     void SetStrategy(PoolStrategy strategy) { strategy_ = strategy; }
@@ -101,16 +138,21 @@ public:
     void EvaluateAndAdjust(); // Periodic evaluation (called every 10s)
 
 private:
+    class SizeClass;  // v2.12: Freelist for one power-of-two size
+
     void AdjustPoolSize(); // Internal: grow or shrink pool based on stats
+    size_t ClassTarget(size_t index, size_t pool_size) const;  // v2.12: Byte-budget target
+    void ApplyTargets(size_t pool_size);
     
     size_t buffer_size_;
-    size_t pool_size_;        // Current target pool size
+    std::atomic<size_t> pool_size_;  // Current target pool size (default request class)
     size_t min_pool_size_;    // v2.7: Minimum pool size (default: 10)
     size_t max_pool_size_;    // v2.7: Maximum pool size (default: 200)
+    size_t slot_capacity_;    // v2.12: Buffers per size class (upper bound for max_pool_size_)
     PoolStrategy strategy_;   // v2.7: Adjustment strategy
 
-    std::vector<std::shared_ptr<ExternalBuffer>> available_buffers_;
-    mutable std::mutex pool_mutex_;
+    std::array<std::shared_ptr<SizeClass>, kClassCount> classes_;
+    mutable std::mutex pool_mutex_;  // v2.12: Guards evaluation/config (each size class has its own lock)
 
     // Statistics
     mutable std::atomic<uint64_t> pool_hits_{0};
@@ -127,6 +169,8 @@ private:
  * 
  * Singleton factory for creating external buffers with proper lifecycle management.
  * v2.7: Supports adaptive pool sizing for optimal performance
+ * v2.12: AudioProcessor owns its own BufferPool; the factory is kept for
+ * standalone users of the shared pool only.
  */
 class ExternalBufferFactory {
 public:
@@ -143,6 +187,11 @@ public:
 
     // Create external buffer (using pool if available)
     std::shared_ptr<ExternalBuffer> Create();
+    
+    // v2.12: Create buffer with at least min_size bytes
+    // Served from the matching size class; requests above the largest
+    // class get a dedicated (unpooled) buffer instead of failing
+    std::shared_ptr<ExternalBuffer> Create(size_t min_size);
 
     // Get buffer pool statistics
     BufferPool::Stats GetStats() const;
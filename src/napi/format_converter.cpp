@@ -0,0 +1,372 @@
+/**
+ * Format Converter Implementation
+ */
+
+#include "format_converter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(AUDIO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace wasapi_capture {
+
+namespace {
+
+constexpr float kInt16Scale = 32768.0f;  // Full scale 1.0 (matches the Int16 level kernels)
+constexpr float kInt16Min = -32768.0f;
+constexpr float kInt16Max = 32767.0f;
+constexpr float kMinus3dB = 0.70710678f;
+
+}  // namespace
+
+bool ParseSampleFormat(const std::string& name, SampleFormat& format) {
+    if (name == "float32") {
+        format = SampleFormat::Float32;
+    } else if (name == "int16") {
+        format = SampleFormat::Int16;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* SampleFormatName(SampleFormat format) {
+    return format == SampleFormat::Int16 ? "int16" : "float32";
+}
+
+namespace format_kernels {
+
+// ========== Scalar (reference) ==========
+
+void FloatToInt16Scalar(const float* input, const float* dither, int16_t* output, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float v = input[i] * kInt16Scale;
+        if (dither) {
+            v += dither[i];
+        }
+        // NaN clamps to the minimum, like the SIMD max instructions
+        if (!(v >= kInt16Min)) {
+            v = kInt16Min;
+        } else if (v > kInt16Max) {
+            v = kInt16Max;
+        }
+        output[i] = static_cast<int16_t>(std::lrint(v));  // Round half to even
+    }
+}
+
+void MixStereoScalar(const float* input, float w0, float w1, float* output, size_t frames) {
+    for (size_t i = 0; i < frames; i++) {
+        output[i] = w0 * input[2 * i] + w1 * input[2 * i + 1];
+    }
+}
+
+#if defined(AUDIO_SIMD_X86)
+
+// ========== SSE2 ==========
+
+void FloatToInt16Sse2(const float* input, const float* dither, int16_t* output, size_t count) {
+    const __m128 scale = _mm_set1_ps(kInt16Scale);
+    const __m128 lo = _mm_set1_ps(kInt16Min);
+    const __m128 hi = _mm_set1_ps(kInt16Max);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps(input + i), scale);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(input + i + 4), scale);
+        if (dither) {
+            a = _mm_add_ps(a, _mm_loadu_ps(dither + i));
+            b = _mm_add_ps(b, _mm_loadu_ps(dither + i + 4));
+        }
+        // max(v, lo) returns lo for NaN
+        a = _mm_min_ps(_mm_max_ps(a, lo), hi);
+        b = _mm_min_ps(_mm_max_ps(b, lo), hi);
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+    FloatToInt16Scalar(input + i, dither ? dither + i : nullptr, output + i, count - i);
+}
+
+void MixStereoSse2(const float* input, float w0, float w1, float* output, size_t frames) {
+    const __m128 g0 = _mm_set1_ps(w0);
+    const __m128 g1 = _mm_set1_ps(w1);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 a = _mm_loadu_ps(input + 2 * i);      // L0 R0 L1 R1
+        __m128 b = _mm_loadu_ps(input + 2 * i + 4);  // L2 R2 L3 R3
+        __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(output + i, _mm_add_ps(_mm_mul_ps(left, g0), _mm_mul_ps(right, g1)));
+    }
+    MixStereoScalar(input + 2 * i, w0, w1, output + i, frames - i);
+}
+
+// ========== AVX2 ==========
+
+AUDIO_TARGET_AVX2
+void FloatToInt16Avx2(const float* input, const float* dither, int16_t* output, size_t count) {
+    const __m256 scale = _mm256_set1_ps(kInt16Scale);
+    const __m256 lo = _mm256_set1_ps(kInt16Min);
+    const __m256 hi = _mm256_set1_ps(kInt16Max);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 a = _mm256_mul_ps(_mm256_loadu_ps(input + i), scale);
+        __m256 b = _mm256_mul_ps(_mm256_loadu_ps(input + i + 8), scale);
+        if (dither) {
+            a = _mm256_add_ps(a, _mm256_loadu_ps(dither + i));
+            b = _mm256_add_ps(b, _mm256_loadu_ps(dither + i + 8));
+        }
+        a = _mm256_min_ps(_mm256_max_ps(a, lo), hi);
+        b = _mm256_min_ps(_mm256_max_ps(b, lo), hi);
+        // packs works per 128-bit lane: a0-3 b0-3 a4-7 b4-7 -> restore order
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+    }
+    FloatToInt16Sse2(input + i, dither ? dither + i : nullptr, output + i, count - i);
+}
+
+#endif  // AUDIO_SIMD_X86
+
+#if defined(AUDIO_SIMD_NEON)
+
+// ========== NEON ==========
+
+void FloatToInt16Neon(const float* input, const float* dither, int16_t* output, size_t count) {
+    const float32x4_t scale = vdupq_n_f32(kInt16Scale);
+    const float32x4_t lo = vdupq_n_f32(kInt16Min);
+    const float32x4_t hi = vdupq_n_f32(kInt16Max);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vmulq_f32(vld1q_f32(input + i), scale);
+        float32x4_t b = vmulq_f32(vld1q_f32(input + i + 4), scale);
+        if (dither) {
+            a = vaddq_f32(a, vld1q_f32(dither + i));
+            b = vaddq_f32(b, vld1q_f32(dither + i + 4));
+        }
+        // maxnm returns lo for NaN
+        a = vminq_f32(vmaxnmq_f32(a, lo), hi);
+        b = vminq_f32(vmaxnmq_f32(b, lo), hi);
+        int16x8_t packed = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b)));
+        vst1q_s16(output + i, packed);
+    }
+    FloatToInt16Scalar(input + i, dither ? dither + i : nullptr, output + i, count - i);
+}
+
+void MixStereoNeon(const float* input, float w0, float w1, float* output, size_t frames) {
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        float32x4x2_t lr = vld2q_f32(input + 2 * i);  // Deinterleaving load
+        vst1q_f32(output + i, vaddq_f32(vmulq_n_f32(lr.val[0], w0), vmulq_n_f32(lr.val[1], w1)));
+    }
+    MixStereoScalar(input + 2 * i, w0, w1, output + i, frames - i);
+}
+
+#endif  // AUDIO_SIMD_NEON
+
+}  // namespace format_kernels
+
+// ========== Dispatch ==========
+
+namespace {
+
+struct FormatKernelTable {
+    SimdLevel level;
+    void (*toInt16)(const float*, const float*, int16_t*, size_t);
+    void (*mixStereo)(const float*, float, float, float*, size_t);
+};
+
+FormatKernelTable SelectKernels() {
+    using namespace format_kernels;
+    switch (GetBestSimdLevel()) {
+#if defined(AUDIO_SIMD_X86)
+        case SimdLevel::AVX2:
+            return {SimdLevel::AVX2, &FloatToInt16Avx2, &MixStereoSse2};
+        case SimdLevel::SSE2:
+            return {SimdLevel::SSE2, &FloatToInt16Sse2, &MixStereoSse2};
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        case SimdLevel::NEON:
+            return {SimdLevel::NEON, &FloatToInt16Neon, &MixStereoNeon};
+#endif
+        default:
+            return {SimdLevel::Scalar, &FloatToInt16Scalar, &MixStereoScalar};
+    }
+}
+
+const FormatKernelTable& Kernels() {
+    static const FormatKernelTable table = SelectKernels();
+    return table;
+}
+
+}  // namespace
+
+SimdLevel GetFormatKernel() {
+    return Kernels().level;
+}
+
+// ========== FormatConverter ==========
+
+std::vector<float> FormatConverter::DefaultMatrix(uint16_t inputChannels, uint16_t outputChannels) {
+    const size_t in = inputChannels;
+    const size_t out = outputChannels;
+    std::vector<float> matrix(out * in, 0.0f);
+
+    if (out == 1) {
+        std::fill(matrix.begin(), matrix.end(), 1.0f / in);
+    } else if (in == 1) {
+        std::fill(matrix.begin(), matrix.end(), 1.0f);
+    } else if (out == 2 && in > 2) {
+        float* left = matrix.data();
+        float* right = matrix.data() + in;
+        left[0] = 1.0f;
+        right[1] = 1.0f;
+        if (in == 4) {
+            // Quad: FL FR BL BR
+            left[2] = kMinus3dB;
+            right[3] = kMinus3dB;
+        } else {
+            // FL FR FC [LFE] [BL BR] [SL SR]
+            left[2] = kMinus3dB;
+            right[2] = kMinus3dB;
+            for (size_t c = 4; c < in; c++) {
+                (c % 2 == 0 ? left : right)[c] = kMinus3dB;
+            }
+        }
+        for (float* row : {left, right}) {
+            float sum = 0.0f;
+            for (size_t c = 0; c < in; c++) {
+                sum += row[c];
+            }
+            for (size_t c = 0; c < in; c++) {
+                row[c] /= sum;
+            }
+        }
+    } else {
+        for (size_t c = 0; c < std::min(in, out); c++) {
+            matrix[c * in + c] = 1.0f;
+        }
+    }
+    return matrix;
+}
+
+FormatConverter::FormatConverter(const FormatConverterConfig& config)
+    : input_channels_(config.input_channels),
+      output_channels_(config.output_channels > 0 ? config.output_channels : config.input_channels),
+      output_format_(config.output_format),
+      dither_(config.dither && config.output_format == SampleFormat::Int16) {
+    if (input_channels_ == 0 || input_channels_ > kMaxChannels || output_channels_ > kMaxChannels) {
+        throw std::invalid_argument("Channel count must be between 1 and 8");
+    }
+
+    const size_t in = input_channels_;
+    const size_t out = output_channels_;
+    if (config.downmix_matrix.empty()) {
+        matrix_ = DefaultMatrix(input_channels_, output_channels_);
+    } else if (config.downmix_matrix.size() == out * in) {
+        matrix_ = config.downmix_matrix;
+    } else {
+        throw std::invalid_argument("downmixMatrix must have outputChannels x inputChannels entries");
+    }
+
+    bool identity = in == out;
+    for (size_t o = 0; identity && o < out; o++) {
+        for (size_t i = 0; i < in; i++) {
+            if (matrix_[o * in + i] != (o == i ? 1.0f : 0.0f)) {
+                identity = false;
+                break;
+            }
+        }
+    }
+    if (identity) {
+        mix_mode_ = MixMode::Identity;
+    } else if (in == 2 && out == 1) {
+        mix_mode_ = MixMode::Stereo;
+    } else {
+        mix_mode_ = MixMode::Generic;
+    }
+
+    if (mix_mode_ != MixMode::Identity && output_format_ == SampleFormat::Int16) {
+        mix_.assign(kChunkFrames * out, 0.0f);
+    }
+    if (dither_) {
+        noise_.assign(kChunkFrames * out, 0.0f);
+    }
+}
+
+void FormatConverter::Mix(const float* input, size_t frames, float* output) const {
+    if (mix_mode_ == MixMode::Stereo) {
+        Kernels().mixStereo(input, matrix_[0], matrix_[1], output, frames);
+        return;
+    }
+
+    const size_t in = input_channels_;
+    const size_t out = output_channels_;
+    for (size_t f = 0; f < frames; f++) {
+        const float* frame = input + f * in;
+        for (size_t o = 0; o < out; o++) {
+            const float* row = matrix_.data() + o * in;
+            float sum = 0.0f;
+            for (size_t i = 0; i < in; i++) {
+                sum += row[i] * frame[i];
+            }
+            output[f * out + o] = sum;
+        }
+    }
+}
+
+// Triangular PDF in (-1, 1) LSB: difference of two uniform variates (xorshift32)
+void FormatConverter::FillDither(size_t count) {
+    constexpr float kUnit = 1.0f / 16777216.0f;  // 2^-24
+    uint32_t x = rng_state_;
+    for (size_t i = 0; i < count; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        float u1 = static_cast<float>(x >> 8) * kUnit;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        float u2 = static_cast<float>(x >> 8) * kUnit;
+        noise_[i] = u1 - u2;
+    }
+    rng_state_ = x;
+}
+
+size_t FormatConverter::Convert(const float* input, size_t frames, uint8_t* output) {
+    const size_t in = input_channels_;
+    const size_t out = output_channels_;
+
+    for (size_t offset = 0; offset < frames; offset += kChunkFrames) {
+        const size_t n = std::min(kChunkFrames, frames - offset);
+        const float* src = input + offset * in;
+
+        if (output_format_ == SampleFormat::Float32) {
+            float* dst = reinterpret_cast<float*>(output) + offset * out;
+            if (mix_mode_ == MixMode::Identity) {
+                std::memcpy(dst, src, n * out * sizeof(float));
+            } else {
+                Mix(src, n, dst);
+            }
+            continue;
+        }
+
+        const float* mixed = src;
+        if (mix_mode_ != MixMode::Identity) {
+            Mix(src, n, mix_.data());
+            mixed = mix_.data();
+        }
+        const float* noise = nullptr;
+        if (dither_) {
+            FillDither(n * out);
+            noise = noise_.data();
+        }
+        Kernels().toInt16(mixed, noise, reinterpret_cast<int16_t*>(output) + offset * out, n * out);
+    }
+    return OutputBytes(frames);
+}
+
+}  // namespace wasapi_capture
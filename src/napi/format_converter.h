@@ -0,0 +1,134 @@
+/**
+ * Format Converter
+ *
+ * v2.12: Native output format stage (replaces utils/AudioFormatConverter.js
+ * on the capture path). Runs on the processing thread before TSFN delivery,
+ * so JavaScript only receives the bytes it asked for: 48 kHz stereo Float32
+ * -> mono Int16 is a 4x smaller buffer.
+ *
+ * Two steps, both optional:
+ * - Channel mixing through an output x input matrix. Identity and two-input
+ *   (stereo -> mono) matrices have dedicated kernels; anything else uses the
+ *   generic per-frame loop.
+ * - Float32 -> Int16 with saturation (full scale 1.0 = 32768, the same scale
+ *   the Int16 level kernels read back) and optional TPDF dither of +-1 LSB.
+ *
+ * Conversion and stereo mixing use SSE2 / AVX2 / NEON, selected at runtime
+ * like the level kernels. Work is done in fixed chunks, so Convert() never
+ * allocates.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "cpu_features.h"
+
+namespace wasapi_capture {
+
+// Sample type of the delivered buffers
+enum class SampleFormat {
+    Float32,
+    Int16
+};
+
+bool ParseSampleFormat(const std::string& name, SampleFormat& format);
+const char* SampleFormatName(SampleFormat format);
+
+struct FormatConverterConfig {
+    uint16_t input_channels = 2;
+    uint16_t output_channels = 0;           // 0 = same as input
+    SampleFormat output_format = SampleFormat::Float32;
+    std::vector<float> downmix_matrix;      // output_channels x input_channels, row-major (empty = default)
+    bool dither = false;                    // TPDF dither (Int16 output only)
+};
+
+class FormatConverter {
+public:
+    /**
+     * @throws std::invalid_argument for zero/over-limit channel counts or a
+     *         matrix whose size is not output_channels * input_channels
+     */
+    explicit FormatConverter(const FormatConverterConfig& config);
+
+    FormatConverter(const FormatConverter&) = delete;
+    FormatConverter& operator=(const FormatConverter&) = delete;
+
+    /**
+     * Convert interleaved Float32 frames
+     *
+     * @param output Room for OutputBytes(frames) bytes (2-byte aligned for Int16)
+     * @return Bytes written
+     */
+    size_t Convert(const float* input, size_t frames, uint8_t* output);
+
+    size_t OutputBytes(size_t frames) const { return frames * GetOutputBlockAlign(); }
+
+    uint16_t GetInputChannels() const { return input_channels_; }
+    uint16_t GetOutputChannels() const { return output_channels_; }
+    SampleFormat GetOutputFormat() const { return output_format_; }
+    uint16_t GetOutputBitsPerSample() const { return output_format_ == SampleFormat::Int16 ? 16 : 32; }
+    size_t GetOutputBlockAlign() const { return static_cast<size_t>(output_channels_) * GetOutputBitsPerSample() / 8; }
+    bool IsDithering() const { return dither_; }
+    const std::vector<float>& GetMatrix() const { return matrix_; }
+
+    /**
+     * Default mix for a channel count change (WAVE channel order)
+     * - N -> 1: equal-weight average
+     * - 1 -> N: copy to every output
+     * - N -> 2 (N > 2): FL/FR plus -3 dB centre and surrounds, LFE dropped,
+     *   rows normalized so a full-scale input cannot clip
+     * - otherwise: the first min(N, M) channels pass through
+     */
+    static std::vector<float> DefaultMatrix(uint16_t inputChannels, uint16_t outputChannels);
+
+    static constexpr uint16_t kMaxChannels = 8;
+
+private:
+    enum class MixMode { Identity, Stereo, Generic };
+
+    uint16_t input_channels_;
+    uint16_t output_channels_;
+    SampleFormat output_format_;
+    bool dither_;
+    std::vector<float> matrix_;
+    MixMode mix_mode_;
+
+    static constexpr size_t kChunkFrames = 512;
+    audio_capture::AlignedVector<float> mix_;     // kChunkFrames * output_channels
+    audio_capture::AlignedVector<float> noise_;   // TPDF dither, in LSBs
+    uint32_t rng_state_ = 0x9E3779B9u;
+
+    void Mix(const float* input, size_t frames, float* output) const;
+    void FillDither(size_t count);
+};
+
+namespace format_kernels {
+
+// Individual variants (for tests and benchmarks; callers must check the CPU)
+// dither: per-sample offset in LSBs, or nullptr
+void FloatToInt16Scalar(const float* input, const float* dither, int16_t* output, size_t count);
+// output[i] = w0 * input[2i] + w1 * input[2i + 1]
+void MixStereoScalar(const float* input, float w0, float w1, float* output, size_t frames);
+
+#if defined(AUDIO_SIMD_X86)
+void FloatToInt16Sse2(const float* input, const float* dither, int16_t* output, size_t count);
+void FloatToInt16Avx2(const float* input, const float* dither, int16_t* output, size_t count);
+void MixStereoSse2(const float* input, float w0, float w1, float* output, size_t frames);
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+void FloatToInt16Neon(const float* input, const float* dither, int16_t* output, size_t count);
+void MixStereoNeon(const float* input, float w0, float w1, float* output, size_t frames);
+#endif
+
+}  // namespace format_kernels
+
+// Variant used by FormatConverter
+SimdLevel GetFormatKernel();
+
+}  // namespace wasapi_capture
@@ -0,0 +1,109 @@
+/**
+ * Fixed-Size Frame Assembler
+ *
+ * v2.12: Re-chunks the output stage into frames of exactly frameBytes
+ * (e.g. 20 ms / 640 bytes of 16 kHz Int16 mono) for ASR services that
+ * require aligned frames. Each frame is one packet from the caller's pool;
+ * input is copied straight into it, so a frame costs one acquisition and
+ * no intermediate buffers, however the capture packets are split.
+ *
+ * Platform independent; the packet type is supplied by the caller and
+ * needs data(), empty() and Truncate(size).
+ */
+
+#ifndef FRAME_ASSEMBLER_H
+#define FRAME_ASSEMBLER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace AudioCapture {
+
+template <typename Packet>
+class FrameAssembler {
+public:
+    FrameAssembler() = default;
+
+    // 0 disables framing; drops any partial frame
+    void Configure(size_t frameBytes) {
+        frame_bytes_ = frameBytes;
+        Reset();
+    }
+
+    void Reset() {
+        current_ = Packet();
+        fill_ = 0;
+    }
+
+    bool IsEnabled() const { return frame_bytes_ > 0; }
+    size_t FrameBytes() const { return frame_bytes_; }
+    size_t PendingBytes() const { return fill_; }
+    uint64_t DroppedBytes() const { return dropped_bytes_; }
+
+    /**
+     * Append bytes; every completed frame is passed to emit
+     *
+     * @param acquire Packet acquire(size_t bytes) - empty() on failure; the
+     *        bytes that do not fit anywhere are dropped and counted
+     * @param emit void emit(Packet&&)
+     * @return Frames emitted
+     */
+    template <typename Acquire, typename Emit>
+    size_t Push(const uint8_t* data, size_t size, Acquire&& acquire, Emit&& emit) {
+        if (frame_bytes_ == 0) {
+            return 0;
+        }
+        size_t emitted = 0;
+        while (size > 0) {
+            if (current_.empty()) {
+                current_ = acquire(frame_bytes_);
+                fill_ = 0;
+                if (current_.empty()) {
+                    dropped_bytes_ += size;  // Allocation failed
+                    return emitted;
+                }
+            }
+            size_t take = (std::min)(size, frame_bytes_ - fill_);
+            std::memcpy(current_.data() + fill_, data, take);
+            fill_ += take;
+            data += take;
+            size -= take;
+
+            if (fill_ == frame_bytes_) {
+                emit(std::move(current_));
+                current_ = Packet();
+                fill_ = 0;
+                emitted++;
+            }
+        }
+        return emitted;
+    }
+
+    /**
+     * Emit the partial frame, truncated to its filled size (end of stream)
+     * @return true if a frame was emitted
+     */
+    template <typename Emit>
+    bool Flush(Emit&& emit) {
+        if (current_.empty() || fill_ == 0) {
+            Reset();
+            return false;
+        }
+        current_.Truncate(fill_);
+        emit(std::move(current_));
+        Reset();
+        return true;
+    }
+
+private:
+    size_t frame_bytes_ = 0;
+    Packet current_;
+    size_t fill_ = 0;
+    uint64_t dropped_bytes_ = 0;
+};
+
+}  // namespace AudioCapture
+
+#endif  // FRAME_ASSEMBLER_H
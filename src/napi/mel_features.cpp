@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025 node-windows-audio-capture contributors
+
+#include "mel_features.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace audio_capture {
+
+float MelFeatureExtractor::HzToMel(float hz) {
+    return 1127.0f * std::log(1.0f + hz / 700.0f);
+}
+
+float MelFeatureExtractor::MelToHz(float mel) {
+    return 700.0f * (std::exp(mel / 1127.0f) - 1.0f);
+}
+
+MelFeatureExtractor::MelFeatureExtractor(const MelFeatureConfig& config)
+    : config_(config) {
+    if (config_.sample_rate <= 0) {
+        throw std::invalid_argument("sample_rate must be positive");
+    }
+    config_.num_mel_bins = std::max(1, std::min(config_.num_mel_bins, 256));
+    config_.cmvn_window = std::max(1, config_.cmvn_window);
+
+    window_length_ = std::max<size_t>(4, static_cast<size_t>(std::lround(config_.sample_rate * config_.window_ms / 1000.0)));
+    hop_length_ = std::max<size_t>(1, static_cast<size_t>(std::lround(config_.sample_rate * config_.hop_ms / 1000.0)));
+    fft_size_ = 4;
+    while (fft_size_ < window_length_) {
+        fft_size_ <<= 1;
+    }
+
+    fft_ = std::make_unique<RealFFT>(fft_size_);
+    fft_in_.assign(fft_size_, 0.0f);
+    fft_re_.assign(fft_->BinCount(), 0.0f);
+    fft_im_.assign(fft_->BinCount(), 0.0f);
+    power_.assign(fft_->BinCount(), 0.0f);
+
+    // Hann window over the analysis length (zero padding after it)
+    const double pi = 3.14159265358979323846;
+    window_.resize(window_length_);
+    for (size_t i = 0; i < window_length_; i++) {
+        window_[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * pi * i / (window_length_ - 1)));
+    }
+
+    BuildFilterbank();
+
+    ring_.assign(window_length_, 0.0f);
+    features_.assign(config_.num_mel_bins, 0.0f);
+    cmvn_history_.assign(static_cast<size_t>(config_.cmvn_window) * config_.num_mel_bins, 0.0f);
+    cmvn_sum_.assign(config_.num_mel_bins, 0.0);
+    cmvn_sum_sq_.assign(config_.num_mel_bins, 0.0);
+    Reset();
+}
+
+// Triangular filters with edges evenly spaced on the mel scale, evaluated at
+// the FFT bin centres. Only the non-zero weights are stored.
+void MelFeatureExtractor::BuildFilterbank() {
+    const int bins = config_.num_mel_bins;
+    const float nyquist = config_.sample_rate / 2.0f;
+    float max_freq = config_.max_freq > 0.0f ? std::min(config_.max_freq, nyquist) : nyquist;
+    float min_freq = std::max(0.0f, std::min(config_.min_freq, max_freq));
+    config_.min_freq = min_freq;
+    config_.max_freq = max_freq;
+
+    const float mel_min = HzToMel(min_freq);
+    const float mel_step = (HzToMel(max_freq) - mel_min) / (bins + 1);
+    const float bin_hz = config_.sample_rate / static_cast<float>(fft_size_);
+    const size_t fft_bins = fft_->BinCount();
+
+    filter_start_.assign(bins, 0);
+    filter_offset_.assign(bins + 1, 0);
+    weights_.clear();
+
+    for (int m = 0; m < bins; m++) {
+        const float left = mel_min + m * mel_step;
+        const float center = left + mel_step;
+        const float right = center + mel_step;
+
+        filter_offset_[m] = static_cast<uint32_t>(weights_.size());
+        bool started = false;
+        for (size_t k = 0; k < fft_bins; k++) {
+            float mel = HzToMel(k * bin_hz);
+            if (mel <= left) {
+                continue;
+            }
+            if (mel >= right) {
+                break;
+            }
+            float weight = mel <= center ? (mel - left) / mel_step : (right - mel) / mel_step;
+            if (!started) {
+                filter_start_[m] = static_cast<uint32_t>(k);
+                started = true;
+            }
+            weights_.push_back(weight);
+        }
+        if (!started) {
+            filter_start_[m] = 0;  // Narrower than one bin: the filter stays empty
+        }
+    }
+    filter_offset_[bins] = static_cast<uint32_t>(weights_.size());
+}
+
+void MelFeatureExtractor::Reset() {
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    ring_pos_ = 0;
+    hop_remaining_ = window_length_;  // First frame needs a full window
+    stream_position_ = 0;
+
+    cmvn_count_ = 0;
+    cmvn_pos_ = 0;
+    std::fill(cmvn_sum_.begin(), cmvn_sum_.end(), 0.0);
+    std::fill(cmvn_sum_sq_.begin(), cmvn_sum_sq_.end(), 0.0);
+}
+
+void MelFeatureExtractor::PushMono(const float* interleaved, size_t frames, int channels) {
+    const size_t size = ring_.size();
+    const float scale = 1.0f / channels;
+
+    for (size_t f = 0; f < frames; f++) {
+        const float* frame = interleaved + f * channels;
+        float sum = frame[0];
+        for (int c = 1; c < channels; c++) {
+            sum += frame[c];
+        }
+        ring_[ring_pos_] = sum * scale;
+        if (++ring_pos_ == size) {
+            ring_pos_ = 0;
+        }
+    }
+    stream_position_ += frames;
+}
+
+void MelFeatureExtractor::ComputeFrame() {
+    const size_t size = ring_.size();
+    const size_t first = size - ring_pos_;
+    float* in = fft_in_.data();
+
+    // Oldest sample first
+    std::copy(ring_.begin() + ring_pos_, ring_.end(), in);
+    std::copy(ring_.begin(), ring_.begin() + ring_pos_, in + first);
+
+    // DC removal, pre-emphasis (backwards, in place) and window
+    double mean = 0.0;
+    for (size_t i = 0; i < size; i++) {
+        mean += in[i];
+    }
+    const float dc = static_cast<float>(mean / size);
+    for (size_t i = 0; i < size; i++) {
+        in[i] -= dc;
+    }
+    const float p = config_.preemphasis;
+    if (p != 0.0f) {
+        for (size_t i = size - 1; i > 0; i--) {
+            in[i] -= p * in[i - 1];
+        }
+        in[0] -= p * in[0];
+    }
+    for (size_t i = 0; i < size; i++) {
+        in[i] *= window_[i];
+    }
+    std::fill(in + size, in + fft_size_, 0.0f);
+
+    fft_->Forward(in, fft_re_.data(), fft_im_.data());
+
+    const size_t fft_bins = fft_->BinCount();
+    for (size_t k = 0; k < fft_bins; k++) {
+        power_[k] = fft_re_[k] * fft_re_[k] + fft_im_[k] * fft_im_[k];
+    }
+
+    // Sparse filterbank + log
+    const int bins = config_.num_mel_bins;
+    for (int m = 0; m < bins; m++) {
+        const float* w = weights_.data() + filter_offset_[m];
+        const float* pw = power_.data() + filter_start_[m];
+        const size_t n = filter_offset_[m + 1] - filter_offset_[m];
+        float energy = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            energy += w[i] * pw[i];
+        }
+        features_[m] = std::log(std::max(energy, config_.log_floor));
+    }
+
+    if (config_.cmvn != CmvnMode::None) {
+        ApplyCmvn();
+    }
+}
+
+// Statistics over the last cmvn_window frames, current frame included
+void MelFeatureExtractor::ApplyCmvn() {
+    const size_t bins = static_cast<size_t>(config_.num_mel_bins);
+    const size_t window = static_cast<size_t>(config_.cmvn_window);
+    float* slot = cmvn_history_.data() + cmvn_pos_ * bins;
+
+    for (size_t m = 0; m < bins; m++) {
+        if (cmvn_count_ == window) {
+            // Evict the oldest frame
+            cmvn_sum_[m] -= slot[m];
+            cmvn_sum_sq_[m] -= static_cast<double>(slot[m]) * slot[m];
+        }
+        slot[m] = features_[m];
+        cmvn_sum_[m] += features_[m];
+        cmvn_sum_sq_[m] += static_cast<double>(features_[m]) * features_[m];
+    }
+    cmvn_count_ = std::min(cmvn_count_ + 1, window);
+    cmvn_pos_ = (cmvn_pos_ + 1) % window;
+
+    const double inv_n = 1.0 / cmvn_count_;
+    for (size_t m = 0; m < bins; m++) {
+        double mean = cmvn_sum_[m] * inv_n;
+        double value = features_[m] - mean;
+        if (config_.cmvn == CmvnMode::MeanVariance) {
+            double var = cmvn_sum_sq_[m] * inv_n - mean * mean;
+            value /= std::sqrt(std::max(var, 1e-10));
+        }
+        features_[m] = static_cast<float>(value);
+    }
+}
+
+} // namespace audio_capture
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025 node-windows-audio-capture contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "real_fft.h"
+#include "aligned_buffer.h"
+
+namespace audio_capture {
+
+// v2.12: Cepstral mean / variance normalization over a sliding window of frames
+enum class CmvnMode {
+    None,
+    Mean,          // Subtract the mean
+    MeanVariance   // Subtract the mean, divide by the standard deviation
+};
+
+// 对数 Mel 特征配置 (ASR 前端)
+struct MelFeatureConfig {
+    int sample_rate;       // 输入采样率 (Hz)
+    int num_mel_bins;      // Mel 滤波器数量
+    float window_ms;       // 分析窗长 (ms)
+    float hop_ms;          // 帧移 (ms)
+    float min_freq;        // 最低频率 (Hz)
+    float max_freq;        // 最高频率 (Hz, <= 0: Nyquist)
+    float preemphasis;     // 预加重系数 (0 = off)
+    float log_floor;       // log(max(energy, log_floor))
+    CmvnMode cmvn;
+    int cmvn_window;       // CMVN 滑动窗口 (帧)
+
+    // Kaldi / Whisper-style defaults: 80 bins, 25 ms window, 10 ms hop
+    MelFeatureConfig()
+        : sample_rate(48000),
+          num_mel_bins(80),
+          window_ms(25.0f),
+          hop_ms(10.0f),
+          min_freq(20.0f),
+          max_freq(8000.0f),
+          preemphasis(0.97f),
+          log_floor(1e-10f),
+          cmvn(CmvnMode::None),
+          cmvn_window(300) {}
+};
+
+/**
+ * v2.12: Streaming log-mel feature extractor
+ *
+ * Interleaved capture samples are downmixed to mono into a sliding window
+ * (same scheme as SpectrumAnalyzer::ProcessStream). Every hop the window is
+ * pre-emphasized, Hann-windowed, zero-padded to the next power of two and
+ * transformed with RealFFT; the power spectrum goes through a sparse
+ * triangular mel filterbank (HTK mel scale), then log and optional CMVN.
+ *
+ * Features are computed at the capture rate; the filterbank only covers
+ * min_freq..max_freq, so no resampling is needed for 16 kHz-style features.
+ */
+class MelFeatureExtractor {
+public:
+    explicit MelFeatureExtractor(const MelFeatureConfig& config);
+
+    MelFeatureExtractor(const MelFeatureExtractor&) = delete;
+    MelFeatureExtractor& operator=(const MelFeatureExtractor&) = delete;
+
+    /**
+     * @param on_frame Called as on_frame(const float* features, uint64_t position)
+     *        with GetNumBins() values; position is the mono sample count at the
+     *        end of the frame's window
+     * @return Number of frames produced
+     */
+    template <typename OnFrame>
+    size_t ProcessStream(const float* interleaved, size_t frames, int channels, OnFrame&& on_frame) {
+        if (!interleaved || channels <= 0) {
+            return 0;
+        }
+        size_t produced = 0;
+        size_t offset = 0;
+        while (offset < frames) {
+            size_t take = (std::min)(frames - offset, hop_remaining_);
+            PushMono(interleaved + offset * channels, take, channels);
+            offset += take;
+            hop_remaining_ -= take;
+
+            if (hop_remaining_ == 0) {
+                hop_remaining_ = hop_length_;
+                ComputeFrame();
+                on_frame(static_cast<const float*>(features_.data()), stream_position_);
+                produced++;
+            }
+        }
+        return produced;
+    }
+
+    // Drop buffered samples and CMVN history
+    void Reset();
+
+    const MelFeatureConfig& GetConfig() const { return config_; }
+    int GetNumBins() const { return config_.num_mel_bins; }
+    size_t GetWindowLength() const { return window_length_; }
+    size_t GetHopLength() const { return hop_length_; }
+    size_t GetFFTSize() const { return fft_size_; }
+
+    // Filter i covers FFT bins [FilterStart(i), FilterStart(i) + weights)
+    size_t GetFilterStart(int mel) const { return filter_start_[mel]; }
+    size_t GetFilterLength(int mel) const { return filter_offset_[mel + 1] - filter_offset_[mel]; }
+
+    static float HzToMel(float hz);
+    static float MelToHz(float mel);
+
+private:
+    MelFeatureConfig config_;
+    size_t window_length_;
+    size_t hop_length_;
+    size_t fft_size_;
+
+    std::unique_ptr<RealFFT> fft_;
+    AlignedVector<float> fft_in_;
+    AlignedVector<float> fft_re_;
+    AlignedVector<float> fft_im_;
+    AlignedVector<float> power_;
+    std::vector<float> window_;
+
+    // Sparse filterbank: weights for filter i are weights_[filter_offset_[i] ..
+    // filter_offset_[i + 1]), applied from bin filter_start_[i]
+    std::vector<uint32_t> filter_start_;
+    std::vector<uint32_t> filter_offset_;
+    std::vector<float> weights_;
+
+    // Streaming state
+    std::vector<float> ring_;       // Mono sliding window (window_length)
+    size_t ring_pos_ = 0;
+    size_t hop_remaining_ = 0;
+    uint64_t stream_position_ = 0;
+    AlignedVector<float> features_;  // Current frame
+
+    // CMVN history (cmvn_window frames) and running sums
+    std::vector<float> cmvn_history_;
+    size_t cmvn_count_ = 0;
+    size_t cmvn_pos_ = 0;
+    std::vector<double> cmvn_sum_;
+    std::vector<double> cmvn_sum_sq_;
+
+    void BuildFilterbank();
+    void PushMono(const float* interleaved, size_t frames, int channels);
+    void ComputeFrame();
+    void ApplyCmvn();
+};
+
+} // namespace audio_capture
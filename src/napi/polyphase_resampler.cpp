@@ -0,0 +1,341 @@
+/**
+ * Polyphase Resampler Implementation
+ */
+
+#include "polyphase_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#if defined(AUDIO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace wasapi_capture {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+struct QualityParams {
+    int zeroCrossings;  // Per side, at the cutoff frequency
+    double beta;        // Kaiser window shape
+    double rolloff;     // Cutoff as a fraction of the lower Nyquist frequency
+};
+
+QualityParams GetQualityParams(ResampleQuality quality) {
+    switch (quality) {
+        case ResampleQuality::Fast:
+            return {8, 5.65, 0.85};
+        case ResampleQuality::Best:
+            return {32, 10.0, 0.95};
+        case ResampleQuality::Balanced:
+        default:
+            return {16, 8.0, 0.91};
+    }
+}
+
+// Zeroth-order modified Bessel function of the first kind (power series)
+double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfSq = x * x / 4.0;
+    for (int k = 1; k < 64; k++) {
+        term *= halfSq / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+}  // namespace
+
+bool ParseResampleQuality(const std::string& name, ResampleQuality& quality) {
+    if (name == "fast") {
+        quality = ResampleQuality::Fast;
+    } else if (name == "balanced") {
+        quality = ResampleQuality::Balanced;
+    } else if (name == "best") {
+        quality = ResampleQuality::Best;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ResampleQualityName(ResampleQuality quality) {
+    switch (quality) {
+        case ResampleQuality::Fast: return "fast";
+        case ResampleQuality::Best: return "best";
+        default: return "balanced";
+    }
+}
+
+namespace resampler_kernels {
+
+// ========== Scalar (reference) ==========
+
+float DotScalar(const float* a, const float* b, size_t n) {
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+    for (size_t i = 0; i < n; i += 4) {
+        acc0 += a[i] * b[i];
+        acc1 += a[i + 1] * b[i + 1];
+        acc2 += a[i + 2] * b[i + 2];
+        acc3 += a[i + 3] * b[i + 3];
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+#if defined(AUDIO_SIMD_X86)
+
+// ========== SSE2 ==========
+
+float DotSse2(const float* a, const float* b, size_t n) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (size_t i = 0; i < n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 sum = _mm_add_ps(acc0, acc1);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+// ========== AVX2 + FMA ==========
+
+AUDIO_TARGET_AVX2_FMA
+float DotAvx2(const float* a, const float* b, size_t n) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_load_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_load_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    if (i < n) {
+        acc0 = _mm256_fmadd_ps(_mm256_load_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    __m256 sum8 = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+#endif  // AUDIO_SIMD_X86
+
+#if defined(AUDIO_SIMD_NEON)
+
+// ========== NEON ==========
+
+float DotNeon(const float* a, const float* b, size_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (size_t i = 0; i < n; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1));
+}
+
+#endif  // AUDIO_SIMD_NEON
+
+}  // namespace resampler_kernels
+
+// ========== Dispatch ==========
+
+namespace {
+
+struct DotKernel {
+    SimdLevel level;
+    float (*dot)(const float*, const float*, size_t);
+};
+
+DotKernel SelectDotKernel() {
+    using namespace resampler_kernels;
+    switch (GetBestSimdLevel()) {
+#if defined(AUDIO_SIMD_X86)
+        case SimdLevel::AVX2:
+            if (GetCpuFeatures().fma) {
+                return {SimdLevel::AVX2, &DotAvx2};
+            }
+            return {SimdLevel::SSE2, &DotSse2};
+        case SimdLevel::SSE2:
+            return {SimdLevel::SSE2, &DotSse2};
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        case SimdLevel::NEON:
+            return {SimdLevel::NEON, &DotNeon};
+#endif
+        default:
+            return {SimdLevel::Scalar, &DotScalar};
+    }
+}
+
+const DotKernel& Kernel() {
+    static const DotKernel kernel = SelectDotKernel();
+    return kernel;
+}
+
+}  // namespace
+
+SimdLevel GetResamplerKernel() {
+    return Kernel().level;
+}
+
+// ========== PolyphaseResampler ==========
+
+PolyphaseResampler::PolyphaseResampler(uint32_t inputRate, uint32_t outputRate, uint16_t channels,
+                                       ResampleQuality quality)
+    : input_rate_(inputRate), output_rate_(outputRate), channels_(channels) {
+    if (inputRate == 0 || outputRate == 0 || channels == 0) {
+        throw std::invalid_argument("Sample rates and channel count must be positive");
+    }
+    uint32_t divisor = std::gcd(inputRate, outputRate);
+    L_ = outputRate / divisor;
+    M_ = inputRate / divisor;
+    if (L_ > kMaxPhases) {
+        throw std::invalid_argument("Unsupported resampling ratio");
+    }
+
+    DesignFilter(quality);
+
+    next_phase_.resize(L_);
+    advance_.resize(L_);
+    for (uint32_t p = 0; p < L_; p++) {
+        next_phase_[p] = (p + M_) % L_;
+        advance_[p] = (p + M_) / L_;
+    }
+
+    capacity_ = taps_ + kChunkFrames;
+    history_.resize(channels_);
+    for (auto& h : history_) {
+        h.assign(capacity_, 0.0f);
+    }
+    Reset();
+}
+
+// Kaiser-windowed sinc, cutoff at rolloff * min(input, output) / 2
+void PolyphaseResampler::DesignFilter(ResampleQuality quality) {
+    const QualityParams params = GetQualityParams(quality);
+    const double scale = std::min(1.0, static_cast<double>(L_) / M_);
+    const double fc = params.rolloff * scale / 2.0;            // Cycles per input sample
+    const double halfWidth = params.zeroCrossings / (2.0 * fc);  // Input samples
+
+    taps_ = 2 * static_cast<size_t>(std::ceil(halfWidth));
+    taps_ = (taps_ + 7) & ~size_t(7);
+
+    coefficients_.assign(static_cast<size_t>(L_) * taps_, 0.0f);
+    const double i0Beta = BesselI0(params.beta);
+    const double center = static_cast<double>(taps_ / 2) - 1.0;
+
+    for (uint32_t p = 0; p < L_; p++) {
+        float* row = coefficients_.data() + static_cast<size_t>(p) * taps_;
+        double sum = 0.0;
+        for (size_t i = 0; i < taps_; i++) {
+            // Tap i sees input sample (base - K/2 + 1 + i); its distance to the output instant
+            double t = static_cast<double>(p) / L_ + center - static_cast<double>(i);
+            double value = 0.0;
+            if (std::fabs(t) < halfWidth) {
+                double x = 2.0 * fc * t;
+                double sinc = std::fabs(x) < 1e-12 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+                double r = t / halfWidth;
+                value = 2.0 * fc * sinc * BesselI0(params.beta * std::sqrt(1.0 - r * r)) / i0Beta;
+            }
+            row[i] = static_cast<float>(value);
+            sum += value;
+        }
+        // Unity DC gain for every phase
+        if (sum != 0.0) {
+            for (size_t i = 0; i < taps_; i++) {
+                row[i] = static_cast<float>(row[i] / sum);
+            }
+        }
+    }
+}
+
+void PolyphaseResampler::Reset() {
+    // K/2 - 1 samples of silence precede the stream, so output 0 lines up with input 0
+    fill_ = taps_ / 2 - 1;
+    next_start_ = 0;
+    phase_ = 0;
+    for (auto& h : history_) {
+        std::fill(h.begin(), h.end(), 0.0f);
+    }
+}
+
+size_t PolyphaseResampler::MaxOutputFrames(size_t inputFrames) const {
+    return static_cast<size_t>((static_cast<uint64_t>(inputFrames + taps_) * L_) / M_) + 2;
+}
+
+size_t PolyphaseResampler::Process(const float* input, size_t frames, float* output) {
+    size_t produced = 0;
+    size_t offset = 0;
+    while (offset < frames) {
+        size_t count = std::min(frames - offset, capacity_ - fill_);
+
+        // Deinterleave into the planar history
+        const float* src = input + offset * channels_;
+        for (uint16_t c = 0; c < channels_; c++) {
+            float* dst = history_[c].data() + fill_;
+            for (size_t i = 0; i < count; i++) {
+                dst[i] = src[i * channels_ + c];
+            }
+        }
+        fill_ += count;
+        offset += count;
+
+        produced += Drain(output + produced * channels_);
+    }
+    return produced;
+}
+
+// Emit every output whose taps are all buffered, then drop consumed input
+size_t PolyphaseResampler::Drain(float* output) {
+    const auto dot = Kernel().dot;
+    const size_t taps = taps_;
+    size_t produced = 0;
+
+    if (L_ == 1) {
+        // Integer decimation: one phase, constant step
+        const float* coef = coefficients_.data();
+        for (; next_start_ + taps <= fill_; next_start_ += M_) {
+            for (uint16_t c = 0; c < channels_; c++) {
+                output[produced * channels_ + c] = dot(coef, history_[c].data() + next_start_, taps);
+            }
+            produced++;
+        }
+    } else {
+        for (; next_start_ + taps <= fill_; produced++) {
+            const float* coef = coefficients_.data() + static_cast<size_t>(phase_) * taps;
+            for (uint16_t c = 0; c < channels_; c++) {
+                output[produced * channels_ + c] = dot(coef, history_[c].data() + next_start_, taps);
+            }
+            next_start_ += advance_[phase_];
+            phase_ = next_phase_[phase_];
+        }
+    }
+
+    size_t shift = std::min(next_start_, fill_);
+    if (shift > 0) {
+        for (auto& h : history_) {
+            std::memmove(h.data(), h.data() + shift, (fill_ - shift) * sizeof(float));
+        }
+        fill_ -= shift;
+        next_start_ -= shift;
+    }
+    return produced;
+}
+
+}  // namespace wasapi_capture
@@ -0,0 +1,128 @@
+/**
+ * Polyphase Resampler
+ *
+ * v2.12: Streaming rational-ratio sample rate conversion for the native
+ * output stage (replaces lib/audio-resampler.js + sinc-interpolator.js on
+ * the capture path).
+ *
+ * The ratio is reduced to L/M (output/input). A Kaiser-windowed sinc
+ * prototype is designed once and split into L phase filters of K taps,
+ * stored in reverse order so every output sample is one contiguous dot
+ * product against the input history. The dot product uses SSE2 / AVX2+FMA /
+ * NEON, selected at runtime like the level kernels.
+ *
+ * Fast paths:
+ * - Integer decimation (L == 1, e.g. 48 kHz -> 16 kHz = 1:3): single phase,
+ *   constant input step, no table lookups
+ * - Other rational ratios (e.g. 48 kHz -> 44.1 kHz = 147:160): next-phase and
+ *   input-advance tables, so the inner loop never divides
+ *
+ * Unlike the JS sinc path, the cutoff follows the lower of the two Nyquist
+ * frequencies, so downsampling is properly anti-aliased.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "cpu_features.h"
+
+namespace wasapi_capture {
+
+// Filter length / stopband trade-off
+enum class ResampleQuality {
+    Fast,      // 8 zero crossings per side, ~-60 dB stopband
+    Balanced,  // 16 zero crossings per side, ~-85 dB stopband (default)
+    Best       // 32 zero crossings per side, ~-100 dB stopband
+};
+
+bool ParseResampleQuality(const std::string& name, ResampleQuality& quality);
+const char* ResampleQualityName(ResampleQuality quality);
+
+class PolyphaseResampler {
+public:
+    /**
+     * @throws std::invalid_argument for zero rates/channels or a ratio whose
+     *         reduced numerator exceeds kMaxPhases
+     */
+    PolyphaseResampler(uint32_t inputRate, uint32_t outputRate, uint16_t channels,
+                       ResampleQuality quality = ResampleQuality::Balanced);
+
+    PolyphaseResampler(const PolyphaseResampler&) = delete;
+    PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+    /**
+     * Resample interleaved Float32 frames
+     *
+     * Streaming: input may be split into packets of any size; the output
+     * sequence is identical to resampling the whole stream at once.
+     *
+     * @param output Room for at least MaxOutputFrames(frames) frames
+     * @return Output frames written
+     */
+    size_t Process(const float* input, size_t frames, float* output);
+
+    // Upper bound on the output of one Process() call
+    size_t MaxOutputFrames(size_t inputFrames) const;
+
+    // Forget the stream history (next output starts from silence)
+    void Reset();
+
+    uint32_t GetInputRate() const { return input_rate_; }
+    uint32_t GetOutputRate() const { return output_rate_; }
+    uint16_t GetChannels() const { return channels_; }
+    uint32_t GetInterpolation() const { return L_; }  // L
+    uint32_t GetDecimation() const { return M_; }     // M
+    size_t GetTapsPerPhase() const { return taps_; }
+    // Input samples the filter looks ahead (output lags the input by this much)
+    size_t GetLatencyFrames() const { return taps_ / 2; }
+
+    static constexpr uint32_t kMaxPhases = 1024;
+
+private:
+    uint32_t input_rate_;
+    uint32_t output_rate_;
+    uint16_t channels_;
+    uint32_t L_;
+    uint32_t M_;
+    size_t taps_;  // K, a multiple of 8
+
+    // Phase p occupies coefficients_[p * taps_ .. (p + 1) * taps_), reversed
+    audio_capture::AlignedVector<float> coefficients_;
+    std::vector<uint32_t> next_phase_;  // (p + M) % L
+    std::vector<uint32_t> advance_;     // (p + M) / L
+
+    // Planar history per channel: buffer index i holds input sample origin + i
+    static constexpr size_t kChunkFrames = 1024;
+    size_t capacity_;
+    std::vector<audio_capture::AlignedVector<float>> history_;
+    size_t fill_ = 0;        // Valid samples per channel
+    size_t next_start_ = 0;  // First tap of the next output
+    uint32_t phase_ = 0;
+
+    void DesignFilter(ResampleQuality quality);
+    size_t Drain(float* output);
+};
+
+namespace resampler_kernels {
+
+// Dot product of n floats (n a multiple of 8); a is the coefficient row
+float DotScalar(const float* a, const float* b, size_t n);
+#if defined(AUDIO_SIMD_X86)
+float DotSse2(const float* a, const float* b, size_t n);
+float DotAvx2(const float* a, const float* b, size_t n);
+#endif
+#if defined(AUDIO_SIMD_NEON)
+float DotNeon(const float* a, const float* b, size_t n);
+#endif
+
+}  // namespace resampler_kernels
+
+// Variant used by PolyphaseResampler
+SimdLevel GetResamplerKernel();
+
+}  // namespace wasapi_capture
@@ -0,0 +1,99 @@
+/**
+ * Processing Worker Implementation
+ */
+
+#include "processing_worker.h"
+
+namespace AudioCapture {
+
+ProcessingWorker::ProcessingWorker(size_t slot_count, size_t slot_capacity, Handler handler)
+    : ring_(slot_count, slot_capacity),
+      handler_(std::move(handler)) {
+}
+
+ProcessingWorker::~ProcessingWorker() {
+    Stop();
+}
+
+void ProcessingWorker::Start() {
+    if (running_) return;
+
+    running_ = true;
+    thread_ = std::thread(&ProcessingWorker::ThreadProc, this);
+}
+
+void ProcessingWorker::Stop() {
+    if (!running_) return;
+    running_ = false;
+    wake_.Signal();
+
+    if (thread_.joinable()) thread_.join();
+}
+
+bool ProcessingWorker::Submit(const uint8_t* data, size_t size, size_t align) {
+    if (!ring_.TryPush(data, size, align)) {
+        return false;
+    }
+    packets_submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    // Pairs with the fence in ThreadProc: either the worker sees the new slot
+    // before sleeping, or we see sleeping_ and wake it up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) &&
+        sleeping_.exchange(false, std::memory_order_relaxed)) {
+        wake_.Signal();  // Kernel event / semaphore: no user-space lock on the capture thread
+    }
+    return true;
+}
+
+ProcessingWorker::Stats ProcessingWorker::GetStats() const {
+    return Stats{
+        packets_submitted_.load(std::memory_order_relaxed),
+        packets_processed_.load(std::memory_order_relaxed),
+        ring_.Overruns(),
+        ring_.Size(),
+        ring_.HighWater(),
+        ring_.Capacity()
+    };
+}
+
+void ProcessingWorker::Drain() {
+    SpscPacketRing::Slot slot;
+    while (ring_.Front(slot)) {
+        if (handler_) {
+            try {
+                handler_(slot.data, slot.size);
+            } catch (...) {
+                // Never let a processing error kill the worker thread
+            }
+        }
+        const bool last = slot.last;
+        ring_.Pop();
+        if (last) {
+            // Same unit as packets_submitted_: a split packet counts once
+            packets_processed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ProcessingWorker::ThreadProc() {
+    while (running_) {
+        Drain();
+
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Re-check after announcing the sleep: a slot pushed before the flag was
+        // visible was not signalled. The timeout is only a safety net.
+        if (running_ && ring_.Empty()) {
+            wake_.WaitFor(100);
+        }
+
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    // Process whatever the capture thread queued before Stop()
+    Drain();
+}
+
+} // namespace AudioCapture
@@ -0,0 +1,91 @@
+/**
+ * Processing Worker
+ *
+ * v2.12: Runs the effect chain off the WASAPI capture thread.
+ *
+ * The capture thread (MMCSS "Pro Audio") only calls Submit(), which copies
+ * the packet into a lock-free SPSC ring and signals this worker through a
+ * WakeEvent; it never locks a mutex. The worker
+ * thread drains the ring and invokes the handler (AudioProcessor's effect
+ * chain + JS delivery) for every slot. A slow RNNoise frame therefore no
+ * longer delays ReleaseBuffer() on the capture side.
+ *
+ * Platform independent (std::thread + WakeEvent) so it can be tested with a
+ * synthetic producer on any OS.
+ */
+
+#ifndef PROCESSING_WORKER_H
+#define PROCESSING_WORKER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include "spsc_ring_buffer.h"
+#include "wake_event.h"
+
+namespace AudioCapture {
+
+class ProcessingWorker {
+public:
+    // Called on the worker thread for every queued slot (data may be modified in place)
+    using Handler = std::function<void(uint8_t* data, size_t size)>;
+
+    struct Stats {
+        uint64_t packets_submitted;   // Packets accepted by Submit()
+        uint64_t packets_processed;   // Packets whose slots were all handed to the handler
+        uint64_t overruns;            // Packets dropped because the ring was full
+        size_t queue_depth;           // Slots currently queued
+        size_t queue_high_water;      // Maximum queued slots observed
+        size_t queue_capacity;        // Ring size in slots
+    };
+
+    /**
+     * @param slot_count Ring size in slots
+     * @param slot_capacity Bytes per slot
+     * @param handler Processing callback (worker thread)
+     */
+    ProcessingWorker(size_t slot_count, size_t slot_capacity, Handler handler);
+    ~ProcessingWorker();
+
+    // Disable copy
+    ProcessingWorker(const ProcessingWorker&) = delete;
+    ProcessingWorker& operator=(const ProcessingWorker&) = delete;
+
+    void Start();
+
+    // Stop the worker; packets still queued are processed before returning
+    void Stop();
+
+    bool IsRunning() const { return running_.load(); }
+
+    /**
+     * @brief Producer entry point (capture thread): copy + signal only, lock-free
+     * @param align Bytes per audio frame (oversized packets split on frame boundaries)
+     * @return false if the packet was dropped (ring full)
+     */
+    bool Submit(const uint8_t* data, size_t size, size_t align = 1);
+
+    Stats GetStats() const;
+
+private:
+    void ThreadProc();
+    void Drain();
+
+    SpscPacketRing ring_;
+    Handler handler_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    // Wake-up signalling; the producer signals only while the worker sleeps
+    WakeEvent wake_;
+    std::atomic<bool> sleeping_{false};
+
+    std::atomic<uint64_t> packets_submitted_{0};
+    std::atomic<uint64_t> packets_processed_{0};
+};
+
+} // namespace AudioCapture
+
+#endif // PROCESSING_WORKER_H
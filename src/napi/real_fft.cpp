@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025 node-windows-audio-capture contributors
+
+#include "real_fft.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace audio_capture {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+}
+
+// ========== ComplexFFT ==========
+
+ComplexFFT::ComplexFFT(size_t n) : n_(n) {
+    if (!IsSupportedSize(n)) {
+        throw std::invalid_argument("FFT size must be a power of two");
+    }
+
+    // Bit-reversal permutation as a list of swaps
+    unsigned bits = 0;
+    while ((size_t(1) << bits) < n_) bits++;
+    for (unsigned i = 0; i < n_; i++) {
+        unsigned j = 0;
+        for (unsigned b = 0; b < bits; b++) {
+            if (i & (1u << b)) j |= 1u << (bits - 1 - b);
+        }
+        if (i < j) swaps_.emplace_back(i, j);
+    }
+
+    // Stage with half-length h uses twiddles [h - 1, 2h - 1)
+    twiddle_re_.resize(n_ - 1);
+    twiddle_im_.resize(n_ - 1);
+    for (size_t half = 1; half < n_; half <<= 1) {
+        for (size_t j = 0; j < half; j++) {
+            double angle = -kPi * static_cast<double>(j) / static_cast<double>(half);
+            twiddle_re_[half - 1 + j] = static_cast<float>(std::cos(angle));
+            twiddle_im_[half - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+}
+
+void ComplexFFT::Forward(float* re, float* im) const {
+    for (const auto& [i, j] : swaps_) {
+        float tr = re[i]; re[i] = re[j]; re[j] = tr;
+        float ti = im[i]; im[i] = im[j]; im[j] = ti;
+    }
+
+    // First stage: twiddle is 1
+    for (size_t i = 0; i < n_; i += 2) {
+        float ar = re[i], ai = im[i];
+        float br = re[i + 1], bi = im[i + 1];
+        re[i] = ar + br;     im[i] = ai + bi;
+        re[i + 1] = ar - br; im[i + 1] = ai - bi;
+    }
+
+    for (size_t half = 2; half < n_; half <<= 1) {
+        const float* wr = twiddle_re_.data() + half - 1;
+        const float* wi = twiddle_im_.data() + half - 1;
+        for (size_t start = 0; start < n_; start += 2 * half) {
+            float* ar = re + start;
+            float* ai = im + start;
+            float* br = ar + half;
+            float* bi = ai + half;
+            for (size_t j = 0; j < half; j++) {
+                float tr = br[j] * wr[j] - bi[j] * wi[j];
+                float ti = br[j] * wi[j] + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+    }
+}
+
+// ========== RealFFT ==========
+
+RealFFT::RealFFT(size_t n)
+    : n_(n), half_(IsSupportedSize(n) ? n / 2 : 2) {
+    if (!IsSupportedSize(n)) {
+        throw std::invalid_argument("Real FFT size must be a power of two >= 4");
+    }
+
+    z_re_.resize(n_ / 2);
+    z_im_.resize(n_ / 2);
+    split_re_.resize(n_ / 2 + 1);
+    split_im_.resize(n_ / 2 + 1);
+    for (size_t k = 0; k <= n_ / 2; k++) {
+        double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(n_);
+        split_re_[k] = static_cast<float>(std::cos(angle));
+        split_im_[k] = static_cast<float>(std::sin(angle));
+    }
+}
+
+void RealFFT::Forward(const float* input, float* out_re, float* out_im) {
+    const size_t m = n_ / 2;
+
+    // z[k] = x[2k] + i * x[2k+1]
+    for (size_t k = 0; k < m; k++) {
+        z_re_[k] = input[2 * k];
+        z_im_[k] = input[2 * k + 1];
+    }
+
+    half_.Forward(z_re_.data(), z_im_.data());
+
+    // X[k] = E[k] + W^k * O[k], with
+    //   E[k] = (Z[k] + conj(Z[m-k])) / 2,  O[k] = (Z[k] - conj(Z[m-k])) / 2i
+    for (size_t k = 0; k <= m; k++) {
+        size_t kk = (k == m) ? 0 : k;
+        size_t mk = (k == 0) ? 0 : m - k;
+        float ar = z_re_[kk], ai = z_im_[kk];
+        float br = z_re_[mk], bi = z_im_[mk];
+
+        float er = 0.5f * (ar + br);
+        float ei = 0.5f * (ai - bi);
+        float or_ = 0.5f * (ai + bi);
+        float oi = -0.5f * (ar - br);
+
+        float wr = split_re_[k], wi = split_im_[k];
+        out_re[k] = er + wr * or_ - wi * oi;
+        out_im[k] = ei + wr * oi + wi * or_;
+    }
+}
+
+} // namespace audio_capture
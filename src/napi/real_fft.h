@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025 node-windows-audio-capture contributors
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "aligned_buffer.h"
+
+namespace audio_capture {
+
+/**
+ * v2.12: Planar radix-2 complex FFT (forward, unscaled)
+ *
+ * Real and imaginary parts live in separate aligned arrays. Twiddles are
+ * stored contiguously per stage so the butterfly loop reads them with unit
+ * stride and vectorizes.
+ */
+class ComplexFFT {
+public:
+    // n must be a power of two >= 2
+    explicit ComplexFFT(size_t n);
+
+    // In-place forward transform of n points
+    void Forward(float* re, float* im) const;
+
+    size_t Size() const { return n_; }
+
+    static bool IsSupportedSize(size_t n) { return n >= 2 && (n & (n - 1)) == 0; }
+
+private:
+    size_t n_;
+    std::vector<std::pair<unsigned, unsigned>> swaps_;  // Bit-reversal pairs (i < j)
+    AlignedVector<float> twiddle_re_;                   // Stage twiddles, n - 1 entries
+    AlignedVector<float> twiddle_im_;
+};
+
+/**
+ * v2.12: Real-input FFT (kiss_fftr-style packed transform)
+ *
+ * The n real samples are packed as n/2 complex values, transformed with a
+ * ComplexFFT of half the size and split into the n/2 + 1 non-redundant bins.
+ * Roughly half the work of a complex transform with a zero imaginary part.
+ */
+class RealFFT {
+public:
+    // n must be a power of two >= 4
+    explicit RealFFT(size_t n);
+
+    /**
+     * @param input n real samples
+     * @param out_re, out_im BinCount() values each (bins 0 .. n/2)
+     */
+    void Forward(const float* input, float* out_re, float* out_im);
+
+    size_t Size() const { return n_; }
+    size_t BinCount() const { return n_ / 2 + 1; }
+
+    static bool IsSupportedSize(size_t n) { return n >= 4 && ComplexFFT::IsSupportedSize(n); }
+
+private:
+    size_t n_;
+    ComplexFFT half_;
+    AlignedVector<float> z_re_;   // Packed even/odd samples, n/2
+    AlignedVector<float> z_im_;
+    AlignedVector<float> split_re_;  // exp(-2*pi*i*k/n), k = 0 .. n/2
+    AlignedVector<float> split_im_;
+};
+
+} // namespace audio_capture
@@ -2,7 +2,9 @@
 // Copyright (c) 2025 node-windows-audio-capture contributors
 
 #include "spectrum_analyzer.h"
+#include <cstdio>
 #include <cstring>
+#include <stdexcept>
 
 namespace audio_capture {
 
@@ -20,21 +22,33 @@ const std::vector<std::string> SpectrumAnalyzer::default_band_names_ = {
 SpectrumAnalyzer::SpectrumAnalyzer(const SpectrumConfig& config)
     : config_(config), fft_cfg_(nullptr) {
     
-    // 初始化 FFT (使用 C 包装器)
-    fft_cfg_ = kiss_fft_wrapper_alloc(config_.fft_size);
-    if (!fft_cfg_) {
-        throw std::runtime_error("Failed to allocate FFT configuration");
+    // v2.12: Real input -> packed N/2 transform, half the work of the complex FFT
+    if (config_.use_real_fft && RealFFT::IsSupportedSize(static_cast<size_t>(config_.fft_size))) {
+        real_fft_ = std::make_unique<RealFFT>(static_cast<size_t>(config_.fft_size));
+    } else {
+        // 初始化 FFT (使用 C 包装器)
+        fft_cfg_ = kiss_fft_wrapper_alloc(config_.fft_size);
+        if (!fft_cfg_) {
+            throw std::runtime_error("Failed to allocate FFT configuration");
+        }
+        fft_in_imag_.resize(config_.fft_size, 0.0f);
     }
     
-    // 分配缓冲区
+    // 分配缓冲区 (real path writes N/2 + 1 bins)
     fft_in_real_.resize(config_.fft_size, 0.0f);
-    fft_in_imag_.resize(config_.fft_size, 0.0f);
     fft_out_real_.resize(config_.fft_size, 0.0f);
     fft_out_imag_.resize(config_.fft_size, 0.0f);
     prev_magnitudes_.resize(config_.fft_size / 2, 0.0f);
     
     // 初始化窗函数
     InitializeWindow();
+    BuildBandLayout();
+    BuildBinTable();
+    
+    // v2.12: Streaming STFT window
+    ring_.assign(config_.fft_size, 0.0f);
+    SetHopSize(config_.hop_size);
+    ResetStream();
 }
 
 SpectrumAnalyzer::~SpectrumAnalyzer() {
@@ -60,132 +74,198 @@ void SpectrumAnalyzer::ApplyWindow(const float* samples, size_t count) {
     
     for (size_t i = 0; i < samples_to_process; i++) {
         fft_in_real_[i] = samples[i] * window_[i];
-        fft_in_imag_[i] = 0.0f;
     }
     
     // 如果样本不足，填充零
     for (size_t i = samples_to_process; i < static_cast<size_t>(config_.fft_size); i++) {
         fft_in_real_[i] = 0.0f;
-        fft_in_imag_[i] = 0.0f;
     }
-}
-
-void SpectrumAnalyzer::CalculateMagnitudes(SpectrumResult& result) {
-    // 计算幅度谱
-    result.magnitudes.resize(config_.fft_size / 2);
     
-    for (int i = 0; i < config_.fft_size / 2; i++) {
-        float real = fft_out_real_[i];
-        float imag = fft_out_imag_[i];
-        float magnitude = std::sqrt(real * real + imag * imag) / config_.fft_size;
-        
-        // 指数平滑
-        result.magnitudes[i] = config_.smoothing * magnitude + 
-                               (1.0f - config_.smoothing) * prev_magnitudes_[i];
-        prev_magnitudes_[i] = result.magnitudes[i];
-    }
+    // Complex fallback needs a zero imaginary part
+    std::fill(fft_in_imag_.begin(), fft_in_imag_.end(), 0.0f);
 }
 
-void SpectrumAnalyzer::CalculateBands(SpectrumResult& result) {
-    result.bands.clear();
-    result.bands.reserve(config_.frequency_bands.size());
+// v2.12: Band names are interned once per band set
+void SpectrumAnalyzer::BuildBandLayout() {
+    auto layout = std::make_shared<SpectrumBandLayout>();
+    size_t count = config_.frequency_bands.size();
+    layout->min_freq.reserve(count);
+    layout->max_freq.reserve(count);
+    layout->names.reserve(count);
     
-    for (size_t band_idx = 0; band_idx < config_.frequency_bands.size(); band_idx++) {
-        const auto& [min_freq, max_freq] = config_.frequency_bands[band_idx];
-        
-        // 计算频段对应的 FFT bin 范围
-        int min_bin = static_cast<int>(min_freq * config_.fft_size / config_.sample_rate);
-        int max_bin = static_cast<int>(max_freq * config_.fft_size / config_.sample_rate);
-        
-        // 确保不超出范围
-        min_bin = std::max(0, std::min(min_bin, config_.fft_size / 2 - 1));
-        max_bin = std::max(0, std::min(max_bin, config_.fft_size / 2 - 1));
-        
-        // 计算频段能量
-        float energy = 0.0f;
-        int bin_count = 0;
-        
-        for (int i = min_bin; i <= max_bin; i++) {
-            energy += result.magnitudes[i];
-            bin_count++;
-        }
-        
-        float avg_energy = bin_count > 0 ? energy / bin_count : 0.0f;
-        
-        // 创建频段对象
-        FrequencyBand band;
-        band.min_freq = min_freq;
-        band.max_freq = max_freq;
-        band.energy = avg_energy;
-        band.db = avg_energy > 1e-10f ? 20.0f * std::log10(avg_energy) : -100.0f;
+    for (size_t band_idx = 0; band_idx < count; band_idx++) {
+        layout->min_freq.push_back(config_.frequency_bands[band_idx].first);
+        layout->max_freq.push_back(config_.frequency_bands[band_idx].second);
         
         // 设置频段名称
-        if (band_idx < default_band_names_.size()) {
-            band.name = default_band_names_[band_idx];
+        if (config_.band_names.size() == count) {
+            layout->names.push_back(config_.band_names[band_idx]);
+        } else if (band_idx < default_band_names_.size()) {
+            layout->names.push_back(default_band_names_[band_idx]);
         } else {
-            band.name = "Band " + std::to_string(band_idx + 1);
+            layout->names.push_back("Band " + std::to_string(band_idx + 1));
         }
-        
-        result.bands.push_back(band);
     }
+    band_layout_ = std::move(layout);
+}
+
+// v2.12: FFT bin range of [min_freq, max_freq], both ends inclusive as before
+SpectrumAnalyzer::BinRange SpectrumAnalyzer::MakeBinRange(float min_freq, float max_freq) const {
+    const int last_bin = config_.fft_size / 2 - 1;
+    
+    // 计算频段对应的 FFT bin 范围
+    int min_bin = static_cast<int>(min_freq * config_.fft_size / config_.sample_rate);
+    int max_bin = static_cast<int>(max_freq * config_.fft_size / config_.sample_rate);
+    
+    // 确保不超出范围
+    min_bin = std::max(0, std::min(min_bin, last_bin));
+    max_bin = std::max(0, std::min(max_bin, last_bin));
+    
+    BinRange range;
+    range.first = static_cast<uint32_t>(min_bin);
+    range.end = static_cast<uint32_t>(std::max(min_bin, max_bin + 1));
+    range.inv_count = range.end > range.first ? 1.0f / (range.end - range.first) : 0.0f;
+    return range;
+}
+
+// v2.12: Per-band and voice bin ranges, so frames never convert Hz to bins
+void SpectrumAnalyzer::BuildBinTable() {
+    const SpectrumBandLayout& layout = *band_layout_;
+    band_bins_.resize(layout.Size());
+    for (size_t band_idx = 0; band_idx < layout.Size(); band_idx++) {
+        band_bins_[band_idx] = MakeBinRange(layout.min_freq[band_idx], layout.max_freq[band_idx]);
+    }
+    voice_bins_ = MakeBinRange(config_.min_voice_freq, config_.max_voice_freq);
+    bin_hz_ = config_.sample_rate / static_cast<float>(config_.fft_size);
+    bin_prefix_.assign(static_cast<size_t>(config_.fft_size / 2) + 1, 0.0);
 }
 
-void SpectrumAnalyzer::DetectVoice(SpectrumResult& result) {
-    // 计算语音频段的能量占比
-    int min_bin = static_cast<int>(config_.min_voice_freq * config_.fft_size / config_.sample_rate);
-    int max_bin = static_cast<int>(config_.max_voice_freq * config_.fft_size / config_.sample_rate);
+/**
+ * v2.12: Magnitudes, bands, voice ratio, centroid and dominant frequency in a
+ * single pass over the bins
+ * 
+ * The pass records running magnitude sums, so every band (and the voice range)
+ * is one subtraction no matter how many bins it spans. The centroid is
+ * bin_hz * sum(i * m) / sum(m) instead of converting each bin to Hz.
+ */
+void SpectrumAnalyzer::CalculateFeatures(SpectrumResult& result) {
+    const size_t bins = static_cast<size_t>(config_.fft_size / 2);
+    const float scale = 1.0f / config_.fft_size;
+    const float smoothing = config_.smoothing;
     
-    min_bin = std::max(0, std::min(min_bin, config_.fft_size / 2 - 1));
-    max_bin = std::max(0, std::min(max_bin, config_.fft_size / 2 - 1));
+    result.magnitudes.resize(bins);
+    float* magnitudes = result.magnitudes.data();
+    float* prev = prev_magnitudes_.data();
+    double* prefix = bin_prefix_.data();
     
-    float voice_energy = 0.0f;
-    float total_energy = 0.0f;
+    double total = 0.0;
+    double weighted = 0.0;
+    float peak = -1.0f;
+    size_t peak_bin = 0;
     
-    for (size_t i = 0; i < result.magnitudes.size(); i++) {
-        float mag = result.magnitudes[i];
-        total_energy += mag;
+    for (size_t i = 0; i < bins; i++) {
+        float real = fft_out_real_[i];
+        float imag = fft_out_imag_[i];
+        float magnitude = std::sqrt(real * real + imag * imag) * scale;
         
-        if (static_cast<int>(i) >= min_bin && static_cast<int>(i) <= max_bin) {
-            voice_energy += mag;
+        // 指数平滑
+        float mag = smoothing * magnitude + (1.0f - smoothing) * prev[i];
+        magnitudes[i] = mag;
+        prev[i] = mag;
+        
+        prefix[i] = total;
+        total += mag;
+        weighted += static_cast<double>(i) * mag;
+        if (mag > peak) {  // First maximum wins, like std::max_element
+            peak = mag;
+            peak_bin = i;
+        }
+    }
+    prefix[bins] = total;
+    
+    // 频段能量 (bin 平均值)
+    const SpectrumBandLayout& layout = *band_layout_;
+    if (result.bands.size() != layout.Size()) {
+        result.bands.resize(layout.Size());
+    }
+    for (size_t band_idx = 0; band_idx < layout.Size(); band_idx++) {
+        const BinRange& range = band_bins_[band_idx];
+        float avg_energy = range.end > range.first
+            ? static_cast<float>(prefix[range.end] - prefix[range.first]) * range.inv_count
+            : 0.0f;
+        
+        FrequencyBand& band = result.bands[band_idx];
+        band.min_freq = layout.min_freq[band_idx];
+        band.max_freq = layout.max_freq[band_idx];
+        band.energy = avg_energy;
+        band.db = avg_energy > 1e-10f ? 20.0f * std::log10(avg_energy) : -100.0f;
+        if (band.name != layout.names[band_idx]) {
+            band.name = layout.names[band_idx];
         }
     }
     
     // 语音概率 = 语音频段能量 / 总能量
+    float total_energy = static_cast<float>(total);
+    float voice_energy = static_cast<float>(prefix[voice_bins_.end] - prefix[voice_bins_.first]);
     result.voice_probability = total_energy > 1e-10f ? voice_energy / total_energy : 0.0f;
     result.is_voice = result.voice_probability > config_.voice_threshold;
+    
+    // 频谱质心和主导频率
+    result.spectral_centroid = total_energy > 1e-10f
+        ? bin_hz_ * static_cast<float>(weighted / total) : 0.0f;
+    result.dominant_frequency = peak_bin * bin_hz_;
 }
 
-void SpectrumAnalyzer::CalculateSpectralFeatures(SpectrumResult& result) {
-    // 计算频谱质心
-    result.spectral_centroid = CalculateSpectralCentroid(result.magnitudes);
+// v2.12: Downmix interleaved frames to mono and append them to the sliding window
+void SpectrumAnalyzer::PushMono(const float* interleaved, size_t frames, int channels) {
+    const size_t size = ring_.size();
+    const float scale = 1.0f / channels;
     
-    // 计算主导频率
-    result.dominant_frequency = FindDominantFrequency(result.magnitudes);
+    for (size_t f = 0; f < frames; f++) {
+        const float* frame = interleaved + f * channels;
+        float sum = frame[0];
+        for (int c = 1; c < channels; c++) {
+            sum += frame[c];
+        }
+        ring_[ring_pos_] = sum * scale;
+        if (++ring_pos_ == size) {
+            ring_pos_ = 0;
+        }
+    }
+    stream_position_ += frames;
 }
 
-float SpectrumAnalyzer::CalculateSpectralCentroid(const std::vector<float>& magnitudes) {
-    float weighted_sum = 0.0f;
-    float total_energy = 0.0f;
+// v2.12: Window the last fft_size mono samples (oldest first) and analyze them
+void SpectrumAnalyzer::AnalyzeWindow(SpectrumResult& result) {
+    const size_t size = ring_.size();
+    const size_t first = size - ring_pos_;  // Samples from ring_pos_ to the end
     
-    for (size_t i = 0; i < magnitudes.size(); i++) {
-        float freq = i * config_.sample_rate / static_cast<float>(config_.fft_size);
-        weighted_sum += freq * magnitudes[i];
-        total_energy += magnitudes[i];
+    for (size_t i = 0; i < first; i++) {
+        fft_in_real_[i] = ring_[ring_pos_ + i] * window_[i];
     }
+    for (size_t i = first; i < size; i++) {
+        fft_in_real_[i] = ring_[i - first] * window_[i];
+    }
+    std::fill(fft_in_imag_.begin(), fft_in_imag_.end(), 0.0f);
     
-    return total_energy > 1e-10f ? weighted_sum / total_energy : 0.0f;
+    Transform(result);
+    result.position = stream_position_;
 }
 
-float SpectrumAnalyzer::FindDominantFrequency(const std::vector<float>& magnitudes) {
-    // 找到最大幅度对应的频率
-    auto max_it = std::max_element(magnitudes.begin(), magnitudes.end());
-    
-    if (max_it == magnitudes.end()) {
-        return 0.0f;
+void SpectrumAnalyzer::ResetStream() {
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    ring_pos_ = 0;
+    hop_remaining_ = ring_.size();  // First frame needs a full window
+    stream_position_ = 0;
+}
+
+void SpectrumAnalyzer::SetHopSize(int hop_size) {
+    config_.hop_size = hop_size;
+    hop_size_ = hop_size > 0 ? static_cast<size_t>(hop_size)
+                             : std::max<size_t>(1, static_cast<size_t>(config_.fft_size) / 2);
+    if (hop_remaining_ > hop_size_ && stream_position_ >= ring_.size()) {
+        hop_remaining_ = hop_size_;
     }
-    
-    size_t max_idx = std::distance(magnitudes.begin(), max_it);
-    return max_idx * config_.sample_rate / static_cast<float>(config_.fft_size);
 }
 
 SpectrumResult SpectrumAnalyzer::Analyze(const float* samples, size_t count) {
@@ -199,30 +279,31 @@ SpectrumResult SpectrumAnalyzer::Analyze(const float* samples, size_t count) {
     // 1. 应用窗函数
     ApplyWindow(samples, count);
     
-    // 2. 执行 FFT (使用 C 包装器)
-    kiss_fft_wrapper_transform(fft_cfg_, 
-                                fft_in_real_.data(), fft_in_imag_.data(),
-                                fft_out_real_.data(), fft_out_imag_.data(),
-                                config_.fft_size);
-    
-    // 3. 计算幅度谱
-    CalculateMagnitudes(result);
-    
-    // 4. 计算频段能量
-    CalculateBands(result);
-    
-    // 5. 语音检测
-    DetectVoice(result);
+    Transform(result);
+    return result;
+}
+
+// FFT and features of the windowed block in fft_in_real_
+void SpectrumAnalyzer::Transform(SpectrumResult& result) {
+    // 2. 执行 FFT
+    if (real_fft_) {
+        // v2.12: Packed real transform (bins 0 .. N/2)
+        real_fft_->Forward(fft_in_real_.data(), fft_out_real_.data(), fft_out_imag_.data());
+    } else {
+        // 使用 C 包装器 (complex fallback)
+        kiss_fft_wrapper_transform(fft_cfg_, 
+                                    fft_in_real_.data(), fft_in_imag_.data(),
+                                    fft_out_real_.data(), fft_out_imag_.data(),
+                                    config_.fft_size);
+    }
     
-    // 6. 计算频谱特征
-    CalculateSpectralFeatures(result);
+    // 3-6. 幅度谱、频段能量、语音检测、频谱特征 (v2.12: single pass)
+    CalculateFeatures(result);
     
     // 7. 设置时间戳
     auto now = std::chrono::system_clock::now();
     auto duration = now.time_since_epoch();
     result.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-    
-    return result;
 }
 
 void SpectrumAnalyzer::SetSmoothingFactor(float factor) {
@@ -233,10 +314,114 @@ void SpectrumAnalyzer::SetVoiceDetectionParams(float threshold, float min_freq,
     config_.voice_threshold = std::max(0.0f, std::min(1.0f, threshold));
     config_.min_voice_freq = std::max(0.0f, min_freq);
     config_.max_voice_freq = std::max(config_.min_voice_freq, max_freq);
+    BuildBinTable();
 }
 
-void SpectrumAnalyzer::SetFrequencyBands(const std::vector<std::pair<float, float>>& bands) {
+void SpectrumAnalyzer::SetFrequencyBands(const std::vector<std::pair<float, float>>& bands,
+                                         const std::vector<std::string>& names) {
     config_.frequency_bands = bands;
+    config_.band_names = names;
+    BuildBandLayout();
+    BuildBinTable();
+}
+
+namespace {
+
+float HzToMel(float hz) { return 2595.0f * std::log10(1.0f + hz / 700.0f); }
+float MelToHz(float mel) { return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f); }
+
+std::string BandLabel(float center) {
+    char label[32];
+    if (center < 1000.0f) {
+        std::snprintf(label, sizeof(label), "%.0f Hz", center);
+    } else {
+        std::snprintf(label, sizeof(label), "%.1f kHz", center / 1000.0f);
+    }
+    return label;
+}
+
+}  // namespace
+
+std::vector<std::pair<float, float>> SpectrumAnalyzer::MakeBands(BandScale scale, int count,
+                                                                 float min_freq, float max_freq,
+                                                                 std::vector<std::string>* names) {
+    std::vector<std::pair<float, float>> bands;
+    std::vector<float> centers;
+    min_freq = std::max(1.0f, min_freq);
+    if (max_freq <= min_freq) {
+        if (names) {
+            names->clear();
+        }
+        return bands;
+    }
+    count = std::max(1, std::min(count, 256));
+    
+    switch (scale) {
+    case BandScale::ThirdOctave: {
+        // fc = 1000 * 2^(k/3), edges fc * 2^(-1/6) .. fc * 2^(1/6), clipped to the range
+        // (every band overlapping the range, so 20 Hz - 20 kHz gives the usual 31)
+        int k_min = static_cast<int>(std::ceil(3.0 * std::log2(min_freq / 1000.0) - 0.5));
+        int k_max = static_cast<int>(std::floor(3.0 * std::log2(max_freq / 1000.0) + 0.5));
+        const float half = std::pow(2.0f, 1.0f / 6.0f);
+        for (int k = k_min; k <= k_max; k++) {
+            float fc = 1000.0f * std::pow(2.0f, k / 3.0f);
+            bands.emplace_back(std::max(min_freq, fc / half), std::min(max_freq, fc * half));
+            centers.push_back(fc);
+        }
+        break;
+    }
+    case BandScale::Log: {
+        const float ratio = max_freq / min_freq;
+        for (int i = 0; i < count; i++) {
+            float lo = min_freq * std::pow(ratio, static_cast<float>(i) / count);
+            float hi = min_freq * std::pow(ratio, static_cast<float>(i + 1) / count);
+            bands.emplace_back(lo, hi);
+            centers.push_back(std::sqrt(lo * hi));
+        }
+        break;
+    }
+    case BandScale::Mel: {
+        const float mel_min = HzToMel(min_freq);
+        const float mel_step = (HzToMel(max_freq) - mel_min) / count;
+        for (int i = 0; i < count; i++) {
+            bands.emplace_back(MelToHz(mel_min + i * mel_step), MelToHz(mel_min + (i + 1) * mel_step));
+            centers.push_back(MelToHz(mel_min + (i + 0.5f) * mel_step));
+        }
+        break;
+    }
+    case BandScale::Custom:
+        break;
+    }
+    
+    if (names) {
+        names->clear();
+        names->reserve(centers.size());
+        for (float center : centers) {
+            names->push_back(BandLabel(center));
+        }
+    }
+    return bands;
+}
+
+void SpectrumAnalyzer::ExportFrame(const SpectrumResult& result, SpectrumFrame& frame) const {
+    size_t bins = std::min(result.magnitudes.size(), frame.bin_count);
+    if (bins > 0) {
+        std::memcpy(frame.magnitudes, result.magnitudes.data(), bins * sizeof(float));
+    }
+    
+    size_t bands = std::min(result.bands.size(), frame.band_count);
+    for (size_t i = 0; i < bands; i++) {
+        frame.band_energy[i] = result.bands[i].energy;
+        frame.band_db[i] = result.bands[i].db;
+    }
+    
+    frame.layout = band_layout_;
+    frame.voice_probability = result.voice_probability;
+    frame.spectral_centroid = result.spectral_centroid;
+    frame.dominant_frequency = result.dominant_frequency;
+    frame.is_voice = result.is_voice;
+    frame.timestamp = result.timestamp;
+    frame.position = result.position;
 }
 
 } // namespace audio_capture
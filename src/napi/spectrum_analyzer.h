@@ -12,6 +12,10 @@
 
 // Use C wrapper to avoid C++/C linkage issues
 #include "kiss_fft_wrapper.h"
+#include "real_fft.h"        // v2.12: Real-input FFT
+#include "aligned_buffer.h"
+#include "spectrum_frame.h"  // v2.12: Pooled frames, interned band layout
+#include <memory>
 
 namespace audio_capture {
 
@@ -33,13 +37,23 @@ struct SpectrumResult {
     float dominant_frequency;             // 主导频率 (Hz)
     bool is_voice;                        // 是否为语音
     int64_t timestamp;                    // 时间戳（毫秒）
+    uint64_t position;                    // v2.12: 帧结束处的流位置（单声道采样数）
     
     SpectrumResult() 
         : voice_probability(0.0f),
           spectral_centroid(0.0f),
           dominant_frequency(0.0f),
           is_voice(false),
-          timestamp(0) {}
+          timestamp(0),
+          position(0) {}
+};
+
+// v2.12: Band set generators for visualizers (32-128 bars)
+enum class BandScale {
+    Custom,       // frequency_bands as given
+    ThirdOctave,  // ISO 1/3-octave bands (base 2, centred on 1 kHz); count is ignored
+    Log,          // count log-spaced bands
+    Mel           // count bands evenly spaced on the mel scale
 };
 
 // 频谱分析器配置
@@ -48,19 +62,30 @@ struct SpectrumConfig {
     int sample_rate;                      // 采样率
     float smoothing;                      // 平滑系数 (0-1)
     std::vector<std::pair<float, float>> frequency_bands; // 自定义频段
+    std::vector<std::string> band_names;  // v2.12: Optional, one per band (empty = defaults)
+    BandScale band_scale;                 // v2.12: How frequency_bands was produced
     
     // 语音检测参数
     float voice_threshold;                // 语音阈值 (0-1)
     float min_voice_freq;                 // 语音最低频率 (Hz)
     float max_voice_freq;                 // 语音最高频率 (Hz)
     
+    // v2.12: Real-input (packed N/2) FFT for power-of-two sizes; otherwise complex kiss_fft
+    bool use_real_fft;
+    
+    // v2.12: Streaming STFT hop in mono samples (0 = fft_size / 2, i.e. 50% overlap)
+    int hop_size;
+    
     SpectrumConfig()
         : fft_size(2048),
           sample_rate(48000),
           smoothing(0.8f),
+          band_scale(BandScale::Custom),
           voice_threshold(0.3f),
           min_voice_freq(300.0f),
-          max_voice_freq(3400.0f) {
+          max_voice_freq(3400.0f),
+          use_real_fft(true),
+          hop_size(0) {
         // 默认 7 段均衡器频段
         frequency_bands = {
             {20.0f, 60.0f},       // Sub-bass
@@ -87,40 +112,129 @@ public:
     // 分析音频样本
     SpectrumResult Analyze(const float* samples, size_t count);
     
+    /**
+     * v2.12: Streaming STFT
+     * 
+     * Interleaved samples are downmixed to mono into a sliding window of
+     * fft_size samples. The first frame is produced once the window is full,
+     * then one frame every hop_size samples, regardless of how the stream is
+     * split into packets.
+     * 
+     * @param on_frame Called with each completed frame (const SpectrumResult&)
+     * @return Number of frames produced
+     */
+    template <typename OnFrame>
+    size_t ProcessStream(const float* interleaved, size_t frames, int channels, OnFrame&& on_frame) {
+        if (!interleaved || channels <= 0) {
+            return 0;
+        }
+        size_t produced = 0;
+        size_t offset = 0;
+        while (offset < frames) {
+            size_t take = (std::min)(frames - offset, hop_remaining_);
+            PushMono(interleaved + offset * channels, take, channels);
+            offset += take;
+            hop_remaining_ -= take;
+            
+            if (hop_remaining_ == 0) {
+                hop_remaining_ = hop_size_;
+                AnalyzeWindow(stream_result_);
+                on_frame(static_cast<const SpectrumResult&>(stream_result_));
+                produced++;
+            }
+        }
+        return produced;
+    }
+    
+    // v2.12: Drop buffered samples; the next frame needs a full window again
+    void ResetStream();
+    
+    // v2.12: Hop size in mono samples (clamped to >= 1)
+    void SetHopSize(int hop_size);
+    int GetHopSize() const { return static_cast<int>(hop_size_); }
+    
     // 更新配置
     void SetSmoothingFactor(float factor);
     void SetVoiceDetectionParams(float threshold, float min_freq, float max_freq);
-    void SetFrequencyBands(const std::vector<std::pair<float, float>>& bands);
+    void SetFrequencyBands(const std::vector<std::pair<float, float>>& bands,
+                           const std::vector<std::string>& names = {});
+    
+    /**
+     * v2.12: Generate a log-spaced band set
+     * 
+     * @param scale ThirdOctave, Log or Mel (Custom returns an empty set)
+     * @param count Number of bands for Log/Mel (clamped to 1-256)
+     * @param min_freq Lowest band edge (Hz)
+     * @param max_freq Highest band edge (Hz), normally min(20000, sample_rate / 2)
+     * @param names Receives one label per band ("63 Hz", "1.3 kHz"), may be null
+     */
+    static std::vector<std::pair<float, float>> MakeBands(BandScale scale, int count,
+                                                          float min_freq, float max_freq,
+                                                          std::vector<std::string>* names = nullptr);
     
     // 获取配置
     const SpectrumConfig& GetConfig() const { return config_; }
+    
+    // v2.12: True if the real-input FFT path is active
+    bool IsRealFFT() const { return real_fft_ != nullptr; }
+    
+    // v2.12: Band ranges and names, rebuilt only when the bands change
+    const std::shared_ptr<const SpectrumBandLayout>& GetBandLayout() const { return band_layout_; }
+    size_t GetBinCount() const { return static_cast<size_t>(config_.fft_size / 2); }
+    
+    // v2.12: Copy a result into a pooled frame (no allocation)
+    void ExportFrame(const SpectrumResult& result, SpectrumFrame& frame) const;
 
 private:
     SpectrumConfig config_;
     
     // FFT 相关 (使用 void* 避免类型暴露问题)
-    void* fft_cfg_;  // kiss_fft_cfg
-    std::vector<float> fft_in_real_;
-    std::vector<float> fft_in_imag_;
-    std::vector<float> fft_out_real_;
-    std::vector<float> fft_out_imag_;
+    void* fft_cfg_;  // kiss_fft_cfg (complex fallback only)
+    std::unique_ptr<RealFFT> real_fft_;  // v2.12: Real-input path
+    
+    // v2.12: Planar, 64-byte aligned working buffers
+    AlignedVector<float> fft_in_real_;
+    AlignedVector<float> fft_in_imag_;
+    AlignedVector<float> fft_out_real_;
+    AlignedVector<float> fft_out_imag_;
     
     // 窗函数和平滑
     std::vector<float> window_;
     std::vector<float> prev_magnitudes_;
     
+    // v2.12: Streaming STFT state
+    std::vector<float> ring_;           // Mono sliding window (fft_size)
+    size_t ring_pos_ = 0;               // Next write index (= oldest sample once full)
+    size_t hop_size_ = 0;
+    size_t hop_remaining_ = 0;          // Samples until the next frame
+    uint64_t stream_position_ = 0;      // Mono samples consumed
+    SpectrumResult stream_result_;      // Reused frame for ProcessStream
+    
     // 频段名称映射
     static const std::vector<std::string> default_band_names_;
+    std::shared_ptr<const SpectrumBandLayout> band_layout_;  // v2.12: Interned names
+    
+    // v2.12: Bin table, rebuilt only when the bands, voice range or format change
+    struct BinRange {
+        uint32_t first;   // Inclusive
+        uint32_t end;     // Exclusive (end <= first: empty)
+        float inv_count;  // 1 / (end - first), 0 if empty
+    };
+    std::vector<BinRange> band_bins_;
+    BinRange voice_bins_ = {0, 0, 0.0f};
+    float bin_hz_ = 0.0f;                 // sample_rate / fft_size
+    std::vector<double> bin_prefix_;      // Running magnitude sums (N/2 + 1)
     
     // 内部方法
     void InitializeWindow();
+    void BuildBandLayout();
+    void BuildBinTable();
+    BinRange MakeBinRange(float min_freq, float max_freq) const;
     void ApplyWindow(const float* samples, size_t count);
-    void CalculateMagnitudes(SpectrumResult& result);
-    void CalculateBands(SpectrumResult& result);
-    void DetectVoice(SpectrumResult& result);
-    void CalculateSpectralFeatures(SpectrumResult& result);
-    float CalculateSpectralCentroid(const std::vector<float>& magnitudes);
-    float FindDominantFrequency(const std::vector<float>& magnitudes);
+    void PushMono(const float* interleaved, size_t frames, int channels);
+    void AnalyzeWindow(SpectrumResult& result);
+    void Transform(SpectrumResult& result);
+    void CalculateFeatures(SpectrumResult& result);
 };
 
 } // namespace audio_capture
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025 node-windows-audio-capture contributors
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "aligned_buffer.h"
+#include "tagged_index_stack.h"
+
+namespace audio_capture {
+
+/**
+ * v2.12: Band set shared by every frame of one analyzer configuration
+ *
+ * Built once when the bands change; frames only hold a reference, so band
+ * ranges and names are never copied per frame.
+ */
+struct SpectrumBandLayout {
+    std::vector<float> min_freq;
+    std::vector<float> max_freq;
+    std::vector<std::string> names;
+
+    size_t Size() const { return names.size(); }
+};
+
+class SpectrumFramePool;
+
+/**
+ * v2.12: Fixed-capacity spectrum frame (flat arrays, recycled through a pool)
+ *
+ * All per-frame arrays live in one contiguous block,
+ * [magnitudes | band_energy | band_db], so a single external ArrayBuffer can
+ * expose the whole frame to JavaScript with typed-array views into it.
+ */
+struct SpectrumFrame {
+    AlignedVector<float> storage;
+    float* magnitudes = nullptr;    // bin_count values
+    float* band_energy = nullptr;   // band_count values (struct-of-arrays)
+    float* band_db = nullptr;
+    size_t bin_count = 0;
+    size_t band_count = 0;
+    std::shared_ptr<const SpectrumBandLayout> layout;
+
+    float voice_probability = 0.0f;
+    float spectral_centroid = 0.0f;
+    float dominant_frequency = 0.0f;
+    bool is_voice = false;
+    int64_t timestamp = 0;
+    uint64_t position = 0;
+    bool soa_bands = false;  // Delivery layout chosen by the producer
+
+    size_t ByteSize() const { return storage.size() * sizeof(float); }
+
+    // Return the frame to its pool (any thread); the frame must not be used afterwards
+    void Release();
+
+private:
+    friend class SpectrumFramePool;
+    std::shared_ptr<SpectrumFramePool> owner_;  // Keeps the pool alive while in flight
+    uint32_t slot_ = 0;
+};
+
+/**
+ * v2.12: Lock-free pool of spectrum frames
+ *
+ * Frames are allocated once with a fixed bin and band capacity. The
+ * processing thread acquires a frame, fills it and hands the raw pointer to
+ * the JS thread, which releases it after marshalling. A frame in flight
+ * holds a reference to its pool, so a pool replaced after a configuration
+ * change is freed only when its last frame comes back.
+ */
+class SpectrumFramePool : public std::enable_shared_from_this<SpectrumFramePool> {
+public:
+    static std::shared_ptr<SpectrumFramePool> Create(size_t frame_count, size_t bin_count, size_t band_count) {
+        return std::shared_ptr<SpectrumFramePool>(new SpectrumFramePool(frame_count, bin_count, band_count));
+    }
+
+    // Disable copy
+    SpectrumFramePool(const SpectrumFramePool&) = delete;
+    SpectrumFramePool& operator=(const SpectrumFramePool&) = delete;
+
+    /**
+     * @return A frame, or nullptr if every frame is in flight
+     */
+    SpectrumFrame* Acquire() {
+        uint32_t slot = free_.Pop();
+        if (slot == AudioCapture::TaggedIndexStack::kEmpty) {
+            exhausted_++;
+            return nullptr;
+        }
+        SpectrumFrame* frame = frames_[slot].get();
+        frame->owner_ = shared_from_this();
+        return frame;
+    }
+
+    /**
+     * @brief Pooled frame, or a one-off frame if JavaScript still holds every
+     * pooled one (zero-copy views live until garbage collection)
+     * @return nullptr only if the allocation fails
+     */
+    SpectrumFrame* AcquireOrAllocate() {
+        if (SpectrumFrame* frame = Acquire()) {
+            return frame;
+        }
+        try {
+            std::unique_ptr<SpectrumFrame> frame = MakeFrame(AudioCapture::TaggedIndexStack::kEmpty);
+            frame->owner_ = shared_from_this();
+            return frame.release();  // Deleted by Release()
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    bool Matches(size_t bin_count, size_t band_count) const {
+        return bin_count == bin_count_ && band_count == band_count_;
+    }
+
+    size_t BinCount() const { return bin_count_; }
+    size_t BandCount() const { return band_count_; }
+    size_t Capacity() const { return frames_.size(); }
+    size_t Available() const { return free_.Size(); }
+    uint64_t Exhausted() const { return exhausted_.load(std::memory_order_relaxed); }
+
+private:
+    friend struct SpectrumFrame;
+
+    SpectrumFramePool(size_t frame_count, size_t bin_count, size_t band_count)
+        : bin_count_(bin_count), band_count_(band_count),
+          free_(static_cast<uint32_t>(frame_count)) {
+        frames_.reserve(frame_count);
+        for (size_t i = 0; i < frame_count; i++) {
+            frames_.push_back(MakeFrame(static_cast<uint32_t>(i)));
+        }
+        for (size_t i = frame_count; i > 0; i--) {
+            free_.Push(static_cast<uint32_t>(i - 1));
+        }
+    }
+
+    std::unique_ptr<SpectrumFrame> MakeFrame(uint32_t slot) const {
+        auto frame = std::make_unique<SpectrumFrame>();
+        frame->storage.resize(bin_count_ + 2 * band_count_);
+        frame->magnitudes = frame->storage.data();
+        frame->band_energy = frame->magnitudes + bin_count_;
+        frame->band_db = frame->band_energy + band_count_;
+        frame->bin_count = bin_count_;
+        frame->band_count = band_count_;
+        frame->slot_ = slot;
+        return frame;
+    }
+
+    void Recycle(uint32_t slot) { free_.Push(slot); }
+
+    const size_t bin_count_;
+    const size_t band_count_;
+    std::vector<std::unique_ptr<SpectrumFrame>> frames_;
+    AudioCapture::TaggedIndexStack free_;
+    std::atomic<uint64_t> exhausted_{0};
+};
+
+inline void SpectrumFrame::Release() {
+    // Moved out first: dropping the last reference destroys the pool and this frame
+    std::shared_ptr<SpectrumFramePool> owner = std::move(owner_);
+    layout.reset();
+    if (slot_ == AudioCapture::TaggedIndexStack::kEmpty) {
+        delete this;  // One-off frame from AcquireOrAllocate()
+    } else if (owner) {
+        owner->Recycle(slot_);
+    }
+}
+
+} // namespace audio_capture
@@ -0,0 +1,163 @@
+/**
+ * Lock-free Single-Producer / Single-Consumer Packet Ring
+ *
+ * v2.12: Decouples the WASAPI capture thread (producer) from the
+ * processing thread (consumer). The capture thread only copies packet
+ * bytes into a pre-allocated slot and publishes it; no locks and no heap
+ * allocations happen on the producer side.
+ *
+ * Packets larger than one slot are split across consecutive slots at
+ * `align` byte boundaries (one audio frame), so a slot never holds a
+ * partial frame. When the ring is full the whole packet is dropped and
+ * counted as an overrun.
+ */
+
+#ifndef SPSC_RING_BUFFER_H
+#define SPSC_RING_BUFFER_H
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+namespace AudioCapture {
+
+class SpscPacketRing {
+public:
+    /**
+     * One slot of the ring (owned by the consumer between Front() and Pop())
+     */
+    struct Slot {
+        uint8_t* data;
+        size_t size;
+        bool last;  // Final slot of its packet (packets split across slots end here)
+    };
+
+    /**
+     * @param slot_count Number of slots (rounded up to a power of two)
+     * @param slot_capacity Bytes per slot
+     */
+    SpscPacketRing(size_t slot_count, size_t slot_capacity)
+        : slot_capacity_(slot_capacity > 0 ? slot_capacity : 1) {
+        size_t count = 2;
+        while (count < slot_count) {
+            count <<= 1;
+        }
+        mask_ = count - 1;
+        storage_.resize(count * slot_capacity_);
+        sizes_.resize(count, 0);
+        last_.resize(count, 0);
+    }
+
+    // Disable copy
+    SpscPacketRing(const SpscPacketRing&) = delete;
+    SpscPacketRing& operator=(const SpscPacketRing&) = delete;
+
+    // ========== Producer side ==========
+
+    /**
+     * @brief Copy a packet into the ring
+     * @param data Packet bytes
+     * @param size Packet size in bytes
+     * @param align Split granularity for oversized packets (bytes per frame)
+     * @return false if the ring had no room (packet dropped, overrun counted)
+     */
+    bool TryPush(const uint8_t* data, size_t size, size_t align = 1) {
+        if (!data || size == 0) {
+            return true;
+        }
+
+        // Largest chunk that fits a slot without splitting a frame
+        size_t chunk = slot_capacity_;
+        if (align > 1 && chunk >= align) {
+            chunk -= chunk % align;
+        }
+        size_t needed = (size + chunk - 1) / chunk;
+
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        if (Capacity() - (tail - head) < needed) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        size_t offset = 0;
+        while (offset < size) {
+            size_t bytes = (size - offset < chunk) ? (size - offset) : chunk;
+            size_t index = tail & mask_;
+            std::memcpy(&storage_[index * slot_capacity_], data + offset, bytes);
+            sizes_[index] = bytes;
+            offset += bytes;
+            last_[index] = offset == size ? 1 : 0;
+            ++tail;
+        }
+
+        tail_.store(tail, std::memory_order_release);
+
+        size_t depth = tail - head;
+        size_t high = high_water_.load(std::memory_order_relaxed);
+        if (depth > high) {
+            high_water_.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // ========== Consumer side ==========
+
+    /**
+     * @brief Peek the oldest slot
+     * @return true if a slot is available
+     */
+    bool Front(Slot& slot) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        size_t index = head & mask_;
+        slot.data = &storage_[index * slot_capacity_];
+        slot.size = sizes_[index];
+        slot.last = last_[index] != 0;
+        return true;
+    }
+
+    /**
+     * @brief Release the slot returned by Front()
+     */
+    void Pop() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ========== Either side ==========
+
+    bool Empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t Size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const { return mask_ + 1; }
+    size_t SlotCapacity() const { return slot_capacity_; }
+    uint64_t Overruns() const { return overruns_.load(std::memory_order_relaxed); }
+    size_t HighWater() const { return high_water_.load(std::memory_order_relaxed); }
+
+private:
+    size_t slot_capacity_;
+    size_t mask_;
+    std::vector<uint8_t> storage_;  // slot_count * slot_capacity bytes
+    std::vector<size_t> sizes_;     // Bytes used per slot
+    std::vector<uint8_t> last_;     // 1 if the slot ends a packet
+
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<size_t> head_{0};  // Next slot to read (consumer)
+    alignas(64) std::atomic<size_t> tail_{0};  // Next slot to write (producer)
+
+    alignas(64) std::atomic<uint64_t> overruns_{0};
+    std::atomic<size_t> high_water_{0};
+};
+
+} // namespace AudioCapture
+
+#endif // SPSC_RING_BUFFER_H
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include "audio_stats_calculator.h"
+#include "audio_level_kernels.h"
+
+namespace wasapi_capture {
+
+/**
+ * v2.12: Statistics for one completed interval of the capture stream
+ */
+struct StreamingStatsSnapshot {
+    AudioStats stats;          // Peak / RMS / dB / volume over the interval
+    uint64_t sampleCount;      // Samples (all channels) in the interval
+    double silenceDurationMs;  // Length of the current silence run (0 if not silent)
+};
+
+/**
+ * v2.12: Incremental audio statistics on the processing thread
+ *
+ * Replaces buffering every packet in JavaScript and concatenating them per
+ * interval. Each packet is folded into a running peak and sum of squares
+ * with the fused level kernels; when the configured interval worth of
+ * samples has been seen, a snapshot is taken and the sums restart.
+ *
+ * Intervals are counted in samples, not wall-clock time, so they are exact
+ * regardless of packet timing. Silence runs are tracked per packet and span
+ * interval boundaries. An interval whose snapshot could not be delivered is
+ * deferred and merged into the next one, so the series has no gaps.
+ */
+class StreamingStatsAccumulator {
+public:
+    StreamingStatsAccumulator() = default;
+
+    /**
+     * @param intervalMs - Snapshot interval in milliseconds of audio
+     */
+    void SetInterval(uint32_t intervalMs) {
+        intervalMs_ = intervalMs > 0 ? intervalMs : 1;
+        UpdateIntervalSamples();
+    }
+
+    uint32_t GetInterval() const { return intervalMs_; }
+
+    // Stream layout; resets the accumulated state when it changes
+    void SetFormat(uint32_t sampleRate, uint16_t channels) {
+        if (sampleRate == sampleRate_ && channels == channels_) {
+            return;
+        }
+        sampleRate_ = sampleRate;
+        channels_ = channels > 0 ? channels : 1;
+        UpdateIntervalSamples();
+        Reset();
+    }
+
+    void SetSilenceThreshold(float threshold) {
+        calculator_.SetSilenceThreshold(threshold);
+    }
+
+    /**
+     * Add one packet of interleaved samples
+     * @return true when an interval is complete (call TakeSnapshot())
+     */
+    bool Add(const float* samples, size_t count) {
+        return Accumulate(MeasureLevels(samples, count), count);
+    }
+
+    bool Add(const int16_t* samples, size_t count) {
+        return Accumulate(MeasureLevels(samples, count), count);
+    }
+
+    /**
+     * Statistics of the samples added since the last snapshot; restarts the interval
+     */
+    StreamingStatsSnapshot TakeSnapshot() {
+        StreamingStatsSnapshot snapshot = GetSnapshot();
+        Restart();
+        return snapshot;
+    }
+
+    /**
+     * Statistics of the samples added since the last snapshot (interval not restarted:
+     * call Restart() once delivered, or Defer())
+     */
+    StreamingStatsSnapshot GetSnapshot() {
+        StreamingStatsSnapshot snapshot = {};
+        snapshot.sampleCount = sampleCount_;
+        snapshot.stats = sampleCount_ > 0
+            ? calculator_.FromLevels(LevelSums{peak_, sumSquares_}, static_cast<size_t>(sampleCount_))
+            : calculator_.Calculate(static_cast<const float*>(nullptr), 0);
+        snapshot.silenceDurationMs = SamplesToMs(silenceRunSamples_);
+        return snapshot;
+    }
+
+    void Restart() {
+        peak_ = 0.0f;
+        sumSquares_ = 0.0;
+        sampleCount_ = 0;
+        snapshotAt_ = intervalSamples_;
+    }
+
+    // The snapshot was not delivered: keep accumulating, report both intervals together
+    void Defer() {
+        snapshotAt_ = sampleCount_ + intervalSamples_;
+    }
+
+    void Reset() {
+        Restart();
+        silenceRunSamples_ = 0;
+    }
+
+    uint64_t GetPendingSamples() const { return sampleCount_; }
+    uint64_t GetIntervalSamples() const { return intervalSamples_; }
+
+private:
+    bool Accumulate(const LevelSums& levels, size_t count) {
+        if (count == 0) {
+            return false;
+        }
+
+        if (levels.peak > peak_) {
+            peak_ = levels.peak;
+        }
+        sumSquares_ += levels.sumSquares;
+        sampleCount_ += count;
+
+        // Packet-level silence: extend or break the current run
+        double packetRms = std::sqrt(levels.sumSquares / count);
+        if (packetRms < calculator_.GetSilenceThreshold()) {
+            silenceRunSamples_ += count;
+        } else {
+            silenceRunSamples_ = 0;
+        }
+
+        return sampleCount_ >= snapshotAt_;
+    }
+
+    void UpdateIntervalSamples() {
+        uint64_t samples = static_cast<uint64_t>(sampleRate_) * channels_ * intervalMs_ / 1000;
+        intervalSamples_ = samples > 0 ? samples : 1;
+        snapshotAt_ = intervalSamples_;
+    }
+
+    double SamplesToMs(uint64_t samples) const {
+        return static_cast<double>(samples) * 1000.0 / (static_cast<double>(sampleRate_) * channels_);
+    }
+
+    AudioStatsCalculator calculator_;
+    uint32_t intervalMs_ = 500;
+    uint32_t sampleRate_ = 48000;
+    uint16_t channels_ = 2;
+    uint64_t intervalSamples_ = 48000;  // 500 ms of 48 kHz stereo
+
+    float peak_ = 0.0f;
+    double sumSquares_ = 0.0;
+    uint64_t sampleCount_ = 0;
+    uint64_t snapshotAt_ = 48000;       // Pending samples that complete the (possibly deferred) interval
+    uint64_t silenceRunSamples_ = 0;
+};
+
+}  // namespace wasapi_capture
@@ -0,0 +1,98 @@
+/**
+ * Lock-free Tagged Index Stack
+ *
+ * v2.12: Treiber stack over a fixed table of slot indices, used as the
+ * freelist of each BufferPool size class.
+ *
+ * The head packs a 32-bit ABA tag and a 32-bit index (+1, 0 = empty) into
+ * one 64-bit word, so push/pop are a single compare-and-swap on every
+ * platform with lock-free 64-bit atomics. Links live in a table that is
+ * never freed while the stack exists, so a popper reading a stale link is
+ * always safe; the tag makes its CAS fail.
+ */
+
+#ifndef TAGGED_INDEX_STACK_H
+#define TAGGED_INDEX_STACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace AudioCapture {
+
+class TaggedIndexStack {
+public:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+    explicit TaggedIndexStack(uint32_t capacity)
+        : capacity_(capacity),
+          next_(new std::atomic<uint32_t>[capacity > 0 ? capacity : 1]) {
+        for (uint32_t i = 0; i < capacity_; ++i) {
+            next_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Disable copy
+    TaggedIndexStack(const TaggedIndexStack&) = delete;
+    TaggedIndexStack& operator=(const TaggedIndexStack&) = delete;
+
+    /**
+     * @brief Push a slot index (must be < capacity and not already on the stack)
+     */
+    void Push(uint32_t index) {
+        // Count first so a racing Pop() can never drive the size below zero
+        size_.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t desired;
+        do {
+            next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            desired = Pack(Tag(head) + 1, index + 1);
+        } while (!head_.compare_exchange_weak(head, desired,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Pop a slot index
+     * @return kEmpty if the stack is empty
+     */
+    uint32_t Pop() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t desired;
+        do {
+            uint32_t top = static_cast<uint32_t>(head);
+            if (top == 0) {
+                return kEmpty;
+            }
+            uint32_t next = next_[top - 1].load(std::memory_order_relaxed);
+            desired = Pack(Tag(head) + 1, next);
+        } while (!head_.compare_exchange_weak(head, desired,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire));
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return static_cast<uint32_t>(head) - 1;
+    }
+
+    // Approximate under concurrency (may briefly over-count, never under-count)
+    size_t Size() const { return size_.load(std::memory_order_relaxed); }
+    uint32_t Capacity() const { return capacity_; }
+
+private:
+    static uint64_t Pack(uint32_t tag, uint32_t index_plus_one) {
+        return (static_cast<uint64_t>(tag) << 32) | index_plus_one;
+    }
+    static uint32_t Tag(uint64_t head) {
+        return static_cast<uint32_t>(head >> 32);
+    }
+
+    const uint32_t capacity_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;  // Link (index + 1) per slot
+    alignas(64) std::atomic<uint64_t> head_{0};
+    std::atomic<size_t> size_{0};
+};
+
+} // namespace AudioCapture
+
+#endif // TAGGED_INDEX_STACK_H
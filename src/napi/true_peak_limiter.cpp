@@ -0,0 +1,287 @@
+/**
+ * True-Peak Limiter Implementation
+ */
+
+#include "true_peak_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(AUDIO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace wasapi_capture {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Gains this close to 1 count as no limiting (float noise of the release)
+constexpr float kUnityGain = 0.99999f;
+
+float DbToLinear(float db) {
+    return std::pow(10.0f, db / 20.0f);
+}
+
+float LinearToDb(float linear) {
+    return linear > 0.0f ? 20.0f * std::log10(linear) : -120.0f;
+}
+
+}  // namespace
+
+namespace limiter_kernels {
+
+// ========== Scalar (reference) ==========
+
+float TruePeakScalar(const float* window, const float* coeffs, size_t taps) {
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t t = 0; t < taps; t++) {
+        for (size_t p = 0; p < 4; p++) {
+            acc[p] += window[t] * coeffs[t * 4 + p];
+        }
+    }
+    float peak = 0.0f;
+    for (float v : acc) {
+        peak = (std::max)(peak, std::fabs(v));
+    }
+    return peak;
+}
+
+#if defined(AUDIO_SIMD_X86)
+
+// ========== SSE2 ==========
+
+float TruePeakSse2(const float* window, const float* coeffs, size_t taps) {
+    __m128 acc = _mm_setzero_ps();
+    for (size_t t = 0; t < taps; t++) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(window[t]), _mm_loadu_ps(coeffs + t * 4)));
+    }
+    acc = _mm_andnot_ps(_mm_set1_ps(-0.0f), acc);  // |phase|
+    __m128 m = _mm_max_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(m);
+}
+
+#endif  // AUDIO_SIMD_X86
+
+#if defined(AUDIO_SIMD_NEON)
+
+// ========== NEON ==========
+
+float TruePeakNeon(const float* window, const float* coeffs, size_t taps) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (size_t t = 0; t < taps; t++) {
+        acc = vaddq_f32(acc, vmulq_n_f32(vld1q_f32(coeffs + t * 4), window[t]));
+    }
+    return vmaxvq_f32(vabsq_f32(acc));
+}
+
+#endif  // AUDIO_SIMD_NEON
+
+}  // namespace limiter_kernels
+
+// ========== Dispatch ==========
+
+namespace {
+
+struct LimiterKernelTable {
+    SimdLevel level;
+    float (*truePeak)(const float*, const float*, size_t);
+};
+
+LimiterKernelTable SelectKernels() {
+    using namespace limiter_kernels;
+    switch (GetBestSimdLevel()) {
+#if defined(AUDIO_SIMD_X86)
+        case SimdLevel::AVX2:
+        case SimdLevel::SSE2:
+            return {SimdLevel::SSE2, &TruePeakSse2};  // Four phases fill one SSE register
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        case SimdLevel::NEON:
+            return {SimdLevel::NEON, &TruePeakNeon};
+#endif
+        default:
+            return {SimdLevel::Scalar, &TruePeakScalar};
+    }
+}
+
+const LimiterKernelTable& Kernels() {
+    static const LimiterKernelTable table = SelectKernels();
+    return table;
+}
+
+}  // namespace
+
+SimdLevel GetLimiterKernel() {
+    return Kernels().level;
+}
+
+// ========== TruePeakLimiter ==========
+
+TruePeakLimiter::TruePeakLimiter(const LimiterConfig& config)
+    : config_(config) {
+    if (config.sample_rate == 0 || config.channels == 0 || config.channels > kMaxChannels) {
+        throw std::invalid_argument("Limiter needs a sample rate and 1-8 channels");
+    }
+    if (!(config.ceiling_db >= -20.0f && config.ceiling_db <= 0.0f)) {
+        throw std::invalid_argument("Limiter ceiling must be between -20 and 0 dBTP");
+    }
+    if (!(config.lookahead_ms >= 0.1f && config.lookahead_ms <= 20.0f)) {
+        throw std::invalid_argument("Limiter look-ahead must be between 0.1 and 20 ms");
+    }
+    if (!(config.release_ms >= 1.0f && config.release_ms <= 2000.0f)) {
+        throw std::invalid_argument("Limiter release must be between 1 and 2000 ms");
+    }
+
+    ceiling_ = DbToLinear(config.ceiling_db);
+    lookahead_ = (std::max)(size_t{1}, static_cast<size_t>(std::lround(config.lookahead_ms * config.sample_rate / 1000.0f)));
+    release_coeff_ = 1.0f - std::exp(-1000.0f / (config.release_ms * config.sample_rate));
+
+    // Phase p interpolates at tap position (kDetectorDelay - 1) + p / 4 with a
+    // Blackman-windowed sinc; each phase is normalized to unity DC gain.
+    // Phase 0 is the sample itself.
+    const double half_width = kTaps / 2.0 + 0.5;
+    for (size_t p = 0; p < kOversampling; p++) {
+        const double centre = static_cast<double>(kDetectorDelay - 1) + static_cast<double>(p) / kOversampling;
+        double sum = 0.0;
+        double taps[kTaps];
+        for (size_t t = 0; t < kTaps; t++) {
+            double x = static_cast<double>(t) - centre;
+            double sinc = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+            double w = 0.42 + 0.5 * std::cos(kPi * x / half_width) + 0.08 * std::cos(2.0 * kPi * x / half_width);
+            taps[t] = sinc * w;
+            sum += taps[t];
+        }
+        for (size_t t = 0; t < kTaps; t++) {
+            coeffs_[t * kOversampling + p] = static_cast<float>(taps[t] / sum);
+        }
+    }
+
+    history_.assign(static_cast<size_t>(config.channels) * 2 * kTaps, 0.0f);
+    min_values_.assign(lookahead_ + 1, 1.0f);
+    min_index_.assign(lookahead_ + 1, 0);
+    box_.assign(lookahead_, 1.0f);
+    box_sum_ = static_cast<double>(lookahead_);
+    delay_.assign(GetLatencyFrames() * config.channels, 0.0f);
+}
+
+void TruePeakLimiter::Reset() {
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    history_pos_ = 0;
+    prev_interval_peak_ = 0.0f;
+    min_head_ = 0;
+    min_count_ = 0;
+    frame_index_ = 0;
+    envelope_ = 1.0f;
+    std::fill(box_.begin(), box_.end(), 1.0f);
+    box_pos_ = 0;
+    box_sum_ = static_cast<double>(lookahead_);
+    std::fill(delay_.begin(), delay_.end(), 0.0f);
+    delay_pos_ = 0;
+    gain_ = 1.0f;
+    min_gain_ = 1.0f;
+    max_true_peak_ = 0.0f;
+    limited_frames_ = 0;
+    frames_processed_ = 0;
+}
+
+// Minimum of the last lookahead_ values (monotonic deque, amortized O(1))
+float TruePeakLimiter::SlidingMin(float value) {
+    const size_t capacity = min_values_.size();
+    while (min_count_ > 0) {
+        size_t back = (min_head_ + min_count_ - 1) % capacity;
+        if (min_values_[back] < value) {
+            break;
+        }
+        min_count_--;
+    }
+    size_t slot = (min_head_ + min_count_) % capacity;
+    min_values_[slot] = value;
+    min_index_[slot] = frame_index_;
+    min_count_++;
+
+    if (min_index_[min_head_] + lookahead_ <= frame_index_) {
+        min_head_ = (min_head_ + 1) % capacity;
+        min_count_--;
+    }
+    frame_index_++;
+    return min_values_[min_head_];
+}
+
+void TruePeakLimiter::Process(float* samples, size_t frames) {
+    const size_t channels = config_.channels;
+    const size_t delay_frames = GetLatencyFrames();
+    auto true_peak = Kernels().truePeak;
+
+    for (size_t f = 0; f < frames; f++) {
+        float* frame = samples + f * channels;
+
+        // 1. Interval [n - kDetectorDelay, n - kDetectorDelay + 1) at 4x, all channels
+        float interval_peak = 0.0f;
+        for (size_t c = 0; c < channels; c++) {
+            float* h = history_.data() + c * 2 * kTaps;
+            h[history_pos_] = frame[c];
+            h[history_pos_ + kTaps] = frame[c];  // Mirror: the window is always contiguous
+        }
+        history_pos_ = (history_pos_ + 1) % kTaps;
+        for (size_t c = 0; c < channels; c++) {
+            const float* window = history_.data() + c * 2 * kTaps + history_pos_;  // Oldest -> newest
+            interval_peak = (std::max)(interval_peak, true_peak(window, coeffs_, kTaps));
+        }
+        max_true_peak_ = (std::max)(max_true_peak_, interval_peak);
+
+        // 2. A sample bounds the intervals on both sides of it
+        const float peak = (std::max)(interval_peak, prev_interval_peak_);
+        prev_interval_peak_ = interval_peak;
+        const float required = peak > ceiling_ ? ceiling_ / peak : 1.0f;
+
+        // 3. Hold for the look-ahead, release slowly, then average over the look-ahead:
+        //    the gain ramps down over lookahead_ frames and reaches `required` at the peak
+        const float hold = SlidingMin(required);
+        if (hold <= envelope_) {
+            envelope_ = hold;
+        } else {
+            const float next = envelope_ + (hold - envelope_) * release_coeff_;
+            envelope_ = next == envelope_ ? hold : next;  // The float step rounds away near the end
+        }
+        box_sum_ += static_cast<double>(envelope_) - box_[box_pos_];
+        box_[box_pos_] = envelope_;
+        box_pos_ = (box_pos_ + 1) % lookahead_;
+        const float gain = (std::min)(static_cast<float>(box_sum_ / static_cast<double>(lookahead_)), 1.0f);
+
+        // 4. Delay line out, gain and the brick wall
+        float* slot = delay_.data() + delay_pos_ * channels;
+        for (size_t c = 0; c < channels; c++) {
+            float y = slot[c] * gain;
+            slot[c] = frame[c];
+            frame[c] = y > ceiling_ ? ceiling_ : (y < -ceiling_ ? -ceiling_ : y);
+        }
+        delay_pos_ = (delay_pos_ + 1) % delay_frames;
+
+        gain_ = gain;
+        min_gain_ = (std::min)(min_gain_, gain);
+        if (gain < kUnityGain) {
+            limited_frames_++;
+        }
+    }
+    frames_processed_ += frames;
+}
+
+TruePeakLimiter::Stats TruePeakLimiter::GetStats() const {
+    Stats stats;
+    stats.gain_reduction_db = (std::max)(0.0f, -LinearToDb(gain_));
+    stats.max_gain_reduction_db = (std::max)(0.0f, -LinearToDb(min_gain_));
+    stats.true_peak_db = LinearToDb(max_true_peak_);
+    stats.limited_frames = limited_frames_;
+    stats.frames_processed = frames_processed_;
+    return stats;
+}
+
+}  // namespace wasapi_capture
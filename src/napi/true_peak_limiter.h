@@ -0,0 +1,135 @@
+/**
+ * True-Peak Limiter
+ *
+ * v2.12: Brick-wall look-ahead limiter, the last stage of the effect chain
+ * (after AGC and EQ, which can add up to +20 dB each).
+ *
+ * - True peak: each channel is interpolated at 4x (three fractional phases
+ *   of a 12-tap windowed sinc plus the sample itself), so inter-sample
+ *   peaks that a DAC or a resampler would reconstruct are caught, in the
+ *   spirit of ITU-R BS.1770 Annex 2. The four phases are one SIMD dot
+ *   product per channel and sample.
+ * - Gain: the gain each frame needs to stay under the ceiling is held for
+ *   the look-ahead window, released with a one-pole smoother and averaged
+ *   over the window, so attenuation ramps in before the peak leaves the
+ *   delay line and reaches the required value exactly at the peak. One gain
+ *   for all channels keeps the stereo image.
+ * - A final clamp at the ceiling makes the sample peak a hard guarantee.
+ *
+ * Latency is GetLatencyFrames() (look-ahead + interpolator delay). Buffers
+ * are sized in the constructor; Process() does not allocate.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cpu_features.h"
+
+namespace wasapi_capture {
+
+struct LimiterConfig {
+    uint32_t sample_rate = 48000;
+    uint16_t channels = 2;
+    float ceiling_db = -1.0f;    // Maximum true peak (dBTP), -20 - 0
+    float lookahead_ms = 1.5f;   // 0.1 - 20
+    float release_ms = 50.0f;    // 1 - 2000
+};
+
+class TruePeakLimiter {
+public:
+    struct Stats {
+        float gain_reduction_db;      // Current (0 = no limiting)
+        float max_gain_reduction_db;  // Largest since Reset()
+        float true_peak_db;           // Largest input true peak since Reset() (dBTP)
+        uint64_t limited_frames;      // Frames with any gain reduction
+        uint64_t frames_processed;
+    };
+
+    static constexpr uint16_t kMaxChannels = 8;
+    static constexpr size_t kTaps = 12;          // Interpolator taps per phase
+    static constexpr size_t kOversampling = 4;
+
+    /**
+     * @throws std::invalid_argument for a zero rate, a channel count outside
+     *         1-8 or parameters outside the ranges in LimiterConfig
+     */
+    explicit TruePeakLimiter(const LimiterConfig& config);
+
+    TruePeakLimiter(const TruePeakLimiter&) = delete;
+    TruePeakLimiter& operator=(const TruePeakLimiter&) = delete;
+
+    // Limit interleaved Float32 frames in place (output is GetLatencyFrames() late)
+    void Process(float* samples, size_t frames);
+
+    void Reset();
+
+    Stats GetStats() const;
+    const LimiterConfig& GetConfig() const { return config_; }
+    size_t GetLatencyFrames() const { return lookahead_ + kDetectorDelay - 1; }
+    bool Matches(uint32_t sampleRate, uint16_t channels) const {
+        return config_.sample_rate == sampleRate && config_.channels == channels;
+    }
+
+private:
+    // The interpolated interval [n - 6, n - 5) is known at input n
+    static constexpr size_t kDetectorDelay = kTaps / 2;
+
+    LimiterConfig config_;
+    float ceiling_;                // Linear
+    size_t lookahead_;             // Frames, >= 1
+    float release_coeff_;
+
+    // Interpolator: per phase, taps oldest -> newest; stored [tap][phase]
+    alignas(16) float coeffs_[kTaps * kOversampling];
+    std::vector<float> history_;   // Per channel, 2 * kTaps (mirrored ring)
+    size_t history_pos_ = 0;
+    float prev_interval_peak_ = 0.0f;
+
+    // Sliding minimum of the required gain (monotonic deque in a ring)
+    std::vector<float> min_values_;
+    std::vector<uint64_t> min_index_;
+    size_t min_head_ = 0;
+    size_t min_count_ = 0;
+    uint64_t frame_index_ = 0;
+
+    float envelope_ = 1.0f;        // Released hold value
+    std::vector<float> box_;       // Last lookahead_ envelope values
+    size_t box_pos_ = 0;
+    double box_sum_ = 0.0;
+
+    std::vector<float> delay_;     // Interleaved, GetLatencyFrames() frames
+    size_t delay_pos_ = 0;
+
+    // Meter
+    float gain_ = 1.0f;
+    float min_gain_ = 1.0f;
+    float max_true_peak_ = 0.0f;
+    uint64_t limited_frames_ = 0;
+    uint64_t frames_processed_ = 0;
+
+    float SlidingMin(float value);
+};
+
+namespace limiter_kernels {
+
+// Individual variants (for tests and benchmarks; callers must check the CPU)
+// Max |value| over four phases: sum over t of window[t] * coeffs[t * 4 + phase]
+float TruePeakScalar(const float* window, const float* coeffs, size_t taps);
+
+#if defined(AUDIO_SIMD_X86)
+float TruePeakSse2(const float* window, const float* coeffs, size_t taps);
+#endif
+
+#if defined(AUDIO_SIMD_NEON)
+float TruePeakNeon(const float* window, const float* coeffs, size_t taps);
+#endif
+
+}  // namespace limiter_kernels
+
+// Variant used by TruePeakLimiter
+SimdLevel GetLimiterKernel();
+
+}  // namespace wasapi_capture
@@ -0,0 +1,241 @@
+/**
+ * Voice Activity Gate Implementation
+ */
+
+#include "vad_gate.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace AudioCapture {
+
+namespace {
+
+// Noise floor rise time constant (falls are immediate)
+constexpr float kFloorRiseMs = 3000.0f;
+constexpr float kMinDb = -120.0f;
+
+}  // namespace
+
+bool ParseVadSource(const std::string& name, VadSource& source) {
+    if (name == "auto") {
+        source = VadSource::Auto;
+    } else if (name == "rnnoise") {
+        source = VadSource::Rnnoise;
+    } else if (name == "energy") {
+        source = VadSource::Energy;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* VadSourceName(VadSource source) {
+    switch (source) {
+        case VadSource::Rnnoise: return "rnnoise";
+        case VadSource::Energy:  return "energy";
+        default:                 return "auto";
+    }
+}
+
+VadGate::VadGate(const VadGateConfig& config)
+    : config_(config) {
+    if (config.sample_rate == 0 || config.channels == 0 || config.hop_ms == 0) {
+        throw std::invalid_argument("VAD gate needs a sample rate, channels and a non-zero hop");
+    }
+    if (!(config.threshold >= 0.0f && config.threshold <= 1.0f)) {
+        throw std::invalid_argument("VAD threshold must be between 0 and 1");
+    }
+
+    hop_frames_ = (std::max)(size_t{1}, static_cast<size_t>(config.sample_rate) * config.hop_ms / 1000);
+    attack_hops_ = (std::max)(size_t{1}, static_cast<size_t>((config.attack_ms + config.hop_ms - 1) / config.hop_ms));
+    hangover_hops_ = (std::max)(size_t{1}, static_cast<size_t>((config.hangover_ms + config.hop_ms - 1) / config.hop_ms));
+    pre_roll_frames_ = static_cast<size_t>(config.sample_rate) * config.pre_roll_ms / 1000;
+
+    // Everything from pre-roll before the onset to the end of the opening hop
+    ring_capacity_ = pre_roll_frames_ + attack_hops_ * hop_frames_;
+    ring_.assign(ring_capacity_ * config.channels, 0.0f);
+    events_.resize(kMaxEventsPerCall);
+}
+
+void VadGate::Reset() {
+    ring_write_ = 0;
+    ring_count_ = 0;
+    open_ = false;
+    hop_fill_ = 0;
+    hop_energy_ = 0.0;
+    speech_hops_ = 0;
+    silent_hops_ = 0;
+    onset_ = 0;
+    noise_floor_db_ = 0.0f;
+    floor_valid_ = false;
+    last_probability_ = 0.0f;
+    position_ = 0;
+    frames_delivered_ = 0;
+    segments_ = 0;
+    dropped_events_ = 0;
+    event_count_ = 0;
+}
+
+size_t VadGate::Process(const float* input, size_t frames, float* output, float probability) {
+    const size_t channels = config_.channels;
+    size_t written = 0;
+    event_count_ = 0;
+
+    while (frames > 0) {
+        size_t n = (std::min)(frames, hop_frames_ - hop_fill_);
+        const size_t samples = n * channels;
+
+        double energy = 0.0;
+        for (size_t i = 0; i < samples; i++) {
+            energy += static_cast<double>(input[i]) * input[i];
+        }
+        hop_energy_ += energy;
+
+        if (open_) {
+            std::memcpy(output + written * channels, input, samples * sizeof(float));
+            written += n;
+        } else {
+            RingPush(input, n);
+        }
+        input += samples;
+        frames -= n;
+        hop_fill_ += n;
+        position_ += n;
+
+        if (hop_fill_ < hop_frames_) {
+            continue;
+        }
+
+        // Hop complete: decide
+        float p = Decide(probability);
+        hop_fill_ = 0;
+        hop_energy_ = 0.0;
+        const bool speech = p >= config_.threshold;
+
+        if (!open_) {
+            if (!speech) {
+                speech_hops_ = 0;
+                continue;
+            }
+            if (speech_hops_ == 0) {
+                onset_ = position_ - hop_frames_;
+            }
+            if (++speech_hops_ < attack_hops_) {
+                continue;
+            }
+
+            // Open: release the ring from pre-roll before the onset
+            uint64_t start = onset_ > pre_roll_frames_ ? onset_ - pre_roll_frames_ : 0;
+            size_t release = static_cast<size_t>((std::min)(position_ - start, static_cast<uint64_t>(ring_count_)));
+            AddEvent({VadEvent::Type::SpeechStart, position_ - release, onset_, written, p});
+            written += RingRelease(output + written * channels, release);
+            open_ = true;
+            speech_hops_ = 0;
+            silent_hops_ = 0;
+            segments_++;
+        } else {
+            if (speech) {
+                silent_hops_ = 0;
+                continue;
+            }
+            if (++silent_hops_ < hangover_hops_) {
+                continue;
+            }
+
+            // Close: the hangover has already been delivered
+            AddEvent({VadEvent::Type::SpeechEnd, position_, position_, written, p});
+            open_ = false;
+            silent_hops_ = 0;
+            ring_write_ = 0;
+            ring_count_ = 0;
+        }
+    }
+
+    frames_delivered_ += written;
+    return written;
+}
+
+bool VadGate::Close(VadEvent& event) {
+    if (!open_) {
+        return false;
+    }
+    event = {VadEvent::Type::SpeechEnd, position_, position_, 0, last_probability_};
+    open_ = false;
+    silent_hops_ = 0;
+    ring_write_ = 0;
+    ring_count_ = 0;
+    return true;
+}
+
+float VadGate::Decide(float probability) {
+    double mean = hop_energy_ / static_cast<double>(hop_frames_ * config_.channels);
+    float db = mean > 0.0 ? static_cast<float>(10.0 * std::log10(mean)) : kMinDb;
+    db = (std::max)(db, kMinDb);
+
+    float p;
+    if (probability >= 0.0f) {
+        p = (std::min)(probability, 1.0f);
+    } else if (db < config_.energy_threshold_db) {
+        p = 0.0f;
+    } else {
+        // 0.5 at noise floor + margin, +/-10 dB spans 0-1
+        float floor = floor_valid_ ? noise_floor_db_ : db;
+        p = 0.5f + (db - (floor + config_.energy_margin_db)) / 20.0f;
+        p = (std::min)((std::max)(p, 0.0f), 1.0f);
+    }
+
+    // Noise floor: follows the level down at once, up with a slow time constant
+    if (!floor_valid_ || db < noise_floor_db_) {
+        noise_floor_db_ = db;
+        floor_valid_ = true;
+    } else {
+        noise_floor_db_ += (db - noise_floor_db_) * (static_cast<float>(config_.hop_ms) / kFloorRiseMs);
+    }
+
+    last_probability_ = p;
+    return p;
+}
+
+void VadGate::RingPush(const float* frames, size_t count) {
+    const size_t channels = config_.channels;
+    if (ring_capacity_ == 0) {
+        return;
+    }
+    if (count >= ring_capacity_) {
+        // Only the newest ring_capacity_ frames survive
+        frames += (count - ring_capacity_) * channels;
+        count = ring_capacity_;
+    }
+    size_t first = (std::min)(count, ring_capacity_ - ring_write_);
+    std::memcpy(ring_.data() + ring_write_ * channels, frames, first * channels * sizeof(float));
+    if (count > first) {
+        std::memcpy(ring_.data(), frames + first * channels, (count - first) * channels * sizeof(float));
+    }
+    ring_write_ = (ring_write_ + count) % ring_capacity_;
+    ring_count_ = (std::min)(ring_count_ + count, ring_capacity_);
+}
+
+size_t VadGate::RingRelease(float* output, size_t count) {
+    const size_t channels = config_.channels;
+    size_t start = (ring_write_ + ring_capacity_ - count) % ring_capacity_;
+    size_t first = (std::min)(count, ring_capacity_ - start);
+    std::memcpy(output, ring_.data() + start * channels, first * channels * sizeof(float));
+    if (count > first) {
+        std::memcpy(output + first * channels, ring_.data(), (count - first) * channels * sizeof(float));
+    }
+    ring_write_ = 0;
+    ring_count_ = 0;
+    return count;
+}
+
+void VadGate::AddEvent(const VadEvent& event) {
+    if (event_count_ < events_.size()) {
+        events_[event_count_++] = event;
+    } else {
+        dropped_events_++;
+    }
+}
+
+}  // namespace AudioCapture
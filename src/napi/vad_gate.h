@@ -0,0 +1,140 @@
+/**
+ * Voice Activity Gate
+ *
+ * v2.12: Suppresses non-speech audio before it reaches the output stage.
+ *
+ * Decisions are made every hop (10 ms) of capture-rate frames, independent
+ * of the WASAPI packet size. The voice probability comes from RNNoise when
+ * denoising is on (passed in per packet), otherwise from an energy detector
+ * against an adaptive noise floor. While closed, audio goes into a pre-roll
+ * ring; after attack_ms of consecutive speech the gate opens and releases
+ * the ring from pre_roll_ms before the speech onset, so word onsets are not
+ * clipped. It closes after hangover_ms without speech.
+ *
+ * Positions are capture frames since Reset(), so segment boundaries are
+ * sample accurate. Buffers are sized in the constructor; Process() does not
+ * allocate. Platform independent.
+ */
+
+#ifndef VAD_GATE_H
+#define VAD_GATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AudioCapture {
+
+enum class VadSource {
+    Auto,     // RNNoise probability when denoise is enabled, energy otherwise
+    Rnnoise,  // RNNoise only (energy while denoise is off)
+    Energy    // Energy detector only
+};
+
+bool ParseVadSource(const std::string& name, VadSource& source);
+const char* VadSourceName(VadSource source);
+
+struct VadGateConfig {
+    uint32_t sample_rate = 48000;
+    uint16_t channels = 2;
+    float threshold = 0.5f;            // Speech when probability >= threshold
+    uint32_t attack_ms = 30;           // Consecutive speech before opening
+    uint32_t hangover_ms = 300;        // Non-speech before closing
+    uint32_t pre_roll_ms = 200;        // Audio released from before the onset
+    uint32_t hop_ms = 10;              // Decision interval
+    float energy_threshold_db = -50.0f;  // Energy detector: absolute minimum level (dBFS)
+    float energy_margin_db = 10.0f;      // Energy detector: level above the noise floor
+    VadSource source = VadSource::Auto;
+};
+
+struct VadEvent {
+    enum class Type { SpeechStart, SpeechEnd };
+    Type type;
+    uint64_t position;     // Start: first released frame (pre-roll included); End: frame after the last
+    uint64_t onset;        // Start: first frame of the speech that opened the gate; End: same as position
+    size_t output_offset;  // Frame in this Process() call's output where the event applies
+    float probability;     // Probability of the deciding hop
+};
+
+class VadGate {
+public:
+    static constexpr size_t kMaxEventsPerCall = 64;
+
+    /**
+     * @throws std::invalid_argument for a zero rate/channel count, hop_ms of 0
+     *         or a threshold outside 0-1
+     */
+    explicit VadGate(const VadGateConfig& config);
+
+    /**
+     * Gate interleaved Float32 frames
+     *
+     * @param probability External voice probability for this packet (RNNoise),
+     *        < 0 to use the energy detector
+     * @param output Room for MaxOutputFrames(frames) frames
+     * @return Frames written to output (0 while closed); events in GetEvents()
+     */
+    size_t Process(const float* input, size_t frames, float* output, float probability);
+
+    // Upper bound on the output of one Process() call
+    size_t MaxOutputFrames(size_t frames) const { return ring_capacity_ + frames; }
+
+    // Events of the last Process() call, in output order
+    const VadEvent* GetEvents() const { return events_.data(); }
+    size_t GetEventCount() const { return event_count_; }
+
+    // End of stream: SpeechEnd at the current position if speaking
+    bool Close(VadEvent& event);
+
+    void Reset();
+
+    const VadGateConfig& GetConfig() const { return config_; }
+    bool IsSpeaking() const { return open_; }
+    float GetLastProbability() const { return last_probability_; }
+    float GetNoiseFloorDb() const { return noise_floor_db_; }
+    uint64_t GetPosition() const { return position_; }
+    uint64_t GetFramesDelivered() const { return frames_delivered_; }
+    uint64_t GetSegments() const { return segments_; }
+    uint64_t GetDroppedEvents() const { return dropped_events_; }
+
+private:
+    VadGateConfig config_;
+    size_t hop_frames_;
+    size_t attack_hops_;
+    size_t hangover_hops_;
+    size_t pre_roll_frames_;
+
+    // Pre-roll ring (interleaved), holds the newest ring_count_ frames while closed
+    std::vector<float> ring_;
+    size_t ring_capacity_;  // Frames
+    size_t ring_write_ = 0;
+    size_t ring_count_ = 0;
+
+    bool open_ = false;
+    size_t hop_fill_ = 0;
+    double hop_energy_ = 0.0;     // Sum of squares in the current hop
+    size_t speech_hops_ = 0;      // Consecutive speech hops while closed
+    size_t silent_hops_ = 0;      // Consecutive non-speech hops while open
+    uint64_t onset_ = 0;          // Start of the first speech hop while closed
+    float noise_floor_db_ = 0.0f;
+    bool floor_valid_ = false;
+    float last_probability_ = 0.0f;
+
+    uint64_t position_ = 0;       // Frames consumed
+    uint64_t frames_delivered_ = 0;
+    uint64_t segments_ = 0;
+    uint64_t dropped_events_ = 0;
+
+    std::vector<VadEvent> events_;
+    size_t event_count_ = 0;
+
+    float Decide(float probability);
+    void RingPush(const float* frames, size_t count);
+    size_t RingRelease(float* output, size_t count);
+    void AddEvent(const VadEvent& event);
+};
+
+}  // namespace AudioCapture
+
+#endif  // VAD_GATE_H
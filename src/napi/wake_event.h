@@ -0,0 +1,110 @@
+/**
+ * Wake Event
+ *
+ * v2.12: Auto-reset wake-up signal for a single waiting thread.
+ *
+ * Signal() never takes a user-space lock, so a real-time producer (the MMCSS
+ * capture thread) can wake a consumer without risking priority inversion on a
+ * mutex held by a lower-priority thread. Windows uses an auto-reset event;
+ * other platforms (tests) use a POSIX semaphore.
+ */
+
+#ifndef WAKE_EVENT_H
+#define WAKE_EVENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+#endif
+
+namespace AudioCapture {
+
+class WakeEvent {
+public:
+#ifdef _WIN32
+    WakeEvent() : event_(CreateEventW(nullptr, FALSE, FALSE, nullptr)) {}
+
+    ~WakeEvent() {
+        if (event_) {
+            CloseHandle(event_);
+        }
+    }
+
+    // Wake the waiter (or the next WaitFor() call); never blocks
+    void Signal() {
+        if (event_) {
+            SetEvent(event_);
+        }
+    }
+
+    // @return true if signalled, false on timeout
+    bool WaitFor(uint32_t timeout_ms) {
+        if (!event_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));  // Polling fallback
+            return false;
+        }
+        return WaitForSingleObject(event_, timeout_ms) == WAIT_OBJECT_0;
+    }
+#else
+    WakeEvent() : valid_(sem_init(&sem_, 0, 0) == 0) {}
+
+    ~WakeEvent() {
+        if (valid_) {
+            sem_destroy(&sem_);
+        }
+    }
+
+    void Signal() {
+        if (valid_) {
+            sem_post(&sem_);
+        }
+    }
+
+    bool WaitFor(uint32_t timeout_ms) {
+        if (!valid_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+            return false;
+        }
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += static_cast<long>(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        int result;
+        while ((result = sem_timedwait(&sem_, &deadline)) != 0 && errno == EINTR) {
+        }
+        if (result != 0) {
+            return false;
+        }
+        while (sem_trywait(&sem_) == 0) {
+            // Auto-reset: collapse signals that arrived meanwhile
+        }
+        return true;
+    }
+#endif
+
+    WakeEvent(const WakeEvent&) = delete;
+    WakeEvent& operator=(const WakeEvent&) = delete;
+
+private:
+#ifdef _WIN32
+    HANDLE event_;
+#else
+    sem_t sem_;
+    bool valid_;
+#endif
+};
+
+} // namespace AudioCapture
+
+#endif // WAKE_EVENT_H
@@ -5,6 +5,9 @@
 #include <propvarutil.h>
 #include <propidl.h>
 #include <windows.h>
+#include <mmreg.h>
+#include <ks.h>
+#include <ksmedia.h>
 #include <functional>
 #include <vector>
 #include <stdio.h>
@@ -48,6 +51,12 @@ bool AudioClient::Initialize(const AudioActivationParams& params) {
     WAVEFORMATEX* pFormat = nullptr;
     hr = audioClient_->GetMixFormat(&pFormat);
     if (FAILED(hr)) return false;
+    
+    // v2.12: 缓存流格式，供数据路径使用
+    if (!CacheStreamFormat(pFormat)) {
+        CoTaskMemFree(pFormat);
+        return false;
+    }
 
     // 初始化音频客户端（共享模式 + 环回 + 事件驱动）
     hr = audioClient_->Initialize(
@@ -67,6 +76,7 @@ bool AudioClient::Initialize(const AudioActivationParams& params) {
     if (FAILED(hr)) return false;
 
     captureClient_ = captureClient;
+    AllocateSilence();
     initialized_ = true;
     return true;
 }
@@ -124,6 +134,13 @@ bool AudioClient::InitializeWithDeviceId(const std::string& deviceId, bool isLoo
     
     DEBUG_LOGF("[AudioClient] Mix format: %d Hz, %d channels, %d bits\n",
                pFormat->nSamplesPerSec, pFormat->nChannels, pFormat->wBitsPerSample);
+    
+    // v2.12: 缓存流格式，供数据路径使用
+    if (!CacheStreamFormat(pFormat)) {
+        DEBUG_LOG("[AudioClient] Unsupported mix format\n");
+        CoTaskMemFree(pFormat);
+        return false;
+    }
 
     // 构建流标志
     DWORD streamFlags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
@@ -167,6 +184,7 @@ bool AudioClient::InitializeWithDeviceId(const std::string& deviceId, bool isLoo
     DEBUG_LOG("[AudioClient] Capture client acquired\n");
 
     captureClient_ = captureClient;
+    AllocateSilence();
     initialized_ = true;
     
     DEBUG_LOG("[AudioClient] InitializeWithDeviceId completed successfully\n");
@@ -227,26 +245,42 @@ bool AudioClient::Stop() {
     return SUCCEEDED(hr);
 }
 
+// v2.12: 暂停音频流（会话静音状态保持不变）
+bool AudioClient::Pause() {
+    if (!audioClient_) return false;
+    
+    HRESULT hr = audioClient_->Stop();
+    if (FAILED(hr)) {
+        return false;
+    }
+    
+    // 丢弃暂停前未读取的数据，恢复后不会收到过期音频
+    audioClient_->Reset();
+    return true;
+}
+
 // 处理音频样本
 bool AudioClient::ProcessAudioSample(BYTE* pData, UINT32 numFrames) {
-    if (!audioDataCallback_ || !pData || numFrames == 0) {
+    if (!audioDataCallback_ || numFrames == 0) {
         return true;
     }
     
-    // 获取音频格式以计算字节数
-    WAVEFORMATEX* pFormat = nullptr;
-    HRESULT hr = audioClient_->GetMixFormat(&pFormat);
-    if (FAILED(hr)) return false;
-    
     // 计算数据大小（帧数 * 每帧字节数）
-    UINT32 bytesPerFrame = pFormat->nBlockAlign;
+    // v2.12: 使用初始化时缓存的格式，避免每个数据包调用 GetMixFormat + CoTaskMemFree
+    UINT32 bytesPerFrame = streamFormat_.blockAlign;
     UINT32 dataSize = numFrames * bytesPerFrame;
     
-    CoTaskMemFree(pFormat);
+    // v2.12: 静音数据包（pData == nullptr）以零填充投递，下游的采样时钟（VAD 位置、统计间隔、
+    // 特征位置）与真实时间保持一致
+    if (!pData) {
+        if (silence_.size() < dataSize) {
+            silence_.resize(dataSize, 0);  // Not expected: packets never exceed the endpoint buffer
+        }
+        pData = silence_.data();
+    }
     
-    // 复制数据到 vector 并回调
-    std::vector<uint8_t> audioData(pData, pData + dataSize);
-    audioDataCallback_(audioData);
+    // v2.12: 不再复制到临时 vector，回调方直接从 WASAPI 缓冲区拷贝到输出缓冲区
+    audioDataCallback_(reinterpret_cast<const uint8_t*>(pData), dataSize, streamFormat_);
     
     return true;
 }
@@ -256,6 +290,48 @@ void AudioClient::SetAudioDataCallback(AudioDataCallback callback) {
     audioDataCallback_ = callback;
 }
 
+// v2.12: 预分配一个端点缓冲区大小的零数据，静音数据包不在捕获线程上分配内存
+void AudioClient::AllocateSilence() {
+    UINT32 bufferFrames = 0;
+    if (FAILED(audioClient_->GetBufferSize(&bufferFrames))) {
+        bufferFrames = streamFormat_.sampleRate;  // 与初始化时请求的 1 秒缓冲区一致
+    }
+    silence_.assign(static_cast<size_t>(bufferFrames) * streamFormat_.blockAlign, 0);
+}
+
+// v2.12: 解析 GetMixFormat 返回的格式并缓存
+bool AudioClient::CacheStreamFormat(const WAVEFORMATEX* pFormat) {
+    if (!pFormat || pFormat->nChannels == 0 || pFormat->nBlockAlign == 0) {
+        return false;
+    }
+    
+    StreamFormat format;
+    format.sampleRate = pFormat->nSamplesPerSec;
+    format.channels = pFormat->nChannels;
+    format.bitsPerSample = pFormat->wBitsPerSample;
+    format.validBitsPerSample = pFormat->wBitsPerSample;
+    format.blockAlign = pFormat->nBlockAlign;
+    format.channelMask = 0;
+    
+    if (pFormat->wFormatTag == WAVE_FORMAT_EXTENSIBLE &&
+        pFormat->cbSize >= sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX)) {
+        // 共享模式混音格式通常为 WAVEFORMATEXTENSIBLE
+        const auto* ext = reinterpret_cast<const WAVEFORMATEXTENSIBLE*>(pFormat);
+        format.isFloat = IsEqualGUID(ext->SubFormat, KSDATAFORMAT_SUBTYPE_IEEE_FLOAT) != FALSE;
+        format.validBitsPerSample = ext->Samples.wValidBitsPerSample;
+        format.channelMask = ext->dwChannelMask;
+    } else {
+        format.isFloat = (pFormat->wFormatTag == WAVE_FORMAT_IEEE_FLOAT);
+    }
+    
+    streamFormat_ = format;
+    
+    DEBUG_LOGF("[AudioClient] Cached stream format: %u Hz, %u ch, %u bits, %s, mask=0x%08X\n",
+               format.sampleRate, format.channels, format.bitsPerSample,
+               format.isFloat ? "float" : "pcm", format.channelMask);
+    return true;
+}
+
 // ========== v2.0: 进程过滤功能 ==========
 
 // v2.0: 初始化并启用进程过滤
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <memory>
 #include "audio_params.h"
+#include "stream_format.h"         // v2.12: 缓存的混音格式
 #include "audio_session_manager.h"  // v2.0: 音频会话管理
 
 class AudioClient {
@@ -44,14 +45,22 @@ public:
 
     // 停止音频捕获
     bool Stop();
+    
+    // v2.12: 暂停音频流（IAudioClient::Stop + Reset），不恢复静音状态；用 Start() 恢复
+    bool Pause();
 
-    // 处理音频样本（接口占位）
+    // 处理音频样本（pData 为 nullptr 表示静音数据包，以零填充投递）
     bool ProcessAudioSample(BYTE* pData, UINT32 numFrames);
     
     // 设置音频数据回调
-    using AudioDataCallback = std::function<void(const std::vector<uint8_t>&)>;
+    // v2.12: 直接传递 WASAPI 缓冲区指针，由回调方负责唯一一次拷贝
+    // v2.12: 同时传递初始化时缓存的流格式，DSP 阶段据此获取真实布局
+    using AudioDataCallback = std::function<void(const uint8_t* data, size_t size, const StreamFormat& format)>;
     void SetAudioDataCallback(AudioDataCallback callback);
     
+    // v2.12: 获取初始化时协商的流格式（不再在每个数据包上调用 GetMixFormat）
+    const StreamFormat& GetStreamFormat() const { return streamFormat_; }
+    
     // v2.0: 进程过滤相关
     void SetProcessFilter(DWORD processId);  // 0 = 禁用过滤
     DWORD GetProcessFilter() const { return filterProcessId_; }
@@ -91,6 +100,14 @@ private:
     bool initialized_ = false;
     AudioDataCallback audioDataCallback_;
     
+    // v2.12: 缓存的混音格式（Initialize 时读取一次）
+    StreamFormat streamFormat_;
+    bool CacheStreamFormat(const WAVEFORMATEX* pFormat);
+    
+    // v2.12: 静音数据包的零填充数据（初始化时按端点缓冲区大小分配）
+    std::vector<BYTE> silence_;
+    void AllocateSilence();
+    
     // v2.0: 进程过滤
     DWORD filterProcessId_ = 0;  // 0 = 不过滤
     std::unique_ptr<audio_capture::AudioSessionManager> sessionManager_;
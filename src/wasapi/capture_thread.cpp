@@ -91,7 +91,7 @@ void CaptureThread::ThreadProc() {
             
             // 处理静音标志
             if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
-                pData = nullptr;  // 静音数据，传递 nullptr
+                pData = nullptr;  // 静音数据：AudioClient 以零填充投递（保持采样时钟连续）
             }
             
             // 处理音频样本（回调到 AudioClient）
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// v2.12: 协商后的流格式（初始化时从 GetMixFormat 读取一次并缓存）
+// 不依赖 Windows 头文件，可在处理线程与 DSP 模块中直接使用
+struct StreamFormat {
+    uint32_t sampleRate = 48000;       // 采样率 (Hz)
+    uint16_t channels = 2;             // 声道数
+    uint16_t bitsPerSample = 32;       // 容器位深
+    uint16_t validBitsPerSample = 32;  // 有效位深（WAVEFORMATEXTENSIBLE）
+    uint16_t blockAlign = 8;           // 每帧字节数
+    bool isFloat = true;               // IEEE float 或整数 PCM
+    uint32_t channelMask = 0;          // 扬声器位置掩码（0 = 未指定）
+
+    // 效果链只处理 Float32 交错数据
+    bool IsFloat32() const { return isFloat && bitsPerSample == 32; }
+
+    size_t BytesPerSample() const { return bitsPerSample / 8; }
+
+    // 字节数 -> 帧数
+    size_t FrameCount(size_t bytes) const {
+        return blockAlign > 0 ? bytes / blockAlign : 0;
+    }
+};
@@ -0,0 +1,204 @@
+#include "agc_processor.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using wasapi_capture::SimpleAGC;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<float> Tone(size_t frames, size_t channels, float amplitude, size_t start = 0) {
+    std::vector<float> out(frames * channels);
+    for (size_t f = 0; f < frames; f++) {
+        float v = amplitude * static_cast<float>(std::sin(2.0 * kPi * 440.0 * (start + f) / 48000.0));
+        for (size_t c = 0; c < channels; c++) {
+            out[f * channels + c] = v;
+        }
+    }
+    return out;
+}
+
+std::unique_ptr<SimpleAGC> MakeLookAhead(SimpleAGC::Options options = SimpleAGC::Options()) {
+    auto agc = std::make_unique<SimpleAGC>();
+    agc->Initialize(48000);
+    options.mode = SimpleAGC::Mode::LookAhead;
+    agc->SetOptions(options);
+    agc->SetEnabled(true);
+    return agc;
+}
+
+std::vector<float> ProcessPackets(SimpleAGC& agc, std::vector<float> data, size_t channels, size_t packet) {
+    size_t frames = data.size() / channels;
+    for (size_t offset = 0; offset < frames; offset += packet) {
+        size_t n = (std::min)(packet, frames - offset);
+        agc.Process(data.data() + offset * channels, static_cast<int>(n), static_cast<int>(channels));
+    }
+    return data;
+}
+
+double RmsDb(const float* samples, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return 10.0 * std::log10(sum / count);
+}
+
+}  // namespace
+
+TEST(AGCProcessorTest, GainRampSimdMatchesScalar) {
+    using namespace wasapi_capture::agc_kernels;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    for (size_t channels : {1u, 2u, 3u, 6u}) {
+        std::vector<float> input(channels * 203);
+        for (auto& v : input) {
+            v = dist(rng);
+        }
+        auto ref = input;
+        ApplyGainRampScalar(ref.data(), 203, channels, 0.5f, 0.01f, 7);
+        EXPECT_FLOAT_EQ(ref[0], input[0] * (0.5f + 0.07f));
+
+        std::vector<std::vector<float>> variants;
+#if defined(AUDIO_SIMD_X86)
+        variants.push_back(input);
+        ApplyGainRampSse2(variants.back().data(), 203, channels, 0.5f, 0.01f, 7);
+        if (wasapi_capture::GetCpuFeatures().avx2) {
+            variants.push_back(input);
+            ApplyGainRampAvx2(variants.back().data(), 203, channels, 0.5f, 0.01f, 7);
+        }
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        variants.push_back(input);
+        ApplyGainRampNeon(variants.back().data(), 203, channels, 0.5f, 0.01f, 7);
+#endif
+        for (const auto& got : variants) {
+            for (size_t i = 0; i < ref.size(); i++) {
+                ASSERT_NEAR(got[i], ref[i], 1e-6f) << channels << " channels, sample " << i;
+            }
+        }
+    }
+}
+
+TEST(AGCProcessorTest, LookAheadDelaysByLatency) {
+    // Gain pinned at 0 dB: the output is the input, lookahead_ms later
+    SimpleAGC::Options options;
+    options.max_gain_db = 0.0f;
+    options.min_gain_db = 0.0f;
+    options.lookahead_ms = 5.0f;
+    auto agc = MakeLookAhead(options);
+    EXPECT_EQ(agc->GetStats().latency_frames, 240u);
+
+    auto input = Tone(4800, 2, 0.3f);
+    auto output = ProcessPackets(*agc, input, 2, 441);
+    for (size_t i = 0; i < 240 * 2; i++) {
+        ASSERT_EQ(output[i], 0.0f);
+    }
+    for (size_t i = 240 * 2; i < output.size(); i++) {
+        ASSERT_EQ(output[i], input[i - 240 * 2]);
+    }
+}
+
+TEST(AGCProcessorTest, LookAheadIsPacketSizeIndependent) {
+    // Quiet, then loud: the gain moves in both directions
+    auto input = Tone(24000, 2, 0.01f);
+    auto loud = Tone(24000, 2, 0.5f, 24000);
+    input.insert(input.end(), loud.begin(), loud.end());
+
+    auto reference_agc = MakeLookAhead();
+    auto reference = ProcessPackets(*reference_agc, input, 2, 480);
+    for (size_t packet : {441u, 7u, 1024u}) {
+        auto agc = MakeLookAhead();
+        auto output = ProcessPackets(*agc, input, 2, packet);
+        for (size_t i = 0; i < output.size(); i++) {
+            ASSERT_NEAR(output[i], reference[i], 1e-5f) << "packet " << packet << ", sample " << i;
+        }
+        EXPECT_NEAR(agc->GetStats().current_gain_db, reference_agc->GetStats().current_gain_db, 1e-3f);
+    }
+}
+
+TEST(AGCProcessorTest, LookAheadGainHasNoSteps) {
+    SimpleAGC::Options options;
+    options.attack_time_ms = 1.0f;
+    options.release_time_ms = 1.0f;
+    auto agc = MakeLookAhead(options);
+
+    // Constant input: the output is the per-sample gain
+    std::vector<float> input(2 * 48000, 0.01f);
+    auto output = ProcessPackets(*agc, input, 2, 480);
+    const size_t delay = agc->GetStats().latency_frames;
+    float max_jump = 0.0f;
+    for (size_t f = delay + 1; f < 48000; f++) {
+        max_jump = (std::max)(max_jump, std::fabs(output[2 * f] - output[2 * (f - 1)]));
+    }
+    // A 20 dB rise (0.01 -> 0.1) spread over hops of 48 samples
+    EXPECT_LT(max_jump, 0.1f / 48.0f);
+    EXPECT_NEAR(RmsDb(output.data() + 2 * 24000, 2 * 24000), -20.0, 0.1);  // Reached the target level
+}
+
+TEST(AGCProcessorTest, LookAheadReachesTargetLevel) {
+    auto agc = MakeLookAhead();
+    auto output = ProcessPackets(*agc, Tone(96000, 1, 0.02f), 1, 441);
+    // Sine peak 0.02 = -37 dBFS RMS, 17 dB below the -20 dBFS target
+    EXPECT_NEAR(RmsDb(output.data() + 48000, 48000), -20.0, 0.5);
+    auto stats = agc->GetStats();
+    EXPECT_NEAR(stats.current_gain_db, 17.0f, 0.5f);
+    EXPECT_EQ(stats.mode, SimpleAGC::Mode::LookAhead);
+    EXPECT_FALSE(stats.clipping);
+    EXPECT_EQ(stats.frames_processed, 96000u);
+}
+
+TEST(AGCProcessorTest, ParsesModes) {
+    SimpleAGC::Mode mode = SimpleAGC::Mode::Block;
+    EXPECT_TRUE(wasapi_capture::ParseAGCMode("lookahead", mode));
+    EXPECT_EQ(mode, SimpleAGC::Mode::LookAhead);
+    EXPECT_STREQ(wasapi_capture::AGCModeName(mode), "lookahead");
+    EXPECT_FALSE(wasapi_capture::ParseAGCMode("peak", mode));
+
+    SimpleAGC agc;
+    agc.Initialize(48000);
+    EXPECT_EQ(agc.GetStats().latency_frames, 0u);  // Block mode adds no delay
+}
+
+TEST(AGCProcessorTest, ReconfiguresWhileProcessing) {
+    // Options and enable/disable come from the JS thread while audio flows
+    auto agc = MakeLookAhead();
+    std::thread processing([&] {
+        auto input = Tone(480, 2, 0.05f);
+        for (int i = 0; i < 2000; i++) {
+            auto packet = input;
+            agc->Process(packet.data(), 480, 2);
+            for (float v : packet) {
+                ASSERT_TRUE(std::isfinite(v));
+            }
+        }
+    });
+    for (int i = 0; i < 500; i++) {
+        SimpleAGC::Options options;
+        options.mode = i % 2 ? SimpleAGC::Mode::LookAhead : SimpleAGC::Mode::Block;
+        options.lookahead_ms = static_cast<float>(i % 20);
+        options.attack_time_ms = 5.0f + static_cast<float>(i % 7);
+        agc->SetOptions(options);
+        agc->SetEnabled(i % 3 != 0);
+        EXPECT_EQ(agc->GetOptions().lookahead_ms, options.lookahead_ms);
+        EXPECT_TRUE(std::isfinite(agc->GetStats().current_gain_db));  // getAGCStats() from JS
+    }
+    processing.join();
+
+    // The gain reset of a disable is applied by the next packet
+    agc->SetOptions(SimpleAGC::Options());
+    agc->SetEnabled(true);
+    ProcessPackets(*agc, Tone(4800, 2, 0.05f), 2, 480);
+    EXPECT_GT(agc->GetStats().current_gain_db, 1.0f);
+    agc->SetEnabled(false);
+    agc->SetEnabled(true);
+    auto silence = std::vector<float>(2, 0.0f);
+    agc->Process(silence.data(), 1, 2);
+    EXPECT_LT(std::fabs(agc->GetStats().current_gain_db), 0.1f);
+}
@@ -0,0 +1,117 @@
+#include "audio_level_kernels.h"
+#include "audio_stats_calculator.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace wasapi_capture;
+
+namespace {
+
+std::vector<float> RandomFloats(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> samples(count);
+    for (auto& s : samples) s = dist(rng);
+    return samples;
+}
+
+std::vector<int16_t> RandomInt16(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+    std::vector<int16_t> samples(count);
+    for (auto& s : samples) s = static_cast<int16_t>(dist(rng));
+    return samples;
+}
+
+// Every variant this CPU can run, scalar first
+std::vector<std::pair<LevelSums (*)(const float*, size_t),
+                      LevelSums (*)(const int16_t*, size_t)>> Variants() {
+    using namespace level_kernels;
+    std::vector<std::pair<LevelSums (*)(const float*, size_t),
+                          LevelSums (*)(const int16_t*, size_t)>> variants;
+    variants.push_back({&MeasureScalar, &MeasureScalar});
+#if defined(AUDIO_SIMD_X86)
+    if (GetCpuFeatures().sse2) variants.push_back({&MeasureSse2, &MeasureSse2});
+    if (GetCpuFeatures().avx2) variants.push_back({&MeasureAvx2, &MeasureAvx2});
+#endif
+#if defined(AUDIO_SIMD_NEON)
+    variants.push_back({&MeasureNeon, &MeasureNeon});
+#endif
+    return variants;
+}
+
+}  // namespace
+
+TEST(AudioLevelKernelsTest, FloatVariantsMatchScalar) {
+    // Odd lengths exercise the scalar tails, long ones the block flush
+    for (size_t count : {0u, 1u, 7u, 15u, 17u, 480u, 1023u, 4801u, 96000u}) {
+        auto samples = RandomFloats(count, static_cast<unsigned>(count));
+        LevelSums ref = level_kernels::MeasureScalar(samples.data(), count);
+        for (auto& variant : Variants()) {
+            LevelSums got = variant.first(samples.data(), count);
+            EXPECT_EQ(got.peak, ref.peak) << "count " << count;
+            EXPECT_NEAR(got.sumSquares, ref.sumSquares, 1e-5 * ref.sumSquares + 1e-12)
+                << "count " << count;
+        }
+    }
+}
+
+TEST(AudioLevelKernelsTest, Int16VariantsAreExact) {
+    for (size_t count : {0u, 3u, 8u, 31u, 480u, 96001u}) {
+        auto samples = RandomInt16(count, static_cast<unsigned>(count) + 1);
+        if (count > 0) samples[count / 2] = -32768;  // |min| overflows int16
+        LevelSums ref = level_kernels::MeasureScalar(samples.data(), count);
+        for (auto& variant : Variants()) {
+            LevelSums got = variant.second(samples.data(), count);
+            EXPECT_EQ(got.peak, ref.peak) << "count " << count;
+            EXPECT_EQ(got.sumSquares, ref.sumSquares) << "count " << count;
+        }
+        if (count > 0) {
+            EXPECT_FLOAT_EQ(ref.peak, 1.0f);
+        }
+    }
+}
+
+TEST(AudioLevelKernelsTest, FullScaleInt16DoesNotWrap) {
+    std::vector<int16_t> samples(64, -32768);
+    for (auto& variant : Variants()) {
+        LevelSums got = variant.second(samples.data(), samples.size());
+        EXPECT_DOUBLE_EQ(got.sumSquares, 64.0);
+        EXPECT_FLOAT_EQ(got.peak, 1.0f);
+    }
+}
+
+TEST(AudioLevelKernelsTest, NanSamplesDoNotBecomePeak) {
+    auto samples = RandomFloats(64, 5);
+    samples[10] = std::numeric_limits<float>::quiet_NaN();
+    samples[20] = -0.999f;
+    for (auto& variant : Variants()) {
+        EXPECT_FLOAT_EQ(variant.first(samples.data(), samples.size()).peak, 0.999f);
+    }
+}
+
+TEST(AudioLevelKernelsTest, CalculatorMatchesReferenceFormulas) {
+    AudioStatsCalculator calculator;
+    auto samples = RandomFloats(4800, 9);
+
+    double sum = 0.0;
+    float peak = 0.0f;
+    for (float s : samples) {
+        sum += static_cast<double>(s) * s;
+        peak = std::max(peak, std::fabs(s));
+    }
+    float rms = static_cast<float>(std::sqrt(sum / samples.size()));
+
+    AudioStats stats = calculator.Calculate(samples.data(), samples.size());
+    EXPECT_FLOAT_EQ(stats.peak, peak);
+    EXPECT_NEAR(stats.rms, rms, 1e-5f);
+    EXPECT_NEAR(stats.db, 20.0f * std::log10(rms), 1e-3f);
+    EXPECT_FALSE(stats.isSilence);
+
+    AudioStats empty = calculator.Calculate(static_cast<const float*>(nullptr), 0);
+    EXPECT_TRUE(empty.isSilence);
+    EXPECT_TRUE(std::isinf(empty.db));
+}
@@ -0,0 +1,209 @@
+#include "biquad_cascade.h"
+#include "eq_processor.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using wasapi_capture::BiquadCascade;
+using wasapi_capture::BiquadCoefficients;
+using wasapi_capture::BiquadFilter;
+
+namespace {
+
+std::vector<float> Noise(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    std::vector<float> out(count);
+    for (auto& v : out) {
+        v = dist(rng);
+    }
+    return out;
+}
+
+// Designs `sections` filters at 48 kHz (shelves and peaks, like the EQ)
+std::vector<BiquadFilter> Design(size_t sections) {
+    std::vector<BiquadFilter> filters(sections);
+    for (size_t s = 0; s < sections; s++) {
+        filters[s].Initialize(48000);
+        BiquadFilter::Type type = s % 3 == 0 ? BiquadFilter::Type::LowShelf
+                                : s % 3 == 1 ? BiquadFilter::Type::Peak
+                                             : BiquadFilter::Type::HighShelf;
+        filters[s].SetFilter(type, 150.0f * static_cast<float>(s + 1), 0.9f, s % 2 ? -6.0f : 9.0f);
+    }
+    return filters;
+}
+
+BiquadCascade MakeCascade(const std::vector<BiquadFilter>& filters, size_t channels) {
+    BiquadCascade cascade(filters.size(), channels);
+    for (size_t s = 0; s < filters.size(); s++) {
+        cascade.SetSection(s, filters[s].GetCoefficients());
+    }
+    return cascade;
+}
+
+}  // namespace
+
+TEST(BiquadCascadeTest, MatchesPerSampleFilters) {
+    const size_t frames = 4800;
+    for (size_t channels = 1; channels <= 8; channels++) {
+        auto designs = Design(3);
+        auto cascade = MakeCascade(designs, channels);
+        auto input = Noise(frames * channels, static_cast<uint32_t>(channels));
+        auto output = input;
+        cascade.Process(output.data(), frames, channels);
+
+        // Independent filters per channel (direct form I)
+        for (size_t ch = 0; ch < channels; ch++) {
+            auto filters = Design(3);
+            for (size_t f = 0; f < frames; f++) {
+                float x = input[f * channels + ch];
+                for (auto& filter : filters) {
+                    x = filter.Process(x);
+                }
+                ASSERT_NEAR(output[f * channels + ch], x, 1e-4f)
+                    << channels << " channels, channel " << ch << ", frame " << f;
+            }
+        }
+    }
+}
+
+TEST(BiquadCascadeTest, SimdMatchesScalar) {
+    using namespace wasapi_capture::biquad_kernels;
+    for (size_t sections : {1u, 3u, 7u}) {
+        auto designs = Design(sections);
+        for (size_t channels = 1; channels <= 8; channels++) {
+            const size_t frames = 517;
+            auto input = Noise(frames * channels, 7);
+            auto cascade = MakeCascade(designs, channels);
+
+            // Coefficients in the cascade layout, fresh state per variant
+            std::vector<float> layout(sections * kCoeffStride);
+            for (size_t s = 0; s < sections; s++) {
+                BiquadCoefficients c = designs[s].GetCoefficients();
+                const float values[5] = {c.b0, c.b1, c.b2, c.a1, c.a2};
+                for (size_t k = 0; k < 5; k++) {
+                    for (size_t lane = 0; lane < 8; lane++) {
+                        layout[s * kCoeffStride + k * 8 + lane] = values[k];
+                    }
+                }
+            }
+
+            auto ref = input;
+            std::vector<float> ref_state(sections * kStateStride, 0.0f);
+            CascadeScalar(ref.data(), frames, channels, channels, layout.data(), ref_state.data(), sections);
+
+            // The engine picks the best variant for this CPU
+            auto engine = input;
+            cascade.Process(engine.data(), frames, channels);
+
+            std::vector<std::vector<float>> variants{engine};
+#if defined(AUDIO_SIMD_X86)
+            variants.push_back(input);
+            std::vector<float> state(sections * kStateStride, 0.0f);
+            CascadeSse2(variants.back().data(), frames, channels, channels, layout.data(), state.data(), sections);
+            if (wasapi_capture::GetCpuFeatures().avx2) {
+                variants.push_back(input);
+                std::fill(state.begin(), state.end(), 0.0f);
+                CascadeAvx2(variants.back().data(), frames, channels, channels, layout.data(), state.data(), sections);
+            }
+#endif
+#if defined(AUDIO_SIMD_NEON)
+            variants.push_back(input);
+            std::vector<float> state(sections * kStateStride, 0.0f);
+            CascadeNeon(variants.back().data(), frames, channels, channels, layout.data(), state.data(), sections);
+#endif
+            for (const auto& got : variants) {
+                for (size_t i = 0; i < ref.size(); i++) {
+                    ASSERT_NEAR(got[i], ref[i], 1e-5f)
+                        << sections << " sections, " << channels << " channels, sample " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(BiquadCascadeTest, IsPacketSizeIndependent) {
+    auto designs = Design(4);
+    const size_t channels = 6;
+    const size_t frames = 4000;
+    auto input = Noise(frames * channels, 3);
+
+    auto whole_cascade = MakeCascade(designs, channels);
+    auto whole = input;
+    whole_cascade.Process(whole.data(), frames, channels);
+
+    for (size_t packet : {1u, 7u, 441u}) {
+        auto cascade = MakeCascade(designs, channels);
+        auto output = input;
+        for (size_t offset = 0; offset < frames; offset += packet) {
+            size_t n = (std::min)(packet, frames - offset);
+            cascade.Process(output.data() + offset * channels, n, channels);
+        }
+        EXPECT_EQ(output, whole) << "packet " << packet;
+    }
+}
+
+TEST(BiquadCascadeTest, FiltersOnlyConfiguredChannels) {
+    // 2-channel cascade on 3-channel frames: the third channel is left alone
+    auto cascade = MakeCascade(Design(2), 2);
+    auto input = Noise(300 * 3, 5);
+    auto output = input;
+    cascade.Process(output.data(), 300, 3);
+    for (size_t f = 0; f < 300; f++) {
+        ASSERT_EQ(output[f * 3 + 2], input[f * 3 + 2]);
+    }
+    EXPECT_NE(output[3 * 100], input[3 * 100]);
+
+    cascade.Reset();
+    auto again = input;
+    cascade.Process(again.data(), 300, 3);
+    EXPECT_EQ(again, output);
+}
+
+TEST(BiquadCascadeTest, RejectsInvalidShape) {
+    EXPECT_THROW(BiquadCascade(0, 2), std::invalid_argument);
+    EXPECT_THROW(BiquadCascade(3, 0), std::invalid_argument);
+    EXPECT_THROW(BiquadCascade(3, 9), std::invalid_argument);
+
+    BiquadCascade cascade(2, 1);
+    EXPECT_THROW(cascade.SetSection(2, BiquadCoefficients{1.0f, 0.0f, 0.0f, 0.0f, 0.0f}), std::out_of_range);
+    EXPECT_FLOAT_EQ(cascade.GetSection(1).b0, 1.0f);  // Pass-through by default
+}
+
+TEST(BiquadCascadeTest, EqFiltersAllChannels) {
+    // Previously channels above 2 were overwritten with channel 0
+    wasapi_capture::ThreeBandEQ eq;
+    eq.Initialize(48000);
+    wasapi_capture::ThreeBandEQ::Options options;
+    options.low_gain_db = 6.0f;
+    options.mid_gain_db = -4.0f;
+    options.high_gain_db = 3.0f;
+    eq.SetOptions(options);
+    eq.SetEnabled(true);
+
+    const size_t channels = 6;
+    const size_t frames = 2400;
+    auto input = Noise(frames * channels, 11);
+    auto output = input;
+    eq.Process(output.data(), static_cast<int>(frames), static_cast<int>(channels));
+
+    BiquadFilter designs[3];
+    for (auto& d : designs) {
+        d.Initialize(48000);
+    }
+    designs[0].SetFilter(BiquadFilter::Type::LowShelf, options.low_freq, 0.707f, options.low_gain_db);
+    designs[1].SetFilter(BiquadFilter::Type::Peak, options.mid_freq, options.mid_q, options.mid_gain_db);
+    designs[2].SetFilter(BiquadFilter::Type::HighShelf, options.high_freq, 0.707f, options.high_gain_db);
+    for (size_t ch = 0; ch < channels; ch++) {
+        BiquadFilter filters[3] = {designs[0], designs[1], designs[2]};
+        for (size_t f = 0; f < frames; f++) {
+            float x = input[f * channels + ch];
+            for (auto& filter : filters) {
+                x = filter.Process(x);
+            }
+            ASSERT_NEAR(output[f * channels + ch], x, 1e-4f) << "channel " << ch << ", frame " << f;
+        }
+    }
+    EXPECT_EQ(eq.GetStats().frames_processed, frames);
+}
@@ -0,0 +1,116 @@
+#include "external_buffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using AudioCapture::BufferPool;
+using AudioCapture::ExternalBuffer;
+
+TEST(BufferPoolTest, ClassIndexRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(BufferPool::ClassIndex(1), 0u);
+    EXPECT_EQ(BufferPool::ClassIndex(256), 0u);
+    EXPECT_EQ(BufferPool::ClassIndex(257), 1u);
+    EXPECT_EQ(BufferPool::ClassIndex(4096), 4u);
+    EXPECT_EQ(BufferPool::ClassIndex(BufferPool::MaxPooledSize()), BufferPool::kClassCount - 1);
+    EXPECT_EQ(BufferPool::ClassIndex(BufferPool::MaxPooledSize() + 1), BufferPool::kClassCount);
+}
+
+TEST(BufferPoolTest, PreallocatedDefaultClassHits) {
+    BufferPool pool(4096, 4);
+    auto buffer = pool.Acquire();
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(buffer->size(), 4096u);
+
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.pool_hits, 1u);
+    EXPECT_EQ(stats.pool_misses, 0u);
+    EXPECT_EQ(stats.current_pool_size, 3u);
+}
+
+TEST(BufferPoolTest, LargePacketsArePooledInTheirSizeClass) {
+    BufferPool pool(4096, 4);
+
+    void* first = nullptr;
+    {
+        auto buffer = pool.Acquire(15360);  // 10 ms of 48 kHz 7.1 float
+        ASSERT_TRUE(buffer);
+        EXPECT_EQ(buffer->size(), 16384u);
+        first = buffer->data();
+    }
+    auto again = pool.Acquire(10000);
+    EXPECT_EQ(again->data(), first);  // Recycled through the shared_ptr deleter
+
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.pool_misses, 1u);
+    EXPECT_EQ(stats.pool_hits, 1u);
+}
+
+TEST(BufferPoolTest, OversizedRequestGetsUnpooledBuffer) {
+    BufferPool pool(4096, 2);
+    auto buffer = pool.Acquire(BufferPool::MaxPooledSize() + 1);
+    ASSERT_TRUE(buffer);
+    EXPECT_GE(buffer->size(), BufferPool::MaxPooledSize() + 1);
+    EXPECT_EQ(pool.GetStats().dynamic_allocations, 1u);
+}
+
+TEST(BufferPoolTest, BufferOutlivesPool) {
+    std::shared_ptr<ExternalBuffer> held;
+    {
+        BufferPool pool(4096, 2);
+        held = pool.Acquire();
+    }
+    ASSERT_TRUE(held);
+    static_cast<uint8_t*>(held->data())[0] = 1;
+    held.reset();  // Returns to an orphaned size class without crashing
+}
+
+TEST(BufferPoolTest, ConcurrentAcquireRelease) {
+    BufferPool pool(4096, 32);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool]() {
+            std::vector<std::shared_ptr<ExternalBuffer>> held;
+            for (int i = 0; i < 20000; ++i) {
+                held.push_back(pool.Acquire(3840));
+                if (held.size() > 4) {
+                    held.erase(held.begin());
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.pool_hits + stats.pool_misses, 80000u);
+    EXPECT_LE(stats.current_pool_size, 32u);
+}
+
+TEST(BufferPoolTest, LargeClassesRetainByByteBudget) {
+    // 50 x 4 KB default buffers = 200 KB budget per size class
+    BufferPool pool(4096, 50, 200);
+    EXPECT_EQ(pool.RetainTarget(4096), 50u);
+    EXPECT_EQ(pool.RetainTarget(256), 50u);      // Capped at pool_size
+    EXPECT_EQ(pool.RetainTarget(16384), 12u);
+    EXPECT_EQ(pool.RetainTarget(BufferPool::MaxPooledSize()), BufferPool::kMinClassTarget);
+    EXPECT_EQ(pool.RetainTarget(BufferPool::MaxPooledSize() + 1), 0u);
+
+    // Released 1 MB buffers beyond the target are freed, not kept idle
+    {
+        std::vector<std::shared_ptr<ExternalBuffer>> held;
+        for (int i = 0; i < 10; i++) {
+            held.push_back(pool.Acquire(BufferPool::MaxPooledSize()));
+        }
+    }
+    pool.ResetStats();
+    std::vector<std::shared_ptr<ExternalBuffer>> again;
+    for (int i = 0; i < 10; i++) {
+        again.push_back(pool.Acquire(BufferPool::MaxPooledSize()));
+    }
+    EXPECT_EQ(pool.GetStats().pool_hits, BufferPool::kMinClassTarget);
+
+    pool.SetMinMaxPoolSize(100, 200);
+    EXPECT_EQ(pool.RetainTarget(4096), 100u);
+    EXPECT_EQ(pool.RetainTarget(16384), 25u);
+}
@@ -0,0 +1,191 @@
+#include "delivery_queue.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using AudioCapture::DeliveryPolicy;
+using AudioCapture::DeliveryQueue;
+
+using Packet = std::vector<int>;
+
+TEST(DeliveryQueueTest, SchedulesOneDrainAtATime) {
+    DeliveryQueue<Packet> queue(4, DeliveryPolicy::DropOldest);
+    EXPECT_TRUE(queue.Push(Packet{1}));
+    EXPECT_FALSE(queue.Push(Packet{2}));
+
+    std::deque<Packet> out;
+    EXPECT_EQ(queue.TakeAll(out), 2u);
+    EXPECT_TRUE(queue.Push(Packet{3}));  // Drain finished, next push schedules again
+}
+
+TEST(DeliveryQueueTest, DropOldestKeepsNewestPackets) {
+    DeliveryQueue<Packet> queue(2, DeliveryPolicy::DropOldest);
+    queue.Push(Packet{1});
+    queue.Push(Packet{2});
+    queue.Push(Packet{3});
+
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0][0], 2);
+    EXPECT_EQ(out[1][0], 3);
+
+    auto stats = queue.GetStats();
+    EXPECT_EQ(stats.packets_dropped, 1u);
+    EXPECT_EQ(stats.packets_delivered, 2u);
+    EXPECT_EQ(stats.queue_high_water, 2u);
+}
+
+TEST(DeliveryQueueTest, DropNewestKeepsOldestPackets) {
+    DeliveryQueue<Packet> queue(2, DeliveryPolicy::DropNewest);
+    queue.Push(Packet{1});
+    queue.Push(Packet{2});
+    queue.Push(Packet{3});
+
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0][0], 1);
+    EXPECT_EQ(out[1][0], 2);
+    EXPECT_EQ(queue.GetStats().packets_dropped, 1u);
+}
+
+TEST(DeliveryQueueTest, CoalesceMergesIntoNewestPacket) {
+    auto merge = [](Packet& into, Packet&& from) {
+        if (into.size() + from.size() > 3) return false;
+        into.insert(into.end(), from.begin(), from.end());
+        return true;
+    };
+    DeliveryQueue<Packet> queue(2, DeliveryPolicy::Coalesce, merge);
+    queue.Push(Packet{1});
+    queue.Push(Packet{2});
+    queue.Push(Packet{3});
+    queue.Push(Packet{4});
+    queue.Push(Packet{5});  // Merge limit reached - falls back to drop-oldest
+
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0], (Packet{2, 3, 4}));
+    EXPECT_EQ(out[1], (Packet{5}));
+
+    auto stats = queue.GetStats();
+    EXPECT_EQ(stats.packets_coalesced, 2u);
+    EXPECT_EQ(stats.packets_dropped, 1u);
+}
+
+TEST(DeliveryQueueTest, CoalesceMergesWithoutHoldingTheLock) {
+    DeliveryQueue<Packet>* self = nullptr;
+    std::deque<Packet> drained;
+    auto merge = [&](Packet& into, Packet&& from) {
+        // A drain on the JS thread can run while the merge copies
+        self->TakeAll(drained);
+        into.insert(into.end(), from.begin(), from.end());
+        return true;
+    };
+    DeliveryQueue<Packet> queue(2, DeliveryPolicy::Coalesce, merge);
+    self = &queue;
+    queue.Push(Packet{1});
+    queue.Push(Packet{2});
+    EXPECT_TRUE(queue.Push(Packet{3}));  // The drain ended, so a new one is needed
+
+    ASSERT_EQ(drained.size(), 1u);
+    EXPECT_EQ(drained[0], (Packet{1}));
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], (Packet{2, 3}));
+}
+
+TEST(DeliveryQueueTest, CancelDrainAllowsReschedule) {
+    DeliveryQueue<Packet> queue(0, DeliveryPolicy::DropOldest);
+    EXPECT_TRUE(queue.Push(Packet{1}));
+    queue.CancelDrain();
+    EXPECT_TRUE(queue.Push(Packet{2}));
+    EXPECT_EQ(queue.GetStats().queue_depth, 2u);
+}
+
+TEST(DeliveryQueueTest, RequestDrainRecoversStrandedPackets) {
+    DeliveryQueue<Packet> queue(4, DeliveryPolicy::DropOldest);
+    EXPECT_FALSE(queue.RequestDrain());  // Nothing queued
+    EXPECT_TRUE(queue.Push(Packet{1}));
+    EXPECT_FALSE(queue.RequestDrain());  // Already scheduled
+    queue.CancelDrain();                 // The TSFN call failed; no more pushes follow
+    EXPECT_TRUE(queue.RequestDrain());
+}
+
+// Boundary markers in these tests: a packet whose first value is negative
+static bool IsMarker(const Packet& packet) {
+    return !packet.empty() && packet[0] < 0;
+}
+
+TEST(DeliveryQueueTest, PinnedItemsAreNeverDropped) {
+    DeliveryQueue<Packet> queue(2, DeliveryPolicy::DropOldest, nullptr, IsMarker);
+    queue.Push(Packet{-1});
+    queue.Push(Packet{1});
+    queue.Push(Packet{2});  // Drops packet 1, not the marker
+    queue.Push(Packet{-2});  // Accepted above the bound
+
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[0], (Packet{-1}));
+    EXPECT_EQ(out[1], (Packet{2}));
+    EXPECT_EQ(out[2], (Packet{-2}));
+
+    auto stats = queue.GetStats();
+    EXPECT_EQ(stats.packets_dropped, 1u);
+    EXPECT_EQ(stats.packets_delivered, 1u);  // Markers are not packets
+}
+
+TEST(DeliveryQueueTest, DropNewestStillAcceptsPinnedItems) {
+    DeliveryQueue<Packet> queue(1, DeliveryPolicy::DropNewest, nullptr, IsMarker);
+    queue.Push(Packet{1});
+    queue.Push(Packet{2});
+    queue.Push(Packet{-1});
+
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[1], (Packet{-1}));
+}
+
+TEST(DeliveryQueueTest, CoalesceDoesNotMergeAcrossPinnedItems) {
+    auto merge = [](Packet& into, Packet&& from) {
+        into.insert(into.end(), from.begin(), from.end());
+        return true;
+    };
+    DeliveryQueue<Packet> queue(2, DeliveryPolicy::Coalesce, merge, IsMarker);
+    queue.Push(Packet{1});
+    queue.Push(Packet{-1});
+    queue.Push(Packet{2});  // Newest item is a marker: the oldest packet goes instead
+
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0], (Packet{-1}));
+    EXPECT_EQ(out[1], (Packet{2}));
+}
+
+TEST(DeliveryQueueTest, RequeueRestoresOrder) {
+    DeliveryQueue<Packet> queue(0, DeliveryPolicy::DropOldest, nullptr, IsMarker);
+    queue.Push(Packet{-1});
+    std::deque<Packet> out;
+    queue.TakeAll(out);
+    queue.Push(Packet{1});
+
+    queue.Requeue(std::move(out));
+    std::deque<Packet> again;
+    queue.TakeAll(again);
+    ASSERT_EQ(again.size(), 2u);
+    EXPECT_EQ(again[0], (Packet{-1}));
+    EXPECT_EQ(again[1], (Packet{1}));
+}
+
+TEST(DeliveryQueueTest, ParsesPolicyNames) {
+    DeliveryPolicy policy = DeliveryPolicy::DropOldest;
+    EXPECT_TRUE(AudioCapture::ParseDeliveryPolicy("coalesce", policy));
+    EXPECT_EQ(policy, DeliveryPolicy::Coalesce);
+    EXPECT_STREQ(AudioCapture::DeliveryPolicyName(policy), "coalesce");
+    EXPECT_FALSE(AudioCapture::ParseDeliveryPolicy("unknown", policy));
+    EXPECT_EQ(policy, DeliveryPolicy::Coalesce);
+}
@@ -0,0 +1,159 @@
+#include "denoise_engine.h"
+#include "audio_effects.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using AudioCapture::DenoiseEngine;
+using AudioCapture::DenoiseJob;
+using AudioCapture::DenoiseProcessor;
+using AudioCapture::DenoiseStage;
+
+namespace {
+
+std::vector<float> Noise(size_t count, float range, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<float> out(count);
+    for (auto& v : out) {
+        v = dist(rng);
+    }
+    return out;
+}
+
+std::vector<float> RunStage(DenoiseStage& stage, std::vector<float> data) {
+    size_t channels = stage.GetChannels();
+    size_t frames = data.size() / channels;
+    for (size_t offset = 0; offset < frames; offset += 441) {
+        size_t n = (std::min)(size_t{441}, frames - offset);
+        stage.Process(data.data() + offset * channels, n);
+    }
+    return data;
+}
+
+}  // namespace
+
+TEST(DenoiseEngineTest, SharedEngineMatchesInlineProcessing) {
+    auto input = Noise(8 * 9600, 0.3f, 1);
+    auto engine = std::make_shared<DenoiseEngine>(3);
+
+    DenoiseStage serial(48000, 8);
+    DenoiseStage pooled(48000, 8);
+    pooled.SetEngine(engine);
+    EXPECT_EQ(RunStage(serial, input), RunStage(pooled, input));
+    EXPECT_EQ(pooled.GetProcessedFrames(), 20);
+
+    auto stats = engine->GetStats();
+    EXPECT_EQ(stats.workers, 3u);
+    EXPECT_EQ(stats.jobs, stats.batches * 8);
+    EXPECT_EQ(stats.failures, 0u);
+}
+
+TEST(DenoiseEngineTest, ConcurrentStreamsShareThePool) {
+    auto engine = std::make_shared<DenoiseEngine>(2);
+    constexpr int kStreams = 6;
+
+    std::vector<std::vector<float>> expected(kStreams), got(kStreams);
+    std::vector<std::thread> threads;
+    for (int s = 0; s < kStreams; s++) {
+        auto input = Noise(2 * 4800, 0.3f, 10 + s);
+        DenoiseStage reference(44100, 2);
+        expected[s] = RunStage(reference, input);
+
+        threads.emplace_back([&, s, input] {
+            DenoiseStage stage(44100, 2);
+            stage.SetEngine(engine);
+            got[s] = RunStage(stage, input);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (int s = 0; s < kStreams; s++) {
+        EXPECT_EQ(got[s], expected[s]) << "stream " << s;
+    }
+    EXPECT_EQ(engine->GetStats().failures, 0u);
+}
+
+TEST(DenoiseEngineTest, InlineWithoutWorkers) {
+    DenoiseEngine engine(0);
+    DenoiseProcessor a, b;
+    auto x = Noise(480, 0.3f, 2);
+    auto y = Noise(480, 0.3f, 3);
+    DenoiseJob jobs[] = {{&a, x.data()}, {&b, y.data()}};
+    engine.Run(jobs, 2);
+
+    EXPECT_EQ(a.GetProcessedFrames(), 1);
+    EXPECT_EQ(b.GetProcessedFrames(), 1);
+    EXPECT_EQ(jobs[0].vad, a.GetLastVoiceProbability());  // Per-stream VAD comes back in the job
+    EXPECT_EQ(jobs[1].vad, b.GetLastVoiceProbability());
+    auto stats = engine.GetStats();
+    EXPECT_EQ(stats.batches, 1u);
+    EXPECT_EQ(stats.jobs, 2u);
+    EXPECT_EQ(stats.jobs_on_workers, 0u);
+}
+
+TEST(DenoiseEngineTest, FeedMatchesProcessBuffer) {
+    auto input = Noise(2000, 0.3f, 4);
+    DenoiseProcessor whole, split;
+    auto expected = input;
+    whole.ProcessBuffer(expected.data(), static_cast<int>(expected.size()));
+
+    auto got = input;
+    int offset = 0;
+    while (offset < static_cast<int>(got.size())) {
+        offset += split.Feed(got.data() + offset, (std::min)(333, static_cast<int>(got.size()) - offset));
+        if (split.FrameReady()) {
+            split.ProcessFrame(split.PendingFrame(), split.GetFrameSize());
+            split.CompleteFrame();
+        }
+    }
+    EXPECT_EQ(got, expected);
+    EXPECT_EQ(split.GetProcessedFrames(), whole.GetProcessedFrames());
+}
+
+TEST(DenoiseEngineTest, MonoAndDownmixStreamsUseThePool) {
+    auto engine = std::make_shared<DenoiseEngine>(2);
+    constexpr int kStreams = 8;
+
+    std::vector<std::vector<float>> expected(kStreams), got(kStreams);
+    std::vector<std::thread> threads;
+    for (int s = 0; s < kStreams; s++) {
+        // Even streams: mono capture, odd: stereo downmix at 44.1 kHz
+        uint32_t rate = s % 2 ? 44100 : 48000;
+        uint16_t channels = s % 2 ? 2 : 1;
+        auto mode = AudioCapture::DenoiseChannelMode::Downmix;
+        auto input = Noise(channels * 4800, 0.3f, 20 + s);
+        DenoiseStage reference(rate, channels, mode);
+        expected[s] = RunStage(reference, input);
+
+        threads.emplace_back([&, s, rate, channels, mode, input] {
+            DenoiseStage stage(rate, channels, mode);
+            stage.SetEngine(engine);
+            got[s] = RunStage(stage, input);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (int s = 0; s < kStreams; s++) {
+        EXPECT_EQ(got[s], expected[s]) << "stream " << s;
+    }
+
+    // One state per stream: every batch is a single frame, and every frame goes through the engine
+    auto stats = engine->GetStats();
+    EXPECT_EQ(stats.jobs, stats.batches);
+    EXPECT_GE(stats.jobs, 4u * 10u);
+    EXPECT_LE(stats.jobs_on_workers + stats.jobs_helped, stats.jobs);
+    EXPECT_EQ(stats.failures, 0u);
+}
+
+TEST(DenoiseEngineTest, SharedInstanceLivesWhileUsed) {
+    auto first = DenoiseEngine::Shared();
+    auto second = DenoiseEngine::Shared();
+    EXPECT_EQ(first, second);
+    EXPECT_GE(first->GetWorkerCount(), 1u);
+    EXPECT_LE(first->GetWorkerCount(), 8u);
+}
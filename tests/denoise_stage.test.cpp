@@ -0,0 +1,142 @@
+#include "audio_effects.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using AudioCapture::DenoiseChannelMode;
+using AudioCapture::DenoiseProcessor;
+using AudioCapture::DenoiseStage;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<float> Noise(size_t count, float range, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<float> out(count);
+    for (auto& v : out) {
+        v = dist(rng);
+    }
+    return out;
+}
+
+// Left channel noisy tone, right channel silent
+std::vector<float> LeftOnly(size_t frames, uint32_t rate) {
+    auto noise = Noise(frames, 0.05f, 7);
+    std::vector<float> out(frames * 2, 0.0f);
+    for (size_t f = 0; f < frames; f++) {
+        out[f * 2] = 0.3f * std::sin(2.0 * kPi * 440.0 * f / rate) + noise[f];
+    }
+    return out;
+}
+
+void ProcessInPackets(DenoiseStage& stage, std::vector<float>& data, const std::vector<size_t>& sizes) {
+    size_t channels = stage.GetChannels();
+    size_t frames = data.size() / channels;
+    size_t offset = 0;
+    for (size_t i = 0; offset < frames; i++) {
+        size_t n = (std::min)(sizes[i % sizes.size()], frames - offset);
+        stage.Process(data.data() + offset * channels, n);
+        offset += n;
+    }
+}
+
+}  // namespace
+
+TEST(DenoiseProcessorTest, StreamsWithOneFrameLatency) {
+    DenoiseProcessor processor;
+    auto input = Noise(480 * 3 + 100, 0.5f, 1);
+    auto split = input;
+    auto whole = input;
+
+    processor.ProcessBuffer(whole.data(), static_cast<int>(whole.size()));
+    // The first frame out is the (silent) carry, whatever the input
+    for (size_t i = 0; i < 480; i++) {
+        ASSERT_EQ(whole[i], 0.0f);
+    }
+    EXPECT_EQ(processor.GetProcessedFrames(), 3);
+
+    DenoiseProcessor streamed;
+    size_t offset = 0;
+    for (int size : {1, 479, 300, 181, 500, 79}) {
+        streamed.ProcessBuffer(split.data() + offset, size);
+        offset += size;
+    }
+    ASSERT_EQ(offset, split.size());
+    EXPECT_EQ(split, whole);
+}
+
+TEST(DenoiseStageTest, PerChannelKeepsChannelsApart) {
+    DenoiseStage stage(48000, 2);
+    EXPECT_EQ(stage.GetStateCount(), 2u);
+    EXPECT_FALSE(stage.IsResampling());
+    EXPECT_EQ(stage.GetLatencyFrames(), 480u);
+
+    auto data = LeftOnly(4800, 48000);
+    ProcessInPackets(stage, data, {441});
+    for (size_t f = 0; f < 4800; f++) {
+        ASSERT_EQ(data[f * 2 + 1], 0.0f) << f;  // Left never leaks into right
+    }
+    EXPECT_EQ(stage.GetProcessedFrames(), 10);
+}
+
+TEST(DenoiseStageTest, DownmixCopiesMonoResultToEveryChannel) {
+    DenoiseStage stage(48000, 4, DenoiseChannelMode::Downmix);
+    EXPECT_EQ(stage.GetStateCount(), 1u);
+
+    auto data = Noise(4 * 2000, 0.5f, 2);
+    stage.Process(data.data(), 2000);
+    for (size_t f = 0; f < 2000; f++) {
+        for (size_t c = 1; c < 4; c++) {
+            ASSERT_EQ(data[f * 4 + c], data[f * 4]);
+        }
+    }
+}
+
+TEST(DenoiseStageTest, ResamplesNon48kRatesWithoutUnderruns) {
+    DenoiseStage stage(44100, 2);
+    EXPECT_TRUE(stage.IsResampling());
+    EXPECT_GT(stage.GetLatencyFrames(), 441u);
+
+    auto data = LeftOnly(44100, 44100);
+    ProcessInPackets(stage, data, {441, 100, 1000, 7});
+    EXPECT_EQ(stage.GetUnderruns(), 0u);
+    EXPECT_GT(stage.GetProcessedFrames(), 95);  // ~100 RNNoise frames per second
+
+    // Right stays (numerically) silent through both resamplers
+    for (size_t f = 0; f < 44100; f++) {
+        ASSERT_NEAR(data[f * 2 + 1], 0.0f, 1e-6f) << f;
+    }
+}
+
+TEST(DenoiseStageTest, PacketSplitDoesNotChangeOutput) {
+    auto input = LeftOnly(16000, 16000);
+    auto a = input;
+    auto b = input;
+
+    DenoiseStage whole(16000, 2);
+    whole.Process(a.data(), 16000);
+    DenoiseStage split(16000, 2);
+    ProcessInPackets(split, b, {160, 33, 999});
+    EXPECT_EQ(a, b);
+
+    // Reset restarts the stream from silence
+    auto c = input;
+    whole.Reset();
+    whole.Process(c.data(), 16000);
+    EXPECT_EQ(a, c);
+}
+
+TEST(DenoiseStageTest, RejectsUnsupportedLayouts) {
+    EXPECT_THROW(DenoiseStage(48000, 0), std::invalid_argument);
+    EXPECT_THROW(DenoiseStage(48000, 9), std::invalid_argument);
+    EXPECT_THROW(DenoiseStage(0, 2), std::invalid_argument);
+
+    DenoiseChannelMode mode = DenoiseChannelMode::PerChannel;
+    EXPECT_TRUE(AudioCapture::ParseDenoiseChannelMode("downmix", mode));
+    EXPECT_EQ(mode, DenoiseChannelMode::Downmix);
+    EXPECT_STREQ(AudioCapture::DenoiseChannelModeName(mode), "downmix");
+    EXPECT_FALSE(AudioCapture::ParseDenoiseChannelMode("stereo", mode));
+}
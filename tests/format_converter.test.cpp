@@ -0,0 +1,171 @@
+#include "format_converter.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using wasapi_capture::FormatConverter;
+using wasapi_capture::FormatConverterConfig;
+using wasapi_capture::SampleFormat;
+
+namespace {
+
+std::vector<float> RandomSamples(size_t count, float range, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<float> out(count);
+    for (auto& v : out) {
+        v = dist(rng);
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<T> Convert(FormatConverter& converter, const std::vector<float>& input) {
+    size_t frames = input.size() / converter.GetInputChannels();
+    std::vector<T> out(converter.OutputBytes(frames) / sizeof(T));
+    size_t bytes = converter.Convert(input.data(), frames, reinterpret_cast<uint8_t*>(out.data()));
+    EXPECT_EQ(bytes, out.size() * sizeof(T));
+    return out;
+}
+
+}  // namespace
+
+TEST(FormatConverterTest, StereoFloatToMonoInt16) {
+    FormatConverterConfig config;
+    config.output_channels = 1;
+    config.output_format = SampleFormat::Int16;
+    FormatConverter converter(config);
+    EXPECT_EQ(converter.GetOutputBlockAlign(), 2u);
+    EXPECT_EQ(converter.OutputBytes(480), 960u);  // 3840 bytes in -> 960 out
+
+    std::vector<float> input = {0.5f, 0.5f, -0.25f, -0.75f, 0.0f, 1.0f, 2.0f, 2.0f, -3.0f, -1.0f};
+    auto out = Convert<int16_t>(converter, input);
+    ASSERT_EQ(out.size(), 5u);
+    EXPECT_EQ(out[0], 16384);
+    EXPECT_EQ(out[1], -16384);
+    EXPECT_EQ(out[2], 16384);
+    EXPECT_EQ(out[3], 32767);   // Saturated
+    EXPECT_EQ(out[4], -32768);  // Saturated
+}
+
+TEST(FormatConverterTest, LongBuffersMatchScalarReference) {
+    // Crosses several internal chunks and leaves a SIMD tail
+    auto input = RandomSamples(2 * 1337, 1.2f, 1);
+    FormatConverterConfig config;
+    config.output_format = SampleFormat::Int16;
+    FormatConverter converter(config);
+    auto out = Convert<int16_t>(converter, input);
+
+    std::vector<int16_t> expected(input.size());
+    wasapi_capture::format_kernels::FloatToInt16Scalar(input.data(), nullptr, expected.data(), input.size());
+    EXPECT_EQ(out, expected);
+}
+
+TEST(FormatConverterTest, SimdMatchesScalar) {
+    using namespace wasapi_capture::format_kernels;
+    auto input = RandomSamples(1003, 1.5f, 2);
+    auto dither = RandomSamples(1003, 1.0f, 3);
+    input[17] = std::nanf("");
+
+    std::vector<int16_t> ref(input.size()), got(input.size());
+    FloatToInt16Scalar(input.data(), dither.data(), ref.data(), input.size());
+    EXPECT_EQ(ref[17], -32768);
+
+    std::vector<float> stereo = RandomSamples(2 * 503, 1.0f, 4);
+    std::vector<float> mix_ref(503), mix_got(503);
+    MixStereoScalar(stereo.data(), 0.3f, 0.7f, mix_ref.data(), 503);
+
+#if defined(AUDIO_SIMD_X86)
+    FloatToInt16Sse2(input.data(), dither.data(), got.data(), input.size());
+    EXPECT_EQ(got, ref);
+    if (wasapi_capture::GetCpuFeatures().avx2) {
+        FloatToInt16Avx2(input.data(), dither.data(), got.data(), input.size());
+        EXPECT_EQ(got, ref);
+    }
+    MixStereoSse2(stereo.data(), 0.3f, 0.7f, mix_got.data(), 503);
+    for (size_t i = 0; i < mix_ref.size(); i++) {
+        EXPECT_NEAR(mix_got[i], mix_ref[i], 1e-6f);
+    }
+#endif
+#if defined(AUDIO_SIMD_NEON)
+    FloatToInt16Neon(input.data(), dither.data(), got.data(), input.size());
+    EXPECT_EQ(got, ref);
+    MixStereoNeon(stereo.data(), 0.3f, 0.7f, mix_got.data(), 503);
+    for (size_t i = 0; i < mix_ref.size(); i++) {
+        EXPECT_NEAR(mix_got[i], mix_ref[i], 1e-6f);
+    }
+#endif
+}
+
+TEST(FormatConverterTest, DitherIsTriangularWithinOneLsb) {
+    FormatConverterConfig config;
+    config.input_channels = 1;
+    config.output_format = SampleFormat::Int16;
+    config.dither = true;
+    FormatConverter converter(config);
+    EXPECT_TRUE(converter.IsDithering());
+
+    // Exactly representable input: the error is the dither rounded to an integer
+    std::vector<float> input(20000, 1000.0f / 32768.0f);
+    auto out = Convert<int16_t>(converter, input);
+    double sum = 0.0;
+    size_t changed = 0;
+    for (int16_t v : out) {
+        ASSERT_GE(v, 999);
+        ASSERT_LE(v, 1001);
+        sum += v - 1000;
+        changed += v != 1000;
+    }
+    EXPECT_NEAR(sum / out.size(), 0.0, 0.02);  // Zero mean
+    // P(|u1 - u2| > 0.5) = 0.25
+    EXPECT_NEAR(static_cast<double>(changed) / out.size(), 0.25, 0.02);
+}
+
+TEST(FormatConverterTest, DefaultMatrices) {
+    auto mono = FormatConverter::DefaultMatrix(2, 1);
+    EXPECT_EQ(mono, (std::vector<float>{0.5f, 0.5f}));
+
+    auto up = FormatConverter::DefaultMatrix(1, 2);
+    EXPECT_EQ(up, (std::vector<float>{1.0f, 1.0f}));
+
+    // 5.1 -> stereo: LFE dropped, rows sum to one
+    auto fold = FormatConverter::DefaultMatrix(6, 2);
+    ASSERT_EQ(fold.size(), 12u);
+    EXPECT_EQ(fold[3], 0.0f);
+    EXPECT_EQ(fold[6 + 3], 0.0f);
+    EXPECT_EQ(fold[1], 0.0f);  // FR not in left
+    float left = 0.0f, right = 0.0f;
+    for (int c = 0; c < 6; c++) {
+        left += fold[c];
+        right += fold[6 + c];
+    }
+    EXPECT_NEAR(left, 1.0f, 1e-6f);
+    EXPECT_NEAR(right, 1.0f, 1e-6f);
+    EXPECT_GT(fold[0], fold[2]);  // Centre at -3 dB relative to FL
+}
+
+TEST(FormatConverterTest, CustomMatrixFloatOutput) {
+    FormatConverterConfig config;
+    config.output_channels = 2;
+    config.downmix_matrix = {0.0f, 1.0f,   // Swap channels
+                             1.0f, 0.0f};
+    FormatConverter converter(config);
+    auto out = Convert<float>(converter, {0.1f, 0.2f, 0.3f, 0.4f});
+    EXPECT_EQ(out, (std::vector<float>{0.2f, 0.1f, 0.4f, 0.3f}));
+
+    config.downmix_matrix = {1.0f, 0.0f, 0.0f};
+    EXPECT_THROW(FormatConverter bad(config), std::invalid_argument);
+
+    FormatConverterConfig wide;
+    wide.input_channels = 9;
+    EXPECT_THROW(FormatConverter tooMany(wide), std::invalid_argument);
+}
+
+TEST(FormatConverterTest, ParsesFormatNames) {
+    SampleFormat format = SampleFormat::Float32;
+    EXPECT_TRUE(wasapi_capture::ParseSampleFormat("int16", format));
+    EXPECT_EQ(format, SampleFormat::Int16);
+    EXPECT_STREQ(wasapi_capture::SampleFormatName(format), "int16");
+    EXPECT_FALSE(wasapi_capture::ParseSampleFormat("int24", format));
+}
@@ -0,0 +1,120 @@
+#include "frame_assembler.h"
+#include "asr_presets.h"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+using AudioCapture::FrameAssembler;
+
+namespace {
+
+struct TestPacket {
+    std::vector<uint8_t> bytes;
+    size_t size = 0;
+
+    uint8_t* data() { return bytes.data(); }
+    bool empty() const { return size == 0; }
+    void Truncate(size_t n) {
+        if (n < size) size = n;
+    }
+};
+
+struct Harness {
+    FrameAssembler<TestPacket> assembler;
+    std::vector<TestPacket> frames;
+    size_t acquired = 0;
+    bool fail = false;
+
+    size_t Push(const std::vector<uint8_t>& data) {
+        return assembler.Push(data.data(), data.size(),
+            [this](size_t n) {
+                TestPacket p;
+                if (!fail) {
+                    p.bytes.resize(n);
+                    p.size = n;
+                    acquired++;
+                }
+                return p;
+            },
+            [this](TestPacket&& p) { frames.push_back(std::move(p)); });
+    }
+};
+
+std::vector<uint8_t> Sequence(size_t n, uint8_t start) {
+    std::vector<uint8_t> v(n);
+    std::iota(v.begin(), v.end(), start);
+    return v;
+}
+
+}  // namespace
+
+TEST(FrameAssemblerTest, EmitsExactFramesAcrossPackets) {
+    Harness h;
+    h.assembler.Configure(640);  // 20 ms of 16 kHz Int16 mono
+
+    // Resampler output sizes vary per packet
+    size_t total = 0;
+    for (size_t size : {322u, 318u, 320u, 1000u, 3u}) {
+        h.Push(Sequence(size, static_cast<uint8_t>(total)));
+        total += size;
+    }
+    ASSERT_EQ(h.frames.size(), total / 640);
+    for (const auto& f : h.frames) {
+        EXPECT_EQ(f.size, 640u);
+    }
+    EXPECT_EQ(h.assembler.PendingBytes(), total % 640);
+    EXPECT_EQ(h.acquired, h.frames.size() + 1);  // One pooled packet per frame
+
+    // Bytes keep their order across frame boundaries
+    uint8_t expected = 0;
+    for (const auto& f : h.frames) {
+        for (size_t i = 0; i < f.size; i++, expected++) {
+            ASSERT_EQ(f.bytes[i], expected);
+        }
+    }
+}
+
+TEST(FrameAssemblerTest, FlushEmitsTruncatedTail) {
+    Harness h;
+    h.assembler.Configure(100);
+    h.Push(Sequence(250, 0));
+    ASSERT_EQ(h.frames.size(), 2u);
+
+    bool flushed = h.assembler.Flush([&](TestPacket&& p) { h.frames.push_back(std::move(p)); });
+    EXPECT_TRUE(flushed);
+    ASSERT_EQ(h.frames.size(), 3u);
+    EXPECT_EQ(h.frames.back().size, 50u);
+    EXPECT_FALSE(h.assembler.Flush([&](TestPacket&&) { FAIL(); }));
+}
+
+TEST(FrameAssemblerTest, CountsBytesDroppedOnAllocationFailure) {
+    Harness h;
+    h.assembler.Configure(64);
+    h.fail = true;
+    EXPECT_EQ(h.Push(Sequence(100, 0)), 0u);
+    EXPECT_EQ(h.assembler.DroppedBytes(), 100u);
+
+    h.fail = false;
+    EXPECT_EQ(h.Push(Sequence(64, 0)), 1u);
+}
+
+TEST(FrameAssemblerTest, DisabledWhenFrameSizeIsZero) {
+    Harness h;
+    EXPECT_FALSE(h.assembler.IsEnabled());
+    EXPECT_EQ(h.Push(Sequence(10, 0)), 0u);
+    EXPECT_EQ(h.acquired, 0u);
+}
+
+TEST(AsrPresetTest, MatchesJavaScriptPresets) {
+    const auto* china = wasapi_capture::FindAsrPreset("china-asr");
+    ASSERT_NE(china, nullptr);
+    EXPECT_EQ(china->sample_rate, 16000u);
+    EXPECT_EQ(china->channels, 1);
+    EXPECT_EQ(china->format, wasapi_capture::SampleFormat::Int16);
+    EXPECT_EQ(china->frame_ms, 40u);
+
+    for (const char* name : {"raw", "openai-whisper", "global-asr-48k", "azure", "google"}) {
+        EXPECT_NE(wasapi_capture::FindAsrPreset(name), nullptr) << name;
+    }
+    EXPECT_EQ(wasapi_capture::FindAsrPreset("whisper"), nullptr);
+}
@@ -0,0 +1,155 @@
+#include "mel_features.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using audio_capture::CmvnMode;
+using audio_capture::MelFeatureConfig;
+using audio_capture::MelFeatureExtractor;
+
+namespace {
+
+std::vector<float> StereoSine(size_t frames, float freq, int sample_rate) {
+    std::vector<float> out(frames * 2);
+    for (size_t i = 0; i < frames; i++) {
+        float v = static_cast<float>(0.5 * std::sin(2.0 * 3.14159265358979323846 * freq * i / sample_rate));
+        out[2 * i] = v;
+        out[2 * i + 1] = v;
+    }
+    return out;
+}
+
+struct Collected {
+    std::vector<std::vector<float>> frames;
+    std::vector<uint64_t> positions;
+};
+
+Collected Extract(MelFeatureExtractor& extractor, const std::vector<float>& stereo, size_t packet) {
+    Collected out;
+    const size_t total = stereo.size() / 2;
+    for (size_t offset = 0; offset < total; offset += packet) {
+        size_t frames = std::min(packet, total - offset);
+        extractor.ProcessStream(stereo.data() + offset * 2, frames, 2,
+            [&](const float* features, uint64_t position) {
+                out.frames.emplace_back(features, features + extractor.GetNumBins());
+                out.positions.push_back(position);
+            });
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(MelFeaturesTest, WindowAndHopFromMilliseconds) {
+    MelFeatureConfig config;  // 48 kHz, 25 ms / 10 ms
+    MelFeatureExtractor extractor(config);
+    EXPECT_EQ(extractor.GetWindowLength(), 1200u);
+    EXPECT_EQ(extractor.GetHopLength(), 480u);
+    EXPECT_EQ(extractor.GetFFTSize(), 2048u);
+    EXPECT_EQ(extractor.GetNumBins(), 80);
+}
+
+TEST(MelFeaturesTest, FramesIndependentOfPacketSize) {
+    auto signal = StereoSine(48000, 440.0f, 48000);
+    Collected reference;
+    for (size_t packet : {size_t(48000), size_t(480), size_t(441), size_t(7)}) {
+        MelFeatureExtractor extractor{MelFeatureConfig()};
+        Collected got = Extract(extractor, signal, packet);
+        ASSERT_EQ(got.positions.size(), (48000 - 1200) / 480 + 1) << "packet " << packet;
+        EXPECT_EQ(got.positions.front(), 1200u);
+        if (reference.frames.empty()) {
+            reference = got;
+            continue;
+        }
+        EXPECT_EQ(got.positions, reference.positions);
+        for (size_t f = 0; f < got.frames.size(); f++) {
+            for (size_t m = 0; m < got.frames[f].size(); m++) {
+                ASSERT_FLOAT_EQ(got.frames[f][m], reference.frames[f][m]) << "frame " << f << " bin " << m;
+            }
+        }
+    }
+}
+
+TEST(MelFeaturesTest, FiltersAreOrderedAndNonEmpty) {
+    MelFeatureConfig config;
+    config.num_mel_bins = 40;
+    MelFeatureExtractor extractor(config);
+
+    // At 48 kHz / 2048 points every triangular filter covers at least one bin
+    for (int m = 0; m < extractor.GetNumBins(); m++) {
+        EXPECT_GT(extractor.GetFilterLength(m), 0u) << "mel " << m;
+        if (m > 0) {
+            EXPECT_GE(extractor.GetFilterStart(m), extractor.GetFilterStart(m - 1));
+        }
+    }
+    // Highest filter stops below max_freq
+    int last = extractor.GetNumBins() - 1;
+    double last_bin = extractor.GetFilterStart(last) + extractor.GetFilterLength(last) - 1;
+    EXPECT_LT(last_bin * 48000.0 / extractor.GetFFTSize(), 8000.0);
+}
+
+TEST(MelFeaturesTest, SinePeaksInMatchingMelBin) {
+    MelFeatureConfig config;
+    config.preemphasis = 0.0f;
+    MelFeatureExtractor extractor(config);
+    Collected got = Extract(extractor, StereoSine(4800, 1000.0f, 48000), 480);
+    ASSERT_FALSE(got.frames.empty());
+
+    const auto& frame = got.frames.back();
+    int peak = static_cast<int>(std::max_element(frame.begin(), frame.end()) - frame.begin());
+
+    // Centre of filter `peak` on the mel scale
+    float mel_min = MelFeatureExtractor::HzToMel(config.min_freq);
+    float step = (MelFeatureExtractor::HzToMel(config.max_freq) - mel_min) / (config.num_mel_bins + 1);
+    float centre = MelFeatureExtractor::MelToHz(mel_min + (peak + 1) * step);
+    EXPECT_NEAR(centre, 1000.0f, 60.0f);
+}
+
+TEST(MelFeaturesTest, CmvnRemovesStationaryMean) {
+    MelFeatureConfig config;
+    config.cmvn = CmvnMode::Mean;
+    config.cmvn_window = 50;
+    MelFeatureExtractor extractor(config);
+
+    // 1 kHz with a 480-sample hop repeats exactly, so every frame is identical
+    Collected got = Extract(extractor, StereoSine(24000, 1000.0f, 48000), 480);
+    ASSERT_GT(got.frames.size(), 10u);
+    for (float v : got.frames.back()) {
+        EXPECT_NEAR(v, 0.0f, 1e-3f);
+    }
+}
+
+TEST(MelFeaturesTest, CmvnMeanVarianceNormalizes) {
+    MelFeatureConfig config;
+    config.cmvn = CmvnMode::MeanVariance;
+    config.cmvn_window = 1000;
+    MelFeatureExtractor extractor(config);
+
+    std::mt19937 rng(7);
+    std::normal_distribution<float> dist(0.0f, 0.1f);
+    std::vector<float> noise(2 * 48000 * 2);
+    for (auto& v : noise) {
+        v = dist(rng);
+    }
+    Collected got = Extract(extractor, noise, 480);
+
+    // With a window covering the whole stream, the final frame's statistics use
+    // every frame; the running outputs must stay bounded and finite
+    for (const auto& frame : got.frames) {
+        for (float v : frame) {
+            ASSERT_TRUE(std::isfinite(v));
+            ASSERT_LT(std::fabs(v), 20.0f);
+        }
+    }
+}
+
+TEST(MelFeaturesTest, ResetRestartsWindow) {
+    MelFeatureExtractor extractor{MelFeatureConfig()};
+    auto signal = StereoSine(2000, 440.0f, 48000);
+    Collected first = Extract(extractor, signal, 2000);
+    extractor.Reset();
+    Collected second = Extract(extractor, signal, 2000);
+    ASSERT_EQ(first.frames.size(), second.frames.size());
+    EXPECT_EQ(first.positions, second.positions);
+}
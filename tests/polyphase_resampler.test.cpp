@@ -0,0 +1,150 @@
+#include "polyphase_resampler.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using wasapi_capture::PolyphaseResampler;
+using wasapi_capture::ResampleQuality;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<float> Sine(size_t frames, uint16_t channels, double freq, double rate) {
+    std::vector<float> out(frames * channels);
+    for (size_t i = 0; i < frames; i++) {
+        float v = static_cast<float>(0.5 * std::sin(2.0 * kPi * freq * i / rate));
+        for (uint16_t c = 0; c < channels; c++) {
+            out[i * channels + c] = c == 0 ? v : -v;
+        }
+    }
+    return out;
+}
+
+std::vector<float> Resample(PolyphaseResampler& r, const std::vector<float>& input, size_t packet) {
+    const uint16_t ch = r.GetChannels();
+    const size_t frames = input.size() / ch;
+    std::vector<float> out;
+    std::vector<float> scratch;
+    for (size_t offset = 0; offset < frames; offset += packet) {
+        size_t n = std::min(packet, frames - offset);
+        scratch.resize(r.MaxOutputFrames(n) * ch);
+        size_t produced = r.Process(input.data() + offset * ch, n, scratch.data());
+        EXPECT_LE(produced, r.MaxOutputFrames(n));
+        out.insert(out.end(), scratch.begin(), scratch.begin() + produced * ch);
+    }
+    return out;
+}
+
+// Error of channel 0 against the ideal sine at the output rate, skipping the start-up transient
+double MaxError(const std::vector<float>& out, uint16_t ch, double freq, double rate, size_t skip) {
+    double max_error = 0.0;
+    for (size_t j = skip; j < out.size() / ch; j++) {
+        double expected = 0.5 * std::sin(2.0 * kPi * freq * j / rate);
+        max_error = std::max(max_error, std::fabs(out[j * ch] - expected));
+    }
+    return max_error;
+}
+
+}  // namespace
+
+TEST(PolyphaseResamplerTest, ReducesRatio) {
+    PolyphaseResampler asr(48000, 16000, 2);
+    EXPECT_EQ(asr.GetInterpolation(), 1u);
+    EXPECT_EQ(asr.GetDecimation(), 3u);
+    EXPECT_EQ(asr.GetTapsPerPhase() % 8, 0u);
+
+    PolyphaseResampler cd(48000, 44100, 2);
+    EXPECT_EQ(cd.GetInterpolation(), 147u);
+    EXPECT_EQ(cd.GetDecimation(), 160u);
+
+    EXPECT_THROW(PolyphaseResampler(0, 16000, 1), std::invalid_argument);
+    EXPECT_THROW(PolyphaseResampler(48000, 16001, 1), std::invalid_argument);  // L = 16001
+}
+
+TEST(PolyphaseResamplerTest, StreamingMatchesOneShot) {
+    auto input = Sine(24000, 2, 440.0, 48000.0);
+    for (uint32_t out_rate : {16000u, 44100u, 22050u, 96000u}) {
+        PolyphaseResampler whole(48000, out_rate, 2);
+        auto reference = Resample(whole, input, 24000);
+        for (size_t packet : {size_t(480), size_t(441), size_t(1), size_t(5000)}) {
+            PolyphaseResampler streamed(48000, out_rate, 2);
+            auto got = Resample(streamed, input, packet);
+            ASSERT_EQ(got.size(), reference.size()) << out_rate << " packet " << packet;
+            for (size_t i = 0; i < got.size(); i++) {
+                ASSERT_EQ(got[i], reference[i]) << out_rate << " packet " << packet << " at " << i;
+            }
+        }
+    }
+}
+
+TEST(PolyphaseResamplerTest, OutputCountTracksRatio) {
+    PolyphaseResampler r(48000, 16000, 1);
+    auto out = Resample(r, Sine(48000, 1, 440.0, 48000.0), 480);
+    // Output lags by the filter look-ahead
+    size_t expected = (48000 - r.GetLatencyFrames()) / 3 + 1;
+    EXPECT_NEAR(static_cast<double>(out.size()), static_cast<double>(expected), 1.0);
+}
+
+TEST(PolyphaseResamplerTest, DecimationPreservesPassband) {
+    PolyphaseResampler r(48000, 16000, 2);
+    auto out = Resample(r, Sine(48000, 2, 1000.0, 48000.0), 480);
+    EXPECT_LT(MaxError(out, 2, 1000.0, 16000.0, r.GetTapsPerPhase()), 2e-3);
+    // Channel 1 is the inverted signal
+    EXPECT_NEAR(out[1000 * 2 + 1], -out[1000 * 2], 1e-6f);
+}
+
+TEST(PolyphaseResamplerTest, RationalRatioPreservesPassband) {
+    PolyphaseResampler r(48000, 44100, 1);
+    auto out = Resample(r, Sine(48000, 1, 3000.0, 48000.0), 441);
+    EXPECT_LT(MaxError(out, 1, 3000.0, 44100.0, r.GetTapsPerPhase()), 2e-3);
+
+    PolyphaseResampler up(16000, 48000, 1);
+    auto up_out = Resample(up, Sine(16000, 1, 1000.0, 16000.0), 160);
+    EXPECT_LT(MaxError(up_out, 1, 1000.0, 48000.0, up.GetTapsPerPhase() * 3), 2e-3);
+}
+
+TEST(PolyphaseResamplerTest, RejectsAliases) {
+    // 10 kHz is above the 8 kHz output Nyquist and must not fold back to 6 kHz
+    PolyphaseResampler r(48000, 16000, 1);
+    auto out = Resample(r, Sine(48000, 1, 10000.0, 48000.0), 480);
+    double sum_sq = 0.0;
+    size_t n = 0;
+    for (size_t j = r.GetTapsPerPhase(); j < out.size(); j++, n++) {
+        sum_sq += static_cast<double>(out[j]) * out[j];
+    }
+    double rms = std::sqrt(sum_sq / n);
+    EXPECT_LT(20.0 * std::log10(rms / (0.5 / std::sqrt(2.0))), -60.0);
+}
+
+TEST(PolyphaseResamplerTest, ResetRestartsStream) {
+    PolyphaseResampler r(48000, 44100, 2);
+    auto input = Sine(4800, 2, 440.0, 48000.0);
+    auto first = Resample(r, input, 480);
+    r.Reset();
+    auto second = Resample(r, input, 480);
+    EXPECT_EQ(first, second);
+}
+
+TEST(PolyphaseResamplerKernelTest, SimdMatchesScalar) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    audio_capture::AlignedVector<float> a(264);
+    std::vector<float> b(265);
+    for (auto& v : a) v = dist(rng);
+    for (auto& v : b) v = dist(rng);
+
+    for (size_t n : {size_t(8), size_t(24), size_t(264)}) {
+        float ref = wasapi_capture::resampler_kernels::DotScalar(a.data(), b.data() + 1, n);
+#if defined(AUDIO_SIMD_X86)
+        EXPECT_NEAR(wasapi_capture::resampler_kernels::DotSse2(a.data(), b.data() + 1, n), ref, 1e-4f);
+        if (wasapi_capture::GetCpuFeatures().avx2 && wasapi_capture::GetCpuFeatures().fma) {
+            EXPECT_NEAR(wasapi_capture::resampler_kernels::DotAvx2(a.data(), b.data() + 1, n), ref, 1e-4f);
+        }
+#endif
+#if defined(AUDIO_SIMD_NEON)
+        EXPECT_NEAR(wasapi_capture::resampler_kernels::DotNeon(a.data(), b.data() + 1, n), ref, 1e-4f);
+#endif
+    }
+}
@@ -0,0 +1,93 @@
+#include "real_fft.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using audio_capture::ComplexFFT;
+using audio_capture::RealFFT;
+
+namespace {
+
+// Reference O(n^2) DFT of a real signal, bins 0 .. n/2
+void NaiveDft(const std::vector<float>& x, std::vector<double>& re, std::vector<double>& im) {
+    const size_t n = x.size();
+    const double pi = 3.14159265358979323846;
+    re.assign(n / 2 + 1, 0.0);
+    im.assign(n / 2 + 1, 0.0);
+    for (size_t k = 0; k <= n / 2; k++) {
+        for (size_t t = 0; t < n; t++) {
+            double angle = -2.0 * pi * static_cast<double>(k * t % n) / n;
+            re[k] += x[t] * std::cos(angle);
+            im[k] += x[t] * std::sin(angle);
+        }
+    }
+}
+
+std::vector<float> RandomSignal(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> x(n);
+    for (auto& v : x) v = dist(rng);
+    return x;
+}
+
+}  // namespace
+
+TEST(RealFftTest, MatchesNaiveDft) {
+    for (size_t n : {4u, 8u, 64u, 512u, 2048u}) {
+        auto x = RandomSignal(n, static_cast<unsigned>(n));
+        std::vector<double> ref_re, ref_im;
+        NaiveDft(x, ref_re, ref_im);
+
+        RealFFT fft(n);
+        std::vector<float> re(fft.BinCount()), im(fft.BinCount());
+        fft.Forward(x.data(), re.data(), im.data());
+
+        double tolerance = 1e-4 * std::sqrt(static_cast<double>(n)) * std::log2(static_cast<double>(n));
+        for (size_t k = 0; k < fft.BinCount(); k++) {
+            EXPECT_NEAR(re[k], ref_re[k], tolerance) << "n=" << n << " bin " << k;
+            EXPECT_NEAR(im[k], ref_im[k], tolerance) << "n=" << n << " bin " << k;
+        }
+    }
+}
+
+TEST(RealFftTest, ComplexFftMatchesRealPath) {
+    const size_t n = 1024;
+    auto x = RandomSignal(n, 7);
+
+    ComplexFFT complex(n);
+    std::vector<float> cre(x.begin(), x.end()), cim(n, 0.0f);
+    complex.Forward(cre.data(), cim.data());
+
+    RealFFT real(n);
+    std::vector<float> re(real.BinCount()), im(real.BinCount());
+    real.Forward(x.data(), re.data(), im.data());
+
+    for (size_t k = 0; k <= n / 2; k++) {
+        EXPECT_NEAR(re[k], cre[k], 1e-3f);
+        EXPECT_NEAR(im[k], cim[k], 1e-3f);
+    }
+}
+
+TEST(RealFftTest, SineLandsInItsBin) {
+    const size_t n = 2048;
+    const size_t bin = 93;
+    std::vector<float> x(n);
+    for (size_t t = 0; t < n; t++) {
+        x[t] = static_cast<float>(std::cos(2.0 * 3.14159265358979323846 * bin * t / n));
+    }
+    RealFFT fft(n);
+    std::vector<float> re(fft.BinCount()), im(fft.BinCount());
+    fft.Forward(x.data(), re.data(), im.data());
+
+    EXPECT_NEAR(std::hypot(re[bin], im[bin]), n / 2.0, 1e-2);
+    EXPECT_NEAR(std::hypot(re[bin + 5], im[bin + 5]), 0.0, 1e-2);
+}
+
+TEST(RealFftTest, RejectsUnsupportedSizes) {
+    EXPECT_FALSE(RealFFT::IsSupportedSize(2));
+    EXPECT_FALSE(RealFFT::IsSupportedSize(1000));
+    EXPECT_TRUE(RealFFT::IsSupportedSize(4096));
+    EXPECT_THROW(RealFFT(1000), std::invalid_argument);
+}
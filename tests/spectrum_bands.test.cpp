@@ -0,0 +1,169 @@
+#include "spectrum_analyzer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using audio_capture::BandScale;
+using audio_capture::SpectrumAnalyzer;
+using audio_capture::SpectrumConfig;
+using audio_capture::SpectrumResult;
+
+namespace {
+
+// The per-frame Hz -> bin loops the fused pass replaced
+struct Reference {
+    std::vector<float> band_energy;
+    float voice_probability = 0.0f;
+    float centroid = 0.0f;
+    float dominant = 0.0f;
+};
+
+int ClampBin(float freq, const SpectrumConfig& c) {
+    int bin = static_cast<int>(freq * c.fft_size / c.sample_rate);
+    return std::max(0, std::min(bin, c.fft_size / 2 - 1));
+}
+
+Reference Compute(const std::vector<float>& mags, const SpectrumConfig& c) {
+    Reference ref;
+    for (const auto& band : c.frequency_bands) {
+        int lo = ClampBin(band.first, c);
+        int hi = ClampBin(band.second, c);
+        double energy = 0.0;
+        int count = 0;
+        for (int i = lo; i <= hi; i++) {
+            energy += mags[i];
+            count++;
+        }
+        ref.band_energy.push_back(count > 0 ? static_cast<float>(energy / count) : 0.0f);
+    }
+
+    int vlo = ClampBin(c.min_voice_freq, c);
+    int vhi = ClampBin(c.max_voice_freq, c);
+    double total = 0.0, voice = 0.0, weighted = 0.0;
+    for (size_t i = 0; i < mags.size(); i++) {
+        total += mags[i];
+        weighted += i * c.sample_rate / static_cast<double>(c.fft_size) * mags[i];
+        if (static_cast<int>(i) >= vlo && static_cast<int>(i) <= vhi) {
+            voice += mags[i];
+        }
+    }
+    ref.voice_probability = total > 1e-10 ? static_cast<float>(voice / total) : 0.0f;
+    ref.centroid = total > 1e-10 ? static_cast<float>(weighted / total) : 0.0f;
+    size_t peak = std::max_element(mags.begin(), mags.end()) - mags.begin();
+    ref.dominant = peak * c.sample_rate / static_cast<float>(c.fft_size);
+    return ref;
+}
+
+std::vector<float> Noise(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> out(n);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = dist(rng) + 0.5f * static_cast<float>(std::sin(0.2 * i));
+    }
+    return out;
+}
+
+void ExpectMatchesReference(SpectrumAnalyzer& analyzer, const std::vector<float>& input) {
+    SpectrumResult result = analyzer.Analyze(input.data(), input.size());
+    const SpectrumConfig& c = analyzer.GetConfig();
+    Reference ref = Compute(result.magnitudes, c);
+
+    ASSERT_EQ(result.bands.size(), ref.band_energy.size());
+    for (size_t i = 0; i < ref.band_energy.size(); i++) {
+        EXPECT_NEAR(result.bands[i].energy, ref.band_energy[i], 1e-5f * ref.band_energy[i] + 1e-9f) << "band " << i;
+    }
+    EXPECT_NEAR(result.voice_probability, ref.voice_probability, 1e-5f);
+    EXPECT_NEAR(result.spectral_centroid, ref.centroid, 1e-3f);
+    EXPECT_FLOAT_EQ(result.dominant_frequency, ref.dominant);
+}
+
+}  // namespace
+
+TEST(SpectrumBandsTest, FusedPassMatchesPerBandLoops) {
+    SpectrumConfig config;
+    config.fft_size = 2048;
+    config.smoothing = 1.0f;
+    SpectrumAnalyzer analyzer(config);
+    ExpectMatchesReference(analyzer, Noise(2048, 1));
+}
+
+TEST(SpectrumBandsTest, TableFollowsBandAndVoiceChanges) {
+    SpectrumConfig config;
+    config.fft_size = 1024;
+    config.smoothing = 1.0f;
+    SpectrumAnalyzer analyzer(config);
+
+    // Overlapping, reversed and out-of-range bands
+    analyzer.SetFrequencyBands({{0.0f, 100.0f}, {50.0f, 30000.0f}, {5000.0f, 1000.0f}, {700.0f, 710.0f}});
+    analyzer.SetVoiceDetectionParams(0.5f, 100.0f, 8000.0f);
+    ExpectMatchesReference(analyzer, Noise(1024, 2));
+
+    SpectrumResult result = analyzer.Analyze(Noise(1024, 3).data(), 1024);
+    EXPECT_EQ(result.bands[2].energy, 0.0f);  // min > max is empty
+    EXPECT_EQ(result.bands[0].name, "Sub-bass");
+}
+
+TEST(SpectrumBandsTest, DominantFrequencyOfSine) {
+    SpectrumConfig config;
+    config.fft_size = 4096;
+    config.smoothing = 1.0f;
+    SpectrumAnalyzer analyzer(config);
+
+    std::vector<float> sine(4096);
+    for (size_t i = 0; i < sine.size(); i++) {
+        sine[i] = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * 1500.0 * i / 48000.0));
+    }
+    SpectrumResult result = analyzer.Analyze(sine.data(), sine.size());
+    EXPECT_NEAR(result.dominant_frequency, 1500.0f, 48000.0f / 4096);
+    EXPECT_NEAR(result.spectral_centroid, 1500.0f, 100.0f);
+    EXPECT_TRUE(result.is_voice);
+}
+
+TEST(SpectrumBandsTest, ThirdOctaveBands) {
+    std::vector<std::string> names;
+    auto bands = SpectrumAnalyzer::MakeBands(BandScale::ThirdOctave, 0, 20.0f, 20000.0f, &names);
+    ASSERT_EQ(bands.size(), 31u);  // 20 Hz .. 20 kHz nominal centres
+    ASSERT_EQ(names.size(), bands.size());
+    EXPECT_EQ(names.front(), "20 Hz");
+    EXPECT_EQ(names[17], "1.0 kHz");
+    EXPECT_FLOAT_EQ(bands.front().first, 20.0f);   // Clipped to the range
+    EXPECT_FLOAT_EQ(bands.back().second, 20000.0f);
+    EXPECT_NEAR(bands[17].first, 1000.0f / std::pow(2.0f, 1.0f / 6.0f), 0.01f);
+    for (size_t i = 1; i < bands.size(); i++) {
+        EXPECT_NEAR(bands[i].first, bands[i - 1].second, 0.01f);  // Contiguous
+    }
+}
+
+TEST(SpectrumBandsTest, LogAndMelBandsCoverTheRange) {
+    for (BandScale scale : {BandScale::Log, BandScale::Mel}) {
+        for (int count : {32, 64, 128}) {
+            std::vector<std::string> names;
+            auto bands = SpectrumAnalyzer::MakeBands(scale, count, 20.0f, 20000.0f, &names);
+            ASSERT_EQ(bands.size(), static_cast<size_t>(count));
+            EXPECT_EQ(names.size(), bands.size());
+            EXPECT_NEAR(bands.front().first, 20.0f, 0.01f);
+            EXPECT_NEAR(bands.back().second, 20000.0f, 1.0f);
+            for (size_t i = 1; i < bands.size(); i++) {
+                EXPECT_GT(bands[i].second - bands[i].first, bands[i - 1].second - bands[i - 1].first);
+            }
+        }
+    }
+}
+
+TEST(SpectrumBandsTest, GeneratedNamesReachTheLayout) {
+    SpectrumConfig config;
+    config.fft_size = 2048;
+    SpectrumAnalyzer analyzer(config);
+
+    std::vector<std::string> names;
+    auto bands = SpectrumAnalyzer::MakeBands(BandScale::Mel, 64, 20.0f, 20000.0f, &names);
+    analyzer.SetFrequencyBands(bands, names);
+    ASSERT_EQ(analyzer.GetBandLayout()->Size(), 64u);
+    EXPECT_EQ(analyzer.GetBandLayout()->names, names);
+
+    SpectrumResult result = analyzer.Analyze(Noise(2048, 4).data(), 2048);
+    EXPECT_EQ(result.bands.size(), 64u);
+}
@@ -0,0 +1,118 @@
+#include "spectrum_analyzer.h"
+#include "spectrum_frame.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using audio_capture::SpectrumAnalyzer;
+using audio_capture::SpectrumConfig;
+using audio_capture::SpectrumFrame;
+using audio_capture::SpectrumFramePool;
+using audio_capture::SpectrumResult;
+
+// Counts heap allocations so steady-state paths can be checked
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+TEST(SpectrumFramePoolTest, AcquireUntilExhaustedThenRecycle) {
+    auto pool = SpectrumFramePool::Create(2, 1024, 7);
+    SpectrumFrame* a = pool->Acquire();
+    SpectrumFrame* b = pool->Acquire();
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(a->bin_count, 1024u);
+    EXPECT_EQ(a->band_count, 7u);
+    // One contiguous block: [magnitudes | band_energy | band_db]
+    EXPECT_EQ(a->ByteSize(), (1024u + 2 * 7u) * sizeof(float));
+    EXPECT_EQ(a->band_energy, a->magnitudes + 1024);
+    EXPECT_EQ(a->band_db, a->band_energy + 7);
+    EXPECT_EQ(pool->Acquire(), nullptr);
+    EXPECT_EQ(pool->Exhausted(), 1u);
+
+    a->Release();
+    EXPECT_EQ(pool->Acquire(), a);
+    a->Release();
+    b->Release();
+    EXPECT_EQ(pool->Available(), 2u);
+}
+
+TEST(SpectrumFramePoolTest, OverflowFramesAreOneOff) {
+    auto pool = SpectrumFramePool::Create(1, 32, 2);
+    SpectrumFrame* pooled = pool->AcquireOrAllocate();
+    SpectrumFrame* extra = pool->AcquireOrAllocate();
+    ASSERT_NE(pooled, nullptr);
+    ASSERT_NE(extra, nullptr);
+    EXPECT_NE(pooled, extra);
+    EXPECT_EQ(extra->bin_count, 32u);
+    EXPECT_EQ(pool->Exhausted(), 1u);
+
+    extra->Release();  // Freed, not added to the pool
+    pooled->Release();
+    EXPECT_EQ(pool->Available(), 1u);
+}
+
+TEST(SpectrumFramePoolTest, FrameInFlightKeepsPoolAlive) {
+    auto pool = SpectrumFramePool::Create(1, 16, 1);
+    std::weak_ptr<SpectrumFramePool> weak = pool;
+    SpectrumFrame* frame = pool->Acquire();
+    pool.reset();                 // Pool replaced after a config change
+    EXPECT_FALSE(weak.expired());
+    frame->magnitudes[0] = 1.0f;  // Still valid
+    frame->Release();
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(SpectrumFramePoolTest, SteadyStateStreamingDoesNotAllocate) {
+    SpectrumConfig config;
+    config.fft_size = 1024;
+    config.hop_size = 480;
+    SpectrumAnalyzer analyzer(config);
+    auto pool = SpectrumFramePool::Create(4, analyzer.GetBinCount(), analyzer.GetBandLayout()->Size());
+
+    std::vector<float> packet(960);
+    for (size_t i = 0; i < packet.size(); i++) {
+        packet[i] = static_cast<float>(std::sin(0.1 * i));
+    }
+    auto emit = [&](const SpectrumResult& result) {
+        SpectrumFrame* frame = pool->Acquire();
+        ASSERT_NE(frame, nullptr);
+        analyzer.ExportFrame(result, *frame);
+        EXPECT_EQ(frame->layout->names[3], "Mid");
+        frame->Release();
+    };
+
+    // Warm-up: first frame sizes the reusable result
+    for (int i = 0; i < 4; i++) analyzer.ProcessStream(packet.data(), 480, 2, emit);
+
+    size_t before = g_allocations.load();
+    size_t frames = 0;
+    for (int i = 0; i < 100; i++) frames += analyzer.ProcessStream(packet.data(), 480, 2, emit);
+    EXPECT_EQ(g_allocations.load(), before);
+    EXPECT_EQ(frames, 100u);
+}
+
+TEST(SpectrumFramePoolTest, BandLayoutRebuiltOnlyOnChange) {
+    SpectrumConfig config;
+    config.fft_size = 512;
+    SpectrumAnalyzer analyzer(config);
+    auto layout = analyzer.GetBandLayout();
+    EXPECT_EQ(layout->Size(), 7u);
+
+    analyzer.SetFrequencyBands({{20.0f, 200.0f}, {200.0f, 2000.0f}});
+    EXPECT_NE(analyzer.GetBandLayout(), layout);
+    EXPECT_EQ(analyzer.GetBandLayout()->names[1], "Bass");
+    EXPECT_FLOAT_EQ(analyzer.GetBandLayout()->max_freq[1], 2000.0f);
+}
@@ -0,0 +1,92 @@
+#include "spectrum_analyzer.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using audio_capture::SpectrumAnalyzer;
+using audio_capture::SpectrumConfig;
+using audio_capture::SpectrumResult;
+
+namespace {
+
+std::vector<float> StereoSine(size_t frames, float freq, int sample_rate, size_t start = 0) {
+    std::vector<float> out(frames * 2);
+    for (size_t i = 0; i < frames; i++) {
+        float v = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * freq * (start + i) / sample_rate));
+        out[2 * i] = v;
+        out[2 * i + 1] = v;
+    }
+    return out;
+}
+
+SpectrumConfig MakeConfig(int hop) {
+    SpectrumConfig config;
+    config.fft_size = 1024;
+    config.sample_rate = 48000;
+    config.smoothing = 1.0f;
+    config.hop_size = hop;
+    return config;
+}
+
+}  // namespace
+
+TEST(SpectrumStftTest, FrameRateIndependentOfPacketSize) {
+    const size_t total = 48000;  // 1 s
+    auto signal = StereoSine(total, 1000.0f, 48000);
+
+    std::vector<uint64_t> reference;
+    for (size_t packet : {total, size_t(480), size_t(441), size_t(1)}) {
+        SpectrumAnalyzer analyzer(MakeConfig(512));
+        std::vector<uint64_t> positions;
+        for (size_t offset = 0; offset < total; offset += packet) {
+            size_t frames = std::min(packet, total - offset);
+            analyzer.ProcessStream(signal.data() + offset * 2, frames, 2,
+                [&](const SpectrumResult& r) { positions.push_back(r.position); });
+        }
+        // First frame after a full window, then one per hop
+        ASSERT_EQ(positions.size(), (total - 1024) / 512 + 1) << "packet " << packet;
+        EXPECT_EQ(positions.front(), 1024u);
+        EXPECT_EQ(positions[1], 1536u);
+        if (reference.empty()) {
+            reference = positions;
+        } else {
+            EXPECT_EQ(positions, reference) << "packet " << packet;
+        }
+    }
+}
+
+TEST(SpectrumStftTest, DownmixesChannels) {
+    // Left and right in opposite phase cancel out in the mono downmix
+    SpectrumAnalyzer analyzer(MakeConfig(1024));
+    std::vector<float> signal = StereoSine(2048, 2000.0f, 48000);
+    for (size_t i = 0; i < 2048; i++) signal[2 * i + 1] = -signal[2 * i];
+
+    float peak = 1.0f;
+    analyzer.ProcessStream(signal.data(), 2048, 2, [&](const SpectrumResult& r) {
+        peak = *std::max_element(r.magnitudes.begin(), r.magnitudes.end());
+    });
+    EXPECT_LT(peak, 1e-6f);
+}
+
+TEST(SpectrumStftTest, WindowSpansPacketBoundaries) {
+    SpectrumAnalyzer analyzer(MakeConfig(256));
+    float dominant = 0.0f;
+    size_t frames = 0;
+    for (size_t offset = 0; offset < 4800; offset += 480) {
+        auto packet = StereoSine(480, 3000.0f, 48000, offset);
+        frames += analyzer.ProcessStream(packet.data(), 480, 2, [&](const SpectrumResult& r) {
+            dominant = r.dominant_frequency;
+        });
+    }
+    EXPECT_EQ(frames, (4800u - 1024u) / 256u + 1u);
+    EXPECT_NEAR(dominant, 3000.0f, 48000.0f / 1024.0f);
+}
+
+TEST(SpectrumStftTest, ResetRequiresFullWindow) {
+    SpectrumAnalyzer analyzer(MakeConfig(128));
+    auto signal = StereoSine(2000, 500.0f, 48000);
+    EXPECT_GT(analyzer.ProcessStream(signal.data(), 2000, 2, [](const SpectrumResult&) {}), 0u);
+    analyzer.ResetStream();
+    EXPECT_EQ(analyzer.ProcessStream(signal.data(), 1000, 2, [](const SpectrumResult&) {}), 0u);
+    EXPECT_EQ(analyzer.ProcessStream(signal.data(), 24, 2, [](const SpectrumResult&) {}), 1u);
+}
@@ -0,0 +1,86 @@
+#include "spsc_ring_buffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using AudioCapture::SpscPacketRing;
+
+TEST(SpscPacketRingTest, RoundsCapacityToPowerOfTwo) {
+    SpscPacketRing ring(5, 64);
+    EXPECT_EQ(ring.Capacity(), 8u);
+    EXPECT_EQ(ring.SlotCapacity(), 64u);
+    EXPECT_TRUE(ring.Empty());
+}
+
+TEST(SpscPacketRingTest, PushFrontPop) {
+    SpscPacketRing ring(4, 16);
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    ASSERT_TRUE(ring.TryPush(data, sizeof(data)));
+    EXPECT_EQ(ring.Size(), 1u);
+
+    SpscPacketRing::Slot slot;
+    ASSERT_TRUE(ring.Front(slot));
+    EXPECT_EQ(slot.size, sizeof(data));
+    EXPECT_EQ(memcmp(slot.data, data, sizeof(data)), 0);
+    ring.Pop();
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_FALSE(ring.Front(slot));
+}
+
+TEST(SpscPacketRingTest, SplitsOversizedPacketOnFrameBoundary) {
+    SpscPacketRing ring(8, 20);  // 20 bytes -> 16 usable with 8-byte frames
+    std::vector<uint8_t> data(40);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i);
+    ASSERT_TRUE(ring.TryPush(data.data(), data.size(), 8));
+    EXPECT_EQ(ring.Size(), 3u);
+
+    std::vector<uint8_t> out;
+    std::vector<bool> last;
+    SpscPacketRing::Slot slot;
+    while (ring.Front(slot)) {
+        EXPECT_EQ(slot.size % 8, 0u);
+        out.insert(out.end(), slot.data, slot.data + slot.size);
+        last.push_back(slot.last);
+        ring.Pop();
+    }
+    EXPECT_EQ(out, data);
+    EXPECT_EQ(last, (std::vector<bool>{false, false, true}));
+}
+
+TEST(SpscPacketRingTest, CountsOverrunWhenFull) {
+    SpscPacketRing ring(2, 8);
+    uint8_t data[8] = {};
+    EXPECT_TRUE(ring.TryPush(data, sizeof(data)));
+    EXPECT_TRUE(ring.TryPush(data, sizeof(data)));
+    EXPECT_FALSE(ring.TryPush(data, sizeof(data)));
+    EXPECT_EQ(ring.Overruns(), 1u);
+    EXPECT_EQ(ring.HighWater(), 2u);
+}
+
+TEST(SpscPacketRingTest, ProducerConsumerPreservesOrder) {
+    SpscPacketRing ring(16, sizeof(uint32_t));
+    const uint32_t count = 100000;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < count; i++) {
+            while (!ring.TryPush(reinterpret_cast<const uint8_t*>(&i), sizeof(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    SpscPacketRing::Slot slot;
+    while (expected < count) {
+        if (!ring.Front(slot)) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t value;
+        memcpy(&value, slot.data, sizeof(value));
+        ASSERT_EQ(value, expected);
+        ring.Pop();
+        expected++;
+    }
+    producer.join();
+}
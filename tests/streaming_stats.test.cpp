@@ -0,0 +1,117 @@
+#include "streaming_stats.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using wasapi_capture::StreamingStatsAccumulator;
+using wasapi_capture::StreamingStatsSnapshot;
+
+TEST(StreamingStatsTest, IntervalCountedInSamples) {
+    StreamingStatsAccumulator acc;
+    acc.SetFormat(48000, 2);
+    acc.SetInterval(100);  // 9600 samples
+    EXPECT_EQ(acc.GetIntervalSamples(), 9600u);
+
+    std::vector<float> packet(960, 0.5f);  // 10 ms stereo
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_FALSE(acc.Add(packet.data(), packet.size()));
+    }
+    EXPECT_TRUE(acc.Add(packet.data(), packet.size()));
+
+    StreamingStatsSnapshot snapshot = acc.TakeSnapshot();
+    EXPECT_EQ(snapshot.sampleCount, 9600u);
+    EXPECT_FLOAT_EQ(snapshot.stats.peak, 0.5f);
+    EXPECT_FLOAT_EQ(snapshot.stats.rms, 0.5f);
+    EXPECT_FALSE(snapshot.stats.isSilence);
+    EXPECT_EQ(acc.GetPendingSamples(), 0u);
+}
+
+TEST(StreamingStatsTest, MatchesOneShotCalculation) {
+    StreamingStatsAccumulator acc;
+    acc.SetFormat(48000, 1);
+    acc.SetInterval(1000);
+
+    std::vector<float> all;
+    for (int p = 0; p < 10; ++p) {
+        std::vector<float> packet(480);
+        for (size_t i = 0; i < packet.size(); ++i) {
+            packet[i] = static_cast<float>((i * 7 + p * 13) % 200) / 200.0f - 0.5f;
+        }
+        acc.Add(packet.data(), packet.size());
+        all.insert(all.end(), packet.begin(), packet.end());
+    }
+
+    wasapi_capture::AudioStatsCalculator calculator;
+    auto expected = calculator.Calculate(all.data(), all.size());
+    auto snapshot = acc.TakeSnapshot();
+    EXPECT_FLOAT_EQ(snapshot.stats.peak, expected.peak);
+    EXPECT_NEAR(snapshot.stats.rms, expected.rms, 1e-6f);
+    EXPECT_EQ(snapshot.sampleCount, all.size());
+}
+
+TEST(StreamingStatsTest, SilenceRunSpansIntervals) {
+    StreamingStatsAccumulator acc;
+    acc.SetFormat(48000, 2);
+    acc.SetInterval(20);
+
+    std::vector<float> loud(960, 0.25f);
+    std::vector<float> quiet(960, 0.0f);
+
+    acc.Add(loud.data(), loud.size());
+    acc.Add(quiet.data(), quiet.size());
+    auto first = acc.TakeSnapshot();
+    EXPECT_DOUBLE_EQ(first.silenceDurationMs, 10.0);
+    EXPECT_FALSE(first.stats.isSilence);
+
+    acc.Add(quiet.data(), quiet.size());
+    acc.Add(quiet.data(), quiet.size());
+    auto second = acc.TakeSnapshot();
+    EXPECT_DOUBLE_EQ(second.silenceDurationMs, 30.0);
+    EXPECT_TRUE(second.stats.isSilence);
+
+    acc.Add(loud.data(), loud.size());
+    EXPECT_DOUBLE_EQ(acc.TakeSnapshot().silenceDurationMs, 0.0);
+}
+
+TEST(StreamingStatsTest, Int16Input) {
+    StreamingStatsAccumulator acc;
+    acc.SetFormat(16000, 1);
+    acc.SetInterval(10);  // 160 samples
+
+    std::vector<int16_t> packet(160, -16384);
+    EXPECT_TRUE(acc.Add(packet.data(), packet.size()));
+    auto snapshot = acc.TakeSnapshot();
+    EXPECT_FLOAT_EQ(snapshot.stats.peak, 0.5f);
+    EXPECT_FLOAT_EQ(snapshot.stats.rms, 0.5f);
+}
+
+TEST(StreamingStatsTest, EmptySnapshotIsSilent) {
+    StreamingStatsAccumulator acc;
+    auto snapshot = acc.TakeSnapshot();
+    EXPECT_EQ(snapshot.sampleCount, 0u);
+    EXPECT_TRUE(snapshot.stats.isSilence);
+}
+
+TEST(StreamingStatsTest, DeferredIntervalMergesIntoNext) {
+    StreamingStatsAccumulator acc;
+    acc.SetFormat(1000, 1);
+    acc.SetInterval(100);  // 100 samples
+
+    std::vector<float> loud(100, 0.5f);
+    std::vector<float> quiet(100, 0.25f);
+    EXPECT_TRUE(acc.Add(loud.data(), loud.size()));
+    acc.Defer();  // Snapshot could not be delivered
+
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_FALSE(acc.Add(quiet.data(), 10));
+    }
+    EXPECT_TRUE(acc.Add(quiet.data(), 10));
+
+    auto snapshot = acc.TakeSnapshot();
+    EXPECT_EQ(snapshot.sampleCount, 200u);
+    EXPECT_FLOAT_EQ(snapshot.stats.peak, 0.5f);
+    EXPECT_NEAR(snapshot.stats.rms, std::sqrt((0.25f + 0.0625f) / 2.0f), 1e-6f);
+
+    EXPECT_FALSE(acc.Add(quiet.data(), 99));  // Back to one interval
+    EXPECT_TRUE(acc.Add(quiet.data(), 1));
+}
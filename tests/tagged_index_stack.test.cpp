@@ -0,0 +1,60 @@
+#include "tagged_index_stack.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using AudioCapture::TaggedIndexStack;
+
+TEST(TaggedIndexStackTest, LifoOrder) {
+    TaggedIndexStack stack(4);
+    EXPECT_EQ(stack.Pop(), TaggedIndexStack::kEmpty);
+    stack.Push(1);
+    stack.Push(3);
+    EXPECT_EQ(stack.Size(), 2u);
+    EXPECT_EQ(stack.Pop(), 3u);
+    EXPECT_EQ(stack.Pop(), 1u);
+    EXPECT_EQ(stack.Pop(), TaggedIndexStack::kEmpty);
+    EXPECT_EQ(stack.Size(), 0u);
+}
+
+TEST(TaggedIndexStackTest, ConcurrentPushPopKeepsEveryIndex) {
+    const uint32_t capacity = 64;
+    TaggedIndexStack stack(capacity);
+    for (uint32_t i = 0; i < capacity; ++i) {
+        stack.Push(i);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&stack]() {
+            std::vector<uint32_t> held;
+            for (int i = 0; i < 50000; ++i) {
+                uint32_t index = stack.Pop();
+                if (index != TaggedIndexStack::kEmpty) {
+                    held.push_back(index);
+                }
+                if (held.size() > 4) {
+                    stack.Push(held.front());
+                    held.erase(held.begin());
+                }
+            }
+            for (uint32_t index : held) {
+                stack.Push(index);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every index comes back exactly once
+    std::vector<int> seen(capacity, 0);
+    uint32_t index;
+    while ((index = stack.Pop()) != TaggedIndexStack::kEmpty) {
+        ASSERT_LT(index, capacity);
+        seen[index]++;
+    }
+    for (uint32_t i = 0; i < capacity; ++i) {
+        EXPECT_EQ(seen[i], 1) << "index " << i;
+    }
+}
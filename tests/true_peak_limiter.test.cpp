@@ -0,0 +1,155 @@
+#include "true_peak_limiter.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using wasapi_capture::LimiterConfig;
+using wasapi_capture::TruePeakLimiter;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<float> Sine(size_t frames, size_t channels, double freq, float amplitude, double phase = 0.0) {
+    std::vector<float> out(frames * channels);
+    for (size_t f = 0; f < frames; f++) {
+        float v = amplitude * static_cast<float>(std::sin(2.0 * kPi * freq * f / 48000.0 + phase));
+        for (size_t c = 0; c < channels; c++) {
+            out[f * channels + c] = v;
+        }
+    }
+    return out;
+}
+
+std::vector<float> ProcessPackets(TruePeakLimiter& limiter, std::vector<float> data, size_t packet) {
+    size_t channels = limiter.GetConfig().channels;
+    size_t frames = data.size() / channels;
+    for (size_t offset = 0; offset < frames; offset += packet) {
+        limiter.Process(data.data() + offset * channels, (std::min)(packet, frames - offset));
+    }
+    return data;
+}
+
+float PeakAbs(const std::vector<float>& data, size_t begin, size_t end) {
+    float peak = 0.0f;
+    for (size_t i = begin; i < end; i++) {
+        peak = (std::max)(peak, std::fabs(data[i]));
+    }
+    return peak;
+}
+
+}  // namespace
+
+TEST(TruePeakLimiterTest, QuietSignalOnlyDelayed) {
+    TruePeakLimiter limiter(LimiterConfig{});
+    const size_t latency = limiter.GetLatencyFrames();
+    EXPECT_EQ(latency, 72u + 5u);  // 1.5 ms + interpolator
+
+    auto input = Sine(4800, 2, 1000.0, 0.5f);
+    auto output = ProcessPackets(limiter, input, 441);
+    for (size_t i = 0; i < latency * 2; i++) {
+        ASSERT_EQ(output[i], 0.0f);
+    }
+    for (size_t i = latency * 2; i < output.size(); i++) {
+        ASSERT_EQ(output[i], input[i - latency * 2]);
+    }
+    EXPECT_EQ(limiter.GetStats().limited_frames, 0u);
+    EXPECT_EQ(limiter.GetStats().gain_reduction_db, 0.0f);
+}
+
+TEST(TruePeakLimiterTest, CatchesInterSamplePeaks) {
+    // fs/4 at 45 degrees: samples at +-0.707, true peak 1.0 (0 dBTP)
+    LimiterConfig config;
+    config.channels = 1;
+    TruePeakLimiter limiter(config);
+    auto input = Sine(9600, 1, 12000.0, 1.0f, kPi / 4.0);
+    EXPECT_LT(PeakAbs(input, 0, input.size()), 0.8f);  // Below the -1 dB ceiling (0.891)
+
+    auto output = ProcessPackets(limiter, input, 480);
+    auto stats = limiter.GetStats();
+    EXPECT_NEAR(stats.true_peak_db, 0.0f, 0.3f);
+    EXPECT_NEAR(stats.gain_reduction_db, 1.0f, 0.3f);
+    // Steady state: the reconstructed peak sits at the ceiling
+    EXPECT_NEAR(PeakAbs(output, 4800, 9600) / 0.70710678f, 0.891f, 0.03f);
+}
+
+TEST(TruePeakLimiterTest, TransientIsLimitedBeforeItArrives) {
+    LimiterConfig config;
+    config.channels = 1;
+    config.release_ms = 20.0f;
+    TruePeakLimiter limiter(config);
+    const size_t latency = limiter.GetLatencyFrames();
+
+    // Quiet tone with a +12 dB burst in the middle
+    auto input = Sine(24000, 1, 500.0, 0.25f);
+    for (size_t i = 9600; i < 10080; i++) {
+        input[i] *= 4.0f;
+    }
+    auto output = ProcessPackets(limiter, input, 441);
+
+    const float ceiling = std::pow(10.0f, -1.0f / 20.0f);
+    EXPECT_LE(PeakAbs(output, 0, output.size()), ceiling);
+    // Gain reduction ramps in during the look-ahead, before the burst leaves the delay line
+    float ramp = 0.0f;
+    for (size_t i = 9600 - 40; i < 9600; i++) {
+        ramp = (std::max)(ramp, std::fabs(output[i + latency] - input[i]));
+    }
+    EXPECT_GT(ramp, 0.0f);
+    // Released a few time constants later
+    for (size_t i = 18000; i < 24000 - latency; i++) {
+        ASSERT_NEAR(output[i + latency], input[i], 1e-4f) << i;
+    }
+    auto stats = limiter.GetStats();
+    EXPECT_NEAR(stats.max_gain_reduction_db, 20.0f * std::log10(1.0f / ceiling), 0.2f);
+    EXPECT_GT(stats.limited_frames, 480u);
+    EXPECT_EQ(stats.gain_reduction_db, 0.0f);
+}
+
+TEST(TruePeakLimiterTest, PacketSizeIndependent) {
+    LimiterConfig config;
+    config.channels = 6;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<float> input(6 * 9000);
+    for (auto& v : input) {
+        v = dist(rng);
+    }
+
+    TruePeakLimiter reference(config);
+    auto expected = ProcessPackets(reference, input, 480);
+    for (size_t packet : {1u, 7u, 1000u}) {
+        TruePeakLimiter limiter(config);
+        EXPECT_EQ(ProcessPackets(limiter, input, packet), expected) << packet;
+    }
+    EXPECT_LE(PeakAbs(expected, 0, expected.size()), std::pow(10.0f, -1.0f / 20.0f));
+}
+
+TEST(TruePeakLimiterTest, SimdMatchesScalar) {
+    using namespace wasapi_capture::limiter_kernels;
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> window(12), coeffs(48);
+    for (auto& v : window) v = dist(rng);
+    for (auto& v : coeffs) v = dist(rng);
+
+    float ref = TruePeakScalar(window.data(), coeffs.data(), 12);
+#if defined(AUDIO_SIMD_X86)
+    EXPECT_FLOAT_EQ(TruePeakSse2(window.data(), coeffs.data(), 12), ref);
+#endif
+#if defined(AUDIO_SIMD_NEON)
+    EXPECT_FLOAT_EQ(TruePeakNeon(window.data(), coeffs.data(), 12), ref);
+#endif
+}
+
+TEST(TruePeakLimiterTest, RejectsInvalidConfig) {
+    LimiterConfig config;
+    config.channels = 9;
+    EXPECT_THROW(TruePeakLimiter bad(config), std::invalid_argument);
+    config = LimiterConfig{};
+    config.ceiling_db = 1.0f;
+    EXPECT_THROW(TruePeakLimiter bad(config), std::invalid_argument);
+    config = LimiterConfig{};
+    config.lookahead_ms = 0.0f;
+    EXPECT_THROW(TruePeakLimiter bad(config), std::invalid_argument);
+}
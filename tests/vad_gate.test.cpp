@@ -0,0 +1,172 @@
+#include "vad_gate.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using AudioCapture::VadEvent;
+using AudioCapture::VadGate;
+using AudioCapture::VadGateConfig;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// 16 kHz mono, 10 ms hops of 160 frames
+VadGateConfig TestConfig() {
+    VadGateConfig config;
+    config.sample_rate = 16000;
+    config.channels = 1;
+    config.attack_ms = 30;    // 3 hops
+    config.hangover_ms = 100; // 10 hops
+    config.pre_roll_ms = 50;  // 800 frames
+    return config;
+}
+
+struct Segment {
+    uint64_t start = 0;
+    uint64_t onset = 0;
+    uint64_t end = 0;
+};
+
+struct GateRun {
+    std::vector<float> output;
+    std::vector<Segment> segments;
+};
+
+// Feeds packets of the given sizes; prob(hop) < 0 selects the energy detector
+template <typename Prob>
+GateRun Feed(VadGate& gate, const std::vector<float>& input, size_t packet, Prob prob) {
+    GateRun run;
+    std::vector<float> out(gate.MaxOutputFrames(packet));
+    for (size_t offset = 0; offset < input.size(); offset += packet) {
+        size_t n = (std::min)(packet, input.size() - offset);
+        size_t written = gate.Process(input.data() + offset, n, out.data(), prob(offset / 160));
+        for (size_t e = 0; e < gate.GetEventCount(); e++) {
+            const VadEvent& event = gate.GetEvents()[e];
+            if (event.type == VadEvent::Type::SpeechStart) {
+                run.segments.push_back({event.position, event.onset, 0});
+            } else {
+                run.segments.back().end = event.position;
+            }
+        }
+        run.output.insert(run.output.end(), out.begin(), out.begin() + written);
+    }
+    return run;
+}
+
+std::vector<float> Ramp(size_t n) {
+    std::vector<float> v(n);
+    for (size_t i = 0; i < n; i++) {
+        v[i] = static_cast<float>(i);
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST(VadGateTest, ReleasesPreRollAndDeliversHangover) {
+    VadGate gate(TestConfig());
+    auto input = Ramp(100 * 160);  // Sample value = stream position
+    auto run = Feed(gate, input, 160, [](size_t hop) { return hop >= 20 && hop < 40 ? 1.0f : 0.0f; });
+
+    ASSERT_EQ(run.segments.size(), 1u);
+    EXPECT_EQ(run.segments[0].onset, 3200u);        // Hop 20
+    EXPECT_EQ(run.segments[0].start, 2400u);        // 50 ms earlier
+    EXPECT_EQ(run.segments[0].end, 50u * 160u);     // 10 silent hops after hop 39
+    ASSERT_EQ(run.output.size(), 8000u - 2400u);
+    for (size_t i = 0; i < run.output.size(); i++) {
+        ASSERT_EQ(run.output[i], static_cast<float>(2400 + i));  // Contiguous, nothing lost
+    }
+    EXPECT_EQ(gate.GetSegments(), 1u);
+    EXPECT_FALSE(gate.IsSpeaking());
+}
+
+TEST(VadGateTest, ShortBurstsDoNotOpen) {
+    VadGate gate(TestConfig());
+    auto input = Ramp(50 * 160);
+    auto run = Feed(gate, input, 160, [](size_t hop) { return hop % 5 < 2 ? 0.9f : 0.1f; });
+    EXPECT_TRUE(run.segments.empty());
+    EXPECT_TRUE(run.output.empty());
+}
+
+TEST(VadGateTest, EnergyDetectorIsPacketSizeIndependent) {
+    // Low noise, one second of a loud tone, low noise
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-0.001f, 0.001f);
+    std::vector<float> input(3 * 16000);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = noise(rng);
+        if (i >= 16000 && i < 32000) {
+            input[i] += 0.3f * std::sin(2.0 * kPi * 300.0 * i / 16000.0);
+        }
+    }
+
+    GateRun reference;
+    for (size_t packet : {160u, 441u, 1000u, 7u}) {
+        VadGate gate(TestConfig());
+        auto run = Feed(gate, input, packet, [](size_t) { return -1.0f; });
+        ASSERT_EQ(run.segments.size(), 1u) << packet;
+        EXPECT_EQ(run.segments[0].onset, 16000u);
+        EXPECT_EQ(run.segments[0].start, 15200u);
+        EXPECT_EQ(run.segments[0].end, 32000u + 1600u);
+        if (packet == 160) {
+            reference = run;
+        } else {
+            EXPECT_EQ(run.output, reference.output) << packet;
+        }
+    }
+}
+
+TEST(VadGateTest, CloseEndsOpenSegment) {
+    VadGate gate(TestConfig());
+    auto input = Ramp(10 * 160);
+    Feed(gate, input, 320, [](size_t) { return 1.0f; });
+    EXPECT_TRUE(gate.IsSpeaking());
+
+    VadEvent event;
+    ASSERT_TRUE(gate.Close(event));
+    EXPECT_EQ(event.type, VadEvent::Type::SpeechEnd);
+    EXPECT_EQ(event.position, 1600u);
+    EXPECT_FALSE(gate.Close(event));
+
+    gate.Reset();
+    EXPECT_EQ(gate.GetPosition(), 0u);
+}
+
+TEST(VadGateTest, StereoFramesStayInterleaved) {
+    VadGateConfig config = TestConfig();
+    config.channels = 2;
+    config.pre_roll_ms = 0;
+    VadGate gate(config);
+
+    std::vector<float> input(2 * 160 * 6);
+    for (size_t f = 0; f < input.size() / 2; f++) {
+        input[f * 2] = static_cast<float>(f);
+        input[f * 2 + 1] = -static_cast<float>(f);
+    }
+    std::vector<float> out(2 * gate.MaxOutputFrames(input.size() / 2));
+    size_t written = gate.Process(input.data(), input.size() / 2, out.data(), 1.0f);
+    ASSERT_EQ(written, 6u * 160u);  // Opens after 3 hops, releases them, passes the rest
+    for (size_t f = 0; f < written; f++) {
+        ASSERT_EQ(out[f * 2], static_cast<float>(f));
+        ASSERT_EQ(out[f * 2 + 1], -static_cast<float>(f));
+    }
+    ASSERT_EQ(gate.GetEventCount(), 1u);
+    EXPECT_EQ(gate.GetEvents()[0].output_offset, 0u);
+}
+
+TEST(VadGateTest, RejectsInvalidConfig) {
+    VadGateConfig config = TestConfig();
+    config.threshold = 1.5f;
+    EXPECT_THROW(VadGate bad(config), std::invalid_argument);
+    config = TestConfig();
+    config.hop_ms = 0;
+    EXPECT_THROW(VadGate bad(config), std::invalid_argument);
+
+    AudioCapture::VadSource source = AudioCapture::VadSource::Auto;
+    EXPECT_TRUE(AudioCapture::ParseVadSource("energy", source));
+    EXPECT_EQ(source, AudioCapture::VadSource::Energy);
+    EXPECT_STREQ(AudioCapture::VadSourceName(source), "energy");
+    EXPECT_FALSE(AudioCapture::ParseVadSource("webrtc", source));
+}
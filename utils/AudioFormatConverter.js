@@ -2,6 +2,9 @@
  * 音频格式转换工具类
  * 用于将 node-windows-audio-capture 的输出格式转换为 Gummy API 要求的格式
  * 
+ * v2.12: 捕获路径上请改用原生选项 { outputFormat: 'int16', outputChannels: 1 }，
+ * 转换在原生处理线程上完成，交给 JS 的数据量最多减少 4 倍；本类保留用于已有数据的离线转换
+ * 
  * @author node-windows-audio-capture
  * @version 1.0.0
  * @date 2025-10-14